@@ -0,0 +1,177 @@
+/*
+ * Per thread pool of printbufs
+ *
+ * This library is free software; you can redistribute it and/or modify
+ * it under the terms of the MIT license. See COPYING for details.
+ *
+ */
+
+/**
+ * json_printbuf_pool_get() hands out a printbuf from a pool kept by the
+ * calling thread, json_printbuf_pool_put() gives it back with its buffer,
+ * so a thread which serializes a message after the other reuses the same
+ * memory. The printbufs are regular ones: they can be passed to the
+ * printbuf functions and released with printbuf_free().
+ *
+ * json_printbuf_memappend() is an inline printbuf_memappend() which at
+ * least doubles the buffer when it grows.
+ */
+
+#ifndef _printbuf_pool_h_
+#define _printbuf_pool_h_
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "printbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * number of printbufs kept per thread
+ */
+#ifndef JSON_PRINTBUF_POOL_SIZE
+#define JSON_PRINTBUF_POOL_SIZE 8
+#endif
+
+/**
+ * printbufs larger than this are freed instead of being kept
+ */
+#ifndef JSON_PRINTBUF_POOL_MAX_SIZE
+#define JSON_PRINTBUF_POOL_MAX_SIZE (256 * 1024)
+#endif
+
+/**
+ * initial size of the printbufs of the pool
+ */
+#define JSON_PRINTBUF_POOL_INITIAL_SIZE 256
+
+/* INTERNAL: printbufs kept by a thread */
+struct json_printbuf_pool
+{
+  struct printbuf *free[JSON_PRINTBUF_POOL_SIZE];
+  int count;
+};
+
+/* INTERNAL: key of the pool of the calling thread, shared by all the compilation units */
+struct json_printbuf_pool_key
+{
+  pthread_once_t once;
+  int created;
+  pthread_key_t key;
+};
+
+__attribute__((weak)) struct json_printbuf_pool_key json_printbuf_pool_key = { PTHREAD_ONCE_INIT, 0, 0 };
+
+/* INTERNAL: free the pool of an exiting thread */
+static inline void json_printbuf_pool_release(void *arg)
+{
+  struct json_printbuf_pool *pool = (struct json_printbuf_pool*)arg;
+  int i;
+  for(i = 0; i < pool->count; i++) printbuf_free(pool->free[i]);
+  free(pool);
+}
+
+static inline void json_printbuf_pool_create_key(void)
+{
+  json_printbuf_pool_key.created = (pthread_key_create(&json_printbuf_pool_key.key, json_printbuf_pool_release) == 0);
+}
+
+/* INTERNAL: pool of the calling thread, created on first use */
+static inline struct json_printbuf_pool* json_printbuf_pool_self(void)
+{
+  struct json_printbuf_pool *pool;
+  pthread_once(&json_printbuf_pool_key.once, json_printbuf_pool_create_key);
+  if(!json_printbuf_pool_key.created) return NULL;
+  pool = (struct json_printbuf_pool*)pthread_getspecific(json_printbuf_pool_key.key);
+  if(pool == NULL) {
+    pool = (struct json_printbuf_pool*)calloc(1, sizeof(struct json_printbuf_pool));
+    if(pool != NULL && pthread_setspecific(json_printbuf_pool_key.key, pool) != 0) {
+      free(pool);
+      pool = NULL;
+    }
+  }
+  return pool;
+}
+
+/**
+ * Get an empty printbuf from the pool of the calling thread
+ * @returns the printbuf, to give back with json_printbuf_pool_put(), or NULL if out of memory
+ */
+static inline struct printbuf* json_printbuf_pool_get(void)
+{
+  struct json_printbuf_pool *pool = json_printbuf_pool_self();
+  struct printbuf *p;
+
+  if(pool != NULL && pool->count > 0) {
+    p = pool->free[--pool->count];
+    p->bpos = 0;
+    p->buf[0] = '\0';
+    return p;
+  }
+
+  p = (struct printbuf*)calloc(1, sizeof(struct printbuf));
+  if(p == NULL) return NULL;
+  p->size = JSON_PRINTBUF_POOL_INITIAL_SIZE;
+  p->bpos = 0;
+  p->buf = (char*)malloc((size_t)p->size);
+  if(p->buf == NULL) {
+    free(p);
+    return NULL;
+  }
+  p->buf[0] = '\0';
+  return p;
+}
+
+/**
+ * Give a printbuf back to the pool of the calling thread
+ *
+ * The printbuf can come from json_printbuf_pool_get() or printbuf_new().
+ * It is freed when the pool is full or when it is larger than
+ * JSON_PRINTBUF_POOL_MAX_SIZE.
+ *
+ * @param p the printbuf, or NULL
+ */
+static inline void json_printbuf_pool_put(struct printbuf *p)
+{
+  struct json_printbuf_pool *pool;
+  if(p == NULL) return;
+  pool = json_printbuf_pool_self();
+  if(pool != NULL && pool->count < JSON_PRINTBUF_POOL_SIZE && p->size <= JSON_PRINTBUF_POOL_MAX_SIZE) {
+    pool->free[pool->count++] = p;
+  } else {
+    printbuf_free(p);
+  }
+}
+
+/**
+ * Append data to a printbuf, growing it geometrically
+ * @param p the printbuf
+ * @param buf the data
+ * @param size the size of the data
+ * @returns size, or -1 if out of memory
+ */
+static inline int json_printbuf_memappend(struct printbuf *p, const char *buf, int size)
+{
+  if(p->size - p->bpos <= size) {
+    int new_size = p->size * 2;
+    char *t;
+    if(new_size < p->bpos + size + 8) new_size = p->bpos + size + 8;
+    t = (char*)realloc(p->buf, (size_t)new_size);
+    if(t == NULL) return -1;
+    p->size = new_size;
+    p->buf = t;
+  }
+  memcpy(p->buf + p->bpos, buf, (size_t)size);
+  p->bpos += size;
+  p->buf[p->bpos] = '\0';
+  return size;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,739 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARDISCOVERY_DeviceRegistry.h
+ * @brief Portable registry of resolved network devices
+ * @note The registry caches the services resolved by the platform discovery (Bonjour on iOS,
+ * avahi or any other resolver elsewhere) with a time to live, probes their reachability in
+ * parallel and hands out copies of a prebuilt ARDISCOVERY_Device_t, so a reconnection does
+ * not need to resolve the service again.
+ * @date 10/18/2026
+ */
+
+#ifndef _ARDISCOVERY_DEVICE_REGISTRY_H_
+#define _ARDISCOVERY_DEVICE_REGISTRY_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <uthash/uthash.h>
+#include <libARSAL/ARSAL_Allocator.h>
+#include <libARSAL/ARSAL_Mutex.h>
+#include <libARSAL/ARSAL_Time.h>
+#include <libARSAL/ARSAL_Socket.h>
+#include <libARDiscovery/ARDISCOVERY_Error.h>
+#include <libARDiscovery/ARDISCOVERY_Discovery.h>
+#include <libARDiscovery/ARDISCOVERY_Device.h>
+
+/**
+ * @brief Maximum size of a service name, including the null terminator
+ */
+#define ARDISCOVERY_DEVICEREGISTRY_NAME_SIZE 128
+
+/**
+ * @brief Maximum size of a numeric IPv4 or IPv6 address, including the null terminator
+ */
+#define ARDISCOVERY_DEVICEREGISTRY_ADDRESS_SIZE 64
+
+/**
+ * @brief Default time to live of a resolved service in milliseconds
+ */
+#define ARDISCOVERY_DEVICEREGISTRY_DEFAULT_TTL_MS 60000
+
+/**
+ * @brief Default reachability probe timeout in milliseconds
+ */
+#define ARDISCOVERY_DEVICEREGISTRY_DEFAULT_PROBE_TIMEOUT_MS 500
+
+/**
+ * @brief Reachability of a registered service
+ */
+typedef enum
+{
+    ARDISCOVERY_DEVICEREGISTRY_REACHABILITY_UNKNOWN = 0,    ///< Not probed since it was resolved
+    ARDISCOVERY_DEVICEREGISTRY_REACHABILITY_REACHABLE,      ///< Last probe succeeded
+    ARDISCOVERY_DEVICEREGISTRY_REACHABILITY_UNREACHABLE,    ///< Last probe failed
+
+    ARDISCOVERY_DEVICEREGISTRY_REACHABILITY_MAX             ///< Max of reachability states
+} eARDISCOVERY_DEVICEREGISTRY_REACHABILITY;
+
+/**
+ * @brief Kind of reachability probe
+ */
+typedef enum
+{
+    ARDISCOVERY_DEVICEREGISTRY_PROBE_TCP = 0,   ///< Non blocking connection to the discovery port, closed as soon as it is established
+
+    ARDISCOVERY_DEVICEREGISTRY_PROBE_MAX        ///< Max of probe kinds
+} eARDISCOVERY_DEVICEREGISTRY_PROBE;
+
+/**
+ * @brief Public description of a registered service
+ */
+typedef struct
+{
+    char name[ARDISCOVERY_DEVICEREGISTRY_NAME_SIZE];        ///< Name of the service
+    eARDISCOVERY_PRODUCT product;                           ///< Product of the service
+    char address[ARDISCOVERY_DEVICEREGISTRY_ADDRESS_SIZE];  ///< Numeric IP address of the service
+    int port;                                               ///< Discovery port of the service
+    eARDISCOVERY_DEVICEREGISTRY_REACHABILITY reachability;  ///< Result of the last probe
+    int32_t roundTripMs;                                    ///< Duration of the last successful probe in milliseconds, -1 if none
+    int32_t remainingTtlMs;                                 ///< Remaining time to live in milliseconds, 0 if expired
+} ARDISCOVERY_DeviceRegistry_Service_t;
+
+/**
+ * @brief INTERNAL TYPE : Registry entry
+ */
+typedef struct
+{
+    ARDISCOVERY_DeviceRegistry_Service_t service;   ///< Public description
+    ARSAL_Time_Monotonic_t expiry;                  ///< Expiry time, as given by ARSAL_Time_GetMonotonicNs()
+    ARDISCOVERY_Device_t *device;                   ///< Prebuilt device, only handed out by copy
+    UT_hash_handle hh;                              ///< Makes this structure hashable by name
+} ARDISCOVERY_DeviceRegistry_Entry_t;
+
+/**
+ * @brief Registry of resolved network devices
+ */
+typedef struct
+{
+    ARDISCOVERY_DeviceRegistry_Entry_t *entries;    ///< Entries hashed by service name
+    ARSAL_Mutex_t mutex;                            ///< Protects the entries
+    int ttlMs;                                      ///< Time to live of the resolved services
+} ARDISCOVERY_DeviceRegistry_t;
+
+/**
+ * @brief INTERNAL FUNCTION : Delete an entry and its prebuilt device
+ */
+static inline void ARDISCOVERY_DeviceRegistry_DeleteEntry (ARDISCOVERY_DeviceRegistry_Entry_t **entry)
+{
+    if ((entry != NULL) && (*entry != NULL))
+    {
+        ARDISCOVERY_Device_Delete (&((*entry)->device));
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARDISCOVERY, *entry);
+        *entry = NULL;
+    }
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Milliseconds left before an entry expires, 0 if it is expired
+ */
+static inline int32_t ARDISCOVERY_DeviceRegistry_RemainingTtl (const ARDISCOVERY_DeviceRegistry_Entry_t *entry, ARSAL_Time_Monotonic_t now)
+{
+    /* Round up so that an entry not yet expired never reports 0. */
+    return (entry->expiry > now) ? (int32_t)((entry->expiry - now + MSEC_TO_NSEC (1ULL) - 1) / MSEC_TO_NSEC (1ULL)) : 0;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Fill a socket address from a numeric IPv4 or IPv6 address
+ */
+static inline socklen_t ARDISCOVERY_DeviceRegistry_SocketAddress (const char *address, int port, struct sockaddr_storage *storage)
+{
+    struct sockaddr_in *addr4 = (struct sockaddr_in *)storage;
+    struct sockaddr_in6 *addr6 = (struct sockaddr_in6 *)storage;
+
+    memset (storage, 0, sizeof (*storage));
+
+    if (inet_pton (AF_INET, address, &addr4->sin_addr) == 1)
+    {
+        addr4->sin_family = AF_INET;
+        addr4->sin_port = htons ((uint16_t)port);
+        return sizeof (*addr4);
+    }
+
+    if (inet_pton (AF_INET6, address, &addr6->sin6_addr) == 1)
+    {
+        addr6->sin6_family = AF_INET6;
+        addr6->sin6_port = htons ((uint16_t)port);
+        return sizeof (*addr6);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Create a new registry
+ * @warning This function allocates memory
+ * @post ARDISCOVERY_DeviceRegistry_Delete() must be called to delete the registry and free the memory allocated.
+ * @param[in] ttlMs Time to live of the resolved services in milliseconds ; ARDISCOVERY_DEVICEREGISTRY_DEFAULT_TTL_MS if not strictly positive
+ * @param[out] error Executing error.
+ * @return The new registry, or NULL if an error occurred
+ * @see ARDISCOVERY_DeviceRegistry_Delete()
+ */
+static inline ARDISCOVERY_DeviceRegistry_t *ARDISCOVERY_DeviceRegistry_New (int ttlMs, eARDISCOVERY_ERROR *error)
+{
+    eARDISCOVERY_ERROR localError = ARDISCOVERY_OK;
+    ARDISCOVERY_DeviceRegistry_t *registry = (ARDISCOVERY_DeviceRegistry_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARDISCOVERY, 1, sizeof (ARDISCOVERY_DeviceRegistry_t));
+
+    if (registry == NULL)
+    {
+        localError = ARDISCOVERY_ERROR_ALLOC;
+    }
+    else
+    {
+        registry->entries = NULL;
+        registry->ttlMs = (ttlMs > 0) ? ttlMs : ARDISCOVERY_DEVICEREGISTRY_DEFAULT_TTL_MS;
+
+        if (ARSAL_Mutex_Init (&(registry->mutex)) != 0)
+        {
+            localError = ARDISCOVERY_ERROR_INIT;
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARDISCOVERY, registry);
+            registry = NULL;
+        }
+    }
+
+    if (error != NULL)
+    {
+        *error = localError;
+    }
+
+    return registry;
+}
+
+/**
+ * @brief Delete a registry and every device it holds
+ * @warning This function frees memory
+ * @param registry The registry to delete ; set to NULL
+ * @see ARDISCOVERY_DeviceRegistry_New()
+ */
+static inline void ARDISCOVERY_DeviceRegistry_Delete (ARDISCOVERY_DeviceRegistry_t **registry)
+{
+    ARDISCOVERY_DeviceRegistry_Entry_t *entry = NULL;
+    ARDISCOVERY_DeviceRegistry_Entry_t *tmp = NULL;
+
+    if ((registry != NULL) && (*registry != NULL))
+    {
+        HASH_ITER (hh, (*registry)->entries, entry, tmp)
+        {
+            HASH_DEL ((*registry)->entries, entry);
+            ARDISCOVERY_DeviceRegistry_DeleteEntry (&entry);
+        }
+
+        ARSAL_Mutex_Destroy (&((*registry)->mutex));
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARDISCOVERY, *registry);
+        *registry = NULL;
+    }
+}
+
+/**
+ * @brief Register a resolved network service, or refresh its time to live
+ * @note The prebuilt device is kept when the product, the address and the port did not change ;
+ * otherwise it is rebuilt and the reachability is reset.
+ * @param registry The registry
+ * @param product The product of the service ; must be a wifi product
+ * @param name The name of the service
+ * @param address The numeric IPv4 or IPv6 address of the service
+ * @param port The discovery port of the service
+ * @return ARDISCOVERY_OK if the service is registered, otherwise an error
+ */
+static inline eARDISCOVERY_ERROR ARDISCOVERY_DeviceRegistry_Add (ARDISCOVERY_DeviceRegistry_t *registry, eARDISCOVERY_PRODUCT product, const char *name, const char *address, int port)
+{
+    eARDISCOVERY_ERROR error = ARDISCOVERY_OK;
+    ARDISCOVERY_DeviceRegistry_Entry_t *entry = NULL;
+    ARDISCOVERY_Device_t *device = NULL;
+    struct sockaddr_storage storage;
+    size_t nameLength;
+
+    if ((registry == NULL) || (name == NULL) || (address == NULL) ||
+        (ARDISCOVERY_getProductService (product) != ARDISCOVERY_PRODUCT_NSNETSERVICE) ||
+        (port <= 0) || (port > 0xFFFF))
+    {
+        return ARDISCOVERY_ERROR_BAD_PARAMETER;
+    }
+
+    nameLength = strlen (name);
+    if ((nameLength == 0) || (nameLength >= ARDISCOVERY_DEVICEREGISTRY_NAME_SIZE) ||
+        (strlen (address) >= ARDISCOVERY_DEVICEREGISTRY_ADDRESS_SIZE) ||
+        (ARDISCOVERY_DeviceRegistry_SocketAddress (address, port, &storage) == 0))
+    {
+        return ARDISCOVERY_ERROR_BAD_PARAMETER;
+    }
+
+    ARSAL_Mutex_Lock (&(registry->mutex));
+
+    HASH_FIND (hh, registry->entries, name, nameLength, entry);
+
+    if ((entry == NULL) || (entry->service.product != product) || (entry->service.port != port) || (strcmp (entry->service.address, address) != 0))
+    {
+        /* Build the device once per resolution ; reconnections copy it. */
+        device = ARDISCOVERY_Device_New (&error);
+        if (error == ARDISCOVERY_OK)
+        {
+            error = ARDISCOVERY_Device_InitWifi (device, product, name, address, port);
+        }
+
+        if (error != ARDISCOVERY_OK)
+        {
+            ARDISCOVERY_Device_Delete (&device);
+        }
+        else if (entry == NULL)
+        {
+            entry = (ARDISCOVERY_DeviceRegistry_Entry_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARDISCOVERY, 1, sizeof (ARDISCOVERY_DeviceRegistry_Entry_t));
+            if (entry == NULL)
+            {
+                error = ARDISCOVERY_ERROR_ALLOC;
+                ARDISCOVERY_Device_Delete (&device);
+            }
+            else
+            {
+                memcpy (entry->service.name, name, nameLength + 1);
+                HASH_ADD_KEYPTR (hh, registry->entries, entry->service.name, nameLength, entry);
+            }
+        }
+        else
+        {
+            ARDISCOVERY_Device_Delete (&(entry->device));
+        }
+
+        if (error == ARDISCOVERY_OK)
+        {
+            entry->device = device;
+            entry->service.product = product;
+            strcpy (entry->service.address, address);
+            entry->service.port = port;
+            entry->service.reachability = ARDISCOVERY_DEVICEREGISTRY_REACHABILITY_UNKNOWN;
+            entry->service.roundTripMs = -1;
+        }
+    }
+
+    if (error == ARDISCOVERY_OK)
+    {
+        entry->expiry = ARSAL_Time_GetMonotonicNs () + MSEC_TO_NSEC ((uint64_t)registry->ttlMs);
+    }
+
+    ARSAL_Mutex_Unlock (&(registry->mutex));
+
+    return error;
+}
+
+/**
+ * @brief Remove a service from the registry
+ * @param registry The registry
+ * @param name The name of the service
+ * @return ARDISCOVERY_OK if the service was removed, ARDISCOVERY_ERROR if it was not registered
+ */
+static inline eARDISCOVERY_ERROR ARDISCOVERY_DeviceRegistry_Remove (ARDISCOVERY_DeviceRegistry_t *registry, const char *name)
+{
+    ARDISCOVERY_DeviceRegistry_Entry_t *entry = NULL;
+
+    if ((registry == NULL) || (name == NULL))
+    {
+        return ARDISCOVERY_ERROR_BAD_PARAMETER;
+    }
+
+    ARSAL_Mutex_Lock (&(registry->mutex));
+    HASH_FIND (hh, registry->entries, name, strlen (name), entry);
+    if (entry != NULL)
+    {
+        HASH_DEL (registry->entries, entry);
+    }
+    ARSAL_Mutex_Unlock (&(registry->mutex));
+
+    if (entry == NULL)
+    {
+        return ARDISCOVERY_ERROR;
+    }
+
+    ARDISCOVERY_DeviceRegistry_DeleteEntry (&entry);
+    return ARDISCOVERY_OK;
+}
+
+/**
+ * @brief Remove the expired services from the registry
+ * @param registry The registry
+ * @return The number of services removed
+ */
+static inline int ARDISCOVERY_DeviceRegistry_Expire (ARDISCOVERY_DeviceRegistry_t *registry)
+{
+    ARDISCOVERY_DeviceRegistry_Entry_t *entry = NULL;
+    ARDISCOVERY_DeviceRegistry_Entry_t *tmp = NULL;
+    ARDISCOVERY_DeviceRegistry_Entry_t *expired = NULL;
+    ARSAL_Time_Monotonic_t now;
+    int count = 0;
+
+    if (registry == NULL)
+    {
+        return 0;
+    }
+
+    now = ARSAL_Time_GetMonotonicNs ();
+
+    ARSAL_Mutex_Lock (&(registry->mutex));
+    HASH_ITER (hh, registry->entries, entry, tmp)
+    {
+        if (ARDISCOVERY_DeviceRegistry_RemainingTtl (entry, now) == 0)
+        {
+            HASH_DEL (registry->entries, entry);
+            /* Chain the expired entries through their hash handle to delete the devices unlocked. */
+            entry->hh.next = expired;
+            expired = entry;
+            count++;
+        }
+    }
+    ARSAL_Mutex_Unlock (&(registry->mutex));
+
+    while (expired != NULL)
+    {
+        entry = expired;
+        expired = (ARDISCOVERY_DeviceRegistry_Entry_t *)entry->hh.next;
+        ARDISCOVERY_DeviceRegistry_DeleteEntry (&entry);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Get the description of a registered service
+ * @param registry The registry
+ * @param name The name of the service
+ * @param[out] service The description of the service
+ * @return ARDISCOVERY_OK if the service is registered and not expired, ARDISCOVERY_ERROR_TIMEOUT if it expired, ARDISCOVERY_ERROR if it is not registered
+ */
+static inline eARDISCOVERY_ERROR ARDISCOVERY_DeviceRegistry_GetService (ARDISCOVERY_DeviceRegistry_t *registry, const char *name, ARDISCOVERY_DeviceRegistry_Service_t *service)
+{
+    eARDISCOVERY_ERROR error = ARDISCOVERY_ERROR;
+    ARDISCOVERY_DeviceRegistry_Entry_t *entry = NULL;
+    ARSAL_Time_Monotonic_t now;
+
+    if ((registry == NULL) || (name == NULL) || (service == NULL))
+    {
+        return ARDISCOVERY_ERROR_BAD_PARAMETER;
+    }
+
+    now = ARSAL_Time_GetMonotonicNs ();
+
+    ARSAL_Mutex_Lock (&(registry->mutex));
+    HASH_FIND (hh, registry->entries, name, strlen (name), entry);
+    if (entry != NULL)
+    {
+        *service = entry->service;
+        service->remainingTtlMs = ARDISCOVERY_DeviceRegistry_RemainingTtl (entry, now);
+        error = (service->remainingTtlMs > 0) ? ARDISCOVERY_OK : ARDISCOVERY_ERROR_TIMEOUT;
+    }
+    ARSAL_Mutex_Unlock (&(registry->mutex));
+
+    return error;
+}
+
+/**
+ * @brief Get the descriptions of the registered services which are not expired
+ * @param registry The registry
+ * @param[out] services Array receiving the descriptions
+ * @param capacity Number of elements of services
+ * @return The number of services not expired ; only the first capacity ones are copied
+ */
+static inline int ARDISCOVERY_DeviceRegistry_GetServices (ARDISCOVERY_DeviceRegistry_t *registry, ARDISCOVERY_DeviceRegistry_Service_t *services, int capacity)
+{
+    ARDISCOVERY_DeviceRegistry_Entry_t *entry = NULL;
+    ARDISCOVERY_DeviceRegistry_Entry_t *tmp = NULL;
+    ARSAL_Time_Monotonic_t now;
+    int32_t remaining;
+    int count = 0;
+
+    if (registry == NULL)
+    {
+        return 0;
+    }
+
+    now = ARSAL_Time_GetMonotonicNs ();
+
+    ARSAL_Mutex_Lock (&(registry->mutex));
+    HASH_ITER (hh, registry->entries, entry, tmp)
+    {
+        remaining = ARDISCOVERY_DeviceRegistry_RemainingTtl (entry, now);
+        if (remaining > 0)
+        {
+            if ((services != NULL) && (count < capacity))
+            {
+                services[count] = entry->service;
+                services[count].remainingTtlMs = remaining;
+            }
+            count++;
+        }
+    }
+    ARSAL_Mutex_Unlock (&(registry->mutex));
+
+    return count;
+}
+
+/**
+ * @brief Create a device for a registered service, without resolving it again
+ * @warning This function allocates memory
+ * @post ARDISCOVERY_Device_Delete() must be called to delete the device and free the memory allocated.
+ * @param registry The registry
+ * @param name The name of the service
+ * @param[out] error ARDISCOVERY_ERROR_TIMEOUT if the service expired, ARDISCOVERY_ERROR if it is not registered
+ * @return A copy of the prebuilt device made by ARDISCOVERY_Device_NewByCopy(), or NULL if an error occurred
+ */
+static inline ARDISCOVERY_Device_t *ARDISCOVERY_DeviceRegistry_NewDevice (ARDISCOVERY_DeviceRegistry_t *registry, const char *name, eARDISCOVERY_ERROR *error)
+{
+    eARDISCOVERY_ERROR localError = ARDISCOVERY_ERROR;
+    ARDISCOVERY_DeviceRegistry_Entry_t *entry = NULL;
+    ARDISCOVERY_Device_t *device = NULL;
+    ARSAL_Time_Monotonic_t now;
+
+    if ((registry == NULL) || (name == NULL))
+    {
+        localError = ARDISCOVERY_ERROR_BAD_PARAMETER;
+    }
+    else
+    {
+        now = ARSAL_Time_GetMonotonicNs ();
+
+        ARSAL_Mutex_Lock (&(registry->mutex));
+        HASH_FIND (hh, registry->entries, name, strlen (name), entry);
+        if (entry == NULL)
+        {
+            localError = ARDISCOVERY_ERROR;
+        }
+        else if (ARDISCOVERY_DeviceRegistry_RemainingTtl (entry, now) == 0)
+        {
+            localError = ARDISCOVERY_ERROR_TIMEOUT;
+        }
+        else
+        {
+            device = ARDISCOVERY_Device_NewByCopy (entry->device, &localError);
+        }
+        ARSAL_Mutex_Unlock (&(registry->mutex));
+    }
+
+    if (error != NULL)
+    {
+        *error = localError;
+    }
+
+    return device;
+}
+
+/**
+ * @brief INTERNAL TYPE : State of one reachability probe
+ */
+typedef struct
+{
+    char name[ARDISCOVERY_DEVICEREGISTRY_NAME_SIZE];
+    char address[ARDISCOVERY_DEVICEREGISTRY_ADDRESS_SIZE];
+    int port;
+    eARDISCOVERY_DEVICEREGISTRY_REACHABILITY reachability;
+    int32_t roundTripMs;
+    ARSAL_Time_Monotonic_t start;
+} ARDISCOVERY_DeviceRegistry_Probe_t;
+
+/**
+ * @brief INTERNAL FUNCTION : Start one non blocking probe
+ * @return The probe socket, or -1 if the probe is already complete
+ */
+static inline int ARDISCOVERY_DeviceRegistry_StartProbe (ARDISCOVERY_DeviceRegistry_Probe_t *probe)
+{
+    struct sockaddr_storage storage;
+    socklen_t length = ARDISCOVERY_DeviceRegistry_SocketAddress (probe->address, probe->port, &storage);
+    int sockfd = (length == 0) ? -1 : ARSAL_Socket_Create (storage.ss_family, SOCK_STREAM, 0);
+    int flags;
+
+    probe->reachability = ARDISCOVERY_DEVICEREGISTRY_REACHABILITY_UNREACHABLE;
+    probe->roundTripMs = -1;
+
+    if (sockfd < 0)
+    {
+        return -1;
+    }
+
+    flags = fcntl (sockfd, F_GETFL, 0);
+    if ((flags < 0) || (fcntl (sockfd, F_SETFL, flags | O_NONBLOCK) < 0))
+    {
+        ARSAL_Socket_Close (sockfd);
+        return -1;
+    }
+
+    probe->start = ARSAL_Time_GetMonotonicNs ();
+    if ((ARSAL_Socket_Connect (sockfd, (struct sockaddr *)&storage, length) != 0) && (errno != EINPROGRESS))
+    {
+        ARSAL_Socket_Close (sockfd);
+        return -1;
+    }
+
+    return sockfd;
+}
+
+/**
+ * @brief Probe the reachability of every registered service which is not expired
+ * @note All the probes run in parallel and the registry is not locked while they run ;
+ * the call returns after at most timeoutMs milliseconds.
+ * A TCP probe succeeds when the connection to the discovery port is established ;
+ * its round trip is measured from the connection start.
+ * @param registry The registry
+ * @param kind The kind of probe
+ * @param timeoutMs Probe timeout in milliseconds ; ARDISCOVERY_DEVICEREGISTRY_DEFAULT_PROBE_TIMEOUT_MS if not strictly positive
+ * @return The number of reachable services, or a negative eARDISCOVERY_ERROR
+ */
+static inline int ARDISCOVERY_DeviceRegistry_Probe (ARDISCOVERY_DeviceRegistry_t *registry, eARDISCOVERY_DEVICEREGISTRY_PROBE kind, int timeoutMs)
+{
+    ARDISCOVERY_DeviceRegistry_Entry_t *entry = NULL;
+    ARDISCOVERY_DeviceRegistry_Entry_t *tmp = NULL;
+    ARDISCOVERY_DeviceRegistry_Probe_t *probes = NULL;
+    struct pollfd *fds = NULL;
+    ARSAL_Time_Monotonic_t start;
+    ARSAL_Time_Monotonic_t now;
+    int count = 0;
+    int pending = 0;
+    int reachable = 0;
+    int elapsed;
+    int socketError;
+    socklen_t socketErrorLength;
+    int i;
+
+    if ((registry == NULL) || ((unsigned)kind >= ARDISCOVERY_DEVICEREGISTRY_PROBE_MAX))
+    {
+        return ARDISCOVERY_ERROR_BAD_PARAMETER;
+    }
+
+    if (timeoutMs <= 0)
+    {
+        timeoutMs = ARDISCOVERY_DEVICEREGISTRY_DEFAULT_PROBE_TIMEOUT_MS;
+    }
+
+    start = ARSAL_Time_GetMonotonicNs ();
+
+    /* Snapshot the targets, the probes run unlocked. */
+    ARSAL_Mutex_Lock (&(registry->mutex));
+    count = (int)HASH_COUNT (registry->entries);
+    if (count > 0)
+    {
+        probes = (ARDISCOVERY_DeviceRegistry_Probe_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARDISCOVERY, (size_t)count, sizeof (ARDISCOVERY_DeviceRegistry_Probe_t));
+        fds = (struct pollfd *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARDISCOVERY, (size_t)count, sizeof (struct pollfd));
+    }
+    if ((probes != NULL) && (fds != NULL))
+    {
+        count = 0;
+        HASH_ITER (hh, registry->entries, entry, tmp)
+        {
+            if (ARDISCOVERY_DeviceRegistry_RemainingTtl (entry, start) > 0)
+            {
+                strcpy (probes[count].name, entry->service.name);
+                strcpy (probes[count].address, entry->service.address);
+                probes[count].port = entry->service.port;
+                count++;
+            }
+        }
+    }
+    ARSAL_Mutex_Unlock (&(registry->mutex));
+
+    if ((count > 0) && ((probes == NULL) || (fds == NULL)))
+    {
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARDISCOVERY, probes);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARDISCOVERY, fds);
+        return ARDISCOVERY_ERROR_ALLOC;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        fds[i].fd = ARDISCOVERY_DeviceRegistry_StartProbe (&probes[i]);
+        fds[i].events = POLLOUT;
+        fds[i].revents = 0;
+        if (fds[i].fd >= 0)
+        {
+            pending++;
+        }
+    }
+
+    while (pending > 0)
+    {
+        elapsed = (int)NSEC_TO_MSEC (ARSAL_Time_GetMonotonicNs () - start);
+        if ((elapsed >= timeoutMs) || ((poll (fds, (nfds_t)count, timeoutMs - elapsed) < 0) && (errno != EINTR)))
+        {
+            break;
+        }
+
+        now = ARSAL_Time_GetMonotonicNs ();
+
+        for (i = 0; i < count; i++)
+        {
+            if ((fds[i].fd < 0) || (fds[i].revents == 0))
+            {
+                continue;
+            }
+
+            socketError = 0;
+            socketErrorLength = sizeof (socketError);
+            ARSAL_Socket_Getsockopt (fds[i].fd, SOL_SOCKET, SO_ERROR, &socketError, &socketErrorLength);
+
+            if ((socketError == 0) && ((fds[i].revents & (POLLERR | POLLHUP | POLLNVAL)) == 0))
+            {
+                probes[i].reachability = ARDISCOVERY_DEVICEREGISTRY_REACHABILITY_REACHABLE;
+                probes[i].roundTripMs = (int32_t)NSEC_TO_MSEC (now - probes[i].start);
+            }
+
+            ARSAL_Socket_Close (fds[i].fd);
+            fds[i].fd = -1;
+            pending--;
+        }
+    }
+
+    /* Close the probes still pending at the timeout. */
+    for (i = 0; i < count; i++)
+    {
+        if (fds[i].fd >= 0)
+        {
+            ARSAL_Socket_Close (fds[i].fd);
+            fds[i].fd = -1;
+        }
+
+        if (probes[i].reachability == ARDISCOVERY_DEVICEREGISTRY_REACHABILITY_REACHABLE)
+        {
+            reachable++;
+        }
+    }
+
+    /* Publish the results, skipping the services changed or removed meanwhile. */
+    ARSAL_Mutex_Lock (&(registry->mutex));
+    for (i = 0; i < count; i++)
+    {
+        HASH_FIND (hh, registry->entries, probes[i].name, strlen (probes[i].name), entry);
+        if ((entry != NULL) && (entry->service.port == probes[i].port) && (strcmp (entry->service.address, probes[i].address) == 0))
+        {
+            entry->service.reachability = probes[i].reachability;
+            entry->service.roundTripMs = probes[i].roundTripMs;
+        }
+    }
+    ARSAL_Mutex_Unlock (&(registry->mutex));
+
+    ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARDISCOVERY, probes);
+    ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARDISCOVERY, fds);
+
+    return reachable;
+}
+
+#endif // _ARDISCOVERY_DEVICE_REGISTRY_H_
@@ -0,0 +1,674 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+
+/**
+ * @file ARDISCOVERY_NetworkConfigurationProfile.h
+ * @brief Static network configuration profiles per product
+ * @note The profiles are static tables checked at build time with
+ * ARNETWORK_IOBUFFERPARAM_IS_VALID(). Each product family has one base table copied from the
+ * ARDISCOVERY_DEVICE_Wifi_Init*NetworkConfiguration() and ARDISCOVERY_DEVICE_Ble_Init*NetworkConfiguration()
+ * tables of the prebuilt library ; the ARStream buffers, which the prebuilt fills in at connection, hold the
+ * values of the ARStream readers and senders for the default fragment size and number. The default variant
+ * is the base table, the other variants are deltas applied on top of it : each tuning macro maps a product
+ * value to the value of the variant and can be overridden by defining it before including this file.
+ * @date 10/18/2026
+ */
+
+#ifndef _ARDISCOVERY_NETWORK_CONFIGURATION_PROFILE_H_
+#define _ARDISCOVERY_NETWORK_CONFIGURATION_PROFILE_H_
+
+#include <stddef.h>
+#include <libARNetwork/ARNETWORK_IOBufferParam.h>
+#include <libARNetworkAL/ARNETWORKAL_Manager.h>
+#include <libARDiscovery/ARDISCOVERY_Discovery.h>
+#include <libARDiscovery/ARDISCOVERY_NetworkConfiguration.h>
+
+/**
+ * @brief Variants of the network configuration profiles
+ */
+typedef enum
+{
+    ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_DEFAULT = 0, /**< Product default values */
+    ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_LOW_LATENCY, /**< Short send intervals and timeouts, stale piloting data is dropped */
+    ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_HIGH_THROUGHPUT, /**< Deep buffers for bursts of events and large video frames */
+    ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_CONSTRAINED_MEMORY, /**< Shallow buffers for memory constrained controllers */
+    ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_MAX, /**< Max of the enumeration */
+} eARDISCOVERY_NETWORKCONFIGURATION_VARIANT;
+
+/*****************************************
+ *
+ *             buffer identifiers :
+ *
+ *****************************************/
+
+#define ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_NONACK_ID              10 /**< Wifi controller to device non acknowledged commands (piloting) */
+#define ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ACK_ID                 11 /**< Wifi controller to device acknowledged commands */
+#define ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_EMERGENCY_ID           12 /**< Wifi controller to device emergency commands */
+#define ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_ACK_ID        13 /**< Wifi controller to device video stream acknowledges */
+#define ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_AUDIO_ACK_ID  14 /**< Wifi controller to device audio stream acknowledges */
+#define ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_AUDIO_DATA_ID 15 /**< Wifi controller to device audio stream data */
+#define ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_NAVDATA_ID             127 /**< Wifi device to controller non acknowledged commands */
+#define ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_EVENT_ID               126 /**< Wifi device to controller acknowledged commands */
+#define ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_DATA_ID       125 /**< Wifi device to controller video stream data */
+#define ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_AUDIO_DATA_ID 124 /**< Wifi device to controller audio stream data */
+#define ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_AUDIO_ACK_ID  123 /**< Wifi device to controller audio stream acknowledges */
+
+#define ARDISCOVERY_NETWORKCONFIGURATION_BLE_C2D_NONACK_ID          10 /**< BLE controller to device non acknowledged commands (piloting) */
+#define ARDISCOVERY_NETWORKCONFIGURATION_BLE_C2D_ACK_ID             11 /**< BLE controller to device acknowledged commands */
+#define ARDISCOVERY_NETWORKCONFIGURATION_BLE_C2D_EMERGENCY_ID       12 /**< BLE controller to device emergency commands */
+#define ARDISCOVERY_NETWORKCONFIGURATION_BLE_D2C_NAVDATA_ID         ((ARNETWORKAL_MANAGER_BLE_ID_MAX / 2) - 1) /**< BLE device to controller non acknowledged commands */
+#define ARDISCOVERY_NETWORKCONFIGURATION_BLE_D2C_EVENT_ID           ((ARNETWORKAL_MANAGER_BLE_ID_MAX / 2) - 2) /**< BLE device to controller acknowledged commands */
+
+/*****************************************
+ *
+ *             ARStream buffers :
+ *
+ *****************************************/
+
+#define ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_FRAGMENT_SIZE    1000 /**< Default ARStream fragment size, as ARCONTROLLER_Stream1 and ARCONTROLLER_StreamSender */
+#define ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_FRAGMENT_NUMBER  128 /**< Default maximum number of ARStream fragments per frame, as ARCONTROLLER_Stream1 */
+#define ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_DATA_HEADER_SIZE 5 /**< Size of the ARStream data header prepended to each fragment (see ARSTREAM_Reader_InitStreamDataBuffer()) */
+#define ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_ACK_CELLS        1000 /**< Number of cells of an ARStream acknowledge buffer (see ARSTREAM_Reader_InitStreamAckBuffer()) */
+#define ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_ACK_SIZE         18 /**< Size of an ARStream acknowledge packet */
+
+/*****************************************
+ *
+ *             tuning values :
+ *
+ *****************************************/
+
+/* Default variant ; the product values */
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_LOOP_INTERVAL_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_LOOP_INTERVAL_MS(base)       (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_NONACK_WAIT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_NONACK_WAIT_MS(base)         (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_NONACK_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_NONACK_CELLS(base)           (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_NONACK_OVERWRITING
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_NONACK_OVERWRITING(base)     (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_ACK_WAIT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_ACK_WAIT_MS(base)            (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_ACK_TIMEOUT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_ACK_TIMEOUT_MS(base)         (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_ACK_RETRY
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_ACK_RETRY(base)              (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_ACK_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_ACK_CELLS(base)              (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_EMERGENCY_WAIT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_EMERGENCY_WAIT_MS(base)      (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_EMERGENCY_TIMEOUT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_EMERGENCY_TIMEOUT_MS(base)   (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_NAVDATA_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_NAVDATA_CELLS(base)          (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_NAVDATA_OVERWRITING
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_NAVDATA_OVERWRITING(base)    (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_EVENT_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_EVENT_CELLS(base)            (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_STREAM_FRAGMENT_SIZE
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_STREAM_FRAGMENT_SIZE(base)   (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_STREAM_FRAGMENT_NUMBER
+#define ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_STREAM_FRAGMENT_NUMBER(base) (base)
+#endif
+
+/* Low latency variant */
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_LOOP_INTERVAL_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_LOOP_INTERVAL_MS(base)       ((base) / 2)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_NONACK_WAIT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_NONACK_WAIT_MS(base)         0
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_NONACK_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_NONACK_CELLS(base)           1
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_NONACK_OVERWRITING
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_NONACK_OVERWRITING(base)     1
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_ACK_WAIT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_ACK_WAIT_MS(base)            5
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_ACK_TIMEOUT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_ACK_TIMEOUT_MS(base)         150
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_ACK_RETRY
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_ACK_RETRY(base)              5
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_ACK_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_ACK_CELLS(base)              (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_EMERGENCY_WAIT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_EMERGENCY_WAIT_MS(base)      1
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_EMERGENCY_TIMEOUT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_EMERGENCY_TIMEOUT_MS(base)   50
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_NAVDATA_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_NAVDATA_CELLS(base)          (((base) < 4) ? (base) : 4)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_NAVDATA_OVERWRITING
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_NAVDATA_OVERWRITING(base)    1
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_EVENT_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_EVENT_CELLS(base)            (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_STREAM_FRAGMENT_SIZE
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_STREAM_FRAGMENT_SIZE(base)   (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_STREAM_FRAGMENT_NUMBER
+#define ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_STREAM_FRAGMENT_NUMBER(base) ((base) / 2)
+#endif
+
+/* High throughput variant */
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_LOOP_INTERVAL_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_LOOP_INTERVAL_MS(base)       (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_NONACK_WAIT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_NONACK_WAIT_MS(base)         (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_NONACK_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_NONACK_CELLS(base)           (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_NONACK_OVERWRITING
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_NONACK_OVERWRITING(base)     (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_ACK_WAIT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_ACK_WAIT_MS(base)            1
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_ACK_TIMEOUT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_ACK_TIMEOUT_MS(base)         (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_ACK_RETRY
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_ACK_RETRY(base)              (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_ACK_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_ACK_CELLS(base)              64
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_EMERGENCY_WAIT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_EMERGENCY_WAIT_MS(base)      (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_EMERGENCY_TIMEOUT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_EMERGENCY_TIMEOUT_MS(base)   (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_NAVDATA_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_NAVDATA_CELLS(base)          64
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_NAVDATA_OVERWRITING
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_NAVDATA_OVERWRITING(base)    (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_EVENT_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_EVENT_CELLS(base)            256
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_STREAM_FRAGMENT_SIZE
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_STREAM_FRAGMENT_SIZE(base)   1400
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_STREAM_FRAGMENT_NUMBER
+#define ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_STREAM_FRAGMENT_NUMBER(base) 256
+#endif
+
+/* Constrained memory variant */
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_LOOP_INTERVAL_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_LOOP_INTERVAL_MS(base)       (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_NONACK_WAIT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_NONACK_WAIT_MS(base)         (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_NONACK_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_NONACK_CELLS(base)           1
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_NONACK_OVERWRITING
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_NONACK_OVERWRITING(base)     1
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_ACK_WAIT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_ACK_WAIT_MS(base)            (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_ACK_TIMEOUT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_ACK_TIMEOUT_MS(base)         (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_ACK_RETRY
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_ACK_RETRY(base)              (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_ACK_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_ACK_CELLS(base)              (((base) < 8) ? (base) : 8)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_EMERGENCY_WAIT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_EMERGENCY_WAIT_MS(base)      (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_EMERGENCY_TIMEOUT_MS
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_EMERGENCY_TIMEOUT_MS(base)   (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_NAVDATA_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_NAVDATA_CELLS(base)          (((base) < 8) ? (base) : 8)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_NAVDATA_OVERWRITING
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_NAVDATA_OVERWRITING(base)    1
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_EVENT_CELLS
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_EVENT_CELLS(base)            (((base) < 10) ? (base) : 10)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_STREAM_FRAGMENT_SIZE
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_STREAM_FRAGMENT_SIZE(base)   (base)
+#endif
+#ifndef ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_STREAM_FRAGMENT_NUMBER
+#define ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_STREAM_FRAGMENT_NUMBER(base) ((base) / 2)
+#endif
+
+/*****************************************
+ *
+ *             buffer layouts :
+ *
+ *****************************************/
+
+/**
+ * @brief Size in bytes of the commands copied in the wifi command buffers
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_WIFI_DATA_SIZE 128
+
+/**
+ * @brief ARStream acknowledge buffer ; X is called with the fields of an ARNETWORK_IOBufferParam_t
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_ACK(X, ID)                                                                         \
+    X((ID), ARNETWORKAL_FRAME_TYPE_DATA_LOW_LATENCY, 0, ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER,                                    \
+      ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_ACK_CELLS,                                 \
+      ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_ACK_SIZE, 1)
+
+/**
+ * @brief ARStream data buffer ; X is called with the fields of an ARNETWORK_IOBufferParam_t, V is the variant prefix
+ * @note A cell holds one fragment and its ARStream data header, as ARSTREAM_Reader_InitStreamDataBuffer() sizes it.
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_DATA(X, ID, V)                                                                     \
+    X((ID), ARNETWORKAL_FRAME_TYPE_DATA_LOW_LATENCY, 0, ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER,                                    \
+      ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, V##_STREAM_FRAGMENT_NUMBER(ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_FRAGMENT_NUMBER), \
+      V##_STREAM_FRAGMENT_SIZE(ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_FRAGMENT_SIZE) + ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_DATA_HEADER_SIZE, 1)
+
+/**
+ * @brief Bebop, SkyController, Bebop 2 and Evinrude controller to device buffers ; X is called with the fields of an ARNETWORK_IOBufferParam_t, V is the variant prefix
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_BEBOP_C2D(X, V)                                                                             \
+    X(ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_NONACK_ID, ARNETWORKAL_FRAME_TYPE_DATA, V##_NONACK_WAIT_MS(20),                     \
+      ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, V##_NONACK_CELLS(2),                        \
+      ARDISCOVERY_NETWORKCONFIGURATION_WIFI_DATA_SIZE, V##_NONACK_OVERWRITING(1))                                                    \
+    X(ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ACK_ID, ARNETWORKAL_FRAME_TYPE_DATA_WITH_ACK, V##_ACK_WAIT_MS(20),                  \
+      V##_ACK_TIMEOUT_MS(500), V##_ACK_RETRY(3), V##_ACK_CELLS(20), ARDISCOVERY_NETWORKCONFIGURATION_WIFI_DATA_SIZE, 0)              \
+    X(ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_EMERGENCY_ID, ARNETWORKAL_FRAME_TYPE_DATA_WITH_ACK, V##_EMERGENCY_WAIT_MS(10),      \
+      V##_EMERGENCY_TIMEOUT_MS(100), ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, 1, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_DATA_SIZE, 0) \
+    ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_ACK(X, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_ACK_ID)
+
+/**
+ * @brief Bebop, SkyController, Bebop 2 and Evinrude device to controller buffers ; X is called with the fields of an ARNETWORK_IOBufferParam_t, V is the variant prefix
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_BEBOP_D2C(X, V)                                                                             \
+    X(ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_NAVDATA_ID, ARNETWORKAL_FRAME_TYPE_DATA, 20,                                        \
+      ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, V##_NAVDATA_CELLS(20),                      \
+      ARDISCOVERY_NETWORKCONFIGURATION_WIFI_DATA_SIZE, V##_NAVDATA_OVERWRITING(0))                                                   \
+    X(ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_EVENT_ID, ARNETWORKAL_FRAME_TYPE_DATA_WITH_ACK, 20,                                 \
+      V##_ACK_TIMEOUT_MS(500), V##_ACK_RETRY(3), V##_EVENT_CELLS(20), ARDISCOVERY_NETWORKCONFIGURATION_WIFI_DATA_SIZE, 0)            \
+    ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_DATA(X, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_DATA_ID, V)
+
+/**
+ * @brief Bebop, SkyController, Bebop 2 and Evinrude network configuration ; the device to controller acknowledged id is the navdata one, as in the prebuilt
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_BEBOP_IDS(V)                                                                                \
+    V##_LOOP_INTERVAL_MS(25),                                                                                                       \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_NONACK_ID, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ACK_ID,                          \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_EMERGENCY_ID, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_ACK_ID, -1, -1,      \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_NAVDATA_ID, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_NAVDATA_ID,                     \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_DATA_ID, -1, -1
+#define ARDISCOVERY_NETWORKCONFIGURATION_BEBOP_PING_DELAY_MS 0
+#define ARDISCOVERY_NETWORKCONFIGURATION_BEBOP_COMMANDS commandsBufferIdsWifi
+
+/**
+ * @brief Jumping Sumo controller to device buffers ; X is called with the fields of an ARNETWORK_IOBufferParam_t, V is the variant prefix
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_C2D(X, V)                                                                       \
+    X(ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_NONACK_ID, ARNETWORKAL_FRAME_TYPE_DATA, V##_NONACK_WAIT_MS(5),                      \
+      ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, V##_NONACK_CELLS(10),                       \
+      ARDISCOVERY_NETWORKCONFIGURATION_WIFI_DATA_SIZE, V##_NONACK_OVERWRITING(0))                                                    \
+    X(ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ACK_ID, ARNETWORKAL_FRAME_TYPE_DATA_WITH_ACK, V##_ACK_WAIT_MS(20),                  \
+      V##_ACK_TIMEOUT_MS(500), V##_ACK_RETRY(3), V##_ACK_CELLS(20), ARDISCOVERY_NETWORKCONFIGURATION_WIFI_DATA_SIZE, 0)              \
+    ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_ACK(X, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_ACK_ID)
+
+/**
+ * @brief Jumping Sumo device to controller buffers ; X is called with the fields of an ARNETWORK_IOBufferParam_t, V is the variant prefix
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_D2C(X, V)                                                                       \
+    X(ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_NAVDATA_ID, ARNETWORKAL_FRAME_TYPE_DATA, 20,                                        \
+      ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, V##_NAVDATA_CELLS(10),                      \
+      ARDISCOVERY_NETWORKCONFIGURATION_WIFI_DATA_SIZE, V##_NAVDATA_OVERWRITING(0))                                                   \
+    X(ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_EVENT_ID, ARNETWORKAL_FRAME_TYPE_DATA_WITH_ACK, 20,                                 \
+      V##_ACK_TIMEOUT_MS(500), V##_ACK_RETRY(3), V##_EVENT_CELLS(20), ARDISCOVERY_NETWORKCONFIGURATION_WIFI_DATA_SIZE, 0)            \
+    ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_DATA(X, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_DATA_ID, V)
+
+/**
+ * @brief Jumping Sumo network configuration
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_IDS(V)                                                                          \
+    V##_LOOP_INTERVAL_MS(50),                                                                                                       \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_NONACK_ID, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ACK_ID, -1,                      \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_ACK_ID, -1, -1,                                                              \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_NAVDATA_ID, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_NAVDATA_ID,                     \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_DATA_ID, -1, -1
+#define ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_PING_DELAY_MS 0
+#define ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_COMMANDS commandsBufferIdsWifi
+
+/**
+ * @brief Jumping Sumo EVO controller to device buffers ; the Jumping Sumo ones and the audio stream buffers
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_EVO_C2D(X, V)                                                                   \
+    ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_C2D(X, V)                                                                          \
+    ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_ACK(X, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_AUDIO_ACK_ID)               \
+    ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_DATA(X, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_AUDIO_DATA_ID, V)
+
+/**
+ * @brief Jumping Sumo EVO device to controller buffers ; the Jumping Sumo ones and the audio stream buffers
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_EVO_D2C(X, V)                                                                   \
+    ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_D2C(X, V)                                                                          \
+    ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_DATA(X, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_AUDIO_DATA_ID, V)          \
+    ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_ACK(X, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_AUDIO_ACK_ID)
+
+/**
+ * @brief Jumping Sumo EVO network configuration
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_EVO_IDS(V)                                                                      \
+    V##_LOOP_INTERVAL_MS(50),                                                                                                       \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_NONACK_ID, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ACK_ID, -1,                      \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_ACK_ID, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_AUDIO_ACK_ID,     \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_AUDIO_DATA_ID,                                                               \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_NAVDATA_ID, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_NAVDATA_ID,                     \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_DATA_ID, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_AUDIO_DATA_ID,   \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_AUDIO_ACK_ID
+#define ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_EVO_PING_DELAY_MS 0
+#define ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_EVO_COMMANDS commandsBufferIdsWifi
+
+/**
+ * @brief Unknown product 1 controller to device buffers ; the Jumping Sumo ones and the audio stream acknowledges
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_UNKNOWNPRODUCT_1_C2D(X, V)                                                                  \
+    ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_C2D(X, V)                                                                          \
+    ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_ACK(X, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_AUDIO_ACK_ID)
+
+/**
+ * @brief Unknown product 1 device to controller buffers ; the Jumping Sumo ones and the audio stream data
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_UNKNOWNPRODUCT_1_D2C(X, V)                                                                  \
+    ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_D2C(X, V)                                                                          \
+    ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_DATA(X, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_AUDIO_DATA_ID, V)
+
+/**
+ * @brief Unknown product 1 network configuration
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_UNKNOWNPRODUCT_1_IDS(V)                                                                     \
+    V##_LOOP_INTERVAL_MS(50),                                                                                                       \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_NONACK_ID, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ACK_ID, -1,                      \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_ACK_ID, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_C2D_ARSTREAM_AUDIO_ACK_ID, -1, \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_NAVDATA_ID, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_NAVDATA_ID,                     \
+    ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_DATA_ID, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_ARSTREAM_AUDIO_DATA_ID, -1
+#define ARDISCOVERY_NETWORKCONFIGURATION_UNKNOWNPRODUCT_1_PING_DELAY_MS 0
+#define ARDISCOVERY_NETWORKCONFIGURATION_UNKNOWNPRODUCT_1_COMMANDS commandsBufferIdsWifi
+
+/**
+ * @brief MiniDrone controller to device buffers ; X is called with the fields of an ARNETWORK_IOBufferParam_t, V is the variant prefix
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_MINIDRONE_C2D(X, V)                                                                         \
+    X(ARDISCOVERY_NETWORKCONFIGURATION_BLE_C2D_NONACK_ID, ARNETWORKAL_FRAME_TYPE_DATA, V##_NONACK_WAIT_MS(20),                      \
+      ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, V##_NONACK_CELLS(1),                        \
+      ARNETWORK_IOBUFFERPARAM_DATACOPYMAXSIZE_USE_MAX, V##_NONACK_OVERWRITING(1))                                                    \
+    X(ARDISCOVERY_NETWORKCONFIGURATION_BLE_C2D_ACK_ID, ARNETWORKAL_FRAME_TYPE_DATA_WITH_ACK, V##_ACK_WAIT_MS(20),                   \
+      V##_ACK_TIMEOUT_MS(500), V##_ACK_RETRY(3), V##_ACK_CELLS(20), ARNETWORK_IOBUFFERPARAM_DATACOPYMAXSIZE_USE_MAX, 0)              \
+    X(ARDISCOVERY_NETWORKCONFIGURATION_BLE_C2D_EMERGENCY_ID, ARNETWORKAL_FRAME_TYPE_DATA_WITH_ACK, V##_EMERGENCY_WAIT_MS(1),        \
+      V##_EMERGENCY_TIMEOUT_MS(100), ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, 1, ARNETWORK_IOBUFFERPARAM_DATACOPYMAXSIZE_USE_MAX, 0)
+
+/**
+ * @brief MiniDrone device to controller buffers ; X is called with the fields of an ARNETWORK_IOBufferParam_t, V is the variant prefix
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_MINIDRONE_D2C(X, V)                                                                         \
+    X(ARDISCOVERY_NETWORKCONFIGURATION_BLE_D2C_NAVDATA_ID, ARNETWORKAL_FRAME_TYPE_DATA, 20,                                         \
+      ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER, V##_NAVDATA_CELLS(20),                      \
+      ARNETWORK_IOBUFFERPARAM_DATACOPYMAXSIZE_USE_MAX, V##_NAVDATA_OVERWRITING(0))                                                   \
+    X(ARDISCOVERY_NETWORKCONFIGURATION_BLE_D2C_EVENT_ID, ARNETWORKAL_FRAME_TYPE_DATA_WITH_ACK, 20,                                  \
+      V##_ACK_TIMEOUT_MS(500), V##_ACK_RETRY(3), V##_EVENT_CELLS(20), ARNETWORK_IOBUFFERPARAM_DATACOPYMAXSIZE_USE_MAX, 0)
+
+/**
+ * @brief MiniDrone network configuration ; the device to controller acknowledged id is the navdata one, as in the prebuilt
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_MINIDRONE_IDS(V)                                                                            \
+    V##_LOOP_INTERVAL_MS(50),                                                                                                       \
+    ARDISCOVERY_NETWORKCONFIGURATION_BLE_C2D_NONACK_ID, ARDISCOVERY_NETWORKCONFIGURATION_BLE_C2D_ACK_ID,                            \
+    ARDISCOVERY_NETWORKCONFIGURATION_BLE_C2D_EMERGENCY_ID, -1, -1, -1,                                                              \
+    ARDISCOVERY_NETWORKCONFIGURATION_BLE_D2C_NAVDATA_ID, ARDISCOVERY_NETWORKCONFIGURATION_BLE_D2C_NAVDATA_ID, -1, -1, -1
+#define ARDISCOVERY_NETWORKCONFIGURATION_MINIDRONE_PING_DELAY_MS -1
+#define ARDISCOVERY_NETWORKCONFIGURATION_MINIDRONE_COMMANDS commandsBufferIdsBle
+
+/**
+ * @brief INTERNAL MACRO : Initializer of an ARNETWORK_IOBufferParam_t
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_PARAM(ID, dataType, sendingWaitTimeMs, ackTimeoutMs, numberOfRetry, numberOfCell, dataCopyMaxSize, isOverwriting) \
+    { (ID), (dataType), (sendingWaitTimeMs), (ackTimeoutMs), (numberOfRetry), (numberOfCell), (dataCopyMaxSize), (isOverwriting) },
+
+/**
+ * @brief INTERNAL MACRO : Check term of an ARNETWORK_IOBufferParam_t
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_CHECK(ID, dataType, sendingWaitTimeMs, ackTimeoutMs, numberOfRetry, numberOfCell, dataCopyMaxSize, isOverwriting) \
+    && ARNETWORK_IOBUFFERPARAM_IS_VALID((ID), (dataType), (sendingWaitTimeMs), (ackTimeoutMs), (numberOfRetry), (numberOfCell), (dataCopyMaxSize), (isOverwriting))
+
+/**
+ * @brief INTERNAL MACRO : Build time assertion that all the buffers of a product family are valid in a variant
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_STATIC_CHECK(name, FAMILY, V) \
+    typedef char ARDISCOVERY_NetworkConfigurationProfile_##name##_IsValid[(1 FAMILY##_C2D(ARDISCOVERY_NETWORKCONFIGURATION_CHECK, V) FAMILY##_D2C(ARDISCOVERY_NETWORKCONFIGURATION_CHECK, V)) ? 1 : -1]
+
+/**
+ * @brief INTERNAL MACRO : Build time assertion that all the buffers of a product family are valid in all the variants
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_STATIC_CHECK_VARIANTS(name, FAMILY)                                                         \
+    ARDISCOVERY_NETWORKCONFIGURATION_STATIC_CHECK(name##Default, FAMILY, ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT);                 \
+    ARDISCOVERY_NETWORKCONFIGURATION_STATIC_CHECK(name##LowLatency, FAMILY, ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY);          \
+    ARDISCOVERY_NETWORKCONFIGURATION_STATIC_CHECK(name##HighThroughput, FAMILY, ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT);  \
+    ARDISCOVERY_NETWORKCONFIGURATION_STATIC_CHECK(name##ConstrainedMemory, FAMILY, ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY)
+
+ARDISCOVERY_NETWORKCONFIGURATION_STATIC_CHECK_VARIANTS(Bebop, ARDISCOVERY_NETWORKCONFIGURATION_BEBOP);
+ARDISCOVERY_NETWORKCONFIGURATION_STATIC_CHECK_VARIANTS(JumpingSumo, ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO);
+ARDISCOVERY_NETWORKCONFIGURATION_STATIC_CHECK_VARIANTS(JumpingSumoEvo, ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_EVO);
+ARDISCOVERY_NETWORKCONFIGURATION_STATIC_CHECK_VARIANTS(UnknownProduct1, ARDISCOVERY_NETWORKCONFIGURATION_UNKNOWNPRODUCT_1);
+ARDISCOVERY_NETWORKCONFIGURATION_STATIC_CHECK_VARIANTS(MiniDrone, ARDISCOVERY_NETWORKCONFIGURATION_MINIDRONE);
+
+/**
+ * @brief INTERNAL MACRO : Static storage of the profile of a product family in a variant
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_PROFILE(name, FAMILY, V)                                                                   \
+    static const ARNETWORK_IOBufferParam_t name##C2D[] = { FAMILY##_C2D(ARDISCOVERY_NETWORKCONFIGURATION_PARAM, V) };              \
+    static const ARNETWORK_IOBufferParam_t name##D2C[] = { FAMILY##_D2C(ARDISCOVERY_NETWORKCONFIGURATION_PARAM, V) };              \
+    static const ARDISCOVERY_NetworkConfiguration_t name =                                                                          \
+    {                                                                                                                               \
+        FAMILY##_IDS(V),                                                                                                            \
+        sizeof (name##C2D) / sizeof (name##C2D[0]), (ARNETWORK_IOBufferParam_t *)name##C2D,                                         \
+        sizeof (name##D2C) / sizeof (name##D2C[0]), (ARNETWORK_IOBufferParam_t *)name##D2C,                                         \
+        FAMILY##_PING_DELAY_MS,                                                                                                     \
+        sizeof (FAMILY##_COMMANDS) / sizeof (FAMILY##_COMMANDS[0]), (int *)FAMILY##_COMMANDS,                                       \
+    }
+
+/**
+ * @brief INTERNAL MACRO : Static storage of the profiles of a product family, indexed by variant
+ */
+#define ARDISCOVERY_NETWORKCONFIGURATION_PROFILES(name, FAMILY)                                                                     \
+    ARDISCOVERY_NETWORKCONFIGURATION_PROFILE(name##Default, FAMILY, ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT);                     \
+    ARDISCOVERY_NETWORKCONFIGURATION_PROFILE(name##LowLatency, FAMILY, ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY);              \
+    ARDISCOVERY_NETWORKCONFIGURATION_PROFILE(name##HighThroughput, FAMILY, ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT);      \
+    ARDISCOVERY_NETWORKCONFIGURATION_PROFILE(name##ConstrainedMemory, FAMILY, ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY); \
+    static const ARDISCOVERY_NetworkConfiguration_t *const name[ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_MAX] =                     \
+    {                                                                                                                               \
+        &name##Default, &name##LowLatency, &name##HighThroughput, &name##ConstrainedMemory,                                         \
+    }
+
+/**
+ * @brief Get the static network configuration profile of a product.
+ * @note The profile is shared by all the callers : it and its buffer parameters are in read-only storage, so a write through
+ * the nested pointers faults instead of changing every later connection ; copy them to change them.
+ * It can be given to ARNETWORK_Manager_New(), which only reads the parameters, by casting away the const.
+ * Unlike ARDISCOVERY_Device_InitNetworkConfiguration(), it does not need a discovery device, and switching variant needs no reallocation.
+ * The default variant holds the buffers of ARDISCOVERY_Device_InitNetworkConfiguration() for the product once its ARStream
+ * buffers are set up with the default fragment size and number.
+ * @param[in] product The product.
+ * @param[in] variant The variant of the profile.
+ * @return The profile, or NULL if the product has no profile (usb products).
+ */
+static inline const ARDISCOVERY_NetworkConfiguration_t *ARDISCOVERY_NetworkConfigurationProfile_Get (eARDISCOVERY_PRODUCT product, eARDISCOVERY_NETWORKCONFIGURATION_VARIANT variant)
+{
+    static const int commandsBufferIdsWifi[] = { ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_NAVDATA_ID, ARDISCOVERY_NETWORKCONFIGURATION_WIFI_D2C_EVENT_ID };
+    static const int commandsBufferIdsBle[] = { ARDISCOVERY_NETWORKCONFIGURATION_BLE_D2C_NAVDATA_ID, ARDISCOVERY_NETWORKCONFIGURATION_BLE_D2C_EVENT_ID };
+
+    ARDISCOVERY_NETWORKCONFIGURATION_PROFILES(bebopProfiles, ARDISCOVERY_NETWORKCONFIGURATION_BEBOP);
+    ARDISCOVERY_NETWORKCONFIGURATION_PROFILES(jumpingSumoProfiles, ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO);
+    ARDISCOVERY_NETWORKCONFIGURATION_PROFILES(jumpingSumoEvoProfiles, ARDISCOVERY_NETWORKCONFIGURATION_JUMPINGSUMO_EVO);
+    ARDISCOVERY_NETWORKCONFIGURATION_PROFILES(unknownProduct1Profiles, ARDISCOVERY_NETWORKCONFIGURATION_UNKNOWNPRODUCT_1);
+    ARDISCOVERY_NETWORKCONFIGURATION_PROFILES(miniDroneProfiles, ARDISCOVERY_NETWORKCONFIGURATION_MINIDRONE);
+
+    const ARDISCOVERY_NetworkConfiguration_t *const *profiles = NULL;
+
+    if ((unsigned)variant >= ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_MAX)
+    {
+        return NULL;
+    }
+
+    switch (product)
+    {
+    case ARDISCOVERY_PRODUCT_ARDRONE:
+    case ARDISCOVERY_PRODUCT_SKYCONTROLLER:
+    case ARDISCOVERY_PRODUCT_BEBOP_2:
+    case ARDISCOVERY_PRODUCT_EVINRUDE:
+        profiles = bebopProfiles;
+        break;
+    case ARDISCOVERY_PRODUCT_JS:
+        profiles = jumpingSumoProfiles;
+        break;
+    case ARDISCOVERY_PRODUCT_JS_EVO_LIGHT:
+    case ARDISCOVERY_PRODUCT_JS_EVO_RACE:
+        profiles = jumpingSumoEvoProfiles;
+        break;
+    case ARDISCOVERY_PRODUCT_UNKNOWN_PRODUCT_1:
+        profiles = unknownProduct1Profiles;
+        break;
+    case ARDISCOVERY_PRODUCT_MINIDRONE:
+    case ARDISCOVERY_PRODUCT_MINIDRONE_EVO_LIGHT:
+    case ARDISCOVERY_PRODUCT_MINIDRONE_EVO_BRICK:
+    case ARDISCOVERY_PRODUCT_MINIDRONE_EVO_HYDROFOIL:
+        profiles = miniDroneProfiles;
+        break;
+    default:
+        break;
+    }
+
+    return (profiles != NULL) ? profiles[variant] : NULL;
+}
+
+/**
+ * @brief Get the ARStream fragment size of a variant
+ * @note To send as ARDISCOVERY_CONNECTION_JSON_ARSTREAM_FRAGMENT_SIZE_KEY so the device matches the profile buffers.
+ * @param[in] variant The variant of the profile.
+ * @return The fragment size, or -1 if the variant is unknown.
+ */
+static inline int ARDISCOVERY_NetworkConfigurationProfile_GetStreamFragmentSize (eARDISCOVERY_NETWORKCONFIGURATION_VARIANT variant)
+{
+    switch (variant)
+    {
+    case ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_DEFAULT: return ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_STREAM_FRAGMENT_SIZE (ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_FRAGMENT_SIZE);
+    case ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_LOW_LATENCY: return ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_STREAM_FRAGMENT_SIZE (ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_FRAGMENT_SIZE);
+    case ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_HIGH_THROUGHPUT: return ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_STREAM_FRAGMENT_SIZE (ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_FRAGMENT_SIZE);
+    case ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_CONSTRAINED_MEMORY: return ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_STREAM_FRAGMENT_SIZE (ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_FRAGMENT_SIZE);
+    default: return -1;
+    }
+}
+
+/**
+ * @brief Get the maximum number of ARStream fragments per frame of a variant
+ * @note To send as ARDISCOVERY_CONNECTION_JSON_ARSTREAM_FRAGMENT_MAXIMUM_NUMBER_KEY so the device matches the profile buffers.
+ * @param[in] variant The variant of the profile.
+ * @return The maximum number of fragments, or -1 if the variant is unknown.
+ */
+static inline int ARDISCOVERY_NetworkConfigurationProfile_GetStreamFragmentNumber (eARDISCOVERY_NETWORKCONFIGURATION_VARIANT variant)
+{
+    switch (variant)
+    {
+    case ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_DEFAULT: return ARDISCOVERY_NETWORKCONFIGURATION_DEFAULT_STREAM_FRAGMENT_NUMBER (ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_FRAGMENT_NUMBER);
+    case ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_LOW_LATENCY: return ARDISCOVERY_NETWORKCONFIGURATION_LOW_LATENCY_STREAM_FRAGMENT_NUMBER (ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_FRAGMENT_NUMBER);
+    case ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_HIGH_THROUGHPUT: return ARDISCOVERY_NETWORKCONFIGURATION_HIGH_THROUGHPUT_STREAM_FRAGMENT_NUMBER (ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_FRAGMENT_NUMBER);
+    case ARDISCOVERY_NETWORKCONFIGURATION_VARIANT_CONSTRAINED_MEMORY: return ARDISCOVERY_NETWORKCONFIGURATION_CONSTRAINED_MEMORY_STREAM_FRAGMENT_NUMBER (ARDISCOVERY_NETWORKCONFIGURATION_ARSTREAM_FRAGMENT_NUMBER);
+    default: return -1;
+    }
+}
+
+/**
+ * @brief Check all the buffers of a network configuration with ARNETWORK_IOBufferParam_Check()
+ * @param[in] networkConfiguration The network configuration.
+ * @return 1 if all the buffers are usable else 0
+ */
+static inline int ARDISCOVERY_NetworkConfigurationProfile_Check (const ARDISCOVERY_NetworkConfiguration_t *networkConfiguration)
+{
+    int i;
+
+    if (networkConfiguration == NULL)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < networkConfiguration->numberOfControllerToDeviceParam; i++)
+    {
+        if (!ARNETWORK_IOBufferParam_Check (&networkConfiguration->controllerToDeviceParams[i]))
+        {
+            return 0;
+        }
+    }
+
+    for (i = 0; i < networkConfiguration->numberOfDeviceToControllerParam; i++)
+    {
+        if (!ARNETWORK_IOBufferParam_Check (&networkConfiguration->deviceToControllerParams[i]))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+#endif // _ARDISCOVERY_NETWORK_CONFIGURATION_PROFILE_H_
@@ -32,9 +32,12 @@
 #define _ARDISCOVERY_H_
 
 #include <libARDiscovery/ARDISCOVERY_Connection.h>
+#include <libARDiscovery/ARDISCOVERY_ConnectionJson.h>
 #include <libARDiscovery/ARDISCOVERY_Discovery.h>
+#include <libARDiscovery/ARDISCOVERY_ProductLookup.h>
 #include <libARDiscovery/ARDISCOVERY_NetworkConfiguration.h>
 #include <libARDiscovery/ARDISCOVERY_Device.h>
+#include <libARDiscovery/ARDISCOVERY_DeviceRegistry.h>
 #include <libARDiscovery/ARDISCOVERY_Error.h>
 
 #endif /* _ARDISCOVERY_H_ */
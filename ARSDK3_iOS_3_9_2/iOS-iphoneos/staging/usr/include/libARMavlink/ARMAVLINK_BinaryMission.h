@@ -0,0 +1,424 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARMAVLINK_BinaryMission.h
+ * @brief Binary mission files
+ * @note A binary mission file is a header followed by the packed array of the mission items, in
+ * the memory layout of mavlink_mission_item_t and in native (little endian) byte order. Opening
+ * such a file maps it and checks it, then the mission items are used in place : nothing is
+ * formatted nor parsed. QGC WPL text files remain the interchange format.
+ * @date 10/18/2026
+ */
+#ifndef _ARMAVLINK_BINARY_MISSION_H
+#define _ARMAVLINK_BINARY_MISSION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <libARSAL/ARSAL_Allocator.h>
+#include <libARMavlink/ARMAVLINK_Error.h>
+#include <libARMavlink/ARMAVLINK_MissionItemBuffer.h>
+#include <mavlink/parrot/mavlink.h>
+
+/**
+ * @brief Magic of the binary mission files
+ */
+#define ARMAVLINK_BINARYMISSION_MAGIC "ARMB"
+
+/**
+ * @brief Version of the binary mission format written by this module
+ */
+#define ARMAVLINK_BINARYMISSION_VERSION 1
+
+/**
+ * @brief Number of mission items converted at once when writing a file
+ */
+#define ARMAVLINK_BINARYMISSION_CHUNK_SIZE 128
+
+/**
+ * @brief Number of bytes of the checksum computation at once ; the mavlink crc functions take a 16 bits length
+ */
+#define ARMAVLINK_BINARYMISSION_CRC_CHUNK_SIZE 0x8000
+
+/**
+ * @brief Suffix of the temporary file written before it replaces the mission file
+ */
+#define ARMAVLINK_BINARYMISSION_TMP_SUFFIX ".tmp"
+
+/**
+ * @brief Header of a binary mission file
+ * @note The checksum is the X.25 crc of the header, with a null checksum field, and of the mission items.
+ */
+typedef struct
+{
+    char magic[4]; /**< ARMAVLINK_BINARYMISSION_MAGIC */
+    uint16_t version; /**< Format version */
+    uint16_t itemSize; /**< sizeof (mavlink_mission_item_t) of the writer */
+    uint32_t itemCount; /**< Number of mission items following the header */
+    uint16_t checksum; /**< X.25 crc of the file */
+    uint16_t reserved; /**< Reserved, 0 */
+} ARMAVLINK_BinaryMission_Header_t;
+
+/**
+ * @brief Binary mission file mapped in memory
+ */
+typedef struct
+{
+    void *mapping; /**< Mapping of the file */
+    size_t mappingSize; /**< Size of the mapping */
+    const mavlink_mission_item_t *missionItems; /**< Mission items of the file, in place */
+    int size; /**< Number of mission items */
+} ARMAVLINK_BinaryMission_t;
+
+/**
+ * @brief INTERNAL FUNCTION : Accumulate the X.25 crc of a memory area of any size
+ */
+static inline void ARMAVLINK_BinaryMission_Checksum (uint16_t *checksum, const void *data, size_t size)
+{
+    const char *cursor = (const char *)data;
+
+    while (size > 0)
+    {
+        uint16_t length = (uint16_t)((size < ARMAVLINK_BINARYMISSION_CRC_CHUNK_SIZE) ? size : ARMAVLINK_BINARYMISSION_CRC_CHUNK_SIZE);
+        crc_accumulate_buffer (checksum, cursor, length);
+        cursor += length;
+        size -= length;
+    }
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Fill a header, without its checksum
+ */
+static inline void ARMAVLINK_BinaryMission_InitHeader (ARMAVLINK_BinaryMission_Header_t *header, int count)
+{
+    memset (header, 0, sizeof (ARMAVLINK_BinaryMission_Header_t));
+    memcpy (header->magic, ARMAVLINK_BINARYMISSION_MAGIC, sizeof (header->magic));
+    header->version = ARMAVLINK_BINARYMISSION_VERSION;
+    header->itemSize = (uint16_t)sizeof (mavlink_mission_item_t);
+    header->itemCount = (uint32_t)count;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Write mission items stored in two segments, numbering their sequences from 0
+ * @note The items are written to filePath.tmp, synced, then renamed over filePath : a crash or a short write leaves the previous file intact.
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_BinaryMission_WriteSegments (const char *const filePath, const mavlink_mission_item_t *const segments[2], const int counts[2])
+{
+    mavlink_mission_item_t chunk[ARMAVLINK_BINARYMISSION_CHUNK_SIZE];
+    ARMAVLINK_BinaryMission_Header_t header;
+    uint16_t checksum = X25_INIT_CRC;
+    char tmpPath[PATH_MAX];
+    FILE *file = NULL;
+    int written = 1;
+    int segment = 0;
+    int seq = 0;
+
+    ARMAVLINK_BinaryMission_InitHeader (&header, counts[0] + counts[1]);
+    ARMAVLINK_BinaryMission_Checksum (&checksum, &header, sizeof (header));
+
+    if (snprintf (tmpPath, sizeof (tmpPath), "%s" ARMAVLINK_BINARYMISSION_TMP_SUFFIX, filePath) >= (int)sizeof (tmpPath))
+    {
+        return ARMAVLINK_ERROR_FILE_GENERATOR;
+    }
+
+    file = fopen (tmpPath, "wb");
+    if (file == NULL)
+    {
+        return ARMAVLINK_ERROR_FILE_GENERATOR;
+    }
+
+    /* the header is rewritten with its checksum once the mission items are written */
+    written = (fwrite (&header, sizeof (header), 1, file) == 1);
+
+    /* the padding of the mission items is cleared so that the file content only depends on the mission */
+    memset (chunk, 0, sizeof (chunk));
+
+    for (segment = 0; written && (segment < 2); segment++)
+    {
+        int index = 0;
+
+        while (written && (index < counts[segment]))
+        {
+            int count = counts[segment] - index;
+            int item = 0;
+
+            count = (count < ARMAVLINK_BINARYMISSION_CHUNK_SIZE) ? count : ARMAVLINK_BINARYMISSION_CHUNK_SIZE;
+            for (item = 0; item < count; item++)
+            {
+                memcpy (&chunk[item], &segments[segment][index + item], MAVLINK_MSG_ID_MISSION_ITEM_LEN);
+                chunk[item].seq = (uint16_t)seq++;
+            }
+
+            ARMAVLINK_BinaryMission_Checksum (&checksum, chunk, (size_t)count * sizeof (mavlink_mission_item_t));
+            written = (fwrite (chunk, sizeof (mavlink_mission_item_t), (size_t)count, file) == (size_t)count);
+            index += count;
+        }
+    }
+
+    if (written)
+    {
+        header.checksum = checksum;
+        written = (fseek (file, 0, SEEK_SET) == 0) && (fwrite (&header, sizeof (header), 1, file) == 1);
+    }
+
+    /* the data must be on the storage before the rename makes it the mission file */
+    written = written && (fflush (file) == 0) && (fsync (fileno (file)) == 0);
+    written = (fclose (file) == 0) && written;
+    written = written && (rename (tmpPath, filePath) == 0);
+
+    if (!written)
+    {
+        unlink (tmpPath);
+    }
+
+    return written ? ARMAVLINK_OK : ARMAVLINK_ERROR_FILE_GENERATOR;
+}
+
+/**
+ * @brief Write mission items in a binary mission file
+ * @note The sequences of the mission items are numbered from 0 in the file.
+ * @param[in] filePath : path to write the file
+ * @param[in] missionItems : the mission items to write
+ * @param[in] count : the number of mission items
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_BinaryMission_Write (const char *const filePath, const mavlink_mission_item_t *missionItems, int count)
+{
+    const mavlink_mission_item_t *segments[2] = {missionItems, NULL};
+    int counts[2] = {count, 0};
+
+    if ((filePath == NULL) || (count < 0) || ((missionItems == NULL) && (count > 0)))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    return ARMAVLINK_BinaryMission_WriteSegments (filePath, segments, counts);
+}
+
+/**
+ * @brief Write the mission items of a mission item buffer in a binary mission file
+ * @note The mission items are written from the buffer storage, without exporting them first.
+ * @param[in] filePath : path to write the file
+ * @param[in] buffer : pointer on the buffer
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_BinaryMission_WriteMissionItemBuffer (const char *const filePath, const ARMAVLINK_MissionItemBuffer_t *buffer)
+{
+    const mavlink_mission_item_t *segments[2] = {NULL, NULL};
+    int counts[2] = {0, 0};
+
+    if ((filePath == NULL) || (buffer == NULL))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    segments[0] = buffer->missionItems;
+    counts[0] = buffer->gapStart;
+    segments[1] = (buffer->missionItems != NULL) ? &buffer->missionItems[buffer->gapEnd] : NULL;
+    counts[1] = buffer->capacity - buffer->gapEnd;
+
+    return ARMAVLINK_BinaryMission_WriteSegments (filePath, segments, counts);
+}
+
+/**
+ * @brief Check binary mission file content held in memory
+ * @param[in] data : the content to check ; must be aligned on 4 bytes to use the mission items in place
+ * @param[in] size : the size of the content
+ * @param[out] count : the number of mission items following the header. Can be null
+ * @return ARMAVLINK_OK if the content is a valid binary mission, ARMAVLINK_ERROR_FILE_PARSER_WORD_NOT_EXPTECTED if the
+ * header is not the one of a binary mission readable here, ARMAVLINK_ERROR_FILE_PARSER if the content is corrupted
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_BinaryMission_CheckBuffer (const void *data, size_t size, int *count)
+{
+    ARMAVLINK_BinaryMission_Header_t header;
+    uint16_t checksum = X25_INIT_CRC;
+
+    if (data == NULL)
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    if (size < sizeof (header))
+    {
+        return ARMAVLINK_ERROR_FILE_PARSER_WORD_NOT_EXPTECTED;
+    }
+
+    memcpy (&header, data, sizeof (header));
+
+    if ((memcmp (header.magic, ARMAVLINK_BINARYMISSION_MAGIC, sizeof (header.magic)) != 0) ||
+        (header.version != ARMAVLINK_BINARYMISSION_VERSION) || (header.itemSize != sizeof (mavlink_mission_item_t)) ||
+        (header.itemCount > (uint32_t)INT_MAX))
+    {
+        return ARMAVLINK_ERROR_FILE_PARSER_WORD_NOT_EXPTECTED;
+    }
+
+    if ((size - sizeof (header)) / sizeof (mavlink_mission_item_t) != header.itemCount ||
+        (size - sizeof (header)) % sizeof (mavlink_mission_item_t) != 0)
+    {
+        return ARMAVLINK_ERROR_FILE_PARSER;
+    }
+
+    header.checksum = 0;
+    ARMAVLINK_BinaryMission_Checksum (&checksum, &header, sizeof (header));
+    ARMAVLINK_BinaryMission_Checksum (&checksum, (const char *)data + sizeof (header), size - sizeof (header));
+
+    if (checksum != ((const ARMAVLINK_BinaryMission_Header_t *)data)->checksum)
+    {
+        return ARMAVLINK_ERROR_FILE_PARSER;
+    }
+
+    if (count != NULL)
+    {
+        *count = (int)header.itemCount;
+    }
+
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief Open a binary mission file
+ * @warning This function allocates memory and maps the file
+ * @post ARMAVLINK_BinaryMission_Delete() must be called to unmap the file and free the memory allocated.
+ * @param[in] filePath : the path of the file to open
+ * @param[out] error : pointer on the error output.
+ * @return Pointer on the mapped binary mission, or NULL if the file can not be opened or is not a valid binary mission
+ * @see ARMAVLINK_BinaryMission_CheckBuffer()
+ */
+static inline ARMAVLINK_BinaryMission_t *ARMAVLINK_BinaryMission_New (const char *const filePath, eARMAVLINK_ERROR *error)
+{
+    eARMAVLINK_ERROR localError = ARMAVLINK_OK;
+    ARMAVLINK_BinaryMission_t *mission = NULL;
+    struct stat status;
+    int fd = -1;
+
+    if (filePath == NULL)
+    {
+        localError = ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+    else if ((fd = open (filePath, O_RDONLY)) < 0)
+    {
+        localError = ARMAVLINK_ERROR_FILE_PARSER_FILE_NOT_FOUND;
+    }
+    else if ((fstat (fd, &status) != 0) || (status.st_size < (off_t)sizeof (ARMAVLINK_BinaryMission_Header_t)) ||
+             ((off_t)(size_t)status.st_size != status.st_size))
+    {
+        localError = ARMAVLINK_ERROR_FILE_PARSER_WORD_NOT_EXPTECTED;
+    }
+    else if ((mission = (ARMAVLINK_BinaryMission_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, 1, sizeof (ARMAVLINK_BinaryMission_t))) == NULL)
+    {
+        localError = ARMAVLINK_ERROR_ALLOC;
+    }
+    else
+    {
+        mission->mappingSize = (size_t)status.st_size;
+        mission->mapping = mmap (NULL, mission->mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (mission->mapping == MAP_FAILED)
+        {
+            localError = ARMAVLINK_ERROR_FILE_PARSER;
+        }
+        else
+        {
+            localError = ARMAVLINK_BinaryMission_CheckBuffer (mission->mapping, mission->mappingSize, &mission->size);
+            if (localError != ARMAVLINK_OK)
+            {
+                munmap (mission->mapping, mission->mappingSize);
+            }
+        }
+
+        if (localError != ARMAVLINK_OK)
+        {
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, mission);
+            mission = NULL;
+        }
+        else
+        {
+            mission->missionItems = (const mavlink_mission_item_t *)((const char *)mission->mapping + sizeof (ARMAVLINK_BinaryMission_Header_t));
+        }
+    }
+
+    if (fd >= 0)
+    {
+        close (fd);
+    }
+
+    if (error != NULL)
+    {
+        *error = localError;
+    }
+
+    return mission;
+}
+
+/**
+ * @brief Unmap the binary mission file
+ * @warning This function frees memory ; the mission items of the file must not be used anymore
+ * @param mission : address of the pointer on the binary mission
+ * @see ARMAVLINK_BinaryMission_New()
+ */
+static inline void ARMAVLINK_BinaryMission_Delete (ARMAVLINK_BinaryMission_t **mission)
+{
+    if ((mission != NULL) && (*mission != NULL))
+    {
+        munmap ((*mission)->mapping, (*mission)->mappingSize);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, *mission);
+        *mission = NULL;
+    }
+}
+
+/**
+ * @brief Get the number of mission items of the binary mission
+ * @param mission : pointer on the binary mission
+ * @return the number of mission items
+ */
+static inline int ARMAVLINK_BinaryMission_GetSize (const ARMAVLINK_BinaryMission_t *mission)
+{
+    return (mission != NULL) ? mission->size : 0;
+}
+
+/**
+ * @brief Get a mission item of the binary mission according to its index
+ * @param mission : pointer on the binary mission
+ * @param[in] index : the index of the mission item to return
+ * @return a pointer on the mission item, in the mapped file, if it exists, otherwise NULL
+ */
+static inline const mavlink_mission_item_t *ARMAVLINK_BinaryMission_Get (const ARMAVLINK_BinaryMission_t *mission, int index)
+{
+    return ((mission != NULL) && (index >= 0) && (index < mission->size)) ? &mission->missionItems[index] : NULL;
+}
+
+#endif
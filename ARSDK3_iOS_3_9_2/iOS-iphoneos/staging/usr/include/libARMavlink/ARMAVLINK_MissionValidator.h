@@ -0,0 +1,864 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARMAVLINK_MissionValidator.h
+ * @brief Mission validation against altitude limits, a maximum distance and fence polygons
+ * @note The edges of the fence polygons are indexed in a uniform grid over their bounding box, each
+ * edge being registered in the cells it crosses. Testing a mission item then only looks at the
+ * edges of the cells around it : point in polygon tests cast a ray along the row of the item, and
+ * leg tests walk the cells crossed by the leg. Altitude and distance checks run over blocks of
+ * items laid out as arrays, so that the compiler vectorizes them.
+ * @date 10/18/2026
+ */
+#ifndef _ARMAVLINK_MISSION_VALIDATOR_H
+#define _ARMAVLINK_MISSION_VALIDATOR_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+#include <libARSAL/ARSAL_Allocator.h>
+#include <libARMavlink/ARMAVLINK_Error.h>
+#include <libARMavlink/ARMAVLINK_MissionItemBuffer.h>
+#include <mavlink/parrot/mavlink.h>
+
+/**
+ * @brief Maximum number of rows or columns of the grid
+ */
+#define ARMAVLINK_MISSIONVALIDATOR_GRID_MAX_SIZE 1024
+
+/**
+ * @brief Number of mission items whose altitude and distance are checked at once
+ */
+#define ARMAVLINK_MISSIONVALIDATOR_BLOCK_SIZE 64
+
+/**
+ * @brief Mean radius of the earth in meters, for the distance checks
+ */
+#define ARMAVLINK_MISSIONVALIDATOR_EARTH_RADIUS 6371000.0
+
+/**
+ * @brief Radians per degree
+ */
+#define ARMAVLINK_MISSIONVALIDATOR_RADIANS_PER_DEGREE (3.14159265358979323846 / 180.0)
+
+/**
+ * @brief Kind of a fence polygon
+ */
+typedef enum
+{
+    ARMAVLINK_MISSIONVALIDATOR_POLYGON_INCLUSION = 0, /**< The mission must stay inside one of the inclusion polygons */
+    ARMAVLINK_MISSIONVALIDATOR_POLYGON_EXCLUSION, /**< The mission must not enter the exclusion polygons (no fly zones) */
+    ARMAVLINK_MISSIONVALIDATOR_POLYGON_MAX, /**< Max of the enum, do not use */
+} eARMAVLINK_MISSIONVALIDATOR_POLYGON;
+
+/**
+ * @brief Validation result flags of a mission item
+ */
+typedef enum
+{
+    ARMAVLINK_MISSIONVALIDATOR_RESULT_OK = 0, /**< The mission item is valid, or has no position */
+    ARMAVLINK_MISSIONVALIDATOR_RESULT_ALTITUDE = (1 << 0), /**< The altitude is out of the limits */
+    ARMAVLINK_MISSIONVALIDATOR_RESULT_DISTANCE = (1 << 1), /**< The position is too far from home */
+    ARMAVLINK_MISSIONVALIDATOR_RESULT_OUTSIDE_FENCE = (1 << 2), /**< The position is outside all the inclusion polygons */
+    ARMAVLINK_MISSIONVALIDATOR_RESULT_NO_FLY_ZONE = (1 << 3), /**< The position is inside an exclusion polygon */
+    ARMAVLINK_MISSIONVALIDATOR_RESULT_LEG_CROSSES_FENCE = (1 << 4), /**< The leg from the previous positioned item crosses a polygon edge */
+} eARMAVLINK_MISSIONVALIDATOR_RESULT;
+
+/**
+ * @brief Mission validator
+ * @note Positions are latitudes and longitudes in degrees ; the fences are handled in this plane,
+ * which is accurate for fences spanning a few kilometers.
+ */
+typedef struct
+{
+    double *edgeLatitudes0; /**< Latitudes of the first vertices of the edges */
+    double *edgeLongitudes0; /**< Longitudes of the first vertices of the edges */
+    double *edgeLatitudes1; /**< Latitudes of the second vertices of the edges */
+    double *edgeLongitudes1; /**< Longitudes of the second vertices of the edges */
+    int *edgePolygons; /**< Polygon of the edges */
+    unsigned int *edgeStamps; /**< Query stamp of the edges, so that an edge registered in several cells is tested once */
+    int edgeCount; /**< Number of edges */
+    int edgeCapacity; /**< Number of edges which can be stored without allocation */
+
+    eARMAVLINK_MISSIONVALIDATOR_POLYGON *polygonKinds; /**< Kind of the polygons */
+    unsigned char *polygonParities; /**< Ray crossing parities of the polygons during a point test */
+    int polygonCount; /**< Number of polygons */
+    int inclusionCount; /**< Number of inclusion polygons */
+
+    int built; /**< 1 if the grid is up to date with the polygons */
+    unsigned int stamp; /**< Current query stamp */
+    double gridLatitude; /**< Minimum latitude of the grid */
+    double gridLongitude; /**< Minimum longitude of the grid */
+    double cellLatitude; /**< Height of a cell in degrees */
+    double cellLongitude; /**< Width of a cell in degrees */
+    int rows; /**< Number of rows of the grid */
+    int columns; /**< Number of columns of the grid */
+    int *cellStarts; /**< Index in cellEdges of the first edge of each cell, rows * columns + 1 entries */
+    int *cellEdges; /**< Edges of the cells */
+
+    int altitudeLimited; /**< 1 if the altitudes are checked */
+    float minAltitude; /**< Minimum altitude */
+    float maxAltitude; /**< Maximum altitude */
+    double homeLatitude; /**< Latitude of home */
+    double homeLongitude; /**< Longitude of home */
+    double maxDistance; /**< Maximum distance from home in meters, 0 if not checked */
+} ARMAVLINK_MissionValidator_t;
+
+/**
+ * @brief INTERNAL FUNCTION : Whether a mission item holds a position in degrees
+ */
+static inline int ARMAVLINK_MissionValidator_HasPosition (const mavlink_mission_item_t *missionItem)
+{
+    return (missionItem->command <= MAV_CMD_NAV_LAST) && (missionItem->command != MAV_CMD_NAV_RETURN_TO_LAUNCH) &&
+           ((missionItem->frame == MAV_FRAME_GLOBAL) || (missionItem->frame == MAV_FRAME_GLOBAL_RELATIVE_ALT) ||
+            (missionItem->frame == MAV_FRAME_GLOBAL_TERRAIN_ALT));
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Row of the grid holding a latitude, clamped to the grid
+ */
+static inline int ARMAVLINK_MissionValidator_Row (const ARMAVLINK_MissionValidator_t *validator, double latitude)
+{
+    double row = floor ((latitude - validator->gridLatitude) / validator->cellLatitude);
+    return (row < 0) ? 0 : (row >= validator->rows) ? validator->rows - 1 : (int)row;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Column of the grid holding a longitude, clamped to the grid
+ */
+static inline int ARMAVLINK_MissionValidator_Column (const ARMAVLINK_MissionValidator_t *validator, double longitude)
+{
+    double column = floor ((longitude - validator->gridLongitude) / validator->cellLongitude);
+    return (column < 0) ? 0 : (column >= validator->columns) ? validator->columns - 1 : (int)column;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Columns crossed by a segment within a row of the grid
+ * @note The span is widened by one column on each side so that rounding never misses a cell.
+ */
+static inline void ARMAVLINK_MissionValidator_RowSpan (const ARMAVLINK_MissionValidator_t *validator, double latitude0, double longitude0, double latitude1, double longitude1, int row, int *firstColumn, int *lastColumn)
+{
+    double longitudeA = longitude0;
+    double longitudeB = longitude1;
+
+    if (latitude0 != latitude1)
+    {
+        double low = validator->gridLatitude + (row * validator->cellLatitude);
+        double high = low + validator->cellLatitude;
+        double minLatitude = (latitude0 < latitude1) ? latitude0 : latitude1;
+        double maxLatitude = (latitude0 < latitude1) ? latitude1 : latitude0;
+        double slope = (longitude1 - longitude0) / (latitude1 - latitude0);
+
+        low = (low < minLatitude) ? minLatitude : low;
+        high = (high > maxLatitude) ? maxLatitude : high;
+        longitudeA = longitude0 + ((low - latitude0) * slope);
+        longitudeB = longitude0 + ((high - latitude0) * slope);
+    }
+
+    if (longitudeA > longitudeB)
+    {
+        double swap = longitudeA;
+        longitudeA = longitudeB;
+        longitudeB = swap;
+    }
+
+    *firstColumn = ARMAVLINK_MissionValidator_Column (validator, longitudeA);
+    *firstColumn -= (*firstColumn > 0) ? 1 : 0;
+    *lastColumn = ARMAVLINK_MissionValidator_Column (validator, longitudeB);
+    *lastColumn += (*lastColumn < validator->columns - 1) ? 1 : 0;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Start a query, so that each edge is tested once
+ */
+static inline unsigned int ARMAVLINK_MissionValidator_NextStamp (ARMAVLINK_MissionValidator_t *validator)
+{
+    validator->stamp++;
+    if (validator->stamp == 0)
+    {
+        memset (validator->edgeStamps, 0, (size_t)validator->edgeCount * sizeof (unsigned int));
+        validator->stamp = 1;
+    }
+    return validator->stamp;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Sign of the orientation of three points
+ */
+static inline int ARMAVLINK_MissionValidator_Orientation (double latitudeA, double longitudeA, double latitudeB, double longitudeB, double latitudeC, double longitudeC)
+{
+    double cross = ((longitudeB - longitudeA) * (latitudeC - latitudeA)) - ((latitudeB - latitudeA) * (longitudeC - longitudeA));
+    return (cross > 0) - (cross < 0);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Whether two segments intersect, touching included
+ */
+static inline int ARMAVLINK_MissionValidator_SegmentsIntersect (double latitudeP0, double longitudeP0, double latitudeP1, double longitudeP1,
+                                                                double latitudeQ0, double longitudeQ0, double latitudeQ1, double longitudeQ1)
+{
+    int o1 = ARMAVLINK_MissionValidator_Orientation (latitudeP0, longitudeP0, latitudeP1, longitudeP1, latitudeQ0, longitudeQ0);
+    int o2 = ARMAVLINK_MissionValidator_Orientation (latitudeP0, longitudeP0, latitudeP1, longitudeP1, latitudeQ1, longitudeQ1);
+    int o3 = ARMAVLINK_MissionValidator_Orientation (latitudeQ0, longitudeQ0, latitudeQ1, longitudeQ1, latitudeP0, longitudeP0);
+    int o4 = ARMAVLINK_MissionValidator_Orientation (latitudeQ0, longitudeQ0, latitudeQ1, longitudeQ1, latitudeP1, longitudeP1);
+
+    if ((o1 * o2 < 0) && (o3 * o4 < 0))
+    {
+        return 1;
+    }
+
+    /* collinear cases : the segments intersect if their bounding boxes overlap */
+    if (((o1 == 0) || (o2 == 0) || (o3 == 0) || (o4 == 0)) && (o1 * o2 <= 0) && (o3 * o4 <= 0))
+    {
+        return (fmin (latitudeP0, latitudeP1) <= fmax (latitudeQ0, latitudeQ1)) && (fmin (latitudeQ0, latitudeQ1) <= fmax (latitudeP0, latitudeP1)) &&
+               (fmin (longitudeP0, longitudeP1) <= fmax (longitudeQ0, longitudeQ1)) && (fmin (longitudeQ0, longitudeQ1) <= fmax (longitudeP0, longitudeP1));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Build the grid over the edges of the polygons
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MissionValidator_Build (ARMAVLINK_MissionValidator_t *validator)
+{
+    double minLatitude = HUGE_VAL, maxLatitude = -HUGE_VAL, minLongitude = HUGE_VAL, maxLongitude = -HUGE_VAL;
+    double extentLatitude = 0, extentLongitude = 0;
+    int *cellStarts = NULL;
+    int *cellEdges = NULL;
+    int cellCount = 0;
+    int pass = 0;
+    int edge = 0;
+
+    if (validator->built)
+    {
+        return ARMAVLINK_OK;
+    }
+
+    ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, validator->cellStarts);
+    ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, validator->cellEdges);
+    validator->cellStarts = NULL;
+    validator->cellEdges = NULL;
+    validator->rows = 0;
+    validator->columns = 0;
+
+    if (validator->edgeCount == 0)
+    {
+        validator->built = 1;
+        return ARMAVLINK_OK;
+    }
+
+    for (edge = 0; edge < validator->edgeCount; edge++)
+    {
+        minLatitude = fmin (minLatitude, fmin (validator->edgeLatitudes0[edge], validator->edgeLatitudes1[edge]));
+        maxLatitude = fmax (maxLatitude, fmax (validator->edgeLatitudes0[edge], validator->edgeLatitudes1[edge]));
+        minLongitude = fmin (minLongitude, fmin (validator->edgeLongitudes0[edge], validator->edgeLongitudes1[edge]));
+        maxLongitude = fmax (maxLongitude, fmax (validator->edgeLongitudes0[edge], validator->edgeLongitudes1[edge]));
+    }
+
+    extentLatitude = fmax (maxLatitude - minLatitude, 1e-9);
+    extentLongitude = fmax (maxLongitude - minLongitude, 1e-9);
+
+    /* about one edge per cell, with square cells in degrees */
+    validator->columns = (int)ceil (sqrt (validator->edgeCount * extentLongitude / extentLatitude));
+    validator->columns = (validator->columns < 1) ? 1 : (validator->columns > ARMAVLINK_MISSIONVALIDATOR_GRID_MAX_SIZE) ? ARMAVLINK_MISSIONVALIDATOR_GRID_MAX_SIZE : validator->columns;
+    validator->rows = (validator->edgeCount + validator->columns - 1) / validator->columns;
+    validator->rows = (validator->rows < 1) ? 1 : (validator->rows > ARMAVLINK_MISSIONVALIDATOR_GRID_MAX_SIZE) ? ARMAVLINK_MISSIONVALIDATOR_GRID_MAX_SIZE : validator->rows;
+    validator->gridLatitude = minLatitude;
+    validator->gridLongitude = minLongitude;
+    validator->cellLatitude = extentLatitude / validator->rows;
+    validator->cellLongitude = extentLongitude / validator->columns;
+    cellCount = validator->rows * validator->columns;
+
+    cellStarts = (int *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (size_t)cellCount + 1, sizeof (int));
+    if (cellStarts == NULL)
+    {
+        return ARMAVLINK_ERROR_ALLOC;
+    }
+
+    /* first pass counts the edges of each cell, second pass stores them */
+    for (pass = 0; pass < 2; pass++)
+    {
+        for (edge = 0; edge < validator->edgeCount; edge++)
+        {
+            double latitude0 = validator->edgeLatitudes0[edge], longitude0 = validator->edgeLongitudes0[edge];
+            double latitude1 = validator->edgeLatitudes1[edge], longitude1 = validator->edgeLongitudes1[edge];
+            int lastRow = ARMAVLINK_MissionValidator_Row (validator, fmax (latitude0, latitude1));
+            int row = ARMAVLINK_MissionValidator_Row (validator, fmin (latitude0, latitude1));
+
+            for (; row <= lastRow; row++)
+            {
+                int column = 0, lastColumn = 0;
+                ARMAVLINK_MissionValidator_RowSpan (validator, latitude0, longitude0, latitude1, longitude1, row, &column, &lastColumn);
+                for (; column <= lastColumn; column++)
+                {
+                    int cell = (row * validator->columns) + column;
+                    if (pass == 0)
+                    {
+                        cellStarts[cell + 1]++;
+                    }
+                    else
+                    {
+                        cellEdges[cellStarts[cell]++] = edge;
+                    }
+                }
+            }
+        }
+
+        if (pass == 0)
+        {
+            int cell = 0;
+            for (cell = 0; cell < cellCount; cell++)
+            {
+                cellStarts[cell + 1] += cellStarts[cell];
+            }
+
+            cellEdges = (int *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, ((size_t)cellStarts[cellCount] + 1) * sizeof (int));
+            if (cellEdges == NULL)
+            {
+                ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, cellStarts);
+                return ARMAVLINK_ERROR_ALLOC;
+            }
+        }
+    }
+
+    /* the second pass moved each start to the end of its cell, which is the start of the next one */
+    memmove (&cellStarts[1], &cellStarts[0], (size_t)cellCount * sizeof (int));
+    cellStarts[0] = 0;
+
+    validator->cellStarts = cellStarts;
+    validator->cellEdges = cellEdges;
+    validator->built = 1;
+
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Fence result of a position
+ */
+static inline uint32_t ARMAVLINK_MissionValidator_CheckPosition (ARMAVLINK_MissionValidator_t *validator, double latitude, double longitude)
+{
+    uint32_t result = ARMAVLINK_MISSIONVALIDATOR_RESULT_OK;
+    int insideInclusion = 0;
+    int polygon = 0;
+
+    if ((validator->rows > 0) &&
+        (latitude >= validator->gridLatitude) && (latitude <= validator->gridLatitude + (validator->rows * validator->cellLatitude)) &&
+        (longitude >= validator->gridLongitude) && (longitude <= validator->gridLongitude + (validator->columns * validator->cellLongitude)))
+    {
+        unsigned int stamp = ARMAVLINK_MissionValidator_NextStamp (validator);
+        int row = ARMAVLINK_MissionValidator_Row (validator, latitude);
+        int column = ARMAVLINK_MissionValidator_Column (validator, longitude);
+        const int *cellStarts = &validator->cellStarts[row * validator->columns];
+
+        memset (validator->polygonParities, 0, (size_t)validator->polygonCount);
+
+        /* ray cast towards the east along the row of the position */
+        column -= (column > 0) ? 1 : 0;
+        for (; column < validator->columns; column++)
+        {
+            int index = 0;
+            for (index = cellStarts[column]; index < cellStarts[column + 1]; index++)
+            {
+                int edge = validator->cellEdges[index];
+                double latitude0 = validator->edgeLatitudes0[edge], latitude1 = validator->edgeLatitudes1[edge];
+
+                if (validator->edgeStamps[edge] == stamp)
+                {
+                    continue;
+                }
+                validator->edgeStamps[edge] = stamp;
+
+                if ((latitude0 > latitude) != (latitude1 > latitude))
+                {
+                    double longitude0 = validator->edgeLongitudes0[edge];
+                    double crossing = longitude0 + ((latitude - latitude0) * (validator->edgeLongitudes1[edge] - longitude0) / (latitude1 - latitude0));
+                    if (crossing > longitude)
+                    {
+                        validator->polygonParities[validator->edgePolygons[edge]] ^= 1;
+                    }
+                }
+            }
+        }
+
+        for (polygon = 0; polygon < validator->polygonCount; polygon++)
+        {
+            if (validator->polygonParities[polygon])
+            {
+                if (validator->polygonKinds[polygon] == ARMAVLINK_MISSIONVALIDATOR_POLYGON_INCLUSION)
+                {
+                    insideInclusion = 1;
+                }
+                else
+                {
+                    result |= ARMAVLINK_MISSIONVALIDATOR_RESULT_NO_FLY_ZONE;
+                }
+            }
+        }
+    }
+
+    if ((validator->inclusionCount > 0) && !insideInclusion)
+    {
+        result |= ARMAVLINK_MISSIONVALIDATOR_RESULT_OUTSIDE_FENCE;
+    }
+
+    return result;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Whether a leg crosses an edge of a polygon
+ */
+static inline int ARMAVLINK_MissionValidator_CheckLeg (ARMAVLINK_MissionValidator_t *validator, double latitude0, double longitude0, double latitude1, double longitude1)
+{
+    unsigned int stamp = 0;
+    int lastRow = 0;
+    int row = 0;
+
+    if ((validator->rows == 0) ||
+        (fmax (latitude0, latitude1) < validator->gridLatitude) || (fmin (latitude0, latitude1) > validator->gridLatitude + (validator->rows * validator->cellLatitude)) ||
+        (fmax (longitude0, longitude1) < validator->gridLongitude) || (fmin (longitude0, longitude1) > validator->gridLongitude + (validator->columns * validator->cellLongitude)))
+    {
+        return 0;
+    }
+
+    stamp = ARMAVLINK_MissionValidator_NextStamp (validator);
+    row = ARMAVLINK_MissionValidator_Row (validator, fmin (latitude0, latitude1));
+    lastRow = ARMAVLINK_MissionValidator_Row (validator, fmax (latitude0, latitude1));
+
+    for (; row <= lastRow; row++)
+    {
+        int column = 0, lastColumn = 0;
+        ARMAVLINK_MissionValidator_RowSpan (validator, latitude0, longitude0, latitude1, longitude1, row, &column, &lastColumn);
+
+        for (; column <= lastColumn; column++)
+        {
+            int cell = (row * validator->columns) + column;
+            int index = 0;
+
+            for (index = validator->cellStarts[cell]; index < validator->cellStarts[cell + 1]; index++)
+            {
+                int edge = validator->cellEdges[index];
+
+                if (validator->edgeStamps[edge] == stamp)
+                {
+                    continue;
+                }
+                validator->edgeStamps[edge] = stamp;
+
+                if (ARMAVLINK_MissionValidator_SegmentsIntersect (latitude0, longitude0, latitude1, longitude1,
+                                                                  validator->edgeLatitudes0[edge], validator->edgeLongitudes0[edge],
+                                                                  validator->edgeLatitudes1[edge], validator->edgeLongitudes1[edge]))
+                {
+                    return 1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Validate a range of mission items stored in two segments
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MissionValidator_ValidateSegments (ARMAVLINK_MissionValidator_t *validator, const mavlink_mission_item_t *const segments[2], const int counts[2],
+                                                                            int first, int count, uint32_t *results)
+{
+    float latitudes[ARMAVLINK_MISSIONVALIDATOR_BLOCK_SIZE];
+    float longitudes[ARMAVLINK_MISSIONVALIDATOR_BLOCK_SIZE];
+    float altitudes[ARMAVLINK_MISSIONVALIDATOR_BLOCK_SIZE];
+    uint32_t flags[ARMAVLINK_MISSIONVALIDATOR_BLOCK_SIZE];
+    int positions[ARMAVLINK_MISSIONVALIDATOR_BLOCK_SIZE];
+    double previousLatitude = 0, previousLongitude = 0;
+    int hasPrevious = 0;
+    double latitudeScale = 0, longitudeScale = 0, maxDistance2 = 0;
+    eARMAVLINK_ERROR error = ARMAVLINK_OK;
+    int block = 0;
+    int index = 0;
+
+    if ((validator == NULL) || (results == NULL) || (first < 0) || (count < 0) || (first > counts[0] + counts[1] - count))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    error = ARMAVLINK_MissionValidator_Build (validator);
+    if (error != ARMAVLINK_OK)
+    {
+        return error;
+    }
+
+    /* the leg of the first item of the range starts at the previous positioned item */
+    for (index = first - 1; (index >= 0) && !hasPrevious; index--)
+    {
+        const mavlink_mission_item_t *missionItem = (index < counts[0]) ? &segments[0][index] : &segments[1][index - counts[0]];
+        if (ARMAVLINK_MissionValidator_HasPosition (missionItem))
+        {
+            previousLatitude = missionItem->x;
+            previousLongitude = missionItem->y;
+            hasPrevious = 1;
+        }
+    }
+
+    latitudeScale = ARMAVLINK_MISSIONVALIDATOR_EARTH_RADIUS * ARMAVLINK_MISSIONVALIDATOR_RADIANS_PER_DEGREE;
+    longitudeScale = latitudeScale * cos (validator->homeLatitude * ARMAVLINK_MISSIONVALIDATOR_RADIANS_PER_DEGREE);
+    maxDistance2 = validator->maxDistance * validator->maxDistance;
+
+    for (block = first; block < first + count; block += ARMAVLINK_MISSIONVALIDATOR_BLOCK_SIZE)
+    {
+        int size = first + count - block;
+        int item = 0;
+
+        size = (size < ARMAVLINK_MISSIONVALIDATOR_BLOCK_SIZE) ? size : ARMAVLINK_MISSIONVALIDATOR_BLOCK_SIZE;
+
+        for (item = 0; item < size; item++)
+        {
+            int global = block + item;
+            const mavlink_mission_item_t *missionItem = (global < counts[0]) ? &segments[0][global] : &segments[1][global - counts[0]];
+            positions[item] = ARMAVLINK_MissionValidator_HasPosition (missionItem);
+            latitudes[item] = missionItem->x;
+            longitudes[item] = missionItem->y;
+            altitudes[item] = missionItem->z;
+        }
+
+        /* branch free loops over the block arrays */
+        for (item = 0; item < size; item++)
+        {
+            flags[item] = (validator->altitudeLimited && ((altitudes[item] < validator->minAltitude) || (altitudes[item] > validator->maxAltitude))) ?
+                          ARMAVLINK_MISSIONVALIDATOR_RESULT_ALTITUDE : ARMAVLINK_MISSIONVALIDATOR_RESULT_OK;
+        }
+
+        if (validator->maxDistance > 0)
+        {
+            for (item = 0; item < size; item++)
+            {
+                double north = (latitudes[item] - validator->homeLatitude) * latitudeScale;
+                double east = (longitudes[item] - validator->homeLongitude) * longitudeScale;
+                flags[item] |= (((north * north) + (east * east)) > maxDistance2) ? ARMAVLINK_MISSIONVALIDATOR_RESULT_DISTANCE : ARMAVLINK_MISSIONVALIDATOR_RESULT_OK;
+            }
+        }
+
+        for (item = 0; item < size; item++)
+        {
+            uint32_t result = ARMAVLINK_MISSIONVALIDATOR_RESULT_OK;
+
+            if (positions[item])
+            {
+                result = flags[item];
+
+                if (validator->polygonCount > 0)
+                {
+                    result |= ARMAVLINK_MissionValidator_CheckPosition (validator, latitudes[item], longitudes[item]);
+
+                    if (hasPrevious && ARMAVLINK_MissionValidator_CheckLeg (validator, previousLatitude, previousLongitude, latitudes[item], longitudes[item]))
+                    {
+                        result |= ARMAVLINK_MISSIONVALIDATOR_RESULT_LEG_CROSSES_FENCE;
+                    }
+                }
+
+                previousLatitude = latitudes[item];
+                previousLongitude = longitudes[item];
+                hasPrevious = 1;
+            }
+
+            results[block - first + item] = result;
+        }
+    }
+
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief Create a new mission validator, without any limit nor polygon
+ * @warning This function allocates memory
+ * @post ARMAVLINK_MissionValidator_Delete() must be called to delete the validator and free the memory allocated.
+ * @param[out] error : pointer on the error output.
+ * @return Pointer on the new validator
+ * @see ARMAVLINK_MissionValidator_Delete()
+ */
+static inline ARMAVLINK_MissionValidator_t *ARMAVLINK_MissionValidator_New (eARMAVLINK_ERROR *error)
+{
+    eARMAVLINK_ERROR localError = ARMAVLINK_OK;
+    ARMAVLINK_MissionValidator_t *validator = (ARMAVLINK_MissionValidator_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, 1, sizeof (ARMAVLINK_MissionValidator_t));
+
+    if (validator == NULL)
+    {
+        localError = ARMAVLINK_ERROR_ALLOC;
+    }
+
+    if (error != NULL)
+    {
+        *error = localError;
+    }
+
+    return validator;
+}
+
+/**
+ * @brief Delete the mission validator
+ * @warning This function frees memory
+ * @param validator : address of the pointer on the validator
+ * @see ARMAVLINK_MissionValidator_New()
+ */
+static inline void ARMAVLINK_MissionValidator_Delete (ARMAVLINK_MissionValidator_t **validator)
+{
+    if ((validator != NULL) && (*validator != NULL))
+    {
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (*validator)->edgeLatitudes0);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (*validator)->edgeLongitudes0);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (*validator)->edgeLatitudes1);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (*validator)->edgeLongitudes1);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (*validator)->edgePolygons);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (*validator)->edgeStamps);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (*validator)->polygonKinds);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (*validator)->polygonParities);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (*validator)->cellStarts);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (*validator)->cellEdges);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, *validator);
+        *validator = NULL;
+    }
+}
+
+/**
+ * @brief Set the altitude limits of the mission items
+ * @param validator : pointer on the validator
+ * @param[in] minAltitude : minimum altitude, in the frame of the mission items
+ * @param[in] maxAltitude : maximum altitude, in the frame of the mission items
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MissionValidator_SetAltitudeLimits (ARMAVLINK_MissionValidator_t *validator, float minAltitude, float maxAltitude)
+{
+    if ((validator == NULL) || !(minAltitude <= maxAltitude))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    validator->altitudeLimited = 1;
+    validator->minAltitude = minAltitude;
+    validator->maxAltitude = maxAltitude;
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief Set the maximum distance of the mission items from home
+ * @param validator : pointer on the validator
+ * @param[in] homeLatitude : latitude of home in degrees
+ * @param[in] homeLongitude : longitude of home in degrees
+ * @param[in] maxDistance : maximum horizontal distance in meters ; 0 to disable the check
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MissionValidator_SetMaxDistance (ARMAVLINK_MissionValidator_t *validator, double homeLatitude, double homeLongitude, double maxDistance)
+{
+    if ((validator == NULL) || !(maxDistance >= 0))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    validator->homeLatitude = homeLatitude;
+    validator->homeLongitude = homeLongitude;
+    validator->maxDistance = maxDistance;
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief Add a fence polygon
+ * @note The index is rebuilt at the next validation.
+ * @param validator : pointer on the validator
+ * @param[in] kind : the kind of the polygon
+ * @param[in] latitudes : latitudes of the vertices in degrees
+ * @param[in] longitudes : longitudes of the vertices in degrees
+ * @param[in] count : number of vertices, at least 3 ; the polygon is closed implicitly
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MissionValidator_AddPolygon (ARMAVLINK_MissionValidator_t *validator, eARMAVLINK_MISSIONVALIDATOR_POLYGON kind,
+                                                                      const double *latitudes, const double *longitudes, int count)
+{
+    int vertex = 0;
+
+    if ((validator == NULL) || (latitudes == NULL) || (longitudes == NULL) || (count < 3) ||
+        (kind < ARMAVLINK_MISSIONVALIDATOR_POLYGON_INCLUSION) || (kind >= ARMAVLINK_MISSIONVALIDATOR_POLYGON_MAX) ||
+        (count > INT_MAX - validator->edgeCount))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    if (validator->edgeCount + count > validator->edgeCapacity)
+    {
+        int capacity = (validator->edgeCapacity > 0) ? validator->edgeCapacity : 64;
+        double **coordinates[4] = {&validator->edgeLatitudes0, &validator->edgeLongitudes0, &validator->edgeLatitudes1, &validator->edgeLongitudes1};
+        int array = 0;
+        void *grown = NULL;
+
+        while (capacity < validator->edgeCount + count)
+        {
+            capacity = (capacity > INT_MAX / 2) ? INT_MAX : capacity * 2;
+        }
+
+        for (array = 0; array < 4; array++)
+        {
+            grown = ARSAL_Allocator_Realloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, *coordinates[array], (size_t)capacity * sizeof (double));
+            if (grown == NULL)
+            {
+                return ARMAVLINK_ERROR_ALLOC;
+            }
+            *coordinates[array] = (double *)grown;
+        }
+
+        grown = ARSAL_Allocator_Realloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, validator->edgePolygons, (size_t)capacity * sizeof (int));
+        if (grown == NULL)
+        {
+            return ARMAVLINK_ERROR_ALLOC;
+        }
+        validator->edgePolygons = (int *)grown;
+
+        grown = ARSAL_Allocator_Realloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, validator->edgeStamps, (size_t)capacity * sizeof (unsigned int));
+        if (grown == NULL)
+        {
+            return ARMAVLINK_ERROR_ALLOC;
+        }
+        validator->edgeStamps = (unsigned int *)grown;
+
+        validator->edgeCapacity = capacity;
+    }
+
+    {
+        void *kinds = ARSAL_Allocator_Realloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, validator->polygonKinds, ((size_t)validator->polygonCount + 1) * sizeof (eARMAVLINK_MISSIONVALIDATOR_POLYGON));
+        void *parities = NULL;
+
+        if (kinds == NULL)
+        {
+            return ARMAVLINK_ERROR_ALLOC;
+        }
+        validator->polygonKinds = (eARMAVLINK_MISSIONVALIDATOR_POLYGON *)kinds;
+
+        parities = ARSAL_Allocator_Realloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, validator->polygonParities, (size_t)validator->polygonCount + 1);
+        if (parities == NULL)
+        {
+            return ARMAVLINK_ERROR_ALLOC;
+        }
+        validator->polygonParities = (unsigned char *)parities;
+    }
+
+    for (vertex = 0; vertex < count; vertex++)
+    {
+        int edge = validator->edgeCount + vertex;
+        int next = (vertex + 1 < count) ? vertex + 1 : 0;
+
+        validator->edgeLatitudes0[edge] = latitudes[vertex];
+        validator->edgeLongitudes0[edge] = longitudes[vertex];
+        validator->edgeLatitudes1[edge] = latitudes[next];
+        validator->edgeLongitudes1[edge] = longitudes[next];
+        validator->edgePolygons[edge] = validator->polygonCount;
+        validator->edgeStamps[edge] = 0;
+    }
+
+    validator->edgeCount += count;
+    validator->polygonKinds[validator->polygonCount] = kind;
+    validator->polygonCount++;
+    validator->inclusionCount += (kind == ARMAVLINK_MISSIONVALIDATOR_POLYGON_INCLUSION) ? 1 : 0;
+    validator->built = 0;
+
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief Remove all the fence polygons
+ * @param validator : pointer on the validator
+ */
+static inline void ARMAVLINK_MissionValidator_ClearPolygons (ARMAVLINK_MissionValidator_t *validator)
+{
+    if (validator != NULL)
+    {
+        validator->edgeCount = 0;
+        validator->polygonCount = 0;
+        validator->inclusionCount = 0;
+        validator->built = 0;
+    }
+}
+
+/**
+ * @brief Validate a range of mission items
+ * @note Only the items of the range are checked ; the leg of the first one starts at the previous
+ * positioned item of the mission. After an edit, validating the edited items and the next
+ * positioned one is enough to update the results.
+ * @param validator : pointer on the validator
+ * @param[in] missionItems : the mission items
+ * @param[in] size : the number of mission items
+ * @param[in] first : the index of the first mission item to validate
+ * @param[in] count : the number of mission items to validate
+ * @param[out] results : count results, combinations of eARMAVLINK_MISSIONVALIDATOR_RESULT
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MissionValidator_Validate (ARMAVLINK_MissionValidator_t *validator, const mavlink_mission_item_t *missionItems, int size,
+                                                                    int first, int count, uint32_t *results)
+{
+    const mavlink_mission_item_t *segments[2] = {missionItems, NULL};
+    int counts[2] = {size, 0};
+
+    if ((missionItems == NULL) && (size > 0))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    return ARMAVLINK_MissionValidator_ValidateSegments (validator, segments, counts, first, count, results);
+}
+
+/**
+ * @brief Validate a range of the mission items of a mission item buffer
+ * @param validator : pointer on the validator
+ * @param[in] buffer : pointer on the buffer
+ * @param[in] first : the index of the first mission item to validate
+ * @param[in] count : the number of mission items to validate
+ * @param[out] results : count results, combinations of eARMAVLINK_MISSIONVALIDATOR_RESULT
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ * @see ARMAVLINK_MissionValidator_Validate()
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MissionValidator_ValidateMissionItemBuffer (ARMAVLINK_MissionValidator_t *validator, const ARMAVLINK_MissionItemBuffer_t *buffer,
+                                                                                     int first, int count, uint32_t *results)
+{
+    const mavlink_mission_item_t *segments[2] = {NULL, NULL};
+    int counts[2] = {0, 0};
+
+    if (buffer == NULL)
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    segments[0] = buffer->missionItems;
+    counts[0] = buffer->gapStart;
+    segments[1] = (buffer->missionItems != NULL) ? &buffer->missionItems[buffer->gapEnd] : NULL;
+    counts[1] = buffer->capacity - buffer->gapEnd;
+
+    return ARMAVLINK_MissionValidator_ValidateSegments (validator, segments, counts, first, count, results);
+}
+
+#endif
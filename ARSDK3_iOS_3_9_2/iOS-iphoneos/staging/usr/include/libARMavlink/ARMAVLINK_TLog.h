@@ -0,0 +1,716 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARMAVLINK_TLog.h
+ * @brief Indexed MAVLink telemetry logs
+ * @note A telemetry log (tlog) is a sequence of records made of a big endian timestamp in
+ * microseconds followed by a MAVLink packet. The writer of this module adds an index block
+ * every ARMAVLINK_TLOG_INDEX_PERIOD records, holding the message id, the timestamp and the offset
+ * of each record, and a trailer pointing to the last block when the log is closed. The reader
+ * maps the log, loads the index, and only reads the records a query returns. Logs without
+ * index, written by other tools or not closed, are indexed by walking their records instead.
+ * @date 10/18/2026
+ */
+#ifndef _ARMAVLINK_TLOG_H
+#define _ARMAVLINK_TLOG_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <libARSAL/ARSAL_Allocator.h>
+#include <libARMavlink/ARMAVLINK_Error.h>
+#include <mavlink/parrot/mavlink.h>
+
+/**
+ * @brief Number of records indexed by an index block
+ */
+#define ARMAVLINK_TLOG_INDEX_PERIOD 1024
+
+/**
+ * @brief Magic written instead of a timestamp at the start of an index block
+ */
+#define ARMAVLINK_TLOG_INDEX_MAGIC "ARMVTIDX"
+
+/**
+ * @brief Magic of the trailer of a closed log
+ */
+#define ARMAVLINK_TLOG_TRAILER_MAGIC "ARMVTEND"
+
+/**
+ * @brief Size of the magics and of the record timestamps
+ */
+#define ARMAVLINK_TLOG_MAGIC_SIZE 8
+
+/**
+ * @brief Offset meaning no index block
+ */
+#define ARMAVLINK_TLOG_NO_OFFSET UINT64_MAX
+
+/**
+ * @brief Number of message ids
+ */
+#define ARMAVLINK_TLOG_MSGID_COUNT 256
+
+/**
+ * @brief Index entry of a record
+ */
+typedef struct
+{
+    uint64_t timestamp; /**< Timestamp of the record in microseconds */
+    uint64_t offset; /**< Offset of the record in the log */
+    uint32_t msgid; /**< Message id of the record */
+    uint32_t length; /**< Size of the MAVLink packet of the record */
+} ARMAVLINK_TLog_IndexEntry_t;
+
+/**
+ * @brief Header of an index block, following ARMAVLINK_TLOG_INDEX_MAGIC and followed by the entries
+ */
+typedef struct
+{
+    uint32_t entryCount; /**< Number of entries of the block */
+    uint32_t reserved; /**< Reserved, 0 */
+    uint64_t previousOffset; /**< Offset of the previous index block, ARMAVLINK_TLOG_NO_OFFSET if none */
+} ARMAVLINK_TLog_IndexHeader_t;
+
+/**
+ * @brief Trailer of a closed log, following ARMAVLINK_TLOG_TRAILER_MAGIC
+ */
+typedef struct
+{
+    uint64_t lastOffset; /**< Offset of the last index block, ARMAVLINK_TLOG_NO_OFFSET if none */
+} ARMAVLINK_TLog_Trailer_t;
+
+/**
+ * @brief Telemetry log writer
+ */
+typedef struct
+{
+    FILE *file; /**< The log */
+    uint64_t offset; /**< Offset of the next record */
+    uint64_t lastOffset; /**< Offset of the last index block */
+    int entryCount; /**< Number of records since the last index block */
+    ARMAVLINK_TLog_IndexEntry_t entries[ARMAVLINK_TLOG_INDEX_PERIOD]; /**< Entries of the records since the last index block */
+} ARMAVLINK_TLogWriter_t;
+
+/**
+ * @brief Telemetry log reader
+ */
+typedef struct
+{
+    const uint8_t *data; /**< Mapping of the log */
+    size_t size; /**< Size of the mapping */
+    ARMAVLINK_TLog_IndexEntry_t *entries; /**< Entries of all the records, grouped by message id and sorted by timestamp */
+    int entryCount; /**< Number of records */
+    int msgidStarts[ARMAVLINK_TLOG_MSGID_COUNT + 1]; /**< Index in entries of the first entry of each message id */
+} ARMAVLINK_TLogReader_t;
+
+/**
+ * @brief INTERNAL FUNCTION : Write an index block of the pending entries
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_TLogWriter_WriteIndex (ARMAVLINK_TLogWriter_t *writer)
+{
+    ARMAVLINK_TLog_IndexHeader_t header;
+    size_t entriesSize = (size_t)writer->entryCount * sizeof (ARMAVLINK_TLog_IndexEntry_t);
+
+    if (writer->entryCount == 0)
+    {
+        return ARMAVLINK_OK;
+    }
+
+    memset (&header, 0, sizeof (header));
+    header.entryCount = (uint32_t)writer->entryCount;
+    header.previousOffset = writer->lastOffset;
+
+    if ((fwrite (ARMAVLINK_TLOG_INDEX_MAGIC, ARMAVLINK_TLOG_MAGIC_SIZE, 1, writer->file) != 1) ||
+        (fwrite (&header, sizeof (header), 1, writer->file) != 1) ||
+        (fwrite (writer->entries, entriesSize, 1, writer->file) != 1))
+    {
+        return ARMAVLINK_ERROR_FILE_GENERATOR;
+    }
+
+    writer->lastOffset = writer->offset;
+    writer->offset += ARMAVLINK_TLOG_MAGIC_SIZE + sizeof (header) + entriesSize;
+    writer->entryCount = 0;
+
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief Create a new telemetry log
+ * @warning This function allocates memory
+ * @post ARMAVLINK_TLogWriter_Delete() must be called to close the log and free the memory allocated.
+ * @param[in] filePath : path of the log to create
+ * @param[out] error : pointer on the error output.
+ * @return Pointer on the new writer
+ * @see ARMAVLINK_TLogWriter_Delete()
+ */
+static inline ARMAVLINK_TLogWriter_t *ARMAVLINK_TLogWriter_New (const char *const filePath, eARMAVLINK_ERROR *error)
+{
+    eARMAVLINK_ERROR localError = ARMAVLINK_OK;
+    ARMAVLINK_TLogWriter_t *writer = NULL;
+
+    if (filePath == NULL)
+    {
+        localError = ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+    else if ((writer = (ARMAVLINK_TLogWriter_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, 1, sizeof (ARMAVLINK_TLogWriter_t))) == NULL)
+    {
+        localError = ARMAVLINK_ERROR_ALLOC;
+    }
+    else if ((writer->file = fopen (filePath, "wb")) == NULL)
+    {
+        localError = ARMAVLINK_ERROR_FILE_GENERATOR;
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, writer);
+        writer = NULL;
+    }
+    else
+    {
+        writer->lastOffset = ARMAVLINK_TLOG_NO_OFFSET;
+    }
+
+    if (error != NULL)
+    {
+        *error = localError;
+    }
+
+    return writer;
+}
+
+/**
+ * @brief Close the telemetry log, writing its last index block and its trailer
+ * @warning This function frees memory
+ * @param writer : address of the pointer on the writer
+ * @see ARMAVLINK_TLogWriter_New()
+ */
+static inline void ARMAVLINK_TLogWriter_Delete (ARMAVLINK_TLogWriter_t **writer)
+{
+    if ((writer != NULL) && (*writer != NULL))
+    {
+        ARMAVLINK_TLog_Trailer_t trailer;
+
+        if (ARMAVLINK_TLogWriter_WriteIndex (*writer) == ARMAVLINK_OK)
+        {
+            trailer.lastOffset = (*writer)->lastOffset;
+            fwrite (ARMAVLINK_TLOG_TRAILER_MAGIC, ARMAVLINK_TLOG_MAGIC_SIZE, 1, (*writer)->file);
+            fwrite (&trailer, sizeof (trailer), 1, (*writer)->file);
+        }
+
+        fclose ((*writer)->file);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, *writer);
+        *writer = NULL;
+    }
+}
+
+/**
+ * @brief Append a MAVLink packet to the telemetry log
+ * @param writer : pointer on the writer
+ * @param[in] timestamp : timestamp of the packet in microseconds
+ * @param[in] packet : the packet, as sent on the link
+ * @param[in] length : the size of the packet
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_TLogWriter_WritePacket (ARMAVLINK_TLogWriter_t *writer, uint64_t timestamp, const uint8_t *packet, uint16_t length)
+{
+    uint8_t bigEndian[ARMAVLINK_TLOG_MAGIC_SIZE];
+    ARMAVLINK_TLog_IndexEntry_t *entry = NULL;
+    eARMAVLINK_ERROR error = ARMAVLINK_OK;
+    int byte = 0;
+
+    if ((writer == NULL) || (packet == NULL) || (length < MAVLINK_NUM_NON_PAYLOAD_BYTES) || (packet[0] != MAVLINK_STX) ||
+        (length != packet[1] + MAVLINK_NUM_NON_PAYLOAD_BYTES))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    if (writer->entryCount == ARMAVLINK_TLOG_INDEX_PERIOD)
+    {
+        error = ARMAVLINK_TLogWriter_WriteIndex (writer);
+        if (error != ARMAVLINK_OK)
+        {
+            return error;
+        }
+    }
+
+    for (byte = 0; byte < ARMAVLINK_TLOG_MAGIC_SIZE; byte++)
+    {
+        bigEndian[byte] = (uint8_t)(timestamp >> (56 - (8 * byte)));
+    }
+
+    if ((fwrite (bigEndian, sizeof (bigEndian), 1, writer->file) != 1) || (fwrite (packet, length, 1, writer->file) != 1))
+    {
+        return ARMAVLINK_ERROR_FILE_GENERATOR;
+    }
+
+    entry = &writer->entries[writer->entryCount++];
+    entry->timestamp = timestamp;
+    entry->offset = writer->offset;
+    entry->msgid = packet[5];
+    entry->length = length;
+    writer->offset += sizeof (bigEndian) + length;
+
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief Append a MAVLink message to the telemetry log
+ * @param writer : pointer on the writer
+ * @param[in] timestamp : timestamp of the message in microseconds
+ * @param[in] msg : the finalized message
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_TLogWriter_WriteMessage (ARMAVLINK_TLogWriter_t *writer, uint64_t timestamp, const mavlink_message_t *msg)
+{
+    uint8_t packet[MAVLINK_MAX_PACKET_LEN];
+
+    if (msg == NULL)
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    return ARMAVLINK_TLogWriter_WritePacket (writer, timestamp, packet, mavlink_msg_to_send_buffer (packet, msg));
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Whether an index block starts at offset
+ */
+static inline int ARMAVLINK_TLogReader_IsIndex (const ARMAVLINK_TLogReader_t *reader, uint64_t offset, ARMAVLINK_TLog_IndexHeader_t *header)
+{
+    uint64_t available = reader->size - offset;
+
+    if ((offset > reader->size) || (available < ARMAVLINK_TLOG_MAGIC_SIZE + sizeof (ARMAVLINK_TLog_IndexHeader_t)) ||
+        (memcmp (&reader->data[offset], ARMAVLINK_TLOG_INDEX_MAGIC, ARMAVLINK_TLOG_MAGIC_SIZE) != 0))
+    {
+        return 0;
+    }
+
+    memcpy (header, &reader->data[offset + ARMAVLINK_TLOG_MAGIC_SIZE], sizeof (ARMAVLINK_TLog_IndexHeader_t));
+    available -= ARMAVLINK_TLOG_MAGIC_SIZE + sizeof (ARMAVLINK_TLog_IndexHeader_t);
+
+    return header->entryCount <= available / sizeof (ARMAVLINK_TLog_IndexEntry_t);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Append an entry to the reader, growing its array
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_TLogReader_AddEntry (ARMAVLINK_TLogReader_t *reader, int *capacity, const ARMAVLINK_TLog_IndexEntry_t *entry)
+{
+    if (reader->entryCount == *capacity)
+    {
+        int grown = (*capacity > 0) ? *capacity * 2 : ARMAVLINK_TLOG_INDEX_PERIOD;
+        ARMAVLINK_TLog_IndexEntry_t *entries = NULL;
+
+        if (*capacity > INT_MAX / 2)
+        {
+            return ARMAVLINK_ERROR_ALLOC;
+        }
+
+        entries = (ARMAVLINK_TLog_IndexEntry_t *)ARSAL_Allocator_Realloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, reader->entries, (size_t)grown * sizeof (ARMAVLINK_TLog_IndexEntry_t));
+        if (entries == NULL)
+        {
+            return ARMAVLINK_ERROR_ALLOC;
+        }
+
+        reader->entries = entries;
+        *capacity = grown;
+    }
+
+    reader->entries[reader->entryCount++] = *entry;
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Load the index blocks of a closed log
+ * @return ARMAVLINK_OK if the log has a valid index, ARMAVLINK_ERROR_FILE_PARSER otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_TLogReader_LoadIndex (ARMAVLINK_TLogReader_t *reader)
+{
+    ARMAVLINK_TLog_Trailer_t trailer;
+    ARMAVLINK_TLog_IndexHeader_t header;
+    uint64_t offset = 0;
+    size_t total = 0;
+    int position = 0;
+
+    if ((reader->size < ARMAVLINK_TLOG_MAGIC_SIZE + sizeof (trailer)) ||
+        (memcmp (&reader->data[reader->size - ARMAVLINK_TLOG_MAGIC_SIZE - sizeof (trailer)], ARMAVLINK_TLOG_TRAILER_MAGIC, ARMAVLINK_TLOG_MAGIC_SIZE) != 0))
+    {
+        return ARMAVLINK_ERROR_FILE_PARSER;
+    }
+
+    memcpy (&trailer, &reader->data[reader->size - sizeof (trailer)], sizeof (trailer));
+
+    /* the blocks are chained from the last one : count the entries first, the offsets decrease at each step */
+    for (offset = trailer.lastOffset; offset != ARMAVLINK_TLOG_NO_OFFSET; offset = header.previousOffset)
+    {
+        if (!ARMAVLINK_TLogReader_IsIndex (reader, offset, &header) || ((header.previousOffset != ARMAVLINK_TLOG_NO_OFFSET) && (header.previousOffset >= offset)) ||
+            (header.entryCount > (size_t)INT_MAX - total))
+        {
+            return ARMAVLINK_ERROR_FILE_PARSER;
+        }
+        total += header.entryCount;
+    }
+
+    reader->entries = (ARMAVLINK_TLog_IndexEntry_t *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (total + 1) * sizeof (ARMAVLINK_TLog_IndexEntry_t));
+    if (reader->entries == NULL)
+    {
+        return ARMAVLINK_ERROR_ALLOC;
+    }
+
+    position = (int)total;
+    for (offset = trailer.lastOffset; offset != ARMAVLINK_TLOG_NO_OFFSET; offset = header.previousOffset)
+    {
+        ARMAVLINK_TLogReader_IsIndex (reader, offset, &header);
+        position -= (int)header.entryCount;
+        memcpy (&reader->entries[position], &reader->data[offset + ARMAVLINK_TLOG_MAGIC_SIZE + sizeof (header)], header.entryCount * sizeof (ARMAVLINK_TLog_IndexEntry_t));
+    }
+
+    reader->entryCount = (int)total;
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Index a log by walking its records, up to the first truncated or invalid one
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_TLogReader_ScanRecords (ARMAVLINK_TLogReader_t *reader)
+{
+    ARMAVLINK_TLog_IndexHeader_t header;
+    uint64_t offset = 0;
+    int capacity = 0;
+
+    ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, reader->entries);
+    reader->entries = NULL;
+    reader->entryCount = 0;
+
+    while (offset + ARMAVLINK_TLOG_MAGIC_SIZE + MAVLINK_NUM_NON_PAYLOAD_BYTES <= reader->size)
+    {
+        const uint8_t *record = &reader->data[offset];
+        ARMAVLINK_TLog_IndexEntry_t entry;
+        eARMAVLINK_ERROR error = ARMAVLINK_OK;
+        int byte = 0;
+
+        if (ARMAVLINK_TLogReader_IsIndex (reader, offset, &header))
+        {
+            offset += ARMAVLINK_TLOG_MAGIC_SIZE + sizeof (header) + ((uint64_t)header.entryCount * sizeof (ARMAVLINK_TLog_IndexEntry_t));
+            continue;
+        }
+
+        if (record[ARMAVLINK_TLOG_MAGIC_SIZE] != MAVLINK_STX)
+        {
+            break;
+        }
+
+        entry.timestamp = 0;
+        for (byte = 0; byte < ARMAVLINK_TLOG_MAGIC_SIZE; byte++)
+        {
+            entry.timestamp = (entry.timestamp << 8) | record[byte];
+        }
+        entry.offset = offset;
+        entry.msgid = record[ARMAVLINK_TLOG_MAGIC_SIZE + 5];
+        entry.length = (uint32_t)record[ARMAVLINK_TLOG_MAGIC_SIZE + 1] + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+
+        if (offset + ARMAVLINK_TLOG_MAGIC_SIZE + entry.length > reader->size)
+        {
+            break;
+        }
+
+        error = ARMAVLINK_TLogReader_AddEntry (reader, &capacity, &entry);
+        if (error != ARMAVLINK_OK)
+        {
+            return error;
+        }
+
+        offset += ARMAVLINK_TLOG_MAGIC_SIZE + entry.length;
+    }
+
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Order two entries by timestamp, then by offset
+ */
+static inline int ARMAVLINK_TLogReader_CompareEntries (const void *a, const void *b)
+{
+    const ARMAVLINK_TLog_IndexEntry_t *entryA = (const ARMAVLINK_TLog_IndexEntry_t *)a;
+    const ARMAVLINK_TLog_IndexEntry_t *entryB = (const ARMAVLINK_TLog_IndexEntry_t *)b;
+
+    if (entryA->timestamp != entryB->timestamp)
+    {
+        return (entryA->timestamp < entryB->timestamp) ? -1 : 1;
+    }
+    return (entryA->offset < entryB->offset) ? -1 : (entryA->offset > entryB->offset);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Group the entries by message id, each group sorted by timestamp
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_TLogReader_SortEntries (ARMAVLINK_TLogReader_t *reader)
+{
+    ARMAVLINK_TLog_IndexEntry_t *sorted = (ARMAVLINK_TLog_IndexEntry_t *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, ((size_t)reader->entryCount + 1) * sizeof (ARMAVLINK_TLog_IndexEntry_t));
+    int positions[ARMAVLINK_TLOG_MSGID_COUNT];
+    int index = 0;
+    int msgid = 0;
+
+    if (sorted == NULL)
+    {
+        return ARMAVLINK_ERROR_ALLOC;
+    }
+
+    /* counting sort on the message id keeps the log order inside each group */
+    memset (reader->msgidStarts, 0, sizeof (reader->msgidStarts));
+    for (index = 0; index < reader->entryCount; index++)
+    {
+        reader->msgidStarts[(reader->entries[index].msgid & (ARMAVLINK_TLOG_MSGID_COUNT - 1)) + 1]++;
+    }
+    for (msgid = 0; msgid < ARMAVLINK_TLOG_MSGID_COUNT; msgid++)
+    {
+        reader->msgidStarts[msgid + 1] += reader->msgidStarts[msgid];
+        positions[msgid] = reader->msgidStarts[msgid];
+    }
+    for (index = 0; index < reader->entryCount; index++)
+    {
+        sorted[positions[reader->entries[index].msgid & (ARMAVLINK_TLOG_MSGID_COUNT - 1)]++] = reader->entries[index];
+    }
+
+    ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, reader->entries);
+    reader->entries = sorted;
+
+    /* logs are written in time order, a group is only sorted if the clock went back */
+    for (msgid = 0; msgid < ARMAVLINK_TLOG_MSGID_COUNT; msgid++)
+    {
+        for (index = reader->msgidStarts[msgid] + 1; index < reader->msgidStarts[msgid + 1]; index++)
+        {
+            if (reader->entries[index].timestamp < reader->entries[index - 1].timestamp)
+            {
+                qsort (&reader->entries[reader->msgidStarts[msgid]], (size_t)(reader->msgidStarts[msgid + 1] - reader->msgidStarts[msgid]),
+                       sizeof (ARMAVLINK_TLog_IndexEntry_t), ARMAVLINK_TLogReader_CompareEntries);
+                break;
+            }
+        }
+    }
+
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief Open a telemetry log
+ * @warning This function allocates memory and maps the log
+ * @post ARMAVLINK_TLogReader_Delete() must be called to unmap the log and free the memory allocated.
+ * @param[in] filePath : path of the log to open
+ * @param[out] error : pointer on the error output.
+ * @return Pointer on the new reader
+ * @see ARMAVLINK_TLogReader_Delete()
+ */
+static inline ARMAVLINK_TLogReader_t *ARMAVLINK_TLogReader_New (const char *const filePath, eARMAVLINK_ERROR *error)
+{
+    eARMAVLINK_ERROR localError = ARMAVLINK_OK;
+    ARMAVLINK_TLogReader_t *reader = NULL;
+    struct stat status;
+    int fd = -1;
+
+    if (filePath == NULL)
+    {
+        localError = ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+    else if ((fd = open (filePath, O_RDONLY)) < 0)
+    {
+        localError = ARMAVLINK_ERROR_FILE_PARSER_FILE_NOT_FOUND;
+    }
+    else if ((fstat (fd, &status) != 0) || (status.st_size < 0) || ((off_t)(size_t)status.st_size != status.st_size))
+    {
+        localError = ARMAVLINK_ERROR_FILE_PARSER;
+    }
+    else if ((reader = (ARMAVLINK_TLogReader_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, 1, sizeof (ARMAVLINK_TLogReader_t))) == NULL)
+    {
+        localError = ARMAVLINK_ERROR_ALLOC;
+    }
+    else
+    {
+        reader->size = (size_t)status.st_size;
+
+        if (reader->size > 0)
+        {
+            void *mapping = mmap (NULL, reader->size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                localError = ARMAVLINK_ERROR_FILE_PARSER;
+                reader->size = 0;
+            }
+            else
+            {
+                reader->data = (const uint8_t *)mapping;
+            }
+        }
+
+        if ((localError == ARMAVLINK_OK) && (ARMAVLINK_TLogReader_LoadIndex (reader) != ARMAVLINK_OK))
+        {
+            localError = ARMAVLINK_TLogReader_ScanRecords (reader);
+        }
+
+        if (localError == ARMAVLINK_OK)
+        {
+            localError = ARMAVLINK_TLogReader_SortEntries (reader);
+        }
+
+        if (localError != ARMAVLINK_OK)
+        {
+            if (reader->data != NULL)
+            {
+                munmap ((void *)reader->data, reader->size);
+            }
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, reader->entries);
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, reader);
+            reader = NULL;
+        }
+    }
+
+    if (fd >= 0)
+    {
+        close (fd);
+    }
+
+    if (error != NULL)
+    {
+        *error = localError;
+    }
+
+    return reader;
+}
+
+/**
+ * @brief Close the telemetry log
+ * @warning This function frees memory ; the entries returned by the queries must not be used anymore
+ * @param reader : address of the pointer on the reader
+ * @see ARMAVLINK_TLogReader_New()
+ */
+static inline void ARMAVLINK_TLogReader_Delete (ARMAVLINK_TLogReader_t **reader)
+{
+    if ((reader != NULL) && (*reader != NULL))
+    {
+        if ((*reader)->data != NULL)
+        {
+            munmap ((void *)(*reader)->data, (*reader)->size);
+        }
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (*reader)->entries);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, *reader);
+        *reader = NULL;
+    }
+}
+
+/**
+ * @brief Get the number of records of the telemetry log
+ * @param reader : pointer on the reader
+ * @return the number of records
+ */
+static inline int ARMAVLINK_TLogReader_GetCount (const ARMAVLINK_TLogReader_t *reader)
+{
+    return (reader != NULL) ? reader->entryCount : 0;
+}
+
+/**
+ * @brief Find the records of a message id in a time range
+ * @note The index is searched by dichotomy ; no record is read.
+ * @param reader : pointer on the reader
+ * @param[in] msgid : the message id
+ * @param[in] start : the first timestamp of the range in microseconds
+ * @param[in] end : the timestamp following the range in microseconds
+ * @param[out] entries : the entries of the records, sorted by timestamp
+ * @return the number of entries
+ */
+static inline int ARMAVLINK_TLogReader_Query (const ARMAVLINK_TLogReader_t *reader, uint8_t msgid, uint64_t start, uint64_t end, const ARMAVLINK_TLog_IndexEntry_t **entries)
+{
+    int bounds[2] = {0, 0};
+    uint64_t timestamps[2] = {start, end};
+    int bound = 0;
+
+    if ((reader == NULL) || (entries == NULL))
+    {
+        return 0;
+    }
+
+    for (bound = 0; bound < 2; bound++)
+    {
+        int low = reader->msgidStarts[msgid];
+        int high = reader->msgidStarts[msgid + 1];
+
+        while (low < high)
+        {
+            int middle = low + ((high - low) / 2);
+            if (reader->entries[middle].timestamp < timestamps[bound])
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        bounds[bound] = low;
+    }
+
+    *entries = &reader->entries[bounds[0]];
+    return (bounds[1] > bounds[0]) ? bounds[1] - bounds[0] : 0;
+}
+
+/**
+ * @brief Decode the MAVLink message of a record
+ * @note The message is then decoded with the generated mavlink_msg_*_decode() functions.
+ * @param reader : pointer on the reader
+ * @param[in] entry : the entry of the record, returned by a query
+ * @param[out] msg : the message
+ * @return ARMAVLINK_OK if the record holds a valid message, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_TLogReader_Decode (const ARMAVLINK_TLogReader_t *reader, const ARMAVLINK_TLog_IndexEntry_t *entry, mavlink_message_t *msg)
+{
+    mavlink_parser_t parser;
+    mavlink_status_t status;
+    size_t consumed = 0;
+
+    if ((reader == NULL) || (entry == NULL) || (msg == NULL) || (entry->offset > reader->size) ||
+        (reader->size - entry->offset < ARMAVLINK_TLOG_MAGIC_SIZE) || (entry->length > reader->size - entry->offset - ARMAVLINK_TLOG_MAGIC_SIZE))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    mavlink_parser_init (&parser);
+    if (mavlink_parse_buffer (&parser, &reader->data[entry->offset + ARMAVLINK_TLOG_MAGIC_SIZE], entry->length, &consumed, msg, &status) != 1)
+    {
+        return ARMAVLINK_ERROR_FILE_PARSER;
+    }
+
+    return ARMAVLINK_OK;
+}
+
+#endif
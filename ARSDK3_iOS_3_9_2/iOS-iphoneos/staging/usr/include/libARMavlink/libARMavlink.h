@@ -42,7 +42,12 @@
 #include <libARMavlink/ARMAVLINK_Manager.h>
 #include <libARMavlink/ARMAVLINK_FileGenerator.h>
 #include <libARMavlink/ARMAVLINK_FileParser.h>
+#include <libARMavlink/ARMAVLINK_MappedFileParser.h>
+#include <libARMavlink/ARMAVLINK_BinaryMission.h>
+#include <libARMavlink/ARMAVLINK_MissionValidator.h>
+#include <libARMavlink/ARMAVLINK_TLog.h>
 #include <libARMavlink/ARMAVLINK_ListUtils.h>
+#include <libARMavlink/ARMAVLINK_MissionItemBuffer.h>
 #include <libARMavlink/ARMAVLINK_MissionItemUtils.h>
 #include <mavlink/parrot/mavlink.h>
 #endif // _ARMAVLINK_H_
@@ -57,6 +57,32 @@
  */
 #define ARNETWORK_IOBUFFERPARAM_DATACOPYMAXSIZE_USE_MAX -1
 
+/**
+ * @brief Minimum identifier of an IOBuffer
+ */
+#define ARNETWORK_IOBUFFERPARAM_ID_MIN 10
+
+/**
+ * @brief Maximum identifier of an IOBuffer
+ */
+#define ARNETWORK_IOBUFFERPARAM_ID_MAX 127
+
+/**
+ * @brief Constant expression checking the values of an IOBufferParam
+ * @note Mirror of ARNETWORK_IOBufferParam_Check() usable at build time, e.g. in a static assertion on a constant configuration.
+ * @return 1 if the values are usable for create a new ioBuffer else 0
+ */
+#define ARNETWORK_IOBUFFERPARAM_IS_VALID(ID, dataType, sendingWaitTimeMs, ackTimeoutMs, numberOfRetry, numberOfCell, dataCopyMaxSize, isOverwriting) \
+    (((ID) >= ARNETWORK_IOBUFFERPARAM_ID_MIN) && ((ID) <= ARNETWORK_IOBUFFERPARAM_ID_MAX) &&                                 \
+     ((dataType) > ARNETWORKAL_FRAME_TYPE_ACK) && ((dataType) < ARNETWORKAL_FRAME_TYPE_MAX) &&                               \
+     ((sendingWaitTimeMs) >= 0) &&                                                                                           \
+     (((dataType) != ARNETWORKAL_FRAME_TYPE_DATA_WITH_ACK) ||                                                                \
+      ((((ackTimeoutMs) > 0) || ((ackTimeoutMs) == ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER)) &&                              \
+       (((numberOfRetry) > 0) || ((numberOfRetry) == ARNETWORK_IOBUFFERPARAM_INFINITE_NUMBER)))) &&                          \
+     ((numberOfCell) > 0) &&                                                                                                 \
+     (((dataCopyMaxSize) > 0) || ((dataCopyMaxSize) == ARNETWORK_IOBUFFERPARAM_DATACOPYMAXSIZE_USE_MAX)) &&                  \
+     (((isOverwriting) == 0) || ((isOverwriting) == 1)))
+
 /*****************************************
  *
  *             IOBufferParam header:
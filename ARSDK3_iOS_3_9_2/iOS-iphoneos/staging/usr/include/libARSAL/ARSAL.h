@@ -37,13 +37,20 @@
 #ifndef _ARSAL_H_
 #define _ARSAL_H_
 
+#include <libARSAL/ARSAL_Allocator.h>
 #include <libARSAL/ARSAL_Endianness.h>
+#include <libARSAL/ARSAL_EventSem.h>
+#include <libARSAL/ARSAL_Executor.h>
+#include <libARSAL/ARSAL_FastMutex.h>
 #include <libARSAL/ARSAL_Ftw.h>
 #include <libARSAL/ARSAL_Mutex.h>
 #include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_PrintAsync.h>
 #include <libARSAL/ARSAL_Sem.h>
 #include <libARSAL/ARSAL_Socket.h>
+#include <libARSAL/ARSAL_SocketBatch.h>
 #include <libARSAL/ARSAL_Thread.h>
 #include <libARSAL/ARSAL_Time.h>
+#include <libARSAL/ARSAL_Trace.h>
 
 #endif /* _ARSAL_H_ */
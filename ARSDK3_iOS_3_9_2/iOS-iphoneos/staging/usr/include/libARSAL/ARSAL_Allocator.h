@@ -0,0 +1,402 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file libARSAL/ARSAL_Allocator.h
+ * @brief Allocator interface with per-subsystem accounting
+ * @note The libraries allocate through ARSAL_Allocator_Malloc() and the others with their subsystem,
+ * which counts the allocations and bytes of each subsystem and lets the application give a subsystem
+ * its own allocator : a pool, an arena, jemalloc... ARSAL_Allocator_Sample() turns the counters into
+ * allocations and bytes per second, to find the allocation hot spots.
+ * Build with ARSAL_ALLOCATOR_NO_STATS to remove the counters.
+ * @date 10/18/2026
+ */
+#ifndef _ARSAL_ALLOCATOR_H_
+#define _ARSAL_ALLOCATOR_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <libARSAL/ARSAL_Error.h>
+#include <libARSAL/ARSAL_Time.h>
+
+/**
+ * @brief Subsystem of an allocation
+ */
+typedef enum
+{
+    ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL = 0, /**< libARSAL */
+    ARSAL_ALLOCATOR_SUBSYSTEM_ARNETWORKAL, /**< libARNetworkAL */
+    ARSAL_ALLOCATOR_SUBSYSTEM_ARNETWORK, /**< libARNetwork */
+    ARSAL_ALLOCATOR_SUBSYSTEM_ARCOMMANDS, /**< libARCommands */
+    ARSAL_ALLOCATOR_SUBSYSTEM_ARDISCOVERY, /**< libARDiscovery */
+    ARSAL_ALLOCATOR_SUBSYSTEM_ARSTREAM, /**< libARStream and libARStream2 */
+    ARSAL_ALLOCATOR_SUBSYSTEM_ARDATATRANSFER, /**< libARDataTransfer and libARUtils */
+    ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, /**< libARMavlink */
+    ARSAL_ALLOCATOR_SUBSYSTEM_ARMEDIA, /**< libARMedia */
+    ARSAL_ALLOCATOR_SUBSYSTEM_ARCONTROLLER, /**< libARController */
+    ARSAL_ALLOCATOR_SUBSYSTEM_JSON, /**< json-c objects and buffers */
+    ARSAL_ALLOCATOR_SUBSYSTEM_APPLICATION, /**< Free for the application */
+    ARSAL_ALLOCATOR_SUBSYSTEM_MAX, /**< Number of subsystems */
+} eARSAL_ALLOCATOR_SUBSYSTEM;
+
+/**
+ * @brief Allocator of a subsystem
+ * @note reallocate gets NULL to allocate and never a size of 0 ; release never gets NULL.
+ */
+typedef struct
+{
+    void *(*allocate) (void *context, size_t size); /**< Allocate size bytes, aligned for any type */
+    void *(*reallocate) (void *context, void *ptr, size_t size); /**< Resize an allocation, keeping its content */
+    void (*release) (void *context, void *ptr); /**< Free an allocation */
+    void *context; /**< Context of the functions */
+} ARSAL_Allocator_t;
+
+/**
+ * @brief Counters of a subsystem
+ */
+typedef struct
+{
+    uint64_t allocations; /**< Number of allocations */
+    uint64_t reallocations; /**< Number of reallocations of an existing allocation */
+    uint64_t frees; /**< Number of frees */
+    uint64_t bytes; /**< Number of bytes requested by the allocations and reallocations */
+    uint64_t failures; /**< Number of allocations and reallocations which failed */
+} ARSAL_Allocator_Stats_t;
+
+/**
+ * @brief INTERNAL : allocator and counters of a subsystem, on its own cache line
+ */
+typedef struct
+{
+    ARSAL_Allocator_Stats_t stats; /**< Counters */
+    ARSAL_Allocator_t allocator; /**< Allocator, all NULL for malloc */
+} __attribute__ ((aligned (64))) ARSAL_Allocator_Subsystem_t;
+
+/**
+ * @brief Subsystems, shared by all the compilation units
+ */
+__attribute__((weak)) ARSAL_Allocator_Subsystem_t ARSAL_Allocator_Subsystems[ARSAL_ALLOCATOR_SUBSYSTEM_MAX];
+
+/**
+ * @brief INTERNAL : add to a counter of a subsystem
+ */
+#ifndef ARSAL_ALLOCATOR_NO_STATS
+#define ARSAL_ALLOCATOR_COUNT(subsystem, counter, value) __atomic_add_fetch (&ARSAL_Allocator_Subsystems[subsystem].stats.counter, (value), __ATOMIC_RELAXED)
+#else
+#define ARSAL_ALLOCATOR_COUNT(subsystem, counter, value) do { } while (0)
+#endif
+
+/**
+ * @brief Get the name of a subsystem
+ * @param subsystem The subsystem
+ * @return A static string
+ */
+static inline const char *ARSAL_Allocator_GetSubsystemName (eARSAL_ALLOCATOR_SUBSYSTEM subsystem)
+{
+    static const char *names[ARSAL_ALLOCATOR_SUBSYSTEM_MAX] = {
+        "ARSAL", "ARNetworkAL", "ARNetwork", "ARCommands", "ARDiscovery", "ARStream",
+        "ARDataTransfer", "ARMavlink", "ARMedia", "ARController", "json", "Application",
+    };
+
+    return ((unsigned)subsystem < ARSAL_ALLOCATOR_SUBSYSTEM_MAX) ? names[subsystem] : "Unknown";
+}
+
+/**
+ * @brief Set the allocator of a subsystem
+ * @warning The memory of a subsystem must be freed by the allocator which allocated it : set the
+ * allocators at init, before the subsystem allocates.
+ * @param subsystem The subsystem
+ * @param allocator The allocator, copied ; NULL for malloc
+ * @retval On success, returns ARSAL_OK. Otherwise, it returns an error number of eARSAL_ERROR :
+ * ARSAL_ERROR if the subsystem has live allocations.
+ */
+static inline eARSAL_ERROR ARSAL_Allocator_Set (eARSAL_ALLOCATOR_SUBSYSTEM subsystem, const ARSAL_Allocator_t *allocator)
+{
+    ARSAL_Allocator_Subsystem_t *entry = NULL;
+
+    if (((unsigned)subsystem >= ARSAL_ALLOCATOR_SUBSYSTEM_MAX) ||
+        ((allocator != NULL) && ((allocator->allocate == NULL) || (allocator->reallocate == NULL) || (allocator->release == NULL))))
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    entry = &ARSAL_Allocator_Subsystems[subsystem];
+
+#ifndef ARSAL_ALLOCATOR_NO_STATS
+    if (__atomic_load_n (&entry->stats.allocations, __ATOMIC_ACQUIRE) != __atomic_load_n (&entry->stats.frees, __ATOMIC_ACQUIRE))
+    {
+        return ARSAL_ERROR;
+    }
+#endif
+
+    if (allocator != NULL)
+    {
+        entry->allocator.reallocate = allocator->reallocate;
+        entry->allocator.release = allocator->release;
+        entry->allocator.context = allocator->context;
+        /* allocate last : it tells the allocating threads that the allocator is complete */
+        __atomic_store_n (&entry->allocator.allocate, allocator->allocate, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        __atomic_store_n (&entry->allocator.allocate, NULL, __ATOMIC_RELEASE);
+    }
+
+    return ARSAL_OK;
+}
+
+/**
+ * @brief Allocate memory for a subsystem
+ * @param subsystem The subsystem
+ * @param size The size to allocate
+ * @return The memory, or NULL
+ */
+static inline void *ARSAL_Allocator_Malloc (eARSAL_ALLOCATOR_SUBSYSTEM subsystem, size_t size)
+{
+    ARSAL_Allocator_Subsystem_t *entry = &ARSAL_Allocator_Subsystems[subsystem];
+    void *(*allocate) (void *, size_t) = __atomic_load_n (&entry->allocator.allocate, __ATOMIC_ACQUIRE);
+    void *ptr = (allocate != NULL) ? allocate (entry->allocator.context, (size > 0) ? size : 1) : malloc (size);
+
+    if (ptr != NULL)
+    {
+        ARSAL_ALLOCATOR_COUNT (subsystem, allocations, 1);
+        ARSAL_ALLOCATOR_COUNT (subsystem, bytes, size);
+    }
+    else
+    {
+        ARSAL_ALLOCATOR_COUNT (subsystem, failures, 1);
+    }
+
+    return ptr;
+}
+
+/**
+ * @brief Allocate zeroed memory for a subsystem
+ * @param subsystem The subsystem
+ * @param count The number of elements
+ * @param size The size of an element
+ * @return The memory, or NULL
+ */
+static inline void *ARSAL_Allocator_Calloc (eARSAL_ALLOCATOR_SUBSYSTEM subsystem, size_t count, size_t size)
+{
+    ARSAL_Allocator_Subsystem_t *entry = &ARSAL_Allocator_Subsystems[subsystem];
+    void *ptr = NULL;
+
+    if ((size != 0) && (count > SIZE_MAX / size))
+    {
+        ARSAL_ALLOCATOR_COUNT (subsystem, failures, 1);
+        return NULL;
+    }
+
+    if (__atomic_load_n (&entry->allocator.allocate, __ATOMIC_ACQUIRE) != NULL)
+    {
+        ptr = ARSAL_Allocator_Malloc (subsystem, count * size);
+        if (ptr != NULL)
+        {
+            memset (ptr, 0, count * size);
+        }
+        return ptr;
+    }
+
+    ptr = calloc (count, size);
+    if (ptr != NULL)
+    {
+        ARSAL_ALLOCATOR_COUNT (subsystem, allocations, 1);
+        ARSAL_ALLOCATOR_COUNT (subsystem, bytes, count * size);
+    }
+    else
+    {
+        ARSAL_ALLOCATOR_COUNT (subsystem, failures, 1);
+    }
+
+    return ptr;
+}
+
+/**
+ * @brief Free memory of a subsystem
+ * @param subsystem The subsystem which allocated ptr
+ * @param ptr The memory, or NULL
+ */
+static inline void ARSAL_Allocator_Free (eARSAL_ALLOCATOR_SUBSYSTEM subsystem, void *ptr)
+{
+    ARSAL_Allocator_Subsystem_t *entry = &ARSAL_Allocator_Subsystems[subsystem];
+
+    if (ptr == NULL)
+    {
+        return;
+    }
+
+    ARSAL_ALLOCATOR_COUNT (subsystem, frees, 1);
+    if (__atomic_load_n (&entry->allocator.allocate, __ATOMIC_ACQUIRE) != NULL)
+    {
+        entry->allocator.release (entry->allocator.context, ptr);
+    }
+    else
+    {
+        free (ptr);
+    }
+}
+
+/**
+ * @brief Resize memory of a subsystem, like realloc()
+ * @param subsystem The subsystem which allocated ptr
+ * @param ptr The memory, or NULL to allocate
+ * @param size The new size ; 0 frees ptr and returns NULL
+ * @return The resized memory, or NULL if it could not be resized and ptr is unchanged
+ */
+static inline void *ARSAL_Allocator_Realloc (eARSAL_ALLOCATOR_SUBSYSTEM subsystem, void *ptr, size_t size)
+{
+    ARSAL_Allocator_Subsystem_t *entry = &ARSAL_Allocator_Subsystems[subsystem];
+    void *resized = NULL;
+
+    if (ptr == NULL)
+    {
+        return ARSAL_Allocator_Malloc (subsystem, size);
+    }
+    if (size == 0)
+    {
+        ARSAL_Allocator_Free (subsystem, ptr);
+        return NULL;
+    }
+
+    if (__atomic_load_n (&entry->allocator.allocate, __ATOMIC_ACQUIRE) != NULL)
+    {
+        resized = entry->allocator.reallocate (entry->allocator.context, ptr, size);
+    }
+    else
+    {
+        resized = realloc (ptr, size);
+    }
+
+    if (resized != NULL)
+    {
+        ARSAL_ALLOCATOR_COUNT (subsystem, reallocations, 1);
+        ARSAL_ALLOCATOR_COUNT (subsystem, bytes, size);
+    }
+    else
+    {
+        ARSAL_ALLOCATOR_COUNT (subsystem, failures, 1);
+    }
+
+    return resized;
+}
+
+/**
+ * @brief Get the counters of a subsystem since the start of the process
+ * @param subsystem The subsystem
+ * @param[out] stats The counters ; all 0 when built with ARSAL_ALLOCATOR_NO_STATS
+ * @retval On success, returns ARSAL_OK. Otherwise, it returns an error number of eARSAL_ERROR
+ */
+static inline eARSAL_ERROR ARSAL_Allocator_GetStats (eARSAL_ALLOCATOR_SUBSYSTEM subsystem, ARSAL_Allocator_Stats_t *stats)
+{
+    ARSAL_Allocator_Stats_t *counters = NULL;
+
+    if (((unsigned)subsystem >= ARSAL_ALLOCATOR_SUBSYSTEM_MAX) || (stats == NULL))
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    counters = &ARSAL_Allocator_Subsystems[subsystem].stats;
+    stats->allocations = __atomic_load_n (&counters->allocations, __ATOMIC_RELAXED);
+    stats->reallocations = __atomic_load_n (&counters->reallocations, __ATOMIC_RELAXED);
+    stats->frees = __atomic_load_n (&counters->frees, __ATOMIC_RELAXED);
+    stats->bytes = __atomic_load_n (&counters->bytes, __ATOMIC_RELAXED);
+    stats->failures = __atomic_load_n (&counters->failures, __ATOMIC_RELAXED);
+
+    return ARSAL_OK;
+}
+
+/**
+ * @brief Rates of a subsystem between two samples
+ */
+typedef struct
+{
+    double allocationsPerSecond; /**< Allocations and reallocations per second */
+    double bytesPerSecond; /**< Bytes requested per second */
+    double freesPerSecond; /**< Frees per second */
+    int64_t live; /**< Allocations not freed yet */
+} ARSAL_Allocator_Rates_t;
+
+/**
+ * @brief Counters of every subsystem at the previous sample
+ */
+typedef struct
+{
+    uint64_t time; /**< Monotonic time of the previous sample, in nanoseconds */
+    ARSAL_Allocator_Stats_t stats[ARSAL_ALLOCATOR_SUBSYSTEM_MAX]; /**< Counters at the previous sample */
+} ARSAL_Allocator_Sampler_t;
+
+/**
+ * @brief Take a sample, and compute the rates of every subsystem since the previous one
+ * @note The first sample of a zeroed sampler only records the counters : its rates are 0.
+ * @param sampler The sampler, zeroed before the first sample
+ * @param[out] rates The rates of each subsystem, ARSAL_ALLOCATOR_SUBSYSTEM_MAX entries
+ * @retval On success, returns ARSAL_OK. Otherwise, it returns an error number of eARSAL_ERROR
+ */
+static inline eARSAL_ERROR ARSAL_Allocator_Sample (ARSAL_Allocator_Sampler_t *sampler, ARSAL_Allocator_Rates_t *rates)
+{
+    uint64_t now = ARSAL_Time_GetMonotonicNs ();
+    double seconds = 0;
+    int subsystem = 0;
+
+    if ((sampler == NULL) || (rates == NULL))
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    /* the first sample only records the counters */
+    seconds = ((sampler->time != 0) && (now > sampler->time)) ? (double)(now - sampler->time) / 1e9 : 0;
+
+    for (subsystem = 0; subsystem < ARSAL_ALLOCATOR_SUBSYSTEM_MAX; subsystem++)
+    {
+        ARSAL_Allocator_Stats_t stats;
+        ARSAL_Allocator_Stats_t *previous = &sampler->stats[subsystem];
+
+        ARSAL_Allocator_GetStats ((eARSAL_ALLOCATOR_SUBSYSTEM)subsystem, &stats);
+        rates[subsystem].allocationsPerSecond = 0;
+        rates[subsystem].bytesPerSecond = 0;
+        rates[subsystem].freesPerSecond = 0;
+        if (seconds > 0)
+        {
+            rates[subsystem].allocationsPerSecond = (double)((stats.allocations + stats.reallocations) - (previous->allocations + previous->reallocations)) / seconds;
+            rates[subsystem].bytesPerSecond = (double)(stats.bytes - previous->bytes) / seconds;
+            rates[subsystem].freesPerSecond = (double)(stats.frees - previous->frees) / seconds;
+        }
+        rates[subsystem].live = (int64_t)(stats.allocations - stats.frees);
+        *previous = stats;
+    }
+
+    sampler->time = now;
+
+    return ARSAL_OK;
+}
+
+#endif /* _ARSAL_ALLOCATOR_H_ */
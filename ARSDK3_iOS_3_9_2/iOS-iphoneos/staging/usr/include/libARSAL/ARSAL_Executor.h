@@ -0,0 +1,1090 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file libARSAL/ARSAL_Executor.h
+ * @brief Shared executor running the background work of the SDK on a fixed set of workers
+ * @note Each worker owns a work-stealing deque : tasks submitted by a worker are pushed on its own
+ * deque, idle workers steal from the others. Tasks submitted by other threads go through a shared
+ * queue. Timers are kept in a heap checked by the workers before they sleep, and blocking calls are
+ * offloaded to a small pool of threads created on demand, which exit when idle.
+ * @date 10/18/2026
+ */
+#ifndef _ARSAL_EXECUTOR_H_
+#define _ARSAL_EXECUTOR_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <libARSAL/ARSAL_Error.h>
+#include <libARSAL/ARSAL_Allocator.h>
+#include <libARSAL/ARSAL_Mutex.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include <libARSAL/ARSAL_Trace.h>
+#include <libARSAL/ARSAL_Time.h>
+
+/**
+ * @brief Initial number of tasks of a worker deque ; must be a power of two
+ */
+#define ARSAL_EXECUTOR_DEQUE_SIZE 256
+
+/**
+ * @brief Maximum number of workers
+ */
+#define ARSAL_EXECUTOR_MAX_WORKERS 64
+
+/**
+ * @brief Maximum number of threads running blocking tasks
+ */
+#define ARSAL_EXECUTOR_MAX_BLOCKING_THREADS 16
+
+/**
+ * @brief Time after which an idle blocking thread exits, in milliseconds
+ */
+#define ARSAL_EXECUTOR_BLOCKING_IDLE_MS 5000
+
+/**
+ * @brief Function of a task
+ */
+typedef void (*ARSAL_Executor_Function_t) (void *arg);
+
+/**
+ * @brief Task of the executor
+ */
+typedef struct ARSAL_Executor_Task_t
+{
+    ARSAL_Executor_Function_t function; /**< Function of the task */
+    void *arg; /**< Argument of the function */
+    struct ARSAL_Executor_Task_t *next; /**< Next task in the shared queues */
+    uint64_t flowId; /**< Flow from the submission to the run in the trace, 0 when not traced */
+} ARSAL_Executor_Task_t;
+
+/**
+ * @brief Array of a worker deque
+ */
+typedef struct ARSAL_Executor_DequeArray_t
+{
+    int64_t size; /**< Number of tasks of the array, a power of two */
+    ARSAL_Executor_Task_t **tasks; /**< Tasks of the array */
+    struct ARSAL_Executor_DequeArray_t *previous; /**< Smaller array replaced by this one, freed with the executor as thieves may still read it */
+} ARSAL_Executor_DequeArray_t;
+
+/**
+ * @brief Timer of the executor
+ */
+typedef struct
+{
+    uint64_t deadline; /**< Monotonic time of the next run, in milliseconds */
+    uint32_t period; /**< Period in milliseconds, 0 for a single run */
+    uint32_t id; /**< Id of the timer */
+    ARSAL_Executor_Function_t function; /**< Function of the timer */
+    void *arg; /**< Argument of the function */
+} ARSAL_Executor_Timer_t;
+
+struct ARSAL_Executor_t;
+
+/**
+ * @brief Worker of the executor
+ */
+typedef struct
+{
+    int64_t top; /**< Steal end of the deque, written by the thieves */
+    char topPadding[64 - sizeof (int64_t)]; /**< Keeps top and bottom on separate cache lines */
+    int64_t bottom; /**< Owner end of the deque, only written by the worker */
+    ARSAL_Executor_DequeArray_t *array; /**< Current array of the deque */
+    struct ARSAL_Executor_t *executor; /**< Executor of the worker */
+    ARSAL_Thread_t thread; /**< Thread of the worker */
+    uint32_t random; /**< State of the victim selection */
+    int index; /**< Index of the worker */
+} ARSAL_Executor_Worker_t;
+
+/**
+ * @brief Shared executor
+ */
+typedef struct ARSAL_Executor_t
+{
+    ARSAL_Executor_Worker_t *workers; /**< Workers */
+    int workerCount; /**< Number of workers */
+    pthread_key_t key; /**< Worker of the calling thread */
+    ARSAL_Mutex_t mutex; /**< Protects the shared queue, the timers and the sleep of the workers */
+    ARSAL_Cond_t cond; /**< Wakes the workers up */
+    ARSAL_Executor_Task_t *queueHead; /**< First task submitted by a thread which is not a worker */
+    ARSAL_Executor_Task_t *queueTail; /**< Last task submitted by a thread which is not a worker */
+    int queueCount; /**< Number of tasks of the shared queue */
+    int sleepers; /**< Number of sleeping workers */
+    int stop; /**< 1 when the executor is deleted ; read by the workers and the blocking threads under different mutexes, accessed atomically */
+    ARSAL_Executor_Timer_t *timers; /**< Heap of the timers by deadline */
+    int timerCount; /**< Number of timers */
+    int timerCapacity; /**< Capacity of the timer heap */
+    uint32_t nextTimerId; /**< Id of the next timer */
+    ARSAL_Mutex_t blockingMutex; /**< Protects the blocking queue */
+    ARSAL_Cond_t blockingCond; /**< Wakes the blocking threads up */
+    ARSAL_Cond_t blockingDone; /**< Signaled when the last blocking thread exits */
+    ARSAL_Executor_Task_t *blockingHead; /**< First blocking task */
+    ARSAL_Executor_Task_t *blockingTail; /**< Last blocking task */
+    int blockingThreads; /**< Number of blocking threads */
+    int blockingIdle; /**< Number of idle blocking threads */
+} ARSAL_Executor_t;
+
+/**
+ * @brief INTERNAL FUNCTION : Get the monotonic time in milliseconds
+ */
+static inline uint64_t ARSAL_Executor_Now (void)
+{
+    return NSEC_TO_MSEC (ARSAL_Time_GetMonotonicNs ());
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Allocate a deque array
+ */
+static inline ARSAL_Executor_DequeArray_t *ARSAL_Executor_DequeArrayNew (int64_t size)
+{
+    ARSAL_Executor_DequeArray_t *array = (ARSAL_Executor_DequeArray_t *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, sizeof (ARSAL_Executor_DequeArray_t) + (size_t)size * sizeof (ARSAL_Executor_Task_t *));
+
+    if (array != NULL)
+    {
+        array->size = size;
+        array->tasks = (ARSAL_Executor_Task_t **)(array + 1);
+        array->previous = NULL;
+    }
+
+    return array;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Push a task on the deque of the calling worker
+ * @return ARSAL_OK, or ARSAL_ERROR_ALLOC if the deque could not grow
+ */
+static inline eARSAL_ERROR ARSAL_Executor_DequePush (ARSAL_Executor_Worker_t *worker, ARSAL_Executor_Task_t *task)
+{
+    int64_t bottom = __atomic_load_n (&worker->bottom, __ATOMIC_RELAXED);
+    int64_t top = __atomic_load_n (&worker->top, __ATOMIC_ACQUIRE);
+    ARSAL_Executor_DequeArray_t *array = __atomic_load_n (&worker->array, __ATOMIC_RELAXED);
+
+    if (bottom - top > array->size - 1)
+    {
+        ARSAL_Executor_DequeArray_t *grown = ARSAL_Executor_DequeArrayNew (array->size * 2);
+        int64_t index = 0;
+
+        if (grown == NULL)
+        {
+            return ARSAL_ERROR_ALLOC;
+        }
+
+        for (index = top; index < bottom; index++)
+        {
+            grown->tasks[index & (grown->size - 1)] = __atomic_load_n (&array->tasks[index & (array->size - 1)], __ATOMIC_RELAXED);
+        }
+        grown->previous = array;
+        __atomic_store_n (&worker->array, grown, __ATOMIC_RELEASE);
+        array = grown;
+    }
+
+    __atomic_store_n (&array->tasks[bottom & (array->size - 1)], task, __ATOMIC_RELAXED);
+    __atomic_thread_fence (__ATOMIC_RELEASE);
+    __atomic_store_n (&worker->bottom, bottom + 1, __ATOMIC_RELAXED);
+
+    return ARSAL_OK;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Take the last task pushed on the deque of the calling worker
+ * @return The task, or NULL if the deque is empty
+ */
+static inline ARSAL_Executor_Task_t *ARSAL_Executor_DequeTake (ARSAL_Executor_Worker_t *worker)
+{
+    int64_t bottom = __atomic_load_n (&worker->bottom, __ATOMIC_RELAXED) - 1;
+    ARSAL_Executor_DequeArray_t *array = __atomic_load_n (&worker->array, __ATOMIC_RELAXED);
+    ARSAL_Executor_Task_t *task = NULL;
+    int64_t top = 0;
+
+    __atomic_store_n (&worker->bottom, bottom, __ATOMIC_RELAXED);
+    __atomic_thread_fence (__ATOMIC_SEQ_CST);
+    top = __atomic_load_n (&worker->top, __ATOMIC_RELAXED);
+
+    if (top <= bottom)
+    {
+        task = __atomic_load_n (&array->tasks[bottom & (array->size - 1)], __ATOMIC_RELAXED);
+        if (top == bottom)
+        {
+            /* last task : races with the thieves */
+            if (!__atomic_compare_exchange_n (&worker->top, &top, top + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+            {
+                task = NULL;
+            }
+            __atomic_store_n (&worker->bottom, bottom + 1, __ATOMIC_RELAXED);
+        }
+    }
+    else
+    {
+        __atomic_store_n (&worker->bottom, bottom + 1, __ATOMIC_RELAXED);
+    }
+
+    return task;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Steal the first task pushed on the deque of another worker
+ * @return The task, or NULL if the deque is empty or another thread took the task
+ */
+static inline ARSAL_Executor_Task_t *ARSAL_Executor_DequeSteal (ARSAL_Executor_Worker_t *victim)
+{
+    int64_t top = __atomic_load_n (&victim->top, __ATOMIC_ACQUIRE);
+    int64_t bottom = 0;
+    ARSAL_Executor_Task_t *task = NULL;
+
+    __atomic_thread_fence (__ATOMIC_SEQ_CST);
+    bottom = __atomic_load_n (&victim->bottom, __ATOMIC_ACQUIRE);
+
+    if (top < bottom)
+    {
+        ARSAL_Executor_DequeArray_t *array = __atomic_load_n (&victim->array, __ATOMIC_ACQUIRE);
+
+        task = __atomic_load_n (&array->tasks[top & (array->size - 1)], __ATOMIC_RELAXED);
+        if (!__atomic_compare_exchange_n (&victim->top, &top, top + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        {
+            task = NULL;
+        }
+    }
+
+    return task;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Check whether tasks are waiting in the shared queue or in a deque
+ */
+static inline int ARSAL_Executor_HasWork (ARSAL_Executor_t *executor)
+{
+    int index = 0;
+
+    if (__atomic_load_n (&executor->queueCount, __ATOMIC_SEQ_CST) > 0)
+    {
+        return 1;
+    }
+
+    for (index = 0; index < executor->workerCount; index++)
+    {
+        if (__atomic_load_n (&executor->workers[index].top, __ATOMIC_SEQ_CST) < __atomic_load_n (&executor->workers[index].bottom, __ATOMIC_SEQ_CST))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Wake a sleeping worker up after new work was added
+ */
+static inline void ARSAL_Executor_Wake (ARSAL_Executor_t *executor)
+{
+    __atomic_thread_fence (__ATOMIC_SEQ_CST);
+    if (__atomic_load_n (&executor->sleepers, __ATOMIC_SEQ_CST) > 0)
+    {
+        ARSAL_Mutex_Lock (&executor->mutex);
+        ARSAL_Cond_Signal (&executor->cond);
+        ARSAL_Mutex_Unlock (&executor->mutex);
+    }
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Append a task to the shared queue
+ * @warning The executor mutex must be locked
+ */
+static inline void ARSAL_Executor_Enqueue (ARSAL_Executor_t *executor, ARSAL_Executor_Task_t *task)
+{
+    task->next = NULL;
+    if (executor->queueTail != NULL)
+    {
+        executor->queueTail->next = task;
+    }
+    else
+    {
+        executor->queueHead = task;
+    }
+    executor->queueTail = task;
+    __atomic_store_n (&executor->queueCount, executor->queueCount + 1, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Remove the first task of the shared queue
+ * @return The task, or NULL if the queue is empty
+ */
+static inline ARSAL_Executor_Task_t *ARSAL_Executor_Dequeue (ARSAL_Executor_t *executor)
+{
+    ARSAL_Executor_Task_t *task = NULL;
+
+    if (__atomic_load_n (&executor->queueCount, __ATOMIC_RELAXED) == 0)
+    {
+        return NULL;
+    }
+
+    ARSAL_Mutex_Lock (&executor->mutex);
+    task = executor->queueHead;
+    if (task != NULL)
+    {
+        executor->queueHead = task->next;
+        if (executor->queueHead == NULL)
+        {
+            executor->queueTail = NULL;
+        }
+        __atomic_store_n (&executor->queueCount, executor->queueCount - 1, __ATOMIC_SEQ_CST);
+    }
+    ARSAL_Mutex_Unlock (&executor->mutex);
+
+    return task;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Move the heap element at index up to its place
+ */
+static inline void ARSAL_Executor_TimerUp (ARSAL_Executor_t *executor, int index)
+{
+    ARSAL_Executor_Timer_t timer = executor->timers[index];
+
+    while (index > 0)
+    {
+        int parent = (index - 1) / 2;
+        if (executor->timers[parent].deadline <= timer.deadline)
+        {
+            break;
+        }
+        executor->timers[index] = executor->timers[parent];
+        index = parent;
+    }
+    executor->timers[index] = timer;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Move the heap element at index down to its place
+ */
+static inline void ARSAL_Executor_TimerDown (ARSAL_Executor_t *executor, int index)
+{
+    ARSAL_Executor_Timer_t timer = executor->timers[index];
+
+    for (;;)
+    {
+        int child = 2 * index + 1;
+        if (child >= executor->timerCount)
+        {
+            break;
+        }
+        if ((child + 1 < executor->timerCount) && (executor->timers[child + 1].deadline < executor->timers[child].deadline))
+        {
+            child++;
+        }
+        if (timer.deadline <= executor->timers[child].deadline)
+        {
+            break;
+        }
+        executor->timers[index] = executor->timers[child];
+        index = child;
+    }
+    executor->timers[index] = timer;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Remove the heap element at index
+ * @warning The executor mutex must be locked
+ */
+static inline void ARSAL_Executor_TimerRemove (ARSAL_Executor_t *executor, int index)
+{
+    executor->timerCount--;
+    if (index < executor->timerCount)
+    {
+        executor->timers[index] = executor->timers[executor->timerCount];
+        ARSAL_Executor_TimerUp (executor, index);
+        ARSAL_Executor_TimerDown (executor, index);
+    }
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Move the expired timers to the shared queue, rearming the periodic ones
+ * @warning The executor mutex must be locked
+ * @return The time until the next timer in milliseconds, -1 if there is no timer
+ */
+static inline int ARSAL_Executor_RunTimers (ARSAL_Executor_t *executor, int *expired)
+{
+    uint64_t now = ARSAL_Executor_Now ();
+
+    *expired = 0;
+
+    while ((executor->timerCount > 0) && (executor->timers[0].deadline <= now))
+    {
+        ARSAL_Executor_Timer_t *timer = &executor->timers[0];
+        ARSAL_Executor_Task_t *task = (ARSAL_Executor_Task_t *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, sizeof (ARSAL_Executor_Task_t));
+
+        if (task == NULL)
+        {
+            /* retried by the next check */
+            return 1;
+        }
+
+        task->function = timer->function;
+        task->arg = timer->arg;
+        task->flowId = 0;
+        ARSAL_Executor_Enqueue (executor, task);
+        (*expired)++;
+
+        if (timer->period > 0)
+        {
+            timer->deadline += timer->period;
+            if (timer->deadline <= now)
+            {
+                /* late : skips the missed periods */
+                timer->deadline = now + timer->period;
+            }
+            ARSAL_Executor_TimerDown (executor, 0);
+        }
+        else
+        {
+            ARSAL_Executor_TimerRemove (executor, 0);
+        }
+    }
+
+    if (executor->timerCount == 0)
+    {
+        return -1;
+    }
+
+    /* a delay or a period past INT_MAX milliseconds wakes the worker up once on the way */
+    if (executor->timers[0].deadline - now > (uint64_t)INT_MAX)
+    {
+        return INT_MAX;
+    }
+
+    return (int)(executor->timers[0].deadline - now);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Start the flow of a task in the trace
+ */
+static inline void ARSAL_Executor_TraceSubmit (ARSAL_Executor_Task_t *task)
+{
+    task->flowId = 0;
+    if (ARSAL_TRACE_IS_ENABLED ())
+    {
+        task->flowId = ARSAL_Trace_NewFlowId ();
+        ARSAL_TRACE_BEGIN ("ARSAL_Executor", "Submit");
+        ARSAL_TRACE_FLOW_BEGIN ("ARSAL_Executor", "Task", task->flowId);
+        ARSAL_TRACE_END ("ARSAL_Executor", "Submit");
+    }
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Run a task and free it
+ */
+static inline void ARSAL_Executor_RunTask (ARSAL_Executor_Task_t *task)
+{
+    ARSAL_TRACE_BEGIN ("ARSAL_Executor", "Task");
+    ARSAL_TRACE_FLOW_END ("ARSAL_Executor", "Task", task->flowId);
+    task->function (task->arg);
+    ARSAL_TRACE_END ("ARSAL_Executor", "Task");
+    ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, task);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Loop of a worker
+ */
+static inline void *ARSAL_Executor_WorkerRun (void *arg)
+{
+    ARSAL_Executor_Worker_t *worker = (ARSAL_Executor_Worker_t *)arg;
+    ARSAL_Executor_t *executor = worker->executor;
+
+    pthread_setspecific (executor->key, worker);
+
+    for (;;)
+    {
+        ARSAL_Executor_Task_t *task = ARSAL_Executor_DequeTake (worker);
+        int timeout = -1;
+        int expired = 0;
+        int attempt = 0;
+
+        if (task == NULL)
+        {
+            task = ARSAL_Executor_Dequeue (executor);
+        }
+
+        for (attempt = 0; (task == NULL) && (attempt < executor->workerCount - 1); attempt++)
+        {
+            int victim = 0;
+
+            /* xorshift to spread the thieves over the victims */
+            worker->random ^= worker->random << 13;
+            worker->random ^= worker->random >> 17;
+            worker->random ^= worker->random << 5;
+            victim = (int)(worker->random % (uint32_t)executor->workerCount);
+            if (victim != worker->index)
+            {
+                task = ARSAL_Executor_DequeSteal (&executor->workers[victim]);
+            }
+        }
+
+        if (task != NULL)
+        {
+            ARSAL_Executor_RunTask (task);
+            continue;
+        }
+
+        ARSAL_Mutex_Lock (&executor->mutex);
+
+        if (!__atomic_load_n (&executor->stop, __ATOMIC_ACQUIRE))
+        {
+            timeout = ARSAL_Executor_RunTimers (executor, &expired);
+        }
+
+        if (expired > 0)
+        {
+            if (expired > 1)
+            {
+                ARSAL_Cond_Signal (&executor->cond);
+            }
+            ARSAL_Mutex_Unlock (&executor->mutex);
+            continue;
+        }
+
+        __atomic_store_n (&executor->sleepers, executor->sleepers + 1, __ATOMIC_SEQ_CST);
+        if (!ARSAL_Executor_HasWork (executor))
+        {
+            if (__atomic_load_n (&executor->stop, __ATOMIC_ACQUIRE))
+            {
+                __atomic_store_n (&executor->sleepers, executor->sleepers - 1, __ATOMIC_SEQ_CST);
+                ARSAL_Mutex_Unlock (&executor->mutex);
+                break;
+            }
+
+            if (timeout >= 0)
+            {
+                ARSAL_Cond_Timedwait (&executor->cond, &executor->mutex, (timeout > 0) ? timeout : 1);
+            }
+            else
+            {
+                ARSAL_Cond_Wait (&executor->cond, &executor->mutex);
+            }
+        }
+        __atomic_store_n (&executor->sleepers, executor->sleepers - 1, __ATOMIC_SEQ_CST);
+
+        ARSAL_Mutex_Unlock (&executor->mutex);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Loop of a blocking thread
+ */
+static inline void *ARSAL_Executor_BlockingRun (void *arg)
+{
+    ARSAL_Executor_t *executor = (ARSAL_Executor_t *)arg;
+    uint64_t idleSince = ARSAL_Executor_Now ();
+
+    ARSAL_Mutex_Lock (&executor->blockingMutex);
+
+    for (;;)
+    {
+        ARSAL_Executor_Task_t *task = executor->blockingHead;
+
+        if (task != NULL)
+        {
+            executor->blockingHead = task->next;
+            if (executor->blockingHead == NULL)
+            {
+                executor->blockingTail = NULL;
+            }
+
+            ARSAL_Mutex_Unlock (&executor->blockingMutex);
+            ARSAL_Executor_RunTask (task);
+            ARSAL_Mutex_Lock (&executor->blockingMutex);
+
+            idleSince = ARSAL_Executor_Now ();
+            continue;
+        }
+
+        if (__atomic_load_n (&executor->stop, __ATOMIC_ACQUIRE) || (ARSAL_Executor_Now () - idleSince >= ARSAL_EXECUTOR_BLOCKING_IDLE_MS))
+        {
+            break;
+        }
+
+        executor->blockingIdle++;
+        ARSAL_Cond_Timedwait (&executor->blockingCond, &executor->blockingMutex, ARSAL_EXECUTOR_BLOCKING_IDLE_MS);
+        executor->blockingIdle--;
+    }
+
+    executor->blockingThreads--;
+    if (executor->blockingThreads == 0)
+    {
+        ARSAL_Cond_Broadcast (&executor->blockingDone);
+    }
+
+    ARSAL_Mutex_Unlock (&executor->blockingMutex);
+
+    return NULL;
+}
+
+/**
+ * @brief Submit a task to the executor
+ * @note Tasks submitted from a task run on the same worker unless another worker steals them.
+ * A task must not block : use ARSAL_Executor_SubmitBlocking() for blocking calls.
+ *
+ * @param executor The executor
+ * @param function The function of the task
+ * @param arg The argument of the function
+ * @return ARSAL_OK, or an error if the task could not be submitted
+ */
+static inline eARSAL_ERROR ARSAL_Executor_Submit (ARSAL_Executor_t *executor, ARSAL_Executor_Function_t function, void *arg)
+{
+    ARSAL_Executor_Worker_t *worker = NULL;
+    ARSAL_Executor_Task_t *task = NULL;
+
+    if ((executor == NULL) || (function == NULL))
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    task = (ARSAL_Executor_Task_t *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, sizeof (ARSAL_Executor_Task_t));
+    if (task == NULL)
+    {
+        return ARSAL_ERROR_ALLOC;
+    }
+    task->function = function;
+    task->arg = arg;
+    task->next = NULL;
+    ARSAL_Executor_TraceSubmit (task);
+
+    worker = (ARSAL_Executor_Worker_t *)pthread_getspecific (executor->key);
+    if ((worker == NULL) || (ARSAL_Executor_DequePush (worker, task) != ARSAL_OK))
+    {
+        ARSAL_Mutex_Lock (&executor->mutex);
+        ARSAL_Executor_Enqueue (executor, task);
+        ARSAL_Mutex_Unlock (&executor->mutex);
+    }
+
+    ARSAL_Executor_Wake (executor);
+
+    return ARSAL_OK;
+}
+
+/**
+ * @brief Submit a task which blocks, like a file or a socket call
+ * @note The task runs on a blocking thread, created if none is idle and fewer than
+ * ARSAL_EXECUTOR_MAX_BLOCKING_THREADS run. Otherwise it waits for a blocking thread.
+ *
+ * @param executor The executor
+ * @param function The function of the task
+ * @param arg The argument of the function
+ * @return ARSAL_OK, or an error if the task could not be submitted
+ */
+static inline eARSAL_ERROR ARSAL_Executor_SubmitBlocking (ARSAL_Executor_t *executor, ARSAL_Executor_Function_t function, void *arg)
+{
+    eARSAL_ERROR error = ARSAL_OK;
+    ARSAL_Executor_Task_t *task = NULL;
+
+    if ((executor == NULL) || (function == NULL))
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    task = (ARSAL_Executor_Task_t *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, sizeof (ARSAL_Executor_Task_t));
+    if (task == NULL)
+    {
+        return ARSAL_ERROR_ALLOC;
+    }
+    task->function = function;
+    task->arg = arg;
+    task->next = NULL;
+    ARSAL_Executor_TraceSubmit (task);
+
+    ARSAL_Mutex_Lock (&executor->blockingMutex);
+
+    if (executor->blockingTail != NULL)
+    {
+        executor->blockingTail->next = task;
+    }
+    else
+    {
+        executor->blockingHead = task;
+    }
+    executor->blockingTail = task;
+
+    if (executor->blockingIdle > 0)
+    {
+        ARSAL_Cond_Signal (&executor->blockingCond);
+    }
+    else if (executor->blockingThreads < ARSAL_EXECUTOR_MAX_BLOCKING_THREADS)
+    {
+        ARSAL_Thread_Attributes_t attributes;
+        ARSAL_Thread_t thread = NULL;
+
+        ARSAL_Thread_Attributes_Init (&attributes);
+        attributes.name = "ARSAL_Executor_Blocking";
+
+        if (ARSAL_Thread_CreateWithAttributes (&thread, ARSAL_Executor_BlockingRun, executor, &attributes) == 0)
+        {
+            /* the blocking threads exit on their own, Delete waits for them through blockingDone */
+            executor->blockingThreads++;
+            pthread_detach (*((pthread_t *)thread));
+            ARSAL_Thread_Destroy (&thread);
+        }
+        else if (executor->blockingThreads == 0)
+        {
+            /* no thread would ever run the task */
+            executor->blockingHead = task->next;
+            executor->blockingTail = (executor->blockingHead == NULL) ? NULL : executor->blockingTail;
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, task);
+            error = ARSAL_ERROR_SYSTEM;
+        }
+    }
+
+    ARSAL_Mutex_Unlock (&executor->blockingMutex);
+
+    return error;
+}
+
+/**
+ * @brief Run a task after a delay, then periodically if a period is given
+ * @note The timer function runs as a task ; a periodic timer runs until it is canceled.
+ *
+ * @param executor The executor
+ * @param delay Delay before the first run, in milliseconds
+ * @param period Period of the next runs in milliseconds, 0 for a single run
+ * @param function The function of the timer
+ * @param arg The argument of the function
+ * @param[out] timerId Id of the timer for ARSAL_Executor_Cancel(), can be NULL
+ * @return ARSAL_OK, or an error if the timer could not be added
+ */
+static inline eARSAL_ERROR ARSAL_Executor_Schedule (ARSAL_Executor_t *executor, uint32_t delay, uint32_t period, ARSAL_Executor_Function_t function, void *arg, uint32_t *timerId)
+{
+    ARSAL_Executor_Timer_t *timer = NULL;
+
+    if ((executor == NULL) || (function == NULL))
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    ARSAL_Mutex_Lock (&executor->mutex);
+
+    if (executor->timerCount == executor->timerCapacity)
+    {
+        int capacity = (executor->timerCapacity > 0) ? executor->timerCapacity * 2 : 16;
+        ARSAL_Executor_Timer_t *timers = (ARSAL_Executor_Timer_t *)ARSAL_Allocator_Realloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, executor->timers, (size_t)capacity * sizeof (ARSAL_Executor_Timer_t));
+
+        if (timers == NULL)
+        {
+            ARSAL_Mutex_Unlock (&executor->mutex);
+            return ARSAL_ERROR_ALLOC;
+        }
+        executor->timers = timers;
+        executor->timerCapacity = capacity;
+    }
+
+    timer = &executor->timers[executor->timerCount];
+    timer->deadline = ARSAL_Executor_Now () + delay;
+    timer->period = period;
+    timer->id = ++executor->nextTimerId;
+    if (timer->id == 0)
+    {
+        timer->id = ++executor->nextTimerId;
+    }
+    timer->function = function;
+    timer->arg = arg;
+
+    if (timerId != NULL)
+    {
+        *timerId = timer->id;
+    }
+
+    executor->timerCount++;
+    ARSAL_Executor_TimerUp (executor, executor->timerCount - 1);
+
+    /* a sleeping worker may have to wait for a shorter time */
+    ARSAL_Cond_Signal (&executor->cond);
+
+    ARSAL_Mutex_Unlock (&executor->mutex);
+
+    return ARSAL_OK;
+}
+
+/**
+ * @brief Cancel a timer
+ * @note A run already moved to the tasks is not canceled.
+ *
+ * @param executor The executor
+ * @param timerId The id of the timer
+ * @return ARSAL_OK, or ARSAL_ERROR_BAD_PARAMETER if the timer is not pending
+ */
+static inline eARSAL_ERROR ARSAL_Executor_Cancel (ARSAL_Executor_t *executor, uint32_t timerId)
+{
+    eARSAL_ERROR error = ARSAL_ERROR_BAD_PARAMETER;
+    int index = 0;
+
+    if (executor == NULL)
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    ARSAL_Mutex_Lock (&executor->mutex);
+
+    for (index = 0; index < executor->timerCount; index++)
+    {
+        if (executor->timers[index].id == timerId)
+        {
+            ARSAL_Executor_TimerRemove (executor, index);
+            error = ARSAL_OK;
+            break;
+        }
+    }
+
+    ARSAL_Mutex_Unlock (&executor->mutex);
+
+    return error;
+}
+
+/**
+ * @brief Get the number of workers of the executor
+ *
+ * @param executor The executor
+ * @return The number of workers, or -1 if the executor is NULL
+ */
+static inline int ARSAL_Executor_GetWorkerCount (ARSAL_Executor_t *executor)
+{
+    return (executor != NULL) ? executor->workerCount : -1;
+}
+
+/**
+ * @brief Delete the executor
+ * @warning This function frees memory
+ * @note The submitted tasks are run before it returns, the pending timers are dropped.
+ * It must not be called from a task.
+ *
+ * @param executor Address of the pointer on the executor
+ * @see ARSAL_Executor_New()
+ */
+static inline void ARSAL_Executor_Delete (ARSAL_Executor_t **executor)
+{
+    ARSAL_Executor_t *deleted = NULL;
+    int index = 0;
+
+    if ((executor == NULL) || (*executor == NULL))
+    {
+        return;
+    }
+
+    deleted = *executor;
+
+    ARSAL_Mutex_Lock (&deleted->mutex);
+    __atomic_store_n (&deleted->stop, 1, __ATOMIC_RELEASE);
+    ARSAL_Cond_Broadcast (&deleted->cond);
+    ARSAL_Mutex_Unlock (&deleted->mutex);
+
+    for (index = 0; index < deleted->workerCount; index++)
+    {
+        if (deleted->workers[index].thread != NULL)
+        {
+            ARSAL_Thread_Join (deleted->workers[index].thread, NULL);
+            ARSAL_Thread_Destroy (&deleted->workers[index].thread);
+        }
+    }
+
+    ARSAL_Mutex_Lock (&deleted->blockingMutex);
+    __atomic_store_n (&deleted->stop, 1, __ATOMIC_RELEASE);
+    ARSAL_Cond_Broadcast (&deleted->blockingCond);
+    while (deleted->blockingThreads > 0)
+    {
+        ARSAL_Cond_Wait (&deleted->blockingDone, &deleted->blockingMutex);
+    }
+    ARSAL_Mutex_Unlock (&deleted->blockingMutex);
+
+    /* tasks submitted by the blocking threads after the workers exited : run them here */
+    for (;;)
+    {
+        ARSAL_Executor_Task_t *task = ARSAL_Executor_Dequeue (deleted);
+        if (task == NULL)
+        {
+            break;
+        }
+        ARSAL_Executor_RunTask (task);
+    }
+
+    for (index = 0; index < deleted->workerCount; index++)
+    {
+        ARSAL_Executor_DequeArray_t *array = deleted->workers[index].array;
+        while (array != NULL)
+        {
+            ARSAL_Executor_DequeArray_t *previous = array->previous;
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, array);
+            array = previous;
+        }
+    }
+
+    pthread_key_delete (deleted->key);
+    ARSAL_Cond_Destroy (&deleted->blockingDone);
+    ARSAL_Cond_Destroy (&deleted->blockingCond);
+    ARSAL_Mutex_Destroy (&deleted->blockingMutex);
+    ARSAL_Cond_Destroy (&deleted->cond);
+    ARSAL_Mutex_Destroy (&deleted->mutex);
+    ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, deleted->timers);
+    ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, deleted->workers);
+    ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, deleted);
+    *executor = NULL;
+}
+
+/**
+ * @brief Create an executor and start its workers
+ * @warning This function allocates memory
+ * @post ARSAL_Executor_Delete() must be called to stop the workers and free the memory allocated.
+ *
+ * @param workerCount Number of workers, 0 for one per CPU
+ * @param[out] error Executing error
+ * @return The new executor, or NULL if an error occurred
+ * @see ARSAL_Executor_Delete()
+ */
+static inline ARSAL_Executor_t *ARSAL_Executor_New (int workerCount, eARSAL_ERROR *error)
+{
+    ARSAL_Executor_t *executor = NULL;
+    eARSAL_ERROR localError = ARSAL_OK;
+    int index = 0;
+
+    if (workerCount == 0)
+    {
+        long cpus = sysconf (_SC_NPROCESSORS_ONLN);
+        workerCount = (cpus > 0) ? (int)((cpus < ARSAL_EXECUTOR_MAX_WORKERS) ? cpus : ARSAL_EXECUTOR_MAX_WORKERS) : 1;
+    }
+
+    if ((workerCount < 0) || (workerCount > ARSAL_EXECUTOR_MAX_WORKERS))
+    {
+        localError = ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    if (localError == ARSAL_OK)
+    {
+        executor = (ARSAL_Executor_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, 1, sizeof (ARSAL_Executor_t));
+        if (executor != NULL)
+        {
+            executor->workers = (ARSAL_Executor_Worker_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (size_t)workerCount, sizeof (ARSAL_Executor_Worker_t));
+        }
+        if ((executor == NULL) || (executor->workers == NULL))
+        {
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, executor);
+            executor = NULL;
+            localError = ARSAL_ERROR_ALLOC;
+        }
+    }
+
+    if (localError == ARSAL_OK)
+    {
+        int initialized = 0;
+
+        initialized += (initialized == 0) && (pthread_key_create (&executor->key, NULL) == 0);
+        initialized += (initialized == 1) && (ARSAL_Mutex_Init (&executor->mutex) == 0);
+        initialized += (initialized == 2) && (ARSAL_Cond_Init (&executor->cond) == 0);
+        initialized += (initialized == 3) && (ARSAL_Mutex_Init (&executor->blockingMutex) == 0);
+        initialized += (initialized == 4) && (ARSAL_Cond_Init (&executor->blockingCond) == 0);
+        initialized += (initialized == 5) && (ARSAL_Cond_Init (&executor->blockingDone) == 0);
+
+        if (initialized < 6)
+        {
+            if (initialized > 4)
+            {
+                ARSAL_Cond_Destroy (&executor->blockingCond);
+            }
+            if (initialized > 3)
+            {
+                ARSAL_Mutex_Destroy (&executor->blockingMutex);
+            }
+            if (initialized > 2)
+            {
+                ARSAL_Cond_Destroy (&executor->cond);
+            }
+            if (initialized > 1)
+            {
+                ARSAL_Mutex_Destroy (&executor->mutex);
+            }
+            if (initialized > 0)
+            {
+                pthread_key_delete (executor->key);
+            }
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, executor->workers);
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, executor);
+            executor = NULL;
+            localError = ARSAL_ERROR_SYSTEM;
+        }
+    }
+
+    if (localError == ARSAL_OK)
+    {
+        executor->workerCount = workerCount;
+
+        for (index = 0; (index < workerCount) && (localError == ARSAL_OK); index++)
+        {
+            executor->workers[index].executor = executor;
+            executor->workers[index].index = index;
+            executor->workers[index].random = 2463534242u + (uint32_t)index * 0x9E3779B9u;
+            executor->workers[index].array = ARSAL_Executor_DequeArrayNew (ARSAL_EXECUTOR_DEQUE_SIZE);
+            if (executor->workers[index].array == NULL)
+            {
+                localError = ARSAL_ERROR_ALLOC;
+            }
+        }
+
+        for (index = 0; (index < workerCount) && (localError == ARSAL_OK); index++)
+        {
+            ARSAL_Thread_Attributes_t attributes;
+            char name[ARSAL_THREAD_NAME_SIZE];
+
+            snprintf (name, sizeof (name), "ARSAL_Executor_%d", index);
+            ARSAL_Thread_Attributes_Init (&attributes);
+            attributes.name = name;
+            if (ARSAL_Thread_CreateWithAttributes (&executor->workers[index].thread, ARSAL_Executor_WorkerRun, &executor->workers[index], &attributes) != 0)
+            {
+                executor->workers[index].thread = NULL;
+                localError = ARSAL_ERROR_SYSTEM;
+            }
+        }
+
+        if (localError != ARSAL_OK)
+        {
+            ARSAL_Executor_Delete (&executor);
+        }
+    }
+
+    if (error != NULL)
+    {
+        *error = localError;
+    }
+
+    return executor;
+}
+
+#endif /* _ARSAL_EXECUTOR_H_ */
@@ -0,0 +1,764 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file libARSAL/ARSAL_FastMutex.h
+ * @brief Mutexes and conditions stored inline, with adaptive spinning and an optional contention profiler
+ * @note Unlike ARSAL_Mutex_t, the lock is stored in the structure, so locking does not follow a pointer.
+ * A contended lock spins for a time adapted to the past acquisitions before sleeping ; it sleeps on a
+ * futex on Linux, and on an inline pthread mutex elsewhere (iOS has no futex).
+ * Defining ARSAL_FASTMUTEX_PROFILE before including this file records, per mutex, the wait time and the
+ * call sites holding the lock ; see ARSAL_FastMutex_PrintProfile().
+ * @date 10/18/2026
+ */
+#ifndef _ARSAL_FAST_MUTEX_H_
+#define _ARSAL_FAST_MUTEX_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#include <libARSAL/ARSAL_Time.h>
+
+/**
+ * @brief 1 when the mutexes sleep on a futex
+ * @note Can be disabled with -DARSAL_FASTMUTEX_NO_FUTEX
+ */
+#if defined(__linux__) && defined(SYS_futex) && defined(__USE_MISC) && !defined(ARSAL_FASTMUTEX_NO_FUTEX)
+#define ARSAL_FASTMUTEX_FUTEX 1
+#else
+#define ARSAL_FASTMUTEX_FUTEX 0
+#endif
+
+/**
+ * @brief Maximum number of spins before sleeping
+ */
+#define ARSAL_FASTMUTEX_MAX_SPIN 100
+
+/**
+ * @brief Number of call sites recorded per mutex by the profiler
+ */
+#define ARSAL_FASTMUTEX_PROFILE_SITES 8
+
+/**
+ * @brief Flags of a mutex
+ */
+typedef enum
+{
+    ARSAL_FASTMUTEX_FLAG_PRIORITY_INHERIT = (1 << 0), /**< The holder of the mutex runs at the priority of its highest priority waiter */
+} eARSAL_FASTMUTEX_FLAG;
+
+/**
+ * @brief Contention of a call site holding a mutex
+ */
+typedef struct
+{
+    const char *function; /**< Function of the call site */
+    int line; /**< Line of the call site */
+    uint64_t count; /**< Number of acquisitions */
+    uint64_t waitNs; /**< Time waited for the lock by the call site, in nanoseconds */
+    uint64_t holdNs; /**< Time the call site held the lock, in nanoseconds */
+    uint64_t maxHoldNs; /**< Longest time the call site held the lock, in nanoseconds */
+    uint64_t blocked; /**< Number of acquisitions of other call sites which waited while this call site held the lock */
+} ARSAL_FastMutex_Site_t;
+
+/**
+ * @brief Contention profile of a mutex
+ */
+typedef struct
+{
+    const char *name; /**< Name of the mutex in the reports, see ARSAL_FastMutex_SetName() */
+    uint64_t count; /**< Number of acquisitions */
+    uint64_t contended; /**< Number of acquisitions which waited */
+    uint64_t waitNs; /**< Total wait time, in nanoseconds */
+    uint64_t maxWaitNs; /**< Longest wait, in nanoseconds */
+    uint64_t lockedAt; /**< Time of the current acquisition */
+    int holder; /**< Site of the current holder, -1 when unlocked or unknown */
+    ARSAL_FastMutex_Site_t sites[ARSAL_FASTMUTEX_PROFILE_SITES]; /**< Call sites ; the last one also counts the sites which do not fit */
+} ARSAL_FastMutex_Profile_t;
+
+/**
+ * @brief Mutex stored inline
+ */
+typedef struct
+{
+#if ARSAL_FASTMUTEX_FUTEX
+    int32_t state; /**< 0 unlocked, 1 locked, 2 locked with waiters ; owner thread id with priority inheritance */
+    int32_t flags; /**< eARSAL_FASTMUTEX_FLAG of the mutex */
+#else
+    pthread_mutex_t mutex; /**< Mutex */
+#endif
+    int32_t spin; /**< Estimated number of spins to get the lock */
+#ifdef ARSAL_FASTMUTEX_PROFILE
+    ARSAL_FastMutex_Profile_t profile; /**< Contention profile */
+#endif
+} ARSAL_FastMutex_t;
+
+/**
+ * @brief Condition stored inline
+ */
+typedef struct
+{
+#if ARSAL_FASTMUTEX_FUTEX
+    uint32_t sequence; /**< Incremented by each signal */
+#else
+    pthread_cond_t cond; /**< Condition */
+#endif
+} ARSAL_FastCond_t;
+
+/**
+ * @brief Static initializer of a mutex without flags
+ */
+#if ARSAL_FASTMUTEX_FUTEX
+#define ARSAL_FASTMUTEX_INITIALIZER { 0 }
+#define ARSAL_FASTCOND_INITIALIZER { 0 }
+#else
+#define ARSAL_FASTMUTEX_INITIALIZER { PTHREAD_MUTEX_INITIALIZER }
+#define ARSAL_FASTCOND_INITIALIZER { PTHREAD_COND_INITIALIZER }
+#endif
+
+/**
+ * @brief Locks a mutex, recording the call site when profiling
+ * @param mutex The mutex to lock
+ */
+#define ARSAL_FastMutex_Lock(mutex) ARSAL_FastMutex_LockAt ((mutex), __FUNCTION__, __LINE__)
+
+/**
+ * @brief Tries to lock a mutex, recording the call site when profiling
+ * @param mutex The mutex to lock
+ */
+#define ARSAL_FastMutex_Trylock(mutex) ARSAL_FastMutex_TrylockAt ((mutex), __FUNCTION__, __LINE__)
+
+/**
+ * @brief INTERNAL FUNCTION : Hint the CPU that the thread spins
+ */
+static inline void ARSAL_FastMutex_Relax (void)
+{
+#if defined(__i386__) || defined(__x86_64__)
+    __asm__ __volatile__ ("pause");
+#elif defined(__arm__) || defined(__aarch64__)
+    __asm__ __volatile__ ("yield");
+#endif
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Get the monotonic time in nanoseconds
+ */
+static inline uint64_t ARSAL_FastMutex_Now (void)
+{
+    return ARSAL_Time_GetMonotonicNs ();
+}
+
+#if ARSAL_FASTMUTEX_FUTEX
+
+/**
+ * @brief INTERNAL FUNCTION : Call the futex system call
+ */
+static inline long ARSAL_FastMutex_Futex (void *address, int operation, int value, const struct timespec *timeout)
+{
+    return syscall (SYS_futex, address, operation, value, timeout, NULL, 0);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Wait on a futex until an absolute deadline of the monotonic clock
+ */
+static inline long ARSAL_FastMutex_FutexWaitUntil (void *address, int value, ARSAL_Time_Monotonic_t deadline)
+{
+    struct timespec absolute;
+
+    if (deadline == ARSAL_TIME_MONOTONIC_INFINITE)
+    {
+        return syscall (SYS_futex, address, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+    }
+
+    /* FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC time, the clock of ARSAL_Time_GetMonotonicNs() on Linux */
+    ARSAL_Time_NsToTimespec (deadline, &absolute);
+    return syscall (SYS_futex, address, FUTEX_WAIT_BITSET_PRIVATE, value, &absolute, NULL, FUTEX_BITSET_MATCH_ANY);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Get the thread id used by the priority inheritance futexes
+ */
+static inline int32_t ARSAL_FastMutex_ThreadId (void)
+{
+    return (int32_t)syscall (SYS_gettid);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Try to take the lock once
+ * @return 1 if the lock was taken
+ */
+static inline int ARSAL_FastMutex_TryAcquire (ARSAL_FastMutex_t *mutex)
+{
+    int32_t expected = 0;
+    int32_t owner = (mutex->flags & ARSAL_FASTMUTEX_FLAG_PRIORITY_INHERIT) ? ARSAL_FastMutex_ThreadId () : 1;
+
+    return __atomic_compare_exchange_n (&mutex->state, &expected, owner, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Sleep until the lock is taken
+ */
+static inline void ARSAL_FastMutex_AcquireSlow (ARSAL_FastMutex_t *mutex)
+{
+    if (mutex->flags & ARSAL_FASTMUTEX_FLAG_PRIORITY_INHERIT)
+    {
+        /* the kernel boosts the owner and hands the lock over */
+        while ((ARSAL_FastMutex_Futex (&mutex->state, FUTEX_LOCK_PI_PRIVATE, 0, NULL) != 0) && (errno == EINTR))
+        {
+        }
+        return;
+    }
+
+    while (__atomic_exchange_n (&mutex->state, 2, __ATOMIC_ACQUIRE) != 0)
+    {
+        ARSAL_FastMutex_Futex (&mutex->state, FUTEX_WAIT_PRIVATE, 2, NULL);
+    }
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Release the lock, waking a waiter up if any
+ */
+static inline void ARSAL_FastMutex_Release (ARSAL_FastMutex_t *mutex)
+{
+    if (mutex->flags & ARSAL_FASTMUTEX_FLAG_PRIORITY_INHERIT)
+    {
+        int32_t owner = ARSAL_FastMutex_ThreadId ();
+        if (!__atomic_compare_exchange_n (&mutex->state, &owner, 0, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        {
+            ARSAL_FastMutex_Futex (&mutex->state, FUTEX_UNLOCK_PI_PRIVATE, 0, NULL);
+        }
+        return;
+    }
+
+    if (__atomic_exchange_n (&mutex->state, 0, __ATOMIC_RELEASE) == 2)
+    {
+        ARSAL_FastMutex_Futex (&mutex->state, FUTEX_WAKE_PRIVATE, 1, NULL);
+    }
+}
+
+#else
+
+/**
+ * @brief INTERNAL FUNCTION : Try to take the lock once
+ * @return 1 if the lock was taken
+ */
+static inline int ARSAL_FastMutex_TryAcquire (ARSAL_FastMutex_t *mutex)
+{
+    return (pthread_mutex_trylock (&mutex->mutex) == 0);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Sleep until the lock is taken
+ */
+static inline void ARSAL_FastMutex_AcquireSlow (ARSAL_FastMutex_t *mutex)
+{
+    pthread_mutex_lock (&mutex->mutex);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Release the lock, waking a waiter up if any
+ */
+static inline void ARSAL_FastMutex_Release (ARSAL_FastMutex_t *mutex)
+{
+    pthread_mutex_unlock (&mutex->mutex);
+}
+
+#endif
+
+#ifdef ARSAL_FASTMUTEX_PROFILE
+
+/**
+ * @brief INTERNAL FUNCTION : Record an acquisition in the profile
+ * @warning The mutex must be locked
+ */
+static inline void ARSAL_FastMutex_ProfileLocked (ARSAL_FastMutex_t *mutex, const char *function, int line, uint64_t start, int holder)
+{
+    ARSAL_FastMutex_Profile_t *profile = &mutex->profile;
+    uint64_t now = ARSAL_FastMutex_Now ();
+    uint64_t wait = (start != 0) ? now - start : 0;
+    int site = 0;
+
+    for (site = 0; site < ARSAL_FASTMUTEX_PROFILE_SITES - 1; site++)
+    {
+        if ((profile->sites[site].function == NULL) ||
+            ((profile->sites[site].function == function) && (profile->sites[site].line == line)))
+        {
+            break;
+        }
+    }
+
+    if (profile->sites[site].function == NULL)
+    {
+        profile->sites[site].function = function;
+        profile->sites[site].line = line;
+    }
+
+    profile->count++;
+    profile->sites[site].count++;
+    if (start != 0)
+    {
+        profile->contended++;
+        profile->waitNs += wait;
+        profile->maxWaitNs = (wait > profile->maxWaitNs) ? wait : profile->maxWaitNs;
+        profile->sites[site].waitNs += wait;
+        if (holder >= 0)
+        {
+            profile->sites[holder].blocked++;
+        }
+    }
+
+    __atomic_store_n (&profile->holder, site, __ATOMIC_RELAXED);
+    profile->lockedAt = now;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Record the end of an acquisition in the profile
+ * @warning The mutex must be locked
+ */
+static inline void ARSAL_FastMutex_ProfileUnlocked (ARSAL_FastMutex_t *mutex)
+{
+    ARSAL_FastMutex_Profile_t *profile = &mutex->profile;
+    int holder = profile->holder;
+
+    if (holder >= 0)
+    {
+        uint64_t hold = ARSAL_FastMutex_Now () - profile->lockedAt;
+        profile->sites[holder].holdNs += hold;
+        profile->sites[holder].maxHoldNs = (hold > profile->sites[holder].maxHoldNs) ? hold : profile->sites[holder].maxHoldNs;
+    }
+    __atomic_store_n (&profile->holder, -1, __ATOMIC_RELAXED);
+}
+
+#endif
+
+/**
+ * @brief Initializes a mutex
+ *
+ * @param mutex The mutex to initialize
+ * @param flags eARSAL_FASTMUTEX_FLAG flags of the mutex
+ * @retval On success, ARSAL_FastMutex_Init() returns 0. Otherwise, it returns an error number (See errno.h)
+ */
+static inline int ARSAL_FastMutex_Init (ARSAL_FastMutex_t *mutex, int flags)
+{
+    int result = 0;
+
+    if (mutex == NULL)
+    {
+        return EINVAL;
+    }
+
+    memset (mutex, 0, sizeof (ARSAL_FastMutex_t));
+
+#if ARSAL_FASTMUTEX_FUTEX
+    mutex->flags = flags;
+#else
+    {
+        pthread_mutexattr_t attr;
+
+        result = pthread_mutexattr_init (&attr);
+        if (result == 0)
+        {
+            if (flags & ARSAL_FASTMUTEX_FLAG_PRIORITY_INHERIT)
+            {
+                result = pthread_mutexattr_setprotocol (&attr, PTHREAD_PRIO_INHERIT);
+            }
+            if (result == 0)
+            {
+                result = pthread_mutex_init (&mutex->mutex, &attr);
+            }
+            pthread_mutexattr_destroy (&attr);
+        }
+    }
+#endif
+
+#ifdef ARSAL_FASTMUTEX_PROFILE
+    mutex->profile.holder = -1;
+#endif
+
+    return result;
+}
+
+/**
+ * @brief Destroys a mutex
+ *
+ * @param mutex The mutex to destroy
+ * @retval On success, ARSAL_FastMutex_Destroy() returns 0. Otherwise, it returns an error number (See errno.h)
+ */
+static inline int ARSAL_FastMutex_Destroy (ARSAL_FastMutex_t *mutex)
+{
+    if (mutex == NULL)
+    {
+        return EINVAL;
+    }
+
+#if ARSAL_FASTMUTEX_FUTEX
+    return (__atomic_load_n (&mutex->state, __ATOMIC_RELAXED) == 0) ? 0 : EBUSY;
+#else
+    return pthread_mutex_destroy (&mutex->mutex);
+#endif
+}
+
+/**
+ * @brief Sets the name of a mutex in the profiler reports
+ * @note Does nothing when ARSAL_FASTMUTEX_PROFILE is not defined
+ *
+ * @param mutex The mutex
+ * @param name The name, which must remain valid for the life of the mutex
+ */
+static inline void ARSAL_FastMutex_SetName (ARSAL_FastMutex_t *mutex, const char *name)
+{
+#ifdef ARSAL_FASTMUTEX_PROFILE
+    mutex->profile.name = name;
+#else
+    (void)mutex;
+    (void)name;
+#endif
+}
+
+/**
+ * @brief Locks a mutex
+ * @warning This function should not be used directly
+ * @see ARSAL_FastMutex_Lock()
+ *
+ * @param mutex The mutex to lock
+ * @param function The function of the call site
+ * @param line The line of the call site
+ * @retval On success, returns 0. Otherwise, it returns an error number (See errno.h)
+ */
+static inline int ARSAL_FastMutex_LockAt (ARSAL_FastMutex_t *mutex, const char *function, int line)
+{
+    uint64_t start = 0;
+    int holder = -1;
+    int32_t spin = 0;
+    int32_t limit = 0;
+
+    (void)function;
+    (void)line;
+    (void)start;
+    (void)holder;
+
+    if (!ARSAL_FastMutex_TryAcquire (mutex))
+    {
+#ifdef ARSAL_FASTMUTEX_PROFILE
+        start = ARSAL_FastMutex_Now ();
+        holder = __atomic_load_n (&mutex->profile.holder, __ATOMIC_RELAXED);
+#endif
+
+        /* spins up to twice the spins which were needed in average, as the glibc adaptive mutexes */
+        limit = __atomic_load_n (&mutex->spin, __ATOMIC_RELAXED) * 2 + 10;
+        limit = (limit < ARSAL_FASTMUTEX_MAX_SPIN) ? limit : ARSAL_FASTMUTEX_MAX_SPIN;
+
+        for (spin = 1; spin <= limit; spin++)
+        {
+            ARSAL_FastMutex_Relax ();
+            if (ARSAL_FastMutex_TryAcquire (mutex))
+            {
+                break;
+            }
+        }
+
+        if (spin > limit)
+        {
+            ARSAL_FastMutex_AcquireSlow (mutex);
+        }
+
+        __atomic_store_n (&mutex->spin, mutex->spin + (spin - mutex->spin) / 8, __ATOMIC_RELAXED);
+    }
+
+#ifdef ARSAL_FASTMUTEX_PROFILE
+    ARSAL_FastMutex_ProfileLocked (mutex, function, line, start, holder);
+#endif
+
+    return 0;
+}
+
+/**
+ * @brief Tries to lock a mutex
+ * @warning This function should not be used directly
+ * @see ARSAL_FastMutex_Trylock()
+ *
+ * @param mutex The mutex to lock
+ * @param function The function of the call site
+ * @param line The line of the call site
+ * @retval Returns 0 if the mutex was locked, EBUSY otherwise
+ */
+static inline int ARSAL_FastMutex_TrylockAt (ARSAL_FastMutex_t *mutex, const char *function, int line)
+{
+    (void)function;
+    (void)line;
+
+    if (!ARSAL_FastMutex_TryAcquire (mutex))
+    {
+        return EBUSY;
+    }
+
+#ifdef ARSAL_FASTMUTEX_PROFILE
+    ARSAL_FastMutex_ProfileLocked (mutex, function, line, 0, -1);
+#endif
+
+    return 0;
+}
+
+/**
+ * @brief Unlocks a mutex
+ *
+ * @param mutex The mutex to unlock
+ * @retval On success, ARSAL_FastMutex_Unlock() returns 0. Otherwise, it returns an error number (See errno.h)
+ */
+static inline int ARSAL_FastMutex_Unlock (ARSAL_FastMutex_t *mutex)
+{
+#ifdef ARSAL_FASTMUTEX_PROFILE
+    ARSAL_FastMutex_ProfileUnlocked (mutex);
+#endif
+
+    ARSAL_FastMutex_Release (mutex);
+
+    return 0;
+}
+
+/**
+ * @brief Prints the contention profile of a mutex
+ * @note Prints nothing when ARSAL_FASTMUTEX_PROFILE is not defined
+ *
+ * @param mutex The mutex, locked or not ; the counters are read without the lock
+ * @param file The output file
+ */
+static inline void ARSAL_FastMutex_PrintProfile (ARSAL_FastMutex_t *mutex, FILE *file)
+{
+#ifdef ARSAL_FASTMUTEX_PROFILE
+    ARSAL_FastMutex_Profile_t *profile = &mutex->profile;
+    int site = 0;
+
+    fprintf (file, "%s (%p) : %llu locks, %llu contended, wait %llu us total, %llu us max\n",
+             (profile->name != NULL) ? profile->name : "mutex", (void *)mutex,
+             (unsigned long long)profile->count, (unsigned long long)profile->contended,
+             (unsigned long long)(profile->waitNs / 1000), (unsigned long long)(profile->maxWaitNs / 1000));
+
+    for (site = 0; (site < ARSAL_FASTMUTEX_PROFILE_SITES) && (profile->sites[site].function != NULL); site++)
+    {
+        ARSAL_FastMutex_Site_t *entry = &profile->sites[site];
+
+        fprintf (file, "    %s:%d%s : %llu locks, wait %llu us, hold %llu us total, %llu us max, blocked %llu\n",
+                 entry->function, entry->line, (site == ARSAL_FASTMUTEX_PROFILE_SITES - 1) ? " and others" : "",
+                 (unsigned long long)entry->count, (unsigned long long)(entry->waitNs / 1000),
+                 (unsigned long long)(entry->holdNs / 1000), (unsigned long long)(entry->maxHoldNs / 1000),
+                 (unsigned long long)entry->blocked);
+    }
+#else
+    (void)mutex;
+    (void)file;
+#endif
+}
+
+/**
+ * @brief Initializes a condition
+ *
+ * @param cond The condition to initialize
+ * @retval On success, ARSAL_FastCond_Init() returns 0. Otherwise, it returns an error number (See errno.h)
+ */
+static inline int ARSAL_FastCond_Init (ARSAL_FastCond_t *cond)
+{
+    if (cond == NULL)
+    {
+        return EINVAL;
+    }
+
+#if ARSAL_FASTMUTEX_FUTEX
+    cond->sequence = 0;
+    return 0;
+#elif defined(__APPLE__)
+    return pthread_cond_init (&cond->cond, NULL);
+#else
+    {
+        pthread_condattr_t attr;
+        int result = pthread_condattr_init (&attr);
+
+        if (result == 0)
+        {
+            pthread_condattr_setclock (&attr, CLOCK_MONOTONIC);
+            result = pthread_cond_init (&cond->cond, &attr);
+            pthread_condattr_destroy (&attr);
+        }
+        return result;
+    }
+#endif
+}
+
+/**
+ * @brief Destroys a condition
+ *
+ * @param cond The condition to destroy
+ * @retval On success, ARSAL_FastCond_Destroy() returns 0. Otherwise, it returns an error number (See errno.h)
+ */
+static inline int ARSAL_FastCond_Destroy (ARSAL_FastCond_t *cond)
+{
+#if ARSAL_FASTMUTEX_FUTEX
+    (void)cond;
+    return 0;
+#else
+    return pthread_cond_destroy (&cond->cond);
+#endif
+}
+
+/**
+ * @brief Waits on a condition until a deadline of the monotonic clock
+ * @note The deadline does not move with the changes of the system date, and can be reused as is after a spurious wake up.
+ *
+ * @param cond The condition to wait
+ * @param mutex The locked mutex linked to the condition
+ * @param deadline The time (see ARSAL_Time_GetMonotonicNs()) at which to return ETIMEDOUT, or ARSAL_TIME_MONOTONIC_INFINITE to wait without timeout
+ * @retval Returns 0 when woken up, ETIMEDOUT on timeout. Wake ups can be spurious.
+ */
+static inline int ARSAL_FastCond_TimedwaitNs (ARSAL_FastCond_t *cond, ARSAL_FastMutex_t *mutex, ARSAL_Time_Monotonic_t deadline)
+{
+    int result = 0;
+#ifdef ARSAL_FASTMUTEX_PROFILE
+    const char *function = NULL;
+    int line = 0;
+
+    if (mutex->profile.holder >= 0)
+    {
+        function = mutex->profile.sites[mutex->profile.holder].function;
+        line = mutex->profile.sites[mutex->profile.holder].line;
+    }
+    ARSAL_FastMutex_ProfileUnlocked (mutex);
+#endif
+
+#if ARSAL_FASTMUTEX_FUTEX
+    {
+        uint32_t sequence = __atomic_load_n (&cond->sequence, __ATOMIC_RELAXED);
+
+        ARSAL_FastMutex_Release (mutex);
+        if ((ARSAL_FastMutex_FutexWaitUntil (&cond->sequence, (int)sequence, deadline) != 0) && (errno == ETIMEDOUT))
+        {
+            result = ETIMEDOUT;
+        }
+        if (!ARSAL_FastMutex_TryAcquire (mutex))
+        {
+            ARSAL_FastMutex_AcquireSlow (mutex);
+        }
+    }
+#else
+    if (deadline == ARSAL_TIME_MONOTONIC_INFINITE)
+    {
+        result = pthread_cond_wait (&cond->cond, &mutex->mutex);
+    }
+    else
+    {
+        struct timespec limit;
+#if defined(__APPLE__)
+        /* Apple conditions only wait on the system clock : wait for the time left on the monotonic clock instead */
+        ARSAL_Time_NsToTimespec ((uint64_t)ARSAL_Time_GetRemainingNs (deadline), &limit);
+        result = pthread_cond_timedwait_relative_np (&cond->cond, &mutex->mutex, &limit);
+#else
+        /* the condition waits on CLOCK_MONOTONIC, see ARSAL_FastCond_Init() */
+        ARSAL_Time_NsToTimespec (deadline, &limit);
+        result = pthread_cond_timedwait (&cond->cond, &mutex->mutex, &limit);
+#endif
+    }
+#endif
+
+#ifdef ARSAL_FASTMUTEX_PROFILE
+    /* the wait for the condition is not contention : only the reacquisition is recorded */
+    ARSAL_FastMutex_ProfileLocked (mutex, (function != NULL) ? function : "ARSAL_FastCond_Timedwait", line, 0, -1);
+#endif
+
+    return result;
+}
+
+/**
+ * @brief Waits on a condition, with an optional timeout
+ *
+ * @param cond The condition to wait
+ * @param mutex The locked mutex linked to the condition
+ * @param timeout The time (ms) to wait before returning ETIMEDOUT, or a negative value to wait without timeout
+ * @retval Returns 0 when woken up, ETIMEDOUT on timeout. Wake ups can be spurious.
+ */
+static inline int ARSAL_FastCond_Timedwait (ARSAL_FastCond_t *cond, ARSAL_FastMutex_t *mutex, int timeout)
+{
+    return ARSAL_FastCond_TimedwaitNs (cond, mutex, ARSAL_Time_GetDeadlineNs ((timeout >= 0) ? (ARSAL_Time_Duration_t)timeout * 1000000LL : -1));
+}
+
+/**
+ * @brief Waits on a condition
+ *
+ * @param cond The condition to wait
+ * @param mutex The locked mutex linked to the condition
+ * @retval Returns 0 when woken up. Wake ups can be spurious.
+ */
+static inline int ARSAL_FastCond_Wait (ARSAL_FastCond_t *cond, ARSAL_FastMutex_t *mutex)
+{
+    return ARSAL_FastCond_Timedwait (cond, mutex, -1);
+}
+
+/**
+ * @brief Wakes one waiter of a condition up
+ *
+ * @param cond The condition to signal
+ * @retval On success, ARSAL_FastCond_Signal() returns 0. Otherwise, it returns an error number (See errno.h)
+ */
+static inline int ARSAL_FastCond_Signal (ARSAL_FastCond_t *cond)
+{
+#if ARSAL_FASTMUTEX_FUTEX
+    __atomic_fetch_add (&cond->sequence, 1, __ATOMIC_RELEASE);
+    ARSAL_FastMutex_Futex (&cond->sequence, FUTEX_WAKE_PRIVATE, 1, NULL);
+    return 0;
+#else
+    return pthread_cond_signal (&cond->cond);
+#endif
+}
+
+/**
+ * @brief Wakes all the waiters of a condition up
+ *
+ * @param cond The condition to broadcast
+ * @retval On success, ARSAL_FastCond_Broadcast() returns 0. Otherwise, it returns an error number (See errno.h)
+ */
+static inline int ARSAL_FastCond_Broadcast (ARSAL_FastCond_t *cond)
+{
+#if ARSAL_FASTMUTEX_FUTEX
+    __atomic_fetch_add (&cond->sequence, 1, __ATOMIC_RELEASE);
+    ARSAL_FastMutex_Futex (&cond->sequence, FUTEX_WAKE_PRIVATE, INT_MAX, NULL);
+    return 0;
+#else
+    return pthread_cond_broadcast (&cond->cond);
+#endif
+}
+
+#endif /* _ARSAL_FAST_MUTEX_H_ */
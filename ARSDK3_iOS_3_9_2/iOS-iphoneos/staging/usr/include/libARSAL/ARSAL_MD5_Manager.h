@@ -132,6 +132,8 @@ eARSAL_ERROR ARSAL_MD5_Manager_Check(ARSAL_MD5_Manager_t *manager, const char *f
  */
 eARSAL_ERROR ARSAL_MD5_Manager_Compute(ARSAL_MD5_Manager_t *manager, const char *filePath, uint8_t *md5, int md5Size);
 
+/* Batches of files : ARSAL_MD5_MultiBuffer_ComputeFiles () and ARSAL_MD5_MultiBuffer_CheckFiles () */
+#include "libARSAL/ARSAL_MD5_MultiBuffer.h"
 
 #endif /* _ARSAL_MD5_H_ */
 
@@ -0,0 +1,594 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file libARSAL/ARSAL_MD5_MultiBuffer.h
+ * @brief Multi-buffer MD5 : several independent streams hashed together, one per SIMD lane
+ * @note MD5 is sequential within a stream, so the parallelism comes from hashing ARSAL_MD5_MULTIBUFFER_LANES
+ * streams in lockstep. The kernel is written once with vector extensions : it builds to NEON on ARM, to SSE2
+ * or AVX2 on x86, AVX2 being chosen at run time. ARSAL_MD5_MultiBuffer_ComputeFiles() and
+ * ARSAL_MD5_MultiBuffer_CheckFiles() use it to hash a list of files with large aligned reads.
+ * @date 10/18/2026
+ */
+#ifndef _ARSAL_MD5_MULTIBUFFER_H_
+#define _ARSAL_MD5_MULTIBUFFER_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <libARSAL/ARSAL_Error.h>
+#include <libARSAL/ARSAL_Endianness.h>
+
+#ifndef ARSAL_MD5_LENGTH
+#define ARSAL_MD5_LENGTH        16
+#endif
+
+/**
+ * @brief Number of streams hashed together
+ */
+#define ARSAL_MD5_MULTIBUFFER_LANES 16
+
+/**
+ * @brief Size of the reads of ARSAL_MD5_MultiBuffer_ComputeFiles(), for each file
+ */
+#define ARSAL_MD5_MULTIBUFFER_READ_SIZE (256 * 1024)
+
+/**
+ * @brief INTERNAL : the state of every lane, as one vector per MD5 word
+ */
+typedef uint32_t ARSAL_MD5_MultiBuffer_Vector_t __attribute__ ((vector_size (ARSAL_MD5_MULTIBUFFER_LANES * 4)));
+
+/**
+ * @brief Multi-buffer MD5 context
+ */
+typedef struct
+{
+    uint32_t state[4][ARSAL_MD5_MULTIBUFFER_LANES] __attribute__ ((aligned (32))); /**< A, B, C and D of each lane */
+    uint8_t buffer[ARSAL_MD5_MULTIBUFFER_LANES][64]; /**< Partial block of each lane */
+    size_t buffered[ARSAL_MD5_MULTIBUFFER_LANES]; /**< Size of the partial block of each lane */
+    uint64_t length[ARSAL_MD5_MULTIBUFFER_LANES]; /**< Number of bytes hashed by each lane */
+} ARSAL_MD5_MultiBuffer_t;
+
+/**
+ * @brief INTERNAL : the MD5 functions and step, for ARSAL_MD5_MultiBuffer_Vector_t
+ */
+#define ARSAL_MD5_F(b, c, d) ((d) ^ ((b) & ((c) ^ (d))))
+#define ARSAL_MD5_G(b, c, d) ((c) ^ ((d) & ((b) ^ (c))))
+#define ARSAL_MD5_H(b, c, d) ((b) ^ (c) ^ (d))
+#define ARSAL_MD5_I(b, c, d) ((c) ^ ((b) | ~(d)))
+#define ARSAL_MD5_STEP(f, a, b, c, d, w, k, s)                                                  \
+    do                                                                                          \
+    {                                                                                           \
+        (a) += ARSAL_MD5_##f ((b), (c), (d)) + (w) + (uint32_t)(k);                             \
+        (a) = (b) + (((a) << (s)) | ((a) >> (32 - (s))));                                       \
+    } while (0)
+
+/**
+ * @brief INTERNAL : the MD5 rounds, for ARSAL_MD5_MultiBuffer_Vector_t
+ * @param state The state of the lanes, updated only for the lanes of mask
+ * @param words The 16 words of the block of each lane
+ * @param mask All ones for the lanes which have a block, zero for the others
+ */
+#define ARSAL_MD5_MULTIBUFFER_ROUNDS(state, words, mask)                                        \
+    do                                                                                          \
+    {                                                                                           \
+        ARSAL_MD5_MultiBuffer_Vector_t w[16], a, b, c, d, a0, b0, c0, d0, m;                    \
+        memcpy (w, (words), sizeof (w));                                                        \
+        memcpy (&m, (mask), sizeof (m));                                                        \
+        memcpy (&a, (state)[0], sizeof (a));                                                    \
+        memcpy (&b, (state)[1], sizeof (b));                                                    \
+        memcpy (&c, (state)[2], sizeof (c));                                                    \
+        memcpy (&d, (state)[3], sizeof (d));                                                    \
+        a0 = a;                                                                                 \
+        b0 = b;                                                                                 \
+        c0 = c;                                                                                 \
+        d0 = d;                                                                                 \
+        ARSAL_MD5_STEP (F, a, b, c, d, w[0], 0xd76aa478, 7);                                    \
+        ARSAL_MD5_STEP (F, d, a, b, c, w[1], 0xe8c7b756, 12);                                   \
+        ARSAL_MD5_STEP (F, c, d, a, b, w[2], 0x242070db, 17);                                   \
+        ARSAL_MD5_STEP (F, b, c, d, a, w[3], 0xc1bdceee, 22);                                   \
+        ARSAL_MD5_STEP (F, a, b, c, d, w[4], 0xf57c0faf, 7);                                    \
+        ARSAL_MD5_STEP (F, d, a, b, c, w[5], 0x4787c62a, 12);                                   \
+        ARSAL_MD5_STEP (F, c, d, a, b, w[6], 0xa8304613, 17);                                   \
+        ARSAL_MD5_STEP (F, b, c, d, a, w[7], 0xfd469501, 22);                                   \
+        ARSAL_MD5_STEP (F, a, b, c, d, w[8], 0x698098d8, 7);                                    \
+        ARSAL_MD5_STEP (F, d, a, b, c, w[9], 0x8b44f7af, 12);                                   \
+        ARSAL_MD5_STEP (F, c, d, a, b, w[10], 0xffff5bb1, 17);                                  \
+        ARSAL_MD5_STEP (F, b, c, d, a, w[11], 0x895cd7be, 22);                                  \
+        ARSAL_MD5_STEP (F, a, b, c, d, w[12], 0x6b901122, 7);                                   \
+        ARSAL_MD5_STEP (F, d, a, b, c, w[13], 0xfd987193, 12);                                  \
+        ARSAL_MD5_STEP (F, c, d, a, b, w[14], 0xa679438e, 17);                                  \
+        ARSAL_MD5_STEP (F, b, c, d, a, w[15], 0x49b40821, 22);                                  \
+        ARSAL_MD5_STEP (G, a, b, c, d, w[1], 0xf61e2562, 5);                                    \
+        ARSAL_MD5_STEP (G, d, a, b, c, w[6], 0xc040b340, 9);                                    \
+        ARSAL_MD5_STEP (G, c, d, a, b, w[11], 0x265e5a51, 14);                                  \
+        ARSAL_MD5_STEP (G, b, c, d, a, w[0], 0xe9b6c7aa, 20);                                   \
+        ARSAL_MD5_STEP (G, a, b, c, d, w[5], 0xd62f105d, 5);                                    \
+        ARSAL_MD5_STEP (G, d, a, b, c, w[10], 0x02441453, 9);                                   \
+        ARSAL_MD5_STEP (G, c, d, a, b, w[15], 0xd8a1e681, 14);                                  \
+        ARSAL_MD5_STEP (G, b, c, d, a, w[4], 0xe7d3fbc8, 20);                                   \
+        ARSAL_MD5_STEP (G, a, b, c, d, w[9], 0x21e1cde6, 5);                                    \
+        ARSAL_MD5_STEP (G, d, a, b, c, w[14], 0xc33707d6, 9);                                   \
+        ARSAL_MD5_STEP (G, c, d, a, b, w[3], 0xf4d50d87, 14);                                   \
+        ARSAL_MD5_STEP (G, b, c, d, a, w[8], 0x455a14ed, 20);                                   \
+        ARSAL_MD5_STEP (G, a, b, c, d, w[13], 0xa9e3e905, 5);                                   \
+        ARSAL_MD5_STEP (G, d, a, b, c, w[2], 0xfcefa3f8, 9);                                    \
+        ARSAL_MD5_STEP (G, c, d, a, b, w[7], 0x676f02d9, 14);                                   \
+        ARSAL_MD5_STEP (G, b, c, d, a, w[12], 0x8d2a4c8a, 20);                                  \
+        ARSAL_MD5_STEP (H, a, b, c, d, w[5], 0xfffa3942, 4);                                    \
+        ARSAL_MD5_STEP (H, d, a, b, c, w[8], 0x8771f681, 11);                                   \
+        ARSAL_MD5_STEP (H, c, d, a, b, w[11], 0x6d9d6122, 16);                                  \
+        ARSAL_MD5_STEP (H, b, c, d, a, w[14], 0xfde5380c, 23);                                  \
+        ARSAL_MD5_STEP (H, a, b, c, d, w[1], 0xa4beea44, 4);                                    \
+        ARSAL_MD5_STEP (H, d, a, b, c, w[4], 0x4bdecfa9, 11);                                   \
+        ARSAL_MD5_STEP (H, c, d, a, b, w[7], 0xf6bb4b60, 16);                                   \
+        ARSAL_MD5_STEP (H, b, c, d, a, w[10], 0xbebfbc70, 23);                                  \
+        ARSAL_MD5_STEP (H, a, b, c, d, w[13], 0x289b7ec6, 4);                                   \
+        ARSAL_MD5_STEP (H, d, a, b, c, w[0], 0xeaa127fa, 11);                                   \
+        ARSAL_MD5_STEP (H, c, d, a, b, w[3], 0xd4ef3085, 16);                                   \
+        ARSAL_MD5_STEP (H, b, c, d, a, w[6], 0x04881d05, 23);                                   \
+        ARSAL_MD5_STEP (H, a, b, c, d, w[9], 0xd9d4d039, 4);                                    \
+        ARSAL_MD5_STEP (H, d, a, b, c, w[12], 0xe6db99e5, 11);                                  \
+        ARSAL_MD5_STEP (H, c, d, a, b, w[15], 0x1fa27cf8, 16);                                  \
+        ARSAL_MD5_STEP (H, b, c, d, a, w[2], 0xc4ac5665, 23);                                   \
+        ARSAL_MD5_STEP (I, a, b, c, d, w[0], 0xf4292244, 6);                                    \
+        ARSAL_MD5_STEP (I, d, a, b, c, w[7], 0x432aff97, 10);                                   \
+        ARSAL_MD5_STEP (I, c, d, a, b, w[14], 0xab9423a7, 15);                                  \
+        ARSAL_MD5_STEP (I, b, c, d, a, w[5], 0xfc93a039, 21);                                   \
+        ARSAL_MD5_STEP (I, a, b, c, d, w[12], 0x655b59c3, 6);                                   \
+        ARSAL_MD5_STEP (I, d, a, b, c, w[3], 0x8f0ccc92, 10);                                   \
+        ARSAL_MD5_STEP (I, c, d, a, b, w[10], 0xffeff47d, 15);                                  \
+        ARSAL_MD5_STEP (I, b, c, d, a, w[1], 0x85845dd1, 21);                                   \
+        ARSAL_MD5_STEP (I, a, b, c, d, w[8], 0x6fa87e4f, 6);                                    \
+        ARSAL_MD5_STEP (I, d, a, b, c, w[15], 0xfe2ce6e0, 10);                                  \
+        ARSAL_MD5_STEP (I, c, d, a, b, w[6], 0xa3014314, 15);                                   \
+        ARSAL_MD5_STEP (I, b, c, d, a, w[13], 0x4e0811a1, 21);                                  \
+        ARSAL_MD5_STEP (I, a, b, c, d, w[4], 0xf7537e82, 6);                                    \
+        ARSAL_MD5_STEP (I, d, a, b, c, w[11], 0xbd3af235, 10);                                  \
+        ARSAL_MD5_STEP (I, c, d, a, b, w[2], 0x2ad7d2bb, 15);                                   \
+        ARSAL_MD5_STEP (I, b, c, d, a, w[9], 0xeb86d391, 21);                                   \
+        a = a0 + (a & m);                                                                       \
+        b = b0 + (b & m);                                                                       \
+        c = c0 + (c & m);                                                                       \
+        d = d0 + (d & m);                                                                       \
+        memcpy ((state)[0], &a, sizeof (a));                                                    \
+        memcpy ((state)[1], &b, sizeof (b));                                                    \
+        memcpy ((state)[2], &c, sizeof (c));                                                    \
+        memcpy ((state)[3], &d, sizeof (d));                                                    \
+    } while (0)
+
+/**
+ * @brief INTERNAL FUNCTION : Hash one block per lane, with the baseline vector instructions
+ * @param state The state of the lanes
+ * @param blocks The block of each lane, 64 bytes
+ * @param mask All ones for the lanes which have a block, zero for the others
+ */
+static inline void ARSAL_MD5_MultiBuffer_Blocks (uint32_t state[4][ARSAL_MD5_MULTIBUFFER_LANES], const uint8_t *const blocks[ARSAL_MD5_MULTIBUFFER_LANES], const uint32_t mask[ARSAL_MD5_MULTIBUFFER_LANES])
+{
+    uint32_t words[16][ARSAL_MD5_MULTIBUFFER_LANES] __attribute__ ((aligned (32)));
+    int word = 0;
+    int lane = 0;
+
+    /* transposes the blocks : one vector per word */
+    for (word = 0; word < 16; word++)
+    {
+        for (lane = 0; lane < ARSAL_MD5_MULTIBUFFER_LANES; lane++)
+        {
+            memcpy (&words[word][lane], &blocks[lane][word * 4], 4);
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+            words[word][lane] = __builtin_bswap32 (words[word][lane]);
+#endif
+        }
+    }
+
+    ARSAL_MD5_MULTIBUFFER_ROUNDS (state, words, mask);
+}
+
+#if defined(ARSAL_ENDIANNESS_X86)
+/**
+ * @brief INTERNAL FUNCTION : Hash one block per lane, with AVX2
+ * @note The blocks are transposed by 8 x 8 words tiles, with unpacks and lane permutes.
+ */
+__attribute__ ((target ("avx2")))
+static inline void ARSAL_MD5_MultiBuffer_BlocksAVX2 (uint32_t state[4][ARSAL_MD5_MULTIBUFFER_LANES], const uint8_t *const blocks[ARSAL_MD5_MULTIBUFFER_LANES], const uint32_t mask[ARSAL_MD5_MULTIBUFFER_LANES])
+{
+    uint32_t words[16][ARSAL_MD5_MULTIBUFFER_LANES] __attribute__ ((aligned (32)));
+    int group = 0;
+    int half = 0;
+
+    for (group = 0; group < ARSAL_MD5_MULTIBUFFER_LANES; group += 8)
+    {
+        for (half = 0; half < 2; half++)
+        {
+            __m256i r[8], t[8], u[8];
+            int index = 0;
+
+            for (index = 0; index < 8; index++)
+            {
+                r[index] = _mm256_loadu_si256 ((const __m256i *)(blocks[group + index] + 32 * half));
+            }
+            for (index = 0; index < 8; index += 2)
+            {
+                t[index] = _mm256_unpacklo_epi32 (r[index], r[index + 1]);
+                t[index + 1] = _mm256_unpackhi_epi32 (r[index], r[index + 1]);
+            }
+            for (index = 0; index < 8; index += 4)
+            {
+                u[index] = _mm256_unpacklo_epi64 (t[index], t[index + 2]);
+                u[index + 1] = _mm256_unpackhi_epi64 (t[index], t[index + 2]);
+                u[index + 2] = _mm256_unpacklo_epi64 (t[index + 1], t[index + 3]);
+                u[index + 3] = _mm256_unpackhi_epi64 (t[index + 1], t[index + 3]);
+            }
+            for (index = 0; index < 4; index++)
+            {
+                _mm256_store_si256 ((__m256i *)&words[8 * half + index][group], _mm256_permute2x128_si256 (u[index], u[index + 4], 0x20));
+                _mm256_store_si256 ((__m256i *)&words[8 * half + index + 4][group], _mm256_permute2x128_si256 (u[index], u[index + 4], 0x31));
+            }
+        }
+    }
+
+    ARSAL_MD5_MULTIBUFFER_ROUNDS (state, words, mask);
+}
+#endif
+
+/**
+ * @brief Reset a lane to start a new stream
+ * @param context The context
+ * @param lane The lane, from 0 to ARSAL_MD5_MULTIBUFFER_LANES - 1
+ */
+static inline void ARSAL_MD5_MultiBuffer_Reset (ARSAL_MD5_MultiBuffer_t *context, int lane)
+{
+    context->state[0][lane] = 0x67452301;
+    context->state[1][lane] = 0xefcdab89;
+    context->state[2][lane] = 0x98badcfe;
+    context->state[3][lane] = 0x10325476;
+    context->buffered[lane] = 0;
+    context->length[lane] = 0;
+}
+
+/**
+ * @brief Initialize a context, with every lane reset
+ * @param context The context
+ */
+static inline void ARSAL_MD5_MultiBuffer_Init (ARSAL_MD5_MultiBuffer_t *context)
+{
+    int lane = 0;
+
+    for (lane = 0; lane < ARSAL_MD5_MULTIBUFFER_LANES; lane++)
+    {
+        ARSAL_MD5_MultiBuffer_Reset (context, lane);
+    }
+}
+
+/**
+ * @brief Hash data on every lane
+ * @note The lanes advance together, one block each per step : the throughput is best when the lanes get
+ * data of similar sizes. A lane without data, or with less than a block, keeps it for the next call.
+ * @param context The context
+ * @param data The data of each lane, NULL for none
+ * @param size The size of the data of each lane
+ */
+static inline void ARSAL_MD5_MultiBuffer_Update (ARSAL_MD5_MultiBuffer_t *context, const uint8_t *const data[ARSAL_MD5_MULTIBUFFER_LANES], const size_t size[ARSAL_MD5_MULTIBUFFER_LANES])
+{
+    uint32_t mask[ARSAL_MD5_MULTIBUFFER_LANES] __attribute__ ((aligned (32)));
+    const uint8_t *blocks[ARSAL_MD5_MULTIBUFFER_LANES];
+    static const uint8_t zeros[64] = { 0 };
+    size_t position[ARSAL_MD5_MULTIBUFFER_LANES];
+    int avx2 = 0;
+    int lane = 0;
+
+#if defined(ARSAL_ENDIANNESS_X86)
+    avx2 = (ARSAL_Endianness_GetKernel () == ARSAL_ENDIANNESS_KERNEL_AVX2);
+#endif
+
+    for (lane = 0; lane < ARSAL_MD5_MULTIBUFFER_LANES; lane++)
+    {
+        position[lane] = 0;
+        if (data[lane] != NULL)
+        {
+            context->length[lane] += size[lane];
+        }
+    }
+
+    for (;;)
+    {
+        int active = 0;
+        int full = 1;
+
+        /* fast path : every lane has a whole block in its data */
+        for (lane = 0; (lane < ARSAL_MD5_MULTIBUFFER_LANES) && full; lane++)
+        {
+            full = (data[lane] != NULL) && (context->buffered[lane] == 0) && (size[lane] - position[lane] >= 64);
+        }
+        if (full)
+        {
+            for (lane = 0; lane < ARSAL_MD5_MULTIBUFFER_LANES; lane++)
+            {
+                blocks[lane] = &data[lane][position[lane]];
+                position[lane] += 64;
+                mask[lane] = 0xFFFFFFFF;
+            }
+            active = ARSAL_MD5_MULTIBUFFER_LANES;
+        }
+
+        for (lane = 0; (lane < ARSAL_MD5_MULTIBUFFER_LANES) && !full; lane++)
+        {
+            const uint8_t *block = NULL;
+            size_t remaining = (data[lane] != NULL) ? size[lane] - position[lane] : 0;
+
+            if (context->buffered[lane] + remaining >= 64)
+            {
+                if (context->buffered[lane] > 0)
+                {
+                    size_t missing = 64 - context->buffered[lane];
+                    memcpy (&context->buffer[lane][context->buffered[lane]], &data[lane][position[lane]], missing);
+                    position[lane] += missing;
+                    context->buffered[lane] = 0;
+                    block = context->buffer[lane];
+                }
+                else
+                {
+                    block = &data[lane][position[lane]];
+                    position[lane] += 64;
+                }
+            }
+            else if (remaining > 0)
+            {
+                memcpy (&context->buffer[lane][context->buffered[lane]], &data[lane][position[lane]], remaining);
+                context->buffered[lane] += remaining;
+                position[lane] += remaining;
+            }
+
+            mask[lane] = (block != NULL) ? 0xFFFFFFFF : 0;
+            blocks[lane] = (block != NULL) ? block : zeros;
+            active += (block != NULL);
+        }
+
+        if (active == 0)
+        {
+            break;
+        }
+
+#if defined(ARSAL_ENDIANNESS_X86)
+        if (avx2)
+        {
+            ARSAL_MD5_MultiBuffer_BlocksAVX2 (context->state, blocks, mask);
+            continue;
+        }
+#endif
+        ARSAL_MD5_MultiBuffer_Blocks (context->state, blocks, mask);
+    }
+
+    (void)avx2;
+}
+
+/**
+ * @brief Finish the stream of a lane
+ * @note The lane must be reset before hashing a new stream.
+ * @param context The context
+ * @param lane The lane
+ * @param[out] md5 The MD5 of the stream
+ */
+static inline void ARSAL_MD5_MultiBuffer_Final (ARSAL_MD5_MultiBuffer_t *context, int lane, uint8_t md5[ARSAL_MD5_LENGTH])
+{
+    const uint8_t *data[ARSAL_MD5_MULTIBUFFER_LANES] = { NULL };
+    size_t size[ARSAL_MD5_MULTIBUFFER_LANES] = { 0 };
+    uint8_t padding[72] = { 0x80 };
+    uint64_t bits = context->length[lane] * 8;
+    size_t padSize = ((context->buffered[lane] < 56) ? 56 : 120) - context->buffered[lane];
+    int index = 0;
+
+    for (index = 0; index < 8; index++)
+    {
+        padding[padSize + index] = (uint8_t)(bits >> (8 * index));
+    }
+
+    data[lane] = padding;
+    size[lane] = padSize + 8;
+    ARSAL_MD5_MultiBuffer_Update (context, data, size);
+
+    for (index = 0; index < ARSAL_MD5_LENGTH; index++)
+    {
+        md5[index] = (uint8_t)(context->state[index / 4][lane] >> (8 * (index % 4)));
+    }
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Hash files, and compare them to their expected MD5 when md5Txts is not NULL
+ */
+static inline eARSAL_ERROR ARSAL_MD5_MultiBuffer_HashFiles (const char *const *filePaths, const char *const *md5Txts, int count, uint8_t (*md5s)[ARSAL_MD5_LENGTH], eARSAL_ERROR *results)
+{
+    ARSAL_MD5_MultiBuffer_t context;
+    const uint8_t *data[ARSAL_MD5_MULTIBUFFER_LANES];
+    size_t size[ARSAL_MD5_MULTIBUFFER_LANES];
+    int fds[ARSAL_MD5_MULTIBUFFER_LANES];
+    int files[ARSAL_MD5_MULTIBUFFER_LANES];
+    void *buffers = NULL;
+    eARSAL_ERROR error = ARSAL_OK;
+    int next = 0;
+    int lane = 0;
+
+    if ((filePaths == NULL) || (count < 0) || ((md5s == NULL) && (md5Txts == NULL)))
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    /* page aligned buffers, so that the reads go straight to the buffer cache pages */
+    if (posix_memalign (&buffers, 4096, (size_t)ARSAL_MD5_MULTIBUFFER_LANES * ARSAL_MD5_MULTIBUFFER_READ_SIZE) != 0)
+    {
+        return ARSAL_ERROR_ALLOC;
+    }
+
+    ARSAL_MD5_MultiBuffer_Init (&context);
+    for (lane = 0; lane < ARSAL_MD5_MULTIBUFFER_LANES; lane++)
+    {
+        fds[lane] = -1;
+    }
+
+    for (;;)
+    {
+        int reading = 0;
+
+        for (lane = 0; lane < ARSAL_MD5_MULTIBUFFER_LANES; lane++)
+        {
+            /* an idle lane takes the next file */
+            while ((fds[lane] < 0) && (next < count))
+            {
+                files[lane] = next++;
+                fds[lane] = (filePaths[files[lane]] != NULL) ? open (filePaths[files[lane]], O_RDONLY) : -1;
+                if (fds[lane] < 0)
+                {
+                    if (results != NULL)
+                    {
+                        results[files[lane]] = ARSAL_ERROR_FILE;
+                    }
+                    error = (error == ARSAL_OK) ? ARSAL_ERROR_FILE : error;
+                    continue;
+                }
+#if defined(__APPLE__)
+                fcntl (fds[lane], F_RDAHEAD, 1);
+#elif defined(POSIX_FADV_SEQUENTIAL)
+                posix_fadvise (fds[lane], 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+                ARSAL_MD5_MultiBuffer_Reset (&context, lane);
+            }
+
+            data[lane] = NULL;
+            size[lane] = 0;
+            if (fds[lane] >= 0)
+            {
+                uint8_t *buffer = (uint8_t *)buffers + (size_t)lane * ARSAL_MD5_MULTIBUFFER_READ_SIZE;
+                ssize_t readSize = read (fds[lane], buffer, ARSAL_MD5_MULTIBUFFER_READ_SIZE);
+
+                if (readSize > 0)
+                {
+                    data[lane] = buffer;
+                    size[lane] = (size_t)readSize;
+                    reading++;
+                }
+                else
+                {
+                    eARSAL_ERROR result = ARSAL_OK;
+                    uint8_t md5[ARSAL_MD5_LENGTH];
+
+                    if (readSize < 0)
+                    {
+                        result = ARSAL_ERROR_FILE;
+                    }
+                    else
+                    {
+                        ARSAL_MD5_MultiBuffer_Final (&context, lane, md5);
+                        if (md5s != NULL)
+                        {
+                            memcpy (md5s[files[lane]], md5, ARSAL_MD5_LENGTH);
+                        }
+                        if (md5Txts != NULL)
+                        {
+                            static const char hex[] = "0123456789abcdef";
+                            const char *md5Txt = md5Txts[files[lane]];
+                            int index = 0;
+
+                            for (index = 0; (index < ARSAL_MD5_LENGTH) && (result == ARSAL_OK); index++)
+                            {
+                                if ((md5Txt == NULL) ||
+                                    ((md5Txt[2 * index] | 0x20) != hex[md5[index] >> 4]) ||
+                                    ((md5Txt[2 * index + 1] | 0x20) != hex[md5[index] & 0xF]))
+                                {
+                                    result = ARSAL_ERROR_MD5;
+                                }
+                            }
+                        }
+                    }
+
+                    close (fds[lane]);
+                    fds[lane] = -1;
+                    if (results != NULL)
+                    {
+                        results[files[lane]] = result;
+                    }
+                    error = (error == ARSAL_OK) ? result : error;
+                    /* takes the next file on the next step */
+                    reading += (next < count);
+                }
+            }
+        }
+
+        if (reading == 0)
+        {
+            break;
+        }
+
+        ARSAL_MD5_MultiBuffer_Update (&context, data, size);
+    }
+
+    free (buffers);
+
+    return error;
+}
+
+/**
+ * @brief Compute the MD5 of several files, hashed together
+ * @param filePaths The paths of the files
+ * @param count The number of files
+ * @param[out] md5s The MD5 of each file
+ * @param[out] results The result of each file : ARSAL_OK, or ARSAL_ERROR_FILE if it could not be read ; may be NULL
+ * @retval On success, returns ARSAL_OK. Otherwise, it returns the first error of the files, or an error of the batch
+ */
+static inline eARSAL_ERROR ARSAL_MD5_MultiBuffer_ComputeFiles (const char *const *filePaths, int count, uint8_t (*md5s)[ARSAL_MD5_LENGTH], eARSAL_ERROR *results)
+{
+    if (md5s == NULL)
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    return ARSAL_MD5_MultiBuffer_HashFiles (filePaths, NULL, count, md5s, results);
+}
+
+/**
+ * @brief Check the MD5 of several files, hashed together
+ * @param filePaths The paths of the files
+ * @param md5Txts The expected MD5 of each file, as hexadecimal strings
+ * @param count The number of files
+ * @param[out] results The result of each file : ARSAL_OK, ARSAL_ERROR_MD5 if it does not match, or ARSAL_ERROR_FILE ; may be NULL
+ * @retval On success, returns ARSAL_OK. Otherwise, it returns the first error of the files, or an error of the batch
+ */
+static inline eARSAL_ERROR ARSAL_MD5_MultiBuffer_CheckFiles (const char *const *filePaths, const char *const *md5Txts, int count, eARSAL_ERROR *results)
+{
+    if (md5Txts == NULL)
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    return ARSAL_MD5_MultiBuffer_HashFiles (filePaths, md5Txts, count, NULL, results);
+}
+
+#endif /* _ARSAL_MD5_MULTIBUFFER_H_ */
@@ -0,0 +1,1289 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file libARSAL/ARSAL_PrintAsync.h
+ * @brief Asynchronous logging backend with deferred formatting
+ * @note A logging thread only copies the format pointer, the level, the tag, the time and the
+ * raw arguments of a message into a ring it owns ; strings are the only arguments which are
+ * copied by value. A background thread drains the rings of all the threads and formats the
+ * messages as text, or dumps them in binary for ARSAL_PrintAsync_Decode(). When a ring is full
+ * the message is dropped and counted instead of blocking the thread that logs.
+ * @date 10/18/2026
+ */
+#ifndef _ARSAL_PRINT_ASYNC_H_
+#define _ARSAL_PRINT_ASYNC_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <libARSAL/ARSAL_Error.h>
+#include <libARSAL/ARSAL_Allocator.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Mutex.h>
+#include <libARSAL/ARSAL_Sem.h>
+#include <libARSAL/ARSAL_Thread.h>
+
+/**
+ * @brief Size in bytes of the ring of each logging thread ; must be a power of two
+ */
+#define ARSAL_PRINTASYNC_RING_SIZE (64 * 1024)
+
+/**
+ * @brief Maximum size of the raw arguments of a message
+ */
+#define ARSAL_PRINTASYNC_ARGS_SIZE 1024
+
+/**
+ * @brief Maximum number of characters copied from a string argument
+ */
+#define ARSAL_PRINTASYNC_STRING_SIZE 256
+
+/**
+ * @brief Position returned when a raw argument is missing or of another type
+ */
+#define ARSAL_PRINTASYNC_BAD_POSITION ((size_t)-1)
+
+/**
+ * @brief INTERNAL : Precision of a conversion without precision
+ */
+#define ARSAL_PRINTASYNC_NO_PRECISION (-1)
+
+/**
+ * @brief INTERNAL : Precision of a conversion given by a '*' argument
+ */
+#define ARSAL_PRINTASYNC_STAR_PRECISION (-2)
+
+/**
+ * @brief Maximum size of a formatted message
+ */
+#define ARSAL_PRINTASYNC_LINE_SIZE 1024
+
+/**
+ * @brief Time the background thread waits for messages when the rings are empty, in milliseconds
+ */
+#define ARSAL_PRINTASYNC_IDLE_MS 20
+
+/**
+ * @brief Magic at the start of a binary dump
+ */
+#define ARSAL_PRINTASYNC_BINARY_MAGIC "ARSALPA1"
+
+/**
+ * @brief Size of ARSAL_PRINTASYNC_BINARY_MAGIC
+ */
+#define ARSAL_PRINTASYNC_BINARY_MAGIC_SIZE 8
+
+/**
+ * @brief Log a message through an asynchronous logger
+ * @note Same message as ARSAL_PRINT(), but only the raw arguments are copied on the calling thread.
+ * The format must be a string literal, which is checked at build time.
+ * @param logger The asynchronous logger (ARSAL_PrintAsync_t *)
+ * @param level The print level (eARSAL_PRINT_LEVEL enum)
+ * @param tag A short tag ; must remain valid for the life of the logger
+ * @param format The format string to print
+ * @param ... The format parameters
+ */
+#define ARSAL_PRINT_ASYNC(logger, level, tag, format, ...)             \
+    do                                                                  \
+    {                                                                   \
+        static int __tagSlot = 0;                                       \
+        if (ARSAL_PRINT_IS_ENABLED (level, tag, __tagSlot))             \
+        {                                                               \
+            ARSAL_PrintAsync_Push ((logger), (level), (tag), __FUNCTION__, __LINE__, "" format, ##__VA_ARGS__); \
+        }                                                               \
+    } while (0)
+
+/**
+ * @brief Define an ARSAL_Print_Callback_t function forwarding the ARSAL_PRINT() messages to an asynchronous logger
+ * @note The messages are copied with their format, which can be built at runtime.
+ * @param name The name of the function to define
+ * @param logger An expression giving the logger, evaluated for each message
+ * @see ARSAL_Print_SetCallback()
+ */
+#define ARSAL_PRINTASYNC_DEFINE_CALLBACK(name, logger)                  \
+    static int name (eARSAL_PRINT_LEVEL level, const char *tag, const char *format, va_list va) \
+    {                                                                   \
+        return ARSAL_PrintAsync_PushCopyV ((logger), level, tag, format, va); \
+    }
+
+/**
+ * @brief Output of an asynchronous logger
+ */
+typedef enum
+{
+    ARSAL_PRINTASYNC_OUTPUT_TEXT = 0, /**< Messages are formatted as text */
+    ARSAL_PRINTASYNC_OUTPUT_BINARY, /**< Messages are dumped in binary, see ARSAL_PrintAsync_Decode() */
+    ARSAL_PRINTASYNC_OUTPUT_MAX, /**< Max of the enum, do not use */
+} eARSAL_PRINTASYNC_OUTPUT;
+
+/**
+ * @brief Type of a raw argument
+ */
+typedef enum
+{
+    ARSAL_PRINTASYNC_ARG_NONE = 0, /**< No argument (%%, %n) */
+    ARSAL_PRINTASYNC_ARG_INT, /**< int, and the smaller promoted types */
+    ARSAL_PRINTASYNC_ARG_LONG, /**< long */
+    ARSAL_PRINTASYNC_ARG_LONG_LONG, /**< long long */
+    ARSAL_PRINTASYNC_ARG_INTMAX, /**< intmax_t */
+    ARSAL_PRINTASYNC_ARG_SIZE, /**< size_t */
+    ARSAL_PRINTASYNC_ARG_PTRDIFF, /**< ptrdiff_t */
+    ARSAL_PRINTASYNC_ARG_DOUBLE, /**< double, and float */
+    ARSAL_PRINTASYNC_ARG_LONG_DOUBLE, /**< long double */
+    ARSAL_PRINTASYNC_ARG_POINTER, /**< pointer */
+    ARSAL_PRINTASYNC_ARG_STRING, /**< string, copied as a 16 bits length and its characters */
+    ARSAL_PRINTASYNC_ARG_INVALID, /**< Unsupported conversion, the rest of the format is printed as is */
+} eARSAL_PRINTASYNC_ARG;
+
+/**
+ * @brief Flags of a message
+ */
+typedef enum
+{
+    ARSAL_PRINTASYNC_FLAG_COPY = (1 << 0), /**< The format and the tag are copied as the first two string arguments */
+} eARSAL_PRINTASYNC_FLAG;
+
+/**
+ * @brief Binary dump record types
+ */
+typedef enum
+{
+    ARSAL_PRINTASYNC_RECORD_STRING = 1, /**< Definition of a string : id (uint32), length (uint16), characters */
+    ARSAL_PRINTASYNC_RECORD_MESSAGE, /**< Message : ARSAL_PrintAsync_Message_t with string ids, then the raw arguments */
+    ARSAL_PRINTASYNC_RECORD_DROPPED, /**< Number of dropped messages (uint32) */
+} eARSAL_PRINTASYNC_RECORD;
+
+/**
+ * @brief Header of a message, in the rings and in the binary dumps
+ * @note In the rings the strings are pointers ; in the binary dumps they are ids of string records.
+ */
+typedef struct
+{
+    uint32_t size; /**< Size of the message, header included, rounded up to 8 bytes in the rings */
+    uint8_t level; /**< eARSAL_PRINT_LEVEL of the message */
+    uint8_t flags; /**< eARSAL_PRINTASYNC_FLAG of the message */
+    uint16_t argsSize; /**< Size of the raw arguments following the header */
+    int32_t line; /**< Line of the call */
+    int32_t nsec; /**< Nanoseconds of the time of the call */
+    int64_t sec; /**< Seconds of the time of the call */
+    union
+    {
+        const char *pointer; /**< String, in the rings */
+        uint64_t id; /**< String id, in the binary dumps */
+    } tag, function, format; /**< Tag, function and format of the call */
+} ARSAL_PrintAsync_Message_t;
+
+/**
+ * @brief Ring of a logging thread
+ */
+typedef struct ARSAL_PrintAsync_Ring_t
+{
+    uint8_t *data; /**< Ring buffer of ARSAL_PRINTASYNC_RING_SIZE bytes */
+    uint64_t head; /**< Write position, only written by the logging thread */
+    uint64_t tail; /**< Read position, only written by the background thread */
+    uint32_t dropped; /**< Number of messages dropped because the ring was full */
+    uint32_t reported; /**< Number of dropped messages already reported */
+    int orphan; /**< 1 once the logging thread exited */
+    struct ARSAL_PrintAsync_Ring_t *next; /**< Next ring of the logger */
+} ARSAL_PrintAsync_Ring_t;
+
+/**
+ * @brief Asynchronous logger
+ */
+typedef struct
+{
+    eARSAL_PRINTASYNC_OUTPUT output; /**< Output of the logger */
+    FILE *file; /**< Output file */
+    pthread_key_t key; /**< Key of the ring of the calling thread */
+    ARSAL_Mutex_t mutex; /**< Protects the list of rings */
+    ARSAL_Sem_t sem; /**< Wakes the background thread up when a ring gets half full or when stopping */
+    ARSAL_Thread_t thread; /**< Background thread */
+    int stop; /**< 1 when the background thread must stop */
+    ARSAL_PrintAsync_Ring_t *rings; /**< Rings of the logging threads */
+    const char **strings; /**< Strings already defined in the binary dump, indexed by hash */
+    uint32_t *stringIds; /**< Ids of the strings already defined */
+    uint32_t stringCapacity; /**< Size of the string hash table, a power of two */
+    uint32_t stringCount; /**< Number of strings already defined */
+} ARSAL_PrintAsync_t;
+
+/**
+ * @brief INTERNAL FUNCTION : Parse a conversion specification
+ * @param spec The specification, starting after the '%'
+ * @param[out] stars Number of '*' width and precision arguments
+ * @param[out] precision The precision, ARSAL_PRINTASYNC_NO_PRECISION if none, ARSAL_PRINTASYNC_STAR_PRECISION if given by the last '*' argument
+ * @param[out] type Type of the argument
+ * @return The length of the specification, conversion character included
+ */
+static inline size_t ARSAL_PrintAsync_ParseSpec (const char *spec, int *stars, int *precision, eARSAL_PRINTASYNC_ARG *type)
+{
+    const char *cursor = spec;
+    int longs = 0;
+    char modifier = '\0';
+
+    *stars = 0;
+    *precision = ARSAL_PRINTASYNC_NO_PRECISION;
+    *type = ARSAL_PRINTASYNC_ARG_INVALID;
+
+    while ((*cursor != '\0') && (strchr ("-+ #0'", *cursor) != NULL))
+    {
+        cursor++;
+    }
+    if (*cursor == '*')
+    {
+        (*stars)++;
+        cursor++;
+    }
+    while ((*cursor >= '0') && (*cursor <= '9'))
+    {
+        cursor++;
+    }
+    if (*cursor == '.')
+    {
+        cursor++;
+        *precision = 0;
+        if (*cursor == '*')
+        {
+            (*stars)++;
+            *precision = ARSAL_PRINTASYNC_STAR_PRECISION;
+            cursor++;
+        }
+        while ((*cursor >= '0') && (*cursor <= '9'))
+        {
+            if (*precision < ARSAL_PRINTASYNC_STRING_SIZE)
+            {
+                *precision = *precision * 10 + (*cursor - '0');
+            }
+            cursor++;
+        }
+    }
+    while ((*cursor != '\0') && (strchr ("hljztLq", *cursor) != NULL))
+    {
+        longs += (*cursor == 'l') ? 1 : 0;
+        modifier = (*cursor == 'q') ? 'L' : *cursor;
+        cursor++;
+    }
+
+    switch (*cursor)
+    {
+    case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+        *type = (longs >= 2) || (modifier == 'L') ? ARSAL_PRINTASYNC_ARG_LONG_LONG :
+                (longs == 1) ? ARSAL_PRINTASYNC_ARG_LONG :
+                (modifier == 'j') ? ARSAL_PRINTASYNC_ARG_INTMAX :
+                (modifier == 'z') ? ARSAL_PRINTASYNC_ARG_SIZE :
+                (modifier == 't') ? ARSAL_PRINTASYNC_ARG_PTRDIFF : ARSAL_PRINTASYNC_ARG_INT;
+        break;
+    case 'c':
+        *type = (longs == 0) ? ARSAL_PRINTASYNC_ARG_INT : ARSAL_PRINTASYNC_ARG_INVALID;
+        break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        *type = (modifier == 'L') ? ARSAL_PRINTASYNC_ARG_LONG_DOUBLE : ARSAL_PRINTASYNC_ARG_DOUBLE;
+        break;
+    case 's':
+        *type = (longs == 0) ? ARSAL_PRINTASYNC_ARG_STRING : ARSAL_PRINTASYNC_ARG_INVALID;
+        break;
+    case 'p':
+        *type = ARSAL_PRINTASYNC_ARG_POINTER;
+        break;
+    case 'n':
+        *type = ARSAL_PRINTASYNC_ARG_NONE;
+        break;
+    case '%':
+        *type = ((cursor == spec) && (*stars == 0)) ? ARSAL_PRINTASYNC_ARG_NONE : ARSAL_PRINTASYNC_ARG_INVALID;
+        break;
+    default:
+        return 0;
+    }
+
+    return (*type == ARSAL_PRINTASYNC_ARG_INVALID) ? 0 : (size_t)(cursor - spec) + 1;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Append a raw argument
+ * @return The new size of the arguments, or size + length + 1 past capacity if they do not fit
+ */
+static inline size_t ARSAL_PrintAsync_PutArg (uint8_t *args, size_t size, eARSAL_PRINTASYNC_ARG type, const void *value, size_t length)
+{
+    if (size + 1 + length <= ARSAL_PRINTASYNC_ARGS_SIZE)
+    {
+        args[size] = (uint8_t)type;
+        memcpy (&args[size + 1], value, length);
+    }
+    return size + 1 + length;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Append a string argument
+ * @param precision The precision of the conversion, negative if none : the string does not need to be null terminated within it
+ */
+static inline size_t ARSAL_PrintAsync_PutString (uint8_t *args, size_t size, const char *string, int precision)
+{
+    uint8_t value[2 + ARSAL_PRINTASYNC_STRING_SIZE];
+    uint16_t length = 0xFFFF;
+
+    if (string != NULL)
+    {
+        size_t limit = ((precision >= 0) && (precision < ARSAL_PRINTASYNC_STRING_SIZE)) ? (size_t)precision : ARSAL_PRINTASYNC_STRING_SIZE;
+        const char *end = (const char *)memchr (string, '\0', limit);
+        length = (uint16_t)((end != NULL) ? (size_t)(end - string) : limit);
+        memcpy (&value[2], string, length);
+    }
+    memcpy (value, &length, sizeof (length));
+
+    return ARSAL_PrintAsync_PutArg (args, size, ARSAL_PRINTASYNC_ARG_STRING, value, 2 + ((length == 0xFFFF) ? 0 : length));
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Copy the raw arguments of a format
+ * @return The size of the arguments, more than ARSAL_PRINTASYNC_ARGS_SIZE if they do not fit
+ */
+static inline size_t ARSAL_PrintAsync_CopyArgs (uint8_t *args, size_t size, const char *format, va_list va)
+{
+    const char *cursor = format;
+
+    while ((cursor = strchr (cursor, '%')) != NULL)
+    {
+        eARSAL_PRINTASYNC_ARG type = ARSAL_PRINTASYNC_ARG_INVALID;
+        int stars = 0;
+        int precision = ARSAL_PRINTASYNC_NO_PRECISION;
+        size_t length = ARSAL_PrintAsync_ParseSpec (cursor + 1, &stars, &precision, &type);
+
+        if (length == 0)
+        {
+            break;
+        }
+
+        for (; stars > 0; stars--)
+        {
+            int star = va_arg (va, int);
+            size = ARSAL_PrintAsync_PutArg (args, size, ARSAL_PRINTASYNC_ARG_INT, &star, sizeof (star));
+            if ((stars == 1) && (precision == ARSAL_PRINTASYNC_STAR_PRECISION))
+            {
+                /* a negative precision is taken as if it were omitted */
+                precision = (star >= 0) ? star : ARSAL_PRINTASYNC_NO_PRECISION;
+            }
+        }
+
+        switch (type)
+        {
+        case ARSAL_PRINTASYNC_ARG_INT:
+            { int value = va_arg (va, int); size = ARSAL_PrintAsync_PutArg (args, size, type, &value, sizeof (value)); }
+            break;
+        case ARSAL_PRINTASYNC_ARG_LONG:
+            { long value = va_arg (va, long); size = ARSAL_PrintAsync_PutArg (args, size, type, &value, sizeof (value)); }
+            break;
+        case ARSAL_PRINTASYNC_ARG_LONG_LONG:
+            { long long value = va_arg (va, long long); size = ARSAL_PrintAsync_PutArg (args, size, type, &value, sizeof (value)); }
+            break;
+        case ARSAL_PRINTASYNC_ARG_INTMAX:
+            { intmax_t value = va_arg (va, intmax_t); size = ARSAL_PrintAsync_PutArg (args, size, type, &value, sizeof (value)); }
+            break;
+        case ARSAL_PRINTASYNC_ARG_SIZE:
+            { size_t value = va_arg (va, size_t); size = ARSAL_PrintAsync_PutArg (args, size, type, &value, sizeof (value)); }
+            break;
+        case ARSAL_PRINTASYNC_ARG_PTRDIFF:
+            { ptrdiff_t value = va_arg (va, ptrdiff_t); size = ARSAL_PrintAsync_PutArg (args, size, type, &value, sizeof (value)); }
+            break;
+        case ARSAL_PRINTASYNC_ARG_DOUBLE:
+            { double value = va_arg (va, double); size = ARSAL_PrintAsync_PutArg (args, size, type, &value, sizeof (value)); }
+            break;
+        case ARSAL_PRINTASYNC_ARG_LONG_DOUBLE:
+            { long double value = va_arg (va, long double); size = ARSAL_PrintAsync_PutArg (args, size, type, &value, sizeof (value)); }
+            break;
+        case ARSAL_PRINTASYNC_ARG_POINTER:
+            { void *value = va_arg (va, void *); size = ARSAL_PrintAsync_PutArg (args, size, type, &value, sizeof (value)); }
+            break;
+        case ARSAL_PRINTASYNC_ARG_STRING:
+            size = ARSAL_PrintAsync_PutString (args, size, va_arg (va, const char *), precision);
+            break;
+        case ARSAL_PRINTASYNC_ARG_NONE:
+            if (cursor[length] == 'n')
+            {
+                (void)va_arg (va, void *);
+            }
+            break;
+        default:
+            break;
+        }
+
+        cursor += 1 + length;
+    }
+
+    return size;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Read a raw argument of the expected type
+ * @return The position of the next argument, ARSAL_PRINTASYNC_BAD_POSITION if the argument is missing or of another type
+ */
+static inline size_t ARSAL_PrintAsync_GetArg (const uint8_t *args, size_t size, size_t position, eARSAL_PRINTASYNC_ARG type, void *value, size_t length)
+{
+    if ((position == ARSAL_PRINTASYNC_BAD_POSITION) || (position + 1 + length > size) || (args[position] != (uint8_t)type))
+    {
+        return ARSAL_PRINTASYNC_BAD_POSITION;
+    }
+    memcpy (value, &args[position + 1], length);
+    return position + 1 + length;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Read a string argument into a null terminated buffer
+ * @return The position of the next argument, ARSAL_PRINTASYNC_BAD_POSITION if the argument is missing or of another type
+ */
+static inline size_t ARSAL_PrintAsync_GetString (const uint8_t *args, size_t size, size_t position, char *string, const char **value)
+{
+    uint16_t length = 0;
+
+    position = ARSAL_PrintAsync_GetArg (args, size, position, ARSAL_PRINTASYNC_ARG_STRING, &length, sizeof (length));
+    if (position == ARSAL_PRINTASYNC_BAD_POSITION)
+    {
+        return ARSAL_PRINTASYNC_BAD_POSITION;
+    }
+
+    if (length == 0xFFFF)
+    {
+        *value = NULL;
+        return position;
+    }
+
+    if ((length > ARSAL_PRINTASYNC_STRING_SIZE) || (position + length > size))
+    {
+        return ARSAL_PRINTASYNC_BAD_POSITION;
+    }
+
+    memcpy (string, &args[position], length);
+    string[length] = '\0';
+    *value = string;
+    return position + length;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Format a message from its format and its raw arguments
+ * @return The length of the formatted message
+ */
+static inline size_t ARSAL_PrintAsync_Format (const char *format, const uint8_t *args, size_t argsSize, size_t position, char *line, size_t lineSize)
+{
+    char string[ARSAL_PRINTASYNC_STRING_SIZE + 1];
+    char spec[64];
+    const char *cursor = format;
+    size_t length = 0;
+
+    line[0] = '\0';
+
+    while ((*cursor != '\0') && (length + 1 < lineSize))
+    {
+        eARSAL_PRINTASYNC_ARG type = ARSAL_PRINTASYNC_ARG_INVALID;
+        int starValues[2] = {0, 0};
+        int stars = 0;
+        int precision = ARSAL_PRINTASYNC_NO_PRECISION;
+        int star = 0;
+        size_t specLength = 0;
+        char *out = &line[length];
+        size_t available = lineSize - length;
+        int written = 0;
+
+        if (*cursor != '%')
+        {
+            const char *percent = strchr (cursor, '%');
+            size_t literal = (percent != NULL) ? (size_t)(percent - cursor) : strlen (cursor);
+            literal = (literal < available - 1) ? literal : available - 1;
+            memcpy (out, cursor, literal);
+            length += literal;
+            line[length] = '\0';
+            cursor += literal;
+            continue;
+        }
+
+        specLength = ARSAL_PrintAsync_ParseSpec (cursor + 1, &stars, &precision, &type);
+        if ((specLength == 0) || (specLength + 2 > sizeof (spec)))
+        {
+            /* unsupported conversion : the rest of the format is printed as is */
+            written = snprintf (out, available, "%s", cursor);
+            length += ((size_t)written < available) ? (size_t)written : available - 1;
+            break;
+        }
+
+        memcpy (spec, cursor, specLength + 1);
+        spec[specLength + 1] = '\0';
+        cursor += specLength + 1;
+
+        for (star = 0; star < stars; star++)
+        {
+            position = ARSAL_PrintAsync_GetArg (args, argsSize, position, ARSAL_PRINTASYNC_ARG_INT, &starValues[star], sizeof (int));
+        }
+
+#define ARSAL_PRINTASYNC_SNPRINTF(value)                                \
+        ((stars == 0) ? snprintf (out, available, spec, value) :         \
+         (stars == 1) ? snprintf (out, available, spec, starValues[0], value) : \
+         snprintf (out, available, spec, starValues[0], starValues[1], value))
+
+        if ((position == ARSAL_PRINTASYNC_BAD_POSITION) && (type != ARSAL_PRINTASYNC_ARG_NONE))
+        {
+            written = snprintf (out, available, "<?>");
+        }
+        else
+        {
+            switch (type)
+            {
+            case ARSAL_PRINTASYNC_ARG_INT:
+                { int value = 0; position = ARSAL_PrintAsync_GetArg (args, argsSize, position, type, &value, sizeof (value)); written = ARSAL_PRINTASYNC_SNPRINTF (value); }
+                break;
+            case ARSAL_PRINTASYNC_ARG_LONG:
+                { long value = 0; position = ARSAL_PrintAsync_GetArg (args, argsSize, position, type, &value, sizeof (value)); written = ARSAL_PRINTASYNC_SNPRINTF (value); }
+                break;
+            case ARSAL_PRINTASYNC_ARG_LONG_LONG:
+                { long long value = 0; position = ARSAL_PrintAsync_GetArg (args, argsSize, position, type, &value, sizeof (value)); written = ARSAL_PRINTASYNC_SNPRINTF (value); }
+                break;
+            case ARSAL_PRINTASYNC_ARG_INTMAX:
+                { intmax_t value = 0; position = ARSAL_PrintAsync_GetArg (args, argsSize, position, type, &value, sizeof (value)); written = ARSAL_PRINTASYNC_SNPRINTF (value); }
+                break;
+            case ARSAL_PRINTASYNC_ARG_SIZE:
+                { size_t value = 0; position = ARSAL_PrintAsync_GetArg (args, argsSize, position, type, &value, sizeof (value)); written = ARSAL_PRINTASYNC_SNPRINTF (value); }
+                break;
+            case ARSAL_PRINTASYNC_ARG_PTRDIFF:
+                { ptrdiff_t value = 0; position = ARSAL_PrintAsync_GetArg (args, argsSize, position, type, &value, sizeof (value)); written = ARSAL_PRINTASYNC_SNPRINTF (value); }
+                break;
+            case ARSAL_PRINTASYNC_ARG_DOUBLE:
+                { double value = 0; position = ARSAL_PrintAsync_GetArg (args, argsSize, position, type, &value, sizeof (value)); written = ARSAL_PRINTASYNC_SNPRINTF (value); }
+                break;
+            case ARSAL_PRINTASYNC_ARG_LONG_DOUBLE:
+                { long double value = 0; position = ARSAL_PrintAsync_GetArg (args, argsSize, position, type, &value, sizeof (value)); written = ARSAL_PRINTASYNC_SNPRINTF (value); }
+                break;
+            case ARSAL_PRINTASYNC_ARG_POINTER:
+                { void *value = NULL; position = ARSAL_PrintAsync_GetArg (args, argsSize, position, type, &value, sizeof (value)); written = ARSAL_PRINTASYNC_SNPRINTF (value); }
+                break;
+            case ARSAL_PRINTASYNC_ARG_STRING:
+                { const char *value = NULL; position = ARSAL_PrintAsync_GetString (args, argsSize, position, string, &value); written = ARSAL_PRINTASYNC_SNPRINTF ((value != NULL) ? value : "(null)"); }
+                break;
+            default:
+                /* %% prints a percent sign, %n stores nothing */
+                written = (spec[specLength] == '%') ? snprintf (out, available, "%%") : 0;
+                break;
+            }
+        }
+
+#undef ARSAL_PRINTASYNC_SNPRINTF
+
+        if (written > 0)
+        {
+            length += ((size_t)written < available) ? (size_t)written : available - 1;
+        }
+    }
+
+    return length;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Copy bytes into a ring, wrapping at its end
+ */
+static inline void ARSAL_PrintAsync_RingWrite (ARSAL_PrintAsync_Ring_t *ring, uint64_t position, const void *data, size_t size)
+{
+    size_t offset = (size_t)(position & (ARSAL_PRINTASYNC_RING_SIZE - 1));
+    size_t first = ARSAL_PRINTASYNC_RING_SIZE - offset;
+
+    first = (size < first) ? size : first;
+    memcpy (&ring->data[offset], data, first);
+    memcpy (ring->data, (const uint8_t *)data + first, size - first);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Copy bytes out of a ring, wrapping at its end
+ */
+static inline void ARSAL_PrintAsync_RingRead (const ARSAL_PrintAsync_Ring_t *ring, uint64_t position, void *data, size_t size)
+{
+    size_t offset = (size_t)(position & (ARSAL_PRINTASYNC_RING_SIZE - 1));
+    size_t first = ARSAL_PRINTASYNC_RING_SIZE - offset;
+
+    first = (size < first) ? size : first;
+    memcpy (data, &ring->data[offset], first);
+    memcpy ((uint8_t *)data + first, ring->data, size - first);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Mark the ring of an exiting thread, the background thread frees it once drained
+ */
+static inline void ARSAL_PrintAsync_ReleaseRing (void *ring)
+{
+    __atomic_store_n (&((ARSAL_PrintAsync_Ring_t *)ring)->orphan, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Get the ring of the calling thread, creating it on the first message
+ */
+static inline ARSAL_PrintAsync_Ring_t *ARSAL_PrintAsync_GetRing (ARSAL_PrintAsync_t *logger)
+{
+    ARSAL_PrintAsync_Ring_t *ring = (ARSAL_PrintAsync_Ring_t *)pthread_getspecific (logger->key);
+
+    if (ring == NULL)
+    {
+        ring = (ARSAL_PrintAsync_Ring_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, 1, sizeof (ARSAL_PrintAsync_Ring_t));
+        if (ring == NULL)
+        {
+            return NULL;
+        }
+
+        ring->data = (uint8_t *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, ARSAL_PRINTASYNC_RING_SIZE);
+        if ((ring->data == NULL) || (pthread_setspecific (logger->key, ring) != 0))
+        {
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, ring->data);
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, ring);
+            return NULL;
+        }
+
+        ARSAL_Mutex_Lock (&logger->mutex);
+        ring->next = logger->rings;
+        logger->rings = ring;
+        ARSAL_Mutex_Unlock (&logger->mutex);
+    }
+
+    return ring;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Count a message which cannot be pushed
+ * @return -1
+ */
+static inline int ARSAL_PrintAsync_Drop (ARSAL_PrintAsync_t *logger)
+{
+    ARSAL_PrintAsync_Ring_t *ring = NULL;
+
+    if ((logger != NULL) && ((ring = ARSAL_PrintAsync_GetRing (logger)) != NULL))
+    {
+        __atomic_fetch_add (&ring->dropped, 1, __ATOMIC_RELAXED);
+    }
+    return -1;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Push a message into the ring of the calling thread
+ */
+static inline int ARSAL_PrintAsync_PushMessage (ARSAL_PrintAsync_t *logger, ARSAL_PrintAsync_Message_t *message, const uint8_t *args, size_t argsSize)
+{
+    ARSAL_PrintAsync_Ring_t *ring = NULL;
+    struct timeval now;
+    uint64_t head = 0;
+    uint64_t tail = 0;
+
+    if ((logger == NULL) || ((ring = ARSAL_PrintAsync_GetRing (logger)) == NULL))
+    {
+        return -1;
+    }
+
+    if (argsSize > ARSAL_PRINTASYNC_ARGS_SIZE)
+    {
+        __atomic_fetch_add (&ring->dropped, 1, __ATOMIC_RELAXED);
+        return -1;
+    }
+
+    gettimeofday (&now, NULL);
+    message->sec = now.tv_sec;
+    message->nsec = (int32_t)now.tv_usec * 1000;
+    message->argsSize = (uint16_t)argsSize;
+    message->size = (uint32_t)((sizeof (ARSAL_PrintAsync_Message_t) + argsSize + 7) & ~(size_t)7);
+
+    head = ring->head;
+    tail = __atomic_load_n (&ring->tail, __ATOMIC_ACQUIRE);
+
+    if (ARSAL_PRINTASYNC_RING_SIZE - (head - tail) < message->size)
+    {
+        __atomic_fetch_add (&ring->dropped, 1, __ATOMIC_RELAXED);
+        return -1;
+    }
+
+    ARSAL_PrintAsync_RingWrite (ring, head, message, sizeof (ARSAL_PrintAsync_Message_t));
+    ARSAL_PrintAsync_RingWrite (ring, head + sizeof (ARSAL_PrintAsync_Message_t), args, argsSize);
+    __atomic_store_n (&ring->head, head + message->size, __ATOMIC_RELEASE);
+
+    /* wakes the background thread up once when the ring gets half full, instead of waiting for its idle timeout */
+    if ((head - tail < ARSAL_PRINTASYNC_RING_SIZE / 2) && (head + message->size - tail >= ARSAL_PRINTASYNC_RING_SIZE / 2))
+    {
+        ARSAL_Sem_Post (&logger->sem);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Push a message with deferred formatting
+ * @warning The tag, the function and the format are not copied ; they must remain valid for the life of the logger
+ * @see ARSAL_PRINT_ASYNC()
+ * @param logger The asynchronous logger
+ * @param level The level of the message
+ * @param tag The tag of the message
+ * @param function The function of the call
+ * @param line The line of the call
+ * @param format The format of the message
+ * @param va The format parameters
+ * @return 0 if the message was pushed, -1 if it was dropped
+ */
+static inline int ARSAL_PrintAsync_PushV (ARSAL_PrintAsync_t *logger, eARSAL_PRINT_LEVEL level, const char *tag, const char *function, int line, const char *format, va_list va)
+{
+    uint8_t args[ARSAL_PRINTASYNC_ARGS_SIZE];
+    ARSAL_PrintAsync_Message_t message;
+    size_t argsSize = 0;
+
+    memset (&message, 0, sizeof (message));
+    message.level = (uint8_t)level;
+    message.line = line;
+    message.tag.pointer = tag;
+    message.function.pointer = function;
+    message.format.pointer = format;
+
+    argsSize = ARSAL_PrintAsync_CopyArgs (args, 0, format, va);
+
+    return ARSAL_PrintAsync_PushMessage (logger, &message, args, argsSize);
+}
+
+/**
+ * @brief Push a message with deferred formatting
+ * @see ARSAL_PrintAsync_PushV()
+ */
+static inline int ARSAL_PrintAsync_Push (ARSAL_PrintAsync_t *logger, eARSAL_PRINT_LEVEL level, const char *tag, const char *function, int line, const char *format, ...)
+{
+    va_list va;
+    int result = 0;
+
+    va_start (va, format);
+    result = ARSAL_PrintAsync_PushV (logger, level, tag, function, line, format, va);
+    va_end (va);
+
+    return result;
+}
+
+/**
+ * @brief Push a message with deferred formatting, copying its tag and its format
+ * @note Used to forward the ARSAL_PRINT() messages, see ARSAL_PRINTASYNC_DEFINE_CALLBACK().
+ * @param logger The asynchronous logger
+ * @param level The level of the message
+ * @param tag The tag of the message
+ * @param format The format of the message
+ * @param va The format parameters
+ * @return 0 if the message was pushed, -1 if it was dropped
+ */
+static inline int ARSAL_PrintAsync_PushCopyV (ARSAL_PrintAsync_t *logger, eARSAL_PRINT_LEVEL level, const char *tag, const char *format, va_list va)
+{
+    uint8_t args[ARSAL_PRINTASYNC_ARGS_SIZE];
+    ARSAL_PrintAsync_Message_t message;
+    size_t argsSize = 0;
+
+    if ((format == NULL) || (strlen (format) > ARSAL_PRINTASYNC_STRING_SIZE))
+    {
+        return ARSAL_PrintAsync_Drop (logger);
+    }
+
+    memset (&message, 0, sizeof (message));
+    message.level = (uint8_t)level;
+    message.flags = ARSAL_PRINTASYNC_FLAG_COPY;
+
+    argsSize = ARSAL_PrintAsync_PutString (args, argsSize, format, ARSAL_PRINTASYNC_NO_PRECISION);
+    argsSize = ARSAL_PrintAsync_PutString (args, argsSize, tag, ARSAL_PRINTASYNC_NO_PRECISION);
+    argsSize = ARSAL_PrintAsync_CopyArgs (args, argsSize, format, va);
+
+    return ARSAL_PrintAsync_PushMessage (logger, &message, args, argsSize);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Write a message as text
+ */
+static inline void ARSAL_PrintAsync_WriteText (FILE *file, const ARSAL_PrintAsync_Message_t *message, const char *tag, const char *function,
+                                               const char *format, const uint8_t *args, size_t position)
+{
+    char line[ARSAL_PRINTASYNC_LINE_SIZE];
+    char date[ARSAL_PRINT_DATE_STRING_LENGTH];
+    time_t sec = (time_t)message->sec;
+    struct tm localTime;
+    size_t length = ARSAL_PrintAsync_Format (format, args, message->argsSize, position, line, sizeof (line));
+
+    if (message->flags & ARSAL_PRINTASYNC_FLAG_COPY)
+    {
+        /* the ARSAL_PRINT() format already holds the time and the function */
+        fprintf (file, "[%s] %s | %s%s", ARSAL_Print_GetLevelDescription ((eARSAL_PRINT_LEVEL)message->level), (tag != NULL) ? tag : "",
+                 line, ((length > 0) && (line[length - 1] == '\n')) ? "" : "\n");
+        return;
+    }
+
+    localtime_r (&sec, &localTime);
+    strftime (date, sizeof (date), "%H:%M:%S", &localTime);
+    fprintf (file, "[%s] %s | %s:%03d | %s:%d - %s%s", ARSAL_Print_GetLevelDescription ((eARSAL_PRINT_LEVEL)message->level), (tag != NULL) ? tag : "",
+             date, (int)(message->nsec / 1000000), (function != NULL) ? function : "", (int)message->line, line,
+             ((length > 0) && (line[length - 1] == '\n')) ? "" : "\n");
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Get the id of a string in the binary dump, defining it on its first use
+ */
+static inline uint32_t ARSAL_PrintAsync_StringId (ARSAL_PrintAsync_t *logger, const char *string)
+{
+    uint32_t slot = 0;
+    uint32_t id = 0;
+    uint16_t length = 0;
+    const char *end = NULL;
+    uint8_t type = ARSAL_PRINTASYNC_RECORD_STRING;
+
+    if (string == NULL)
+    {
+        return 0;
+    }
+
+    /* keeps the table at most half full */
+    if ((logger->stringCount + 1) * 2 > logger->stringCapacity)
+    {
+        uint32_t capacity = (logger->stringCapacity > 0) ? logger->stringCapacity * 2 : 256;
+        const char **strings = (const char **)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, capacity, sizeof (const char *));
+        uint32_t *ids = (uint32_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, capacity, sizeof (uint32_t));
+        uint32_t old = 0;
+
+        if ((strings == NULL) || (ids == NULL))
+        {
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (void *)strings);
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, ids);
+            return 0;
+        }
+
+        for (old = 0; old < logger->stringCapacity; old++)
+        {
+            if (logger->strings[old] != NULL)
+            {
+                slot = (uint32_t)(((uintptr_t)logger->strings[old] >> 3) * 2654435761u) & (capacity - 1);
+                while (strings[slot] != NULL)
+                {
+                    slot = (slot + 1) & (capacity - 1);
+                }
+                strings[slot] = logger->strings[old];
+                ids[slot] = logger->stringIds[old];
+            }
+        }
+
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (void *)logger->strings);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, logger->stringIds);
+        logger->strings = strings;
+        logger->stringIds = ids;
+        logger->stringCapacity = capacity;
+    }
+
+    slot = (uint32_t)(((uintptr_t)string >> 3) * 2654435761u) & (logger->stringCapacity - 1);
+    while (logger->strings[slot] != NULL)
+    {
+        if (logger->strings[slot] == string)
+        {
+            return logger->stringIds[slot];
+        }
+        slot = (slot + 1) & (logger->stringCapacity - 1);
+    }
+
+    id = ++logger->stringCount;
+    logger->strings[slot] = string;
+    logger->stringIds[slot] = id;
+
+    end = (const char *)memchr (string, '\0', 0xFFFF);
+    length = (uint16_t)((end != NULL) ? end - string : 0xFFFF);
+    fwrite (&type, sizeof (type), 1, logger->file);
+    fwrite (&id, sizeof (id), 1, logger->file);
+    fwrite (&length, sizeof (length), 1, logger->file);
+    fwrite (string, length, 1, logger->file);
+
+    return id;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Output the messages of a ring
+ * @return The number of messages output
+ */
+static inline int ARSAL_PrintAsync_DrainRing (ARSAL_PrintAsync_t *logger, ARSAL_PrintAsync_Ring_t *ring)
+{
+    uint8_t args[ARSAL_PRINTASYNC_ARGS_SIZE];
+    uint64_t head = __atomic_load_n (&ring->head, __ATOMIC_ACQUIRE);
+    uint64_t tail = ring->tail;
+    uint32_t dropped = __atomic_load_n (&ring->dropped, __ATOMIC_RELAXED);
+    int count = 0;
+
+    while (tail != head)
+    {
+        ARSAL_PrintAsync_Message_t message;
+
+        ARSAL_PrintAsync_RingRead (ring, tail, &message, sizeof (message));
+        ARSAL_PrintAsync_RingRead (ring, tail + sizeof (message), args, message.argsSize);
+
+        if (logger->output == ARSAL_PRINTASYNC_OUTPUT_TEXT)
+        {
+            char tagCopy[ARSAL_PRINTASYNC_STRING_SIZE + 1];
+            char formatCopy[ARSAL_PRINTASYNC_STRING_SIZE + 1];
+            const char *tag = message.tag.pointer;
+            const char *format = message.format.pointer;
+            size_t position = 0;
+
+            if (message.flags & ARSAL_PRINTASYNC_FLAG_COPY)
+            {
+                position = ARSAL_PrintAsync_GetString (args, message.argsSize, 0, formatCopy, &format);
+                position = ARSAL_PrintAsync_GetString (args, message.argsSize, position, tagCopy, &tag);
+            }
+
+            ARSAL_PrintAsync_WriteText (logger->file, &message, tag, message.function.pointer, (format != NULL) ? format : "", args, position);
+        }
+        else
+        {
+            uint8_t type = ARSAL_PRINTASYNC_RECORD_MESSAGE;
+            uint32_t size = message.size;
+
+            message.tag.id = ARSAL_PrintAsync_StringId (logger, message.tag.pointer);
+            message.function.id = ARSAL_PrintAsync_StringId (logger, message.function.pointer);
+            message.format.id = ARSAL_PrintAsync_StringId (logger, message.format.pointer);
+            message.size = (uint32_t)(sizeof (message) + message.argsSize);
+
+            fwrite (&type, sizeof (type), 1, logger->file);
+            fwrite (&message, sizeof (message), 1, logger->file);
+            fwrite (args, message.argsSize, 1, logger->file);
+
+            message.size = size;
+        }
+
+        tail += message.size;
+        count++;
+    }
+
+    __atomic_store_n (&ring->tail, tail, __ATOMIC_RELEASE);
+
+    if (dropped != ring->reported)
+    {
+        uint32_t lost = dropped - ring->reported;
+        ring->reported = dropped;
+
+        if (logger->output == ARSAL_PRINTASYNC_OUTPUT_TEXT)
+        {
+            fprintf (logger->file, "[%s] ARSAL_PrintAsync | %u messages dropped\n", ARSAL_Print_GetLevelDescription (ARSAL_PRINT_WARNING), lost);
+        }
+        else
+        {
+            uint8_t type = ARSAL_PRINTASYNC_RECORD_DROPPED;
+            fwrite (&type, sizeof (type), 1, logger->file);
+            fwrite (&lost, sizeof (lost), 1, logger->file);
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Output the messages of all the rings, freeing the drained rings of the exited threads
+ * @return The number of messages output
+ */
+static inline int ARSAL_PrintAsync_Drain (ARSAL_PrintAsync_t *logger)
+{
+    ARSAL_PrintAsync_Ring_t **link = NULL;
+    int count = 0;
+
+    ARSAL_Mutex_Lock (&logger->mutex);
+
+    link = &logger->rings;
+    while (*link != NULL)
+    {
+        ARSAL_PrintAsync_Ring_t *ring = *link;
+        int orphan = __atomic_load_n (&ring->orphan, __ATOMIC_ACQUIRE);
+
+        count += ARSAL_PrintAsync_DrainRing (logger, ring);
+
+        if (orphan)
+        {
+            *link = ring->next;
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, ring->data);
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, ring);
+        }
+        else
+        {
+            link = &ring->next;
+        }
+    }
+
+    ARSAL_Mutex_Unlock (&logger->mutex);
+
+    if (count > 0)
+    {
+        fflush (logger->file);
+    }
+
+    return count;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Background thread of the logger
+ */
+static inline void *ARSAL_PrintAsync_Run (void *arg)
+{
+    ARSAL_PrintAsync_t *logger = (ARSAL_PrintAsync_t *)arg;
+    struct timespec idle = {0, ARSAL_PRINTASYNC_IDLE_MS * 1000000L};
+
+    while (!__atomic_load_n (&logger->stop, __ATOMIC_ACQUIRE))
+    {
+        if (ARSAL_PrintAsync_Drain (logger) == 0)
+        {
+            ARSAL_Sem_Timedwait (&logger->sem, &idle);
+        }
+    }
+
+    ARSAL_PrintAsync_Drain (logger);
+
+    return NULL;
+}
+
+/**
+ * @brief Create an asynchronous logger and start its background thread
+ * @warning This function allocates memory
+ * @post ARSAL_PrintAsync_Delete() must be called to output the last messages, stop the logger and free the memory allocated.
+ * @param file The output file ; it is not closed by the logger
+ * @param output The output of the logger
+ * @param[out] error Executing error
+ * @return The new logger, or NULL if an error occurred
+ * @see ARSAL_PrintAsync_Delete()
+ */
+static inline ARSAL_PrintAsync_t *ARSAL_PrintAsync_New (FILE *file, eARSAL_PRINTASYNC_OUTPUT output, eARSAL_ERROR *error)
+{
+    ARSAL_PrintAsync_t *logger = NULL;
+    eARSAL_ERROR localError = ARSAL_OK;
+    int keyCreated = 0;
+    int mutexInitialized = 0;
+    int semInitialized = 0;
+
+    if ((file == NULL) || (output < ARSAL_PRINTASYNC_OUTPUT_TEXT) || (output >= ARSAL_PRINTASYNC_OUTPUT_MAX))
+    {
+        localError = ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    if (localError == ARSAL_OK)
+    {
+        logger = (ARSAL_PrintAsync_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, 1, sizeof (ARSAL_PrintAsync_t));
+        if (logger == NULL)
+        {
+            localError = ARSAL_ERROR_ALLOC;
+        }
+    }
+
+    if (localError == ARSAL_OK)
+    {
+        logger->file = file;
+        logger->output = output;
+
+        keyCreated = (pthread_key_create (&logger->key, ARSAL_PrintAsync_ReleaseRing) == 0);
+        mutexInitialized = keyCreated && (ARSAL_Mutex_Init (&logger->mutex) == 0);
+        semInitialized = mutexInitialized && (ARSAL_Sem_Init (&logger->sem, 0, 0) == 0);
+        if (!semInitialized)
+        {
+            localError = ARSAL_ERROR_SYSTEM;
+        }
+    }
+
+    if (localError == ARSAL_OK)
+    {
+        if ((output == ARSAL_PRINTASYNC_OUTPUT_BINARY) &&
+            (fwrite (ARSAL_PRINTASYNC_BINARY_MAGIC, ARSAL_PRINTASYNC_BINARY_MAGIC_SIZE, 1, file) != 1))
+        {
+            localError = ARSAL_ERROR_FILE;
+        }
+    }
+
+    if (localError == ARSAL_OK)
+    {
+        ARSAL_Thread_Attributes_t attributes;
+
+        ARSAL_Thread_Attributes_Init (&attributes);
+        attributes.name = "ARSAL_PrintAsync";
+        if (ARSAL_Thread_CreateWithAttributes (&logger->thread, ARSAL_PrintAsync_Run, logger, &attributes) != 0)
+        {
+            localError = ARSAL_ERROR_SYSTEM;
+        }
+    }
+
+    if ((localError != ARSAL_OK) && (logger != NULL))
+    {
+        if (semInitialized)
+        {
+            ARSAL_Sem_Destroy (&logger->sem);
+        }
+        if (mutexInitialized)
+        {
+            ARSAL_Mutex_Destroy (&logger->mutex);
+        }
+        if (keyCreated)
+        {
+            pthread_key_delete (logger->key);
+        }
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, logger);
+        logger = NULL;
+    }
+
+    if (error != NULL)
+    {
+        *error = localError;
+    }
+
+    return logger;
+}
+
+/**
+ * @brief Output the last messages, stop the background thread and delete the logger
+ * @warning This function frees memory ; no thread must log through the logger anymore
+ * @param logger Address of the pointer on the logger
+ * @see ARSAL_PrintAsync_New()
+ */
+static inline void ARSAL_PrintAsync_Delete (ARSAL_PrintAsync_t **logger)
+{
+    ARSAL_PrintAsync_Ring_t *ring = NULL;
+
+    if ((logger != NULL) && (*logger != NULL))
+    {
+        __atomic_store_n (&(*logger)->stop, 1, __ATOMIC_RELEASE);
+        ARSAL_Sem_Post (&(*logger)->sem);
+        ARSAL_Thread_Join ((*logger)->thread, NULL);
+        ARSAL_Thread_Destroy (&(*logger)->thread);
+
+        pthread_setspecific ((*logger)->key, NULL);
+        pthread_key_delete ((*logger)->key);
+
+        while ((ring = (*logger)->rings) != NULL)
+        {
+            (*logger)->rings = ring->next;
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, ring->data);
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, ring);
+        }
+
+        ARSAL_Sem_Destroy (&(*logger)->sem);
+        ARSAL_Mutex_Destroy (&(*logger)->mutex);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (void *)(*logger)->strings);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (*logger)->stringIds);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, *logger);
+        *logger = NULL;
+    }
+}
+
+/**
+ * @brief Decode a binary dump into text
+ * @param input The binary dump
+ * @param output The text output
+ * @return The number of messages decoded, or -1 if the input is not a binary dump
+ */
+static inline int ARSAL_PrintAsync_Decode (FILE *input, FILE *output)
+{
+    uint8_t args[ARSAL_PRINTASYNC_ARGS_SIZE];
+    char magic[ARSAL_PRINTASYNC_BINARY_MAGIC_SIZE];
+    char **strings = NULL;
+    uint32_t stringCount = 0;
+    uint8_t type = 0;
+    int count = 0;
+
+    if ((input == NULL) || (output == NULL) || (fread (magic, sizeof (magic), 1, input) != 1) ||
+        (memcmp (magic, ARSAL_PRINTASYNC_BINARY_MAGIC, sizeof (magic)) != 0))
+    {
+        return -1;
+    }
+
+    while (fread (&type, sizeof (type), 1, input) == 1)
+    {
+        if (type == ARSAL_PRINTASYNC_RECORD_STRING)
+        {
+            uint32_t id = 0;
+            uint16_t length = 0;
+            char *string = NULL;
+            char **grown = NULL;
+
+            if ((fread (&id, sizeof (id), 1, input) != 1) || (fread (&length, sizeof (length), 1, input) != 1) ||
+                (id != stringCount + 1) || ((string = (char *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (size_t)length + 1)) == NULL))
+            {
+                break;
+            }
+            if (((length > 0) && (fread (string, length, 1, input) != 1)) ||
+                ((grown = (char **)ARSAL_Allocator_Realloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, strings, ((size_t)stringCount + 1) * sizeof (char *))) == NULL))
+            {
+                ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, string);
+                break;
+            }
+            string[length] = '\0';
+            strings = grown;
+            strings[stringCount++] = string;
+        }
+        else if (type == ARSAL_PRINTASYNC_RECORD_MESSAGE)
+        {
+            char tagCopy[ARSAL_PRINTASYNC_STRING_SIZE + 1];
+            char formatCopy[ARSAL_PRINTASYNC_STRING_SIZE + 1];
+            ARSAL_PrintAsync_Message_t message;
+            const char *tag = NULL;
+            const char *function = NULL;
+            const char *format = NULL;
+            size_t position = 0;
+
+            if ((fread (&message, sizeof (message), 1, input) != 1) || (message.argsSize > sizeof (args)) ||
+                ((message.argsSize > 0) && (fread (args, message.argsSize, 1, input) != 1)))
+            {
+                break;
+            }
+
+            tag = ((message.tag.id > 0) && (message.tag.id <= stringCount)) ? strings[message.tag.id - 1] : NULL;
+            function = ((message.function.id > 0) && (message.function.id <= stringCount)) ? strings[message.function.id - 1] : NULL;
+            format = ((message.format.id > 0) && (message.format.id <= stringCount)) ? strings[message.format.id - 1] : NULL;
+
+            if (message.flags & ARSAL_PRINTASYNC_FLAG_COPY)
+            {
+                position = ARSAL_PrintAsync_GetString (args, message.argsSize, 0, formatCopy, &format);
+                position = ARSAL_PrintAsync_GetString (args, message.argsSize, position, tagCopy, &tag);
+            }
+
+            ARSAL_PrintAsync_WriteText (output, &message, tag, function, (format != NULL) ? format : "", args, position);
+            count++;
+        }
+        else if (type == ARSAL_PRINTASYNC_RECORD_DROPPED)
+        {
+            uint32_t lost = 0;
+            if (fread (&lost, sizeof (lost), 1, input) != 1)
+            {
+                break;
+            }
+            fprintf (output, "[%s] ARSAL_PrintAsync | %u messages dropped\n", ARSAL_Print_GetLevelDescription (ARSAL_PRINT_WARNING), lost);
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    while (stringCount > 0)
+    {
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, strings[--stringCount]);
+    }
+    ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (void *)strings);
+
+    return count;
+}
+
+#endif /* _ARSAL_PRINT_ASYNC_H_ */
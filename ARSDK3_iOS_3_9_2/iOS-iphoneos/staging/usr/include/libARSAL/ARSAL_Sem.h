@@ -84,6 +84,7 @@ int ARSAL_Sem_Trywait(ARSAL_Sem_t *sem);
  * @param sem The sem to wait for
  * @param timeout Maximum time to wait
  * @warning POSIX.1-2001 semaphore use an absolute time as timeout. Instead, libSAL use a relative time !
+ * @see ARSAL_EventSem_Timedwait() for a timeout measured on the monotonic clock
  * @retval If the semaphore was sucessfully decremented, ARSAL_Sem_timedwait() returns 0. If the call has timed-out, it returns -1 and sets errno to "ETIMEDOUT". On any other error, return -1 and set errno (See errno.h)
  */
 int ARSAL_Sem_Timedwait(ARSAL_Sem_t *sem, const struct timespec *timeout);
@@ -0,0 +1,580 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file libARSAL/ARSAL_SocketBatch.h
+ * @brief Batched datagram sockets : many packets per kernel crossing
+ * @note The sockets are registered once and stay armed : each wait polls all of them in one call, then
+ * drains the ready ones into a pool of buffers allocated at creation with recvmmsg(). Sends are queued
+ * and flushed together with sendmmsg().
+ * The statistics count the system calls, to compare the cost per packet with ARSAL_Socket_Recvfrom().
+ * The batch is only defined where the system has recvmmsg() and sendmmsg(), see ARSAL_SOCKETBATCH_MMSG :
+ * without them (Apple systems), a wait would cost a poll() plus one recvmsg() per datagram and one more per
+ * drained socket, more system calls per packet than a blocking ARSAL_Socket_Recvfrom() on a single socket.
+ * @date 10/18/2026
+ */
+#ifndef _ARSAL_SOCKET_BATCH_H_
+#define _ARSAL_SOCKET_BATCH_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <libARSAL/ARSAL_Error.h>
+#include <libARSAL/ARSAL_Allocator.h>
+#include <libARSAL/ARSAL_Socket.h>
+#include <libARSAL/ARSAL_Trace.h>
+
+/**
+ * @brief 1 when the system receives and sends several datagrams per call ; the batch is only defined then
+ * @note Can be overridden with -DARSAL_SOCKETBATCH_MMSG=0 to leave the batch out.
+ */
+#ifndef ARSAL_SOCKETBATCH_MMSG
+#if defined(__linux__) && defined(__USE_GNU)
+#define ARSAL_SOCKETBATCH_MMSG 1
+#else
+#define ARSAL_SOCKETBATCH_MMSG 0
+#endif
+#endif
+
+#if ARSAL_SOCKETBATCH_MMSG
+
+/**
+ * @brief Maximum number of sockets of a batch
+ */
+#define ARSAL_SOCKETBATCH_MAX_SOCKETS 32
+
+/**
+ * @brief Maximum number of datagrams received or sent per system call
+ */
+#define ARSAL_SOCKETBATCH_MAX_VECTOR 64
+
+/**
+ * @brief Received packet, or packet to send
+ */
+typedef struct
+{
+    int sockfd; /**< Socket of the packet */
+    int index; /**< Index of the buffer of the packet in the pool */
+    uint8_t *data; /**< Data of the packet, in the pool */
+    size_t size; /**< Size of the data */
+    struct sockaddr_storage address; /**< Source or destination address */
+    socklen_t addressLength; /**< Length of the address, 0 for a connected socket */
+    int truncated; /**< 1 when the received datagram was longer than the buffer and was cut to its size */
+} ARSAL_SocketBatch_Packet_t;
+
+/**
+ * @brief Statistics of a batch
+ */
+typedef struct
+{
+    uint64_t syscalls; /**< Number of system calls */
+    uint64_t waits; /**< Number of waits */
+    uint64_t received; /**< Number of packets received */
+    uint64_t sent; /**< Number of packets sent */
+    uint64_t dropped; /**< Number of packets not sent because of an error */
+    uint64_t exhausted; /**< Number of times the pool ran out of buffers */
+    uint64_t truncated; /**< Number of packets received truncated */
+} ARSAL_SocketBatch_Stats_t;
+
+/**
+ * @brief Batch of sockets
+ */
+typedef struct
+{
+    uint8_t *pool; /**< Buffers of the packets */
+    size_t bufferSize; /**< Size of each buffer */
+    int bufferCount; /**< Number of buffers */
+    ARSAL_SocketBatch_Packet_t *packets; /**< Packet of each buffer */
+    int *freeBuffers; /**< Stack of the free buffers */
+    int freeCount; /**< Number of free buffers */
+    int *pending; /**< Buffers queued for sending, in order */
+    int pendingCount; /**< Number of buffers queued for sending */
+    struct pollfd sockets[ARSAL_SOCKETBATCH_MAX_SOCKETS]; /**< Registered sockets */
+    int socketCount; /**< Number of registered sockets */
+    int nextSocket; /**< First socket drained by the next wait, so that a busy socket does not starve the others */
+    ARSAL_SocketBatch_Stats_t stats; /**< Statistics */
+} ARSAL_SocketBatch_t;
+
+/**
+ * @brief Delete a batch
+ * @warning This function frees memory ; the sockets are not closed
+ * @param batch Address of the pointer on the batch
+ * @see ARSAL_SocketBatch_New()
+ */
+static inline void ARSAL_SocketBatch_Delete (ARSAL_SocketBatch_t **batch)
+{
+    if ((batch != NULL) && (*batch != NULL))
+    {
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (*batch)->pool);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (*batch)->packets);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (*batch)->freeBuffers);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (*batch)->pending);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, *batch);
+        *batch = NULL;
+    }
+}
+
+/**
+ * @brief Create a batch with its pool of buffers
+ * @warning This function allocates memory
+ * @post ARSAL_SocketBatch_Delete() must be called to free the memory allocated.
+ * @param bufferCount Number of buffers, shared by the received packets and the packets to send
+ * @param bufferSize Size of each buffer ; longer datagrams are truncated, see ARSAL_SocketBatch_Packet_t.truncated
+ * @param[out] error Executing error
+ * @return The new batch, or NULL if an error occurred
+ * @see ARSAL_SocketBatch_Delete()
+ */
+static inline ARSAL_SocketBatch_t *ARSAL_SocketBatch_New (int bufferCount, size_t bufferSize, eARSAL_ERROR *error)
+{
+    ARSAL_SocketBatch_t *batch = NULL;
+    eARSAL_ERROR localError = ARSAL_OK;
+    int index = 0;
+
+    if ((bufferCount <= 0) || (bufferSize == 0) || ((size_t)bufferCount > SIZE_MAX / bufferSize))
+    {
+        localError = ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    if (localError == ARSAL_OK)
+    {
+        batch = (ARSAL_SocketBatch_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, 1, sizeof (ARSAL_SocketBatch_t));
+        if (batch != NULL)
+        {
+            batch->pool = (uint8_t *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (size_t)bufferCount * bufferSize);
+            batch->packets = (ARSAL_SocketBatch_Packet_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (size_t)bufferCount, sizeof (ARSAL_SocketBatch_Packet_t));
+            batch->freeBuffers = (int *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (size_t)bufferCount * sizeof (int));
+            batch->pending = (int *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, (size_t)bufferCount * sizeof (int));
+        }
+        if ((batch == NULL) || (batch->pool == NULL) || (batch->packets == NULL) || (batch->freeBuffers == NULL) || (batch->pending == NULL))
+        {
+            ARSAL_SocketBatch_Delete (&batch);
+            localError = ARSAL_ERROR_ALLOC;
+        }
+    }
+
+    if (localError == ARSAL_OK)
+    {
+        batch->bufferSize = bufferSize;
+        batch->bufferCount = bufferCount;
+        for (index = 0; index < bufferCount; index++)
+        {
+            batch->packets[index].index = index;
+            batch->packets[index].data = &batch->pool[(size_t)index * bufferSize];
+            batch->freeBuffers[index] = bufferCount - 1 - index;
+        }
+        batch->freeCount = bufferCount;
+    }
+
+    if (error != NULL)
+    {
+        *error = localError;
+    }
+
+    return batch;
+}
+
+/**
+ * @brief Register a datagram socket ; it stays armed until removed
+ * @note The socket is switched to non blocking mode.
+ * @param batch The batch
+ * @param sockfd The socket
+ * @return ARSAL_OK, or an error if the socket could not be registered
+ */
+static inline eARSAL_ERROR ARSAL_SocketBatch_AddSocket (ARSAL_SocketBatch_t *batch, int sockfd)
+{
+    int flags = 0;
+
+    if ((batch == NULL) || (sockfd < 0) || (batch->socketCount >= ARSAL_SOCKETBATCH_MAX_SOCKETS))
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    flags = fcntl (sockfd, F_GETFL, 0);
+    if ((flags < 0) || (fcntl (sockfd, F_SETFL, flags | O_NONBLOCK) < 0))
+    {
+        return ARSAL_ERROR_SYSTEM;
+    }
+
+    batch->sockets[batch->socketCount].fd = sockfd;
+    batch->sockets[batch->socketCount].events = POLLIN;
+    batch->sockets[batch->socketCount].revents = 0;
+    batch->socketCount++;
+
+    return ARSAL_OK;
+}
+
+/**
+ * @brief Unregister a socket
+ * @param batch The batch
+ * @param sockfd The socket
+ * @return ARSAL_OK, or ARSAL_ERROR_BAD_PARAMETER if the socket is not registered
+ */
+static inline eARSAL_ERROR ARSAL_SocketBatch_RemoveSocket (ARSAL_SocketBatch_t *batch, int sockfd)
+{
+    int index = 0;
+
+    if (batch == NULL)
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    for (index = 0; index < batch->socketCount; index++)
+    {
+        if (batch->sockets[index].fd == sockfd)
+        {
+            batch->socketCount--;
+            memmove (&batch->sockets[index], &batch->sockets[index + 1], (size_t)(batch->socketCount - index) * sizeof (struct pollfd));
+            batch->nextSocket = 0;
+            return ARSAL_OK;
+        }
+    }
+
+    return ARSAL_ERROR_BAD_PARAMETER;
+}
+
+/**
+ * @brief Get a buffer of the pool to build a packet to send
+ * @param batch The batch
+ * @return The packet, or NULL if the pool is empty
+ * @see ARSAL_SocketBatch_Queue()
+ */
+static inline ARSAL_SocketBatch_Packet_t *ARSAL_SocketBatch_GetPacket (ARSAL_SocketBatch_t *batch)
+{
+    ARSAL_SocketBatch_Packet_t *packet = NULL;
+
+    if ((batch == NULL) || (batch->freeCount == 0))
+    {
+        if (batch != NULL)
+        {
+            batch->stats.exhausted++;
+        }
+        return NULL;
+    }
+
+    packet = &batch->packets[batch->freeBuffers[--batch->freeCount]];
+    packet->size = 0;
+    packet->addressLength = 0;
+    packet->truncated = 0;
+
+    return packet;
+}
+
+/**
+ * @brief Give a packet back to the pool
+ * @param batch The batch
+ * @param packet A packet received by ARSAL_SocketBatch_Wait(), or got from ARSAL_SocketBatch_GetPacket() and not queued
+ */
+static inline void ARSAL_SocketBatch_Release (ARSAL_SocketBatch_t *batch, ARSAL_SocketBatch_Packet_t *packet)
+{
+    if ((batch != NULL) && (packet != NULL))
+    {
+        batch->freeBuffers[batch->freeCount++] = packet->index;
+    }
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Receive the datagrams waiting on a socket into free buffers
+ * @return The number of packets received
+ */
+static inline int ARSAL_SocketBatch_Drain (ARSAL_SocketBatch_t *batch, int sockfd, ARSAL_SocketBatch_Packet_t **packets, int maxPackets)
+{
+    int count = 0;
+
+    while ((count < maxPackets) && (batch->freeCount > 0))
+    {
+        struct mmsghdr messages[ARSAL_SOCKETBATCH_MAX_VECTOR];
+        struct iovec vectors[ARSAL_SOCKETBATCH_MAX_VECTOR];
+        int wanted = maxPackets - count;
+        int received = 0;
+        int index = 0;
+
+        wanted = (wanted < batch->freeCount) ? wanted : batch->freeCount;
+        wanted = (wanted < ARSAL_SOCKETBATCH_MAX_VECTOR) ? wanted : ARSAL_SOCKETBATCH_MAX_VECTOR;
+
+        memset (messages, 0, (size_t)wanted * sizeof (struct mmsghdr));
+        for (index = 0; index < wanted; index++)
+        {
+            ARSAL_SocketBatch_Packet_t *packet = &batch->packets[batch->freeBuffers[batch->freeCount - 1 - index]];
+            vectors[index].iov_base = packet->data;
+            vectors[index].iov_len = batch->bufferSize;
+            messages[index].msg_hdr.msg_iov = &vectors[index];
+            messages[index].msg_hdr.msg_iovlen = 1;
+            messages[index].msg_hdr.msg_name = &packet->address;
+            messages[index].msg_hdr.msg_namelen = sizeof (packet->address);
+        }
+
+        batch->stats.syscalls++;
+        received = recvmmsg (sockfd, messages, (unsigned int)wanted, MSG_DONTWAIT, NULL);
+        if (received <= 0)
+        {
+            break;
+        }
+
+        for (index = 0; index < received; index++)
+        {
+            ARSAL_SocketBatch_Packet_t *packet = &batch->packets[batch->freeBuffers[--batch->freeCount]];
+            packet->sockfd = sockfd;
+            packet->size = messages[index].msg_len;
+            packet->addressLength = messages[index].msg_hdr.msg_namelen;
+            packet->truncated = (messages[index].msg_hdr.msg_flags & MSG_TRUNC) ? 1 : 0;
+            batch->stats.truncated += (uint64_t)packet->truncated;
+            packets[count++] = packet;
+        }
+
+        if (received < wanted)
+        {
+            /* the socket is drained, no need to check again */
+            break;
+        }
+    }
+
+    if ((count < maxPackets) && (batch->freeCount == 0))
+    {
+        batch->stats.exhausted++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Wait for datagrams on the registered sockets and receive them
+ * @note The packets belong to the caller until given back with ARSAL_SocketBatch_Release().
+ * Datagrams left in the sockets, when maxPackets or the pool is reached, are returned by the next wait.
+ * @param batch The batch
+ * @param timeout The time (ms) to wait for a datagram, 0 to only receive the waiting ones, -1 to wait without timeout
+ * @param[out] packets The packets received
+ * @param maxPackets The capacity of packets
+ * @return The number of packets received, 0 on timeout, or -1 if an error occurred and errno is set appropriately ;
+ * errno is EBADF when a registered socket was closed, it must be removed with ARSAL_SocketBatch_RemoveSocket()
+ */
+static inline int ARSAL_SocketBatch_Wait (ARSAL_SocketBatch_t *batch, int timeout, ARSAL_SocketBatch_Packet_t **packets, int maxPackets)
+{
+    int ready = 0;
+    int count = 0;
+    int index = 0;
+
+    if ((batch == NULL) || (packets == NULL) || (maxPackets <= 0))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    batch->stats.waits++;
+    batch->stats.syscalls++;
+    ready = poll (batch->sockets, (nfds_t)batch->socketCount, timeout);
+    if (ready <= 0)
+    {
+        return (ready < 0) && (errno != EINTR) ? -1 : 0;
+    }
+
+    /* a closed socket stays ready : report it rather than polling it again */
+    for (index = 0; index < batch->socketCount; index++)
+    {
+        if (batch->sockets[index].revents & POLLNVAL)
+        {
+            errno = EBADF;
+            return -1;
+        }
+    }
+
+    ARSAL_TRACE_BEGIN ("ARSAL_SocketBatch", "Receive");
+    for (index = 0; (index < batch->socketCount) && (count < maxPackets); index++)
+    {
+        struct pollfd *socket = &batch->sockets[(batch->nextSocket + index) % batch->socketCount];
+
+        if (socket->revents & (POLLIN | POLLERR))
+        {
+            count += ARSAL_SocketBatch_Drain (batch, socket->fd, &packets[count], maxPackets - count);
+        }
+    }
+    batch->nextSocket = (batch->nextSocket + 1) % batch->socketCount;
+
+    batch->stats.received += (uint64_t)count;
+    ARSAL_TRACE_END ("ARSAL_SocketBatch", "Receive");
+
+    return count;
+}
+
+/**
+ * @brief Queue a packet to send
+ * @note The packet is sent, then given back to the pool, by ARSAL_SocketBatch_Flush().
+ * @param batch The batch
+ * @param packet The packet, from ARSAL_SocketBatch_GetPacket() or received, with its socket, size and address set
+ * @return ARSAL_OK, or ARSAL_ERROR_BAD_PARAMETER
+ */
+static inline eARSAL_ERROR ARSAL_SocketBatch_Queue (ARSAL_SocketBatch_t *batch, ARSAL_SocketBatch_Packet_t *packet)
+{
+    if ((batch == NULL) || (packet == NULL) || (packet->size > batch->bufferSize) || (batch->pendingCount >= batch->bufferCount))
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    batch->pending[batch->pendingCount++] = packet->index;
+
+    return ARSAL_OK;
+}
+
+/**
+ * @brief Copy data into a pool buffer and queue it
+ * @param batch The batch
+ * @param sockfd The socket to send on
+ * @param buf The data to send
+ * @param buflen The size of the data
+ * @param dest_addr The destination address, NULL for a connected socket
+ * @param addrlen The size of the destination address
+ * @return ARSAL_OK, ARSAL_ERROR_ALLOC if the pool is empty, or ARSAL_ERROR_BAD_PARAMETER
+ */
+static inline eARSAL_ERROR ARSAL_SocketBatch_Sendto (ARSAL_SocketBatch_t *batch, int sockfd, const void *buf, size_t buflen, const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+    ARSAL_SocketBatch_Packet_t *packet = NULL;
+
+    if ((batch == NULL) || (buflen > batch->bufferSize) || (addrlen > sizeof (struct sockaddr_storage)))
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    packet = ARSAL_SocketBatch_GetPacket (batch);
+    if (packet == NULL)
+    {
+        return ARSAL_ERROR_ALLOC;
+    }
+
+    packet->sockfd = sockfd;
+    packet->size = buflen;
+    memcpy (packet->data, buf, buflen);
+    if (dest_addr != NULL)
+    {
+        memcpy (&packet->address, dest_addr, addrlen);
+        packet->addressLength = addrlen;
+    }
+
+    return ARSAL_SocketBatch_Queue (batch, packet);
+}
+
+/**
+ * @brief Send the queued packets and give them back to the pool
+ * @note A packet which fails to send is dropped and counted in the statistics ; a full socket buffer
+ * stops the flush and keeps the remaining packets queued.
+ * @param batch The batch
+ * @return The number of packets sent, or -1 if the batch is NULL
+ */
+static inline int ARSAL_SocketBatch_Flush (ARSAL_SocketBatch_t *batch)
+{
+    int done = 0;
+    int sent = 0;
+
+    if (batch == NULL)
+    {
+        return -1;
+    }
+
+    ARSAL_TRACE_BEGIN ("ARSAL_SocketBatch", "Flush");
+    while (done < batch->pendingCount)
+    {
+        ARSAL_SocketBatch_Packet_t *first = &batch->packets[batch->pending[done]];
+        int result = 0;
+        struct mmsghdr messages[ARSAL_SOCKETBATCH_MAX_VECTOR];
+        struct iovec vectors[ARSAL_SOCKETBATCH_MAX_VECTOR];
+        int count = 0;
+
+        /* one call per run of packets of the same socket */
+        while ((count < ARSAL_SOCKETBATCH_MAX_VECTOR) && (done + count < batch->pendingCount) &&
+               (batch->packets[batch->pending[done + count]].sockfd == first->sockfd))
+        {
+            ARSAL_SocketBatch_Packet_t *packet = &batch->packets[batch->pending[done + count]];
+
+            memset (&messages[count], 0, sizeof (struct mmsghdr));
+            vectors[count].iov_base = packet->data;
+            vectors[count].iov_len = packet->size;
+            messages[count].msg_hdr.msg_iov = &vectors[count];
+            messages[count].msg_hdr.msg_iovlen = 1;
+            messages[count].msg_hdr.msg_name = (packet->addressLength > 0) ? &packet->address : NULL;
+            messages[count].msg_hdr.msg_namelen = packet->addressLength;
+            count++;
+        }
+
+        batch->stats.syscalls++;
+        result = sendmmsg (first->sockfd, messages, (unsigned int)count, MSG_DONTWAIT);
+
+        if (result < 0)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS))
+            {
+                break;
+            }
+            /* the first packet of the run failed : drops it */
+            result = 1;
+            batch->stats.dropped++;
+            sent--;
+        }
+
+        sent += result;
+        for (; result > 0; result--)
+        {
+            batch->freeBuffers[batch->freeCount++] = batch->pending[done++];
+        }
+    }
+
+    batch->pendingCount -= done;
+    memmove (batch->pending, &batch->pending[done], (size_t)batch->pendingCount * sizeof (int));
+    batch->stats.sent += (uint64_t)sent;
+    ARSAL_TRACE_END ("ARSAL_SocketBatch", "Flush");
+
+    return sent;
+}
+
+/**
+ * @brief Get the statistics of a batch
+ * @param batch The batch
+ * @param[out] stats The statistics
+ * @return ARSAL_OK, or ARSAL_ERROR_BAD_PARAMETER
+ */
+static inline eARSAL_ERROR ARSAL_SocketBatch_GetStats (ARSAL_SocketBatch_t *batch, ARSAL_SocketBatch_Stats_t *stats)
+{
+    if ((batch == NULL) || (stats == NULL))
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    *stats = batch->stats;
+
+    return ARSAL_OK;
+}
+
+#endif /* ARSAL_SOCKETBATCH_MMSG */
+
+#endif /* _ARSAL_SOCKET_BATCH_H_ */
@@ -40,6 +40,9 @@
 #include <time.h>
 #include <sys/time.h>
 #include <unistd.h>
+#ifdef __APPLE__
+#include <mach/mach_time.h>
+#endif
 
 /**
  * @brief Convert second to millisecond
@@ -198,4 +201,322 @@ int32_t ARSAL_Time_ComputeTimevalMsTimeDiff (struct timeval *start, struct timev
  */
 int32_t ARSAL_Time_ComputeTimespecMsTimeDiff (struct timespec *start, struct timespec *end);
 
+/**
+ * @brief Time on the monotonic clock, in nanoseconds
+ * @note The origin is unspecified : only differences between two values are meaningful.
+ * The monotonic clock is not affected by the changes of the system date nor by NTP.
+ */
+typedef uint64_t ARSAL_Time_Monotonic_t;
+
+/**
+ * @brief Difference between two times, in nanoseconds
+ */
+typedef int64_t ARSAL_Time_Duration_t;
+
+/**
+ * @brief Deadline which never expires, for the timed waits taking a monotonic deadline
+ */
+#define ARSAL_TIME_MONOTONIC_INFINITE UINT64_MAX
+
+/**
+ * @brief Calibration of the cycle counter
+ * @warning Used through the ARSAL_Time_xxxTicks() functions, do not use directly
+ */
+typedef struct
+{
+    uint32_t sequence; /**< Odd while the calibration is written, the readers retry when it changed */
+    uint64_t scale; /**< Nanoseconds per tick in 32.32 fixed point, 0 when not calibrated */
+    uint64_t ticksOrigin; /**< Ticks at the calibration */
+    uint64_t nsOrigin; /**< Monotonic time at the calibration */
+} ARSAL_Time_TicksCalibration_t;
+
+/**
+ * @brief Calibration of the cycle counter, shared by all the compilation units
+ */
+__attribute__((weak)) ARSAL_Time_TicksCalibration_t ARSAL_Time_TicksCalibration;
+
+/**
+ * @brief Gets the time of the monotonic clock in nanoseconds
+ *
+ * Uses mach_absolute_time() on Apple systems and clock_gettime(CLOCK_MONOTONIC) elsewhere,
+ * which do not enter the kernel. The Apple clock does not advance while the device sleeps.
+ *
+ * @return The monotonic time in nanoseconds
+ */
+static inline ARSAL_Time_Monotonic_t ARSAL_Time_GetMonotonicNs(void)
+{
+#ifdef __APPLE__
+    /* numer in the high half, denom in the low half : a single store cannot be seen torn */
+    static uint64_t cachedTimebase = 0;
+    uint64_t localTimebase = __atomic_load_n (&cachedTimebase, __ATOMIC_RELAXED);
+    uint64_t ticks = mach_absolute_time ();
+    uint32_t localNumer = 0;
+    uint32_t localDenom = 0;
+
+    if (localTimebase == 0)
+    {
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info (&timebase);
+        localTimebase = ((uint64_t)timebase.numer << 32) | timebase.denom;
+        __atomic_store_n (&cachedTimebase, localTimebase, __ATOMIC_RELAXED);
+    }
+    localNumer = (uint32_t)(localTimebase >> 32);
+    localDenom = (uint32_t)localTimebase;
+
+    if (localNumer == localDenom)
+    {
+        return ticks;
+    }
+
+    /* split to avoid the overflow of ticks * numer */
+    return (ticks / localDenom) * localNumer + ((ticks % localDenom) * localNumer) / localDenom;
+#else
+    struct timespec now;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Computes the monotonic deadline of a timeout starting now
+ * @note Waiting until a deadline rather than for a duration keeps loops on spurious wake ups from drifting.
+ *
+ * @param timeout The timeout in nanoseconds, or a negative value for no timeout
+ * @return The deadline, ARSAL_TIME_MONOTONIC_INFINITE when timeout is negative
+ */
+static inline ARSAL_Time_Monotonic_t ARSAL_Time_GetDeadlineNs(ARSAL_Time_Duration_t timeout)
+{
+    if (timeout < 0)
+    {
+        return ARSAL_TIME_MONOTONIC_INFINITE;
+    }
+
+    return ARSAL_Time_GetMonotonicNs () + (uint64_t)timeout;
+}
+
+/**
+ * @brief Computes the time left before a monotonic deadline
+ *
+ * @param deadline The deadline
+ * @return The time left in nanoseconds, 0 when the deadline has passed, INT64_MAX for ARSAL_TIME_MONOTONIC_INFINITE
+ */
+static inline ARSAL_Time_Duration_t ARSAL_Time_GetRemainingNs(ARSAL_Time_Monotonic_t deadline)
+{
+    ARSAL_Time_Monotonic_t now = 0;
+
+    if (deadline == ARSAL_TIME_MONOTONIC_INFINITE)
+    {
+        return INT64_MAX;
+    }
+
+    now = ARSAL_Time_GetMonotonicNs ();
+
+    return (deadline > now) ? (ARSAL_Time_Duration_t)(deadline - now) : 0;
+}
+
+/**
+ * @brief Gets the time of the system clock in nanoseconds since the Epoch
+ * @warning Affected by the changes of the system date and by NTP : use ARSAL_Time_GetMonotonicNs() to measure durations
+ *
+ * @return The system time in nanoseconds
+ */
+static inline uint64_t ARSAL_Time_GetRealtimeNs(void)
+{
+    struct timeval now;
+
+    gettimeofday (&now, NULL);
+
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_usec * 1000ULL;
+}
+
+/**
+ * @brief Converts nanoseconds to a timespec
+ *
+ * @param ns The time in nanoseconds
+ * @param ts Pointer to the timespec to fill
+ */
+static inline void ARSAL_Time_NsToTimespec(uint64_t ns, struct timespec *ts)
+{
+    ts->tv_sec = (time_t)(ns / 1000000000ULL);
+    ts->tv_nsec = (long)(ns % 1000000000ULL);
+}
+
+/**
+ * @brief Converts a timespec to nanoseconds
+ *
+ * @param ts The timespec to convert
+ * @return The time in nanoseconds
+ */
+static inline uint64_t ARSAL_Time_TimespecToNs(const struct timespec *ts)
+{
+    return (uint64_t)ts->tv_sec * 1000000000ULL + (uint64_t)ts->tv_nsec;
+}
+
+/**
+ * @brief Converts nanoseconds to a timeval
+ *
+ * @param ns The time in nanoseconds
+ * @param tv Pointer to the timeval to fill
+ */
+static inline void ARSAL_Time_NsToTimeval(uint64_t ns, struct timeval *tv)
+{
+    tv->tv_sec = (time_t)(ns / 1000000000ULL);
+    tv->tv_usec = (suseconds_t)((ns % 1000000000ULL) / 1000ULL);
+}
+
+/**
+ * @brief Converts a timeval to nanoseconds
+ *
+ * @param tv The timeval to convert
+ * @return The time in nanoseconds
+ */
+static inline uint64_t ARSAL_Time_TimevalToNs(const struct timeval *tv)
+{
+    return (uint64_t)tv->tv_sec * 1000000000ULL + (uint64_t)tv->tv_usec * 1000ULL;
+}
+
+/**
+ * @brief Computes the difference between two timespec in nanoseconds
+ *
+ * @param start Start of the time interval to compute
+ * @param end End of the time interval to compute
+ * @return The number of ns between the two timespec, negative if end is before start
+ */
+static inline ARSAL_Time_Duration_t ARSAL_Time_ComputeTimespecNsTimeDiff(const struct timespec *start, const struct timespec *end)
+{
+    return (ARSAL_Time_Duration_t)(end->tv_sec - start->tv_sec) * 1000000000LL + (ARSAL_Time_Duration_t)(end->tv_nsec - start->tv_nsec);
+}
+
+/**
+ * @brief Reads the cycle counter of the CPU
+ * @note The counter of the x86 CPUs (TSC) must be invariant for the conversion to be meaningful.
+ *
+ * @return The counter, or 0 if the CPU has no counter readable by applications
+ */
+static inline uint64_t ARSAL_Time_GetTicks(void)
+{
+#if defined(__aarch64__)
+    uint64_t ticks;
+    __asm__ __volatile__ ("isb\n\tmrs %0, cntvct_el0" : "=r" (ticks));
+    return ticks;
+#elif defined(__x86_64__) || defined(__i386__)
+    uint32_t low;
+    uint32_t high;
+    __asm__ __volatile__ ("rdtsc" : "=a" (low), "=d" (high));
+    return ((uint64_t)high << 32) | low;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Calibrates the conversion of the cycle counter to nanoseconds
+ *
+ * The generic timer of ARM64 gives its frequency ; on x86 the counter is measured
+ * against the monotonic clock for the given duration.
+ *
+ * @param duration Duration of the measure in milliseconds, ignored on ARM64
+ * @return 0 if the counter was calibrated, -1 if the CPU has no usable counter
+ */
+static inline int ARSAL_Time_CalibrateTicks(uint32_t duration)
+{
+    ARSAL_Time_TicksCalibration_t calibration;
+    uint32_t sequence = 0;
+
+#if defined(__aarch64__)
+    uint64_t frequency;
+
+    (void)duration;
+    __asm__ __volatile__ ("mrs %0, cntfrq_el0" : "=r" (frequency));
+    if (frequency == 0)
+    {
+        return -1;
+    }
+    calibration.scale = (1000000000ULL << 32) / frequency;
+    calibration.ticksOrigin = ARSAL_Time_GetTicks ();
+    calibration.nsOrigin = ARSAL_Time_GetMonotonicNs ();
+#elif defined(__x86_64__) || defined(__i386__)
+    uint64_t startNs = ARSAL_Time_GetMonotonicNs ();
+    uint64_t startTicks = ARSAL_Time_GetTicks ();
+    uint64_t endNs = 0;
+    uint64_t endTicks = 0;
+
+    usleep ((useconds_t)((duration > 0) ? duration : 1) * 1000);
+    endNs = ARSAL_Time_GetMonotonicNs ();
+    endTicks = ARSAL_Time_GetTicks ();
+    if (endTicks <= startTicks)
+    {
+        return -1;
+    }
+    /* ns per tick stays below 1 on the CPUs with a TSC, the 32.32 scale keeps 9 significant digits */
+    calibration.scale = (uint64_t)(((double)(endNs - startNs) / (double)(endTicks - startTicks)) * 4294967296.0);
+    calibration.ticksOrigin = endTicks;
+    calibration.nsOrigin = endNs;
+#else
+    (void)duration;
+    return -1;
+#endif
+
+    /* sequence lock : make the sequence odd, write, make it even again */
+    sequence = __atomic_load_n (&ARSAL_Time_TicksCalibration.sequence, __ATOMIC_RELAXED);
+    while ((sequence & 1) ||
+           !__atomic_compare_exchange_n (&ARSAL_Time_TicksCalibration.sequence, &sequence, sequence + 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        sequence = __atomic_load_n (&ARSAL_Time_TicksCalibration.sequence, __ATOMIC_RELAXED);
+    }
+    __atomic_thread_fence (__ATOMIC_RELEASE);
+    __atomic_store_n (&ARSAL_Time_TicksCalibration.scale, calibration.scale, __ATOMIC_RELAXED);
+    __atomic_store_n (&ARSAL_Time_TicksCalibration.ticksOrigin, calibration.ticksOrigin, __ATOMIC_RELAXED);
+    __atomic_store_n (&ARSAL_Time_TicksCalibration.nsOrigin, calibration.nsOrigin, __ATOMIC_RELAXED);
+    __atomic_store_n (&ARSAL_Time_TicksCalibration.sequence, sequence + 2, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+/**
+ * @brief Converts a cycle counter value to the monotonic clock
+ * @warning ARSAL_Time_CalibrateTicks() must have been called
+ *
+ * @param ticks The cycle counter value
+ * @return The monotonic time in nanoseconds, 0 if the counter was not calibrated
+ */
+static inline ARSAL_Time_Monotonic_t ARSAL_Time_TicksToNs(uint64_t ticks)
+{
+    uint64_t scale = 0;
+    uint64_t ticksOrigin = 0;
+    uint64_t nsOrigin = 0;
+    uint32_t sequence = 0;
+    int64_t delta = 0;
+    uint64_t magnitude = 0;
+    uint64_t fraction = 0;
+    uint64_t ns = 0;
+
+    /* retry while a calibration is being written */
+    do
+    {
+        sequence = __atomic_load_n (&ARSAL_Time_TicksCalibration.sequence, __ATOMIC_ACQUIRE);
+        scale = __atomic_load_n (&ARSAL_Time_TicksCalibration.scale, __ATOMIC_RELAXED);
+        ticksOrigin = __atomic_load_n (&ARSAL_Time_TicksCalibration.ticksOrigin, __ATOMIC_RELAXED);
+        nsOrigin = __atomic_load_n (&ARSAL_Time_TicksCalibration.nsOrigin, __ATOMIC_RELAXED);
+        __atomic_thread_fence (__ATOMIC_ACQUIRE);
+    } while ((sequence & 1) || (sequence != __atomic_load_n (&ARSAL_Time_TicksCalibration.sequence, __ATOMIC_RELAXED)));
+
+    if (scale == 0)
+    {
+        return 0;
+    }
+
+    delta = (int64_t)(ticks - ticksOrigin);
+    magnitude = (delta < 0) ? (uint64_t)-delta : (uint64_t)delta;
+
+    /* 64x64 bits product of the 32.32 scale, without 128 bits integers (armv7) :
+     * integer part times the ticks, then the 32 bits fraction times each half of the ticks */
+    fraction = scale & 0xFFFFFFFFULL;
+    ns = magnitude * (scale >> 32) + (magnitude >> 32) * fraction + (((magnitude & 0xFFFFFFFFULL) * fraction) >> 32);
+
+    return (delta < 0) ? nsOrigin - ns : nsOrigin + ns;
+}
+
 #endif // _ARSAL_TIME_H_
@@ -222,6 +222,16 @@ typedef struct __mavlink_status {
     uint16_t packet_rx_drop_count;      ///< Number of packet drops
 } mavlink_status_t;
 
+/*
+ * Caller owned parsing context for mavlink_parse_buffer() and
+ * mavlink_frame_buffer(). Unlike the channel buffers, the number of
+ * parsers is not limited by MAVLINK_COMM_NUM_BUFFERS.
+ */
+typedef struct __mavlink_parser {
+    mavlink_message_t rxmsg;            ///< Message being parsed
+    mavlink_status_t status;            ///< Parsing state machine and statistics
+} mavlink_parser_t;
+
 #define MAVLINK_BIG_ENDIAN 0
 #define MAVLINK_LITTLE_ENDIAN 1
 
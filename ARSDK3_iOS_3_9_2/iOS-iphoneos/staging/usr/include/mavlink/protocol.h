@@ -72,6 +72,11 @@
 						     mavlink_status_t* r_mavlink_status);
     MAVLINK_HELPER uint8_t mavlink_frame_char(uint8_t chan, uint8_t c, mavlink_message_t* r_message, mavlink_status_t* r_mavlink_status);
     MAVLINK_HELPER uint8_t mavlink_parse_char(uint8_t chan, uint8_t c, mavlink_message_t* r_message, mavlink_status_t* r_mavlink_status);
+    MAVLINK_HELPER void mavlink_parser_init(mavlink_parser_t* parser);
+    MAVLINK_HELPER uint8_t mavlink_frame_buffer(mavlink_parser_t* parser, const uint8_t* buf, size_t len, size_t* r_consumed,
+                                                mavlink_message_t* r_message, mavlink_status_t* r_mavlink_status);
+    MAVLINK_HELPER uint8_t mavlink_parse_buffer(mavlink_parser_t* parser, const uint8_t* buf, size_t len, size_t* r_consumed,
+                                                mavlink_message_t* r_message, mavlink_status_t* r_mavlink_status);
     MAVLINK_HELPER uint8_t put_bitfield_n_by_index(int32_t b, uint8_t bits, uint8_t packet_index, uint8_t bit_index,
                                uint8_t* r_bit_index, uint8_t* buffer);
     #ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
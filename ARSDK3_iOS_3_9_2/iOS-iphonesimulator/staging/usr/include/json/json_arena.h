@@ -0,0 +1,611 @@
+/*
+ * json_object trees allocated from a single region
+ *
+ * This library is free software; you can redistribute it and/or modify
+ * it under the terms of the MIT license. See COPYING for details.
+ *
+ */
+
+/**
+ * The json_arena_new_* functions create json_objects whose memory, keys,
+ * strings, hash tables and array lists included, is taken from an arena.
+ * json_arena_reset() releases a whole document at once and keeps the
+ * memory for the next one: once the arena has grown to the size of the
+ * largest document, building and serializing a document allocates
+ * nothing.
+ *
+ * Arena objects are regular json_objects for the functions which read
+ * them (json_object_get_*, json_object_object_get, json_object_array_*,
+ * json_object_object_foreach, json_object_to_json_string...), and
+ * json_object_put() on them is harmless. They serialize as the json-c
+ * objects do.
+ *
+ * @warning Arena objects and arrays must be modified with
+ * json_arena_object_add() and json_arena_array_add() only: the json-c
+ * functions would resize their tables with realloc() and free().
+ * @warning Arena objects must not be used after json_arena_reset() or
+ * json_arena_free(), even when held by a json-c object.
+ */
+
+#ifndef _json_arena_h_
+#define _json_arena_h_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "json_object.h"
+#include "json_object_private.h"
+#include "linkhash.h"
+#include "arraylist.h"
+#include "printbuf.h"
+#include "printbuf_pool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * default size of the first chunk of an arena
+ */
+#define JSON_ARENA_DEFAULT_SIZE 4096
+
+/**
+ * alignment of the allocations
+ */
+#define JSON_ARENA_ALIGN 16
+
+/* INTERNAL: block of memory of an arena, the data follows */
+struct json_arena_chunk
+{
+  struct json_arena_chunk *next;
+  size_t size;
+};
+
+/* INTERNAL: object to release when the arena is reset */
+struct json_arena_ref
+{
+  struct json_arena_ref *next;
+  struct json_object *obj;
+  /* 1: json_object_put() the object, 0: free the printbuf of the object */
+  int put;
+};
+
+/**
+ * A region holding json_objects
+ */
+struct json_arena
+{
+  struct json_arena_chunk *chunks;
+  char *cursor;
+  char *limit;
+  size_t total;
+  struct json_arena_ref *refs;
+  struct printbuf *pb;
+};
+
+/* INTERNAL: a json_object of an arena */
+struct json_arena_object
+{
+  struct json_object obj;
+  struct json_arena *arena;
+  int pb_tracked;
+};
+
+/* INTERNAL: allocate a chunk of at least size bytes of data */
+static inline int json_arena_add_chunk(struct json_arena *arena, size_t size)
+{
+  size_t header = (sizeof(struct json_arena_chunk) + JSON_ARENA_ALIGN - 1) & ~(size_t)(JSON_ARENA_ALIGN - 1);
+  struct json_arena_chunk *chunk = (struct json_arena_chunk*)malloc(header + size);
+  if(chunk == NULL) return -1;
+  chunk->next = arena->chunks;
+  chunk->size = size;
+  arena->chunks = chunk;
+  arena->cursor = (char*)chunk + header;
+  arena->limit = arena->cursor + size;
+  arena->total += size;
+  return 0;
+}
+
+/**
+ * Create a new arena
+ * @param size size of the first chunk, 0 for JSON_ARENA_DEFAULT_SIZE; the arena grows when needed
+ * @returns the arena, or NULL if out of memory
+ */
+static inline struct json_arena* json_arena_new(size_t size)
+{
+  struct json_arena *arena = (struct json_arena*)calloc(1, sizeof(struct json_arena));
+  if(arena == NULL) return NULL;
+  if(json_arena_add_chunk(arena, (size > 0) ? size : JSON_ARENA_DEFAULT_SIZE) != 0) {
+    free(arena);
+    return NULL;
+  }
+  return arena;
+}
+
+/**
+ * Allocate memory from an arena
+ * @param arena the arena
+ * @param size the size
+ * @returns memory aligned on JSON_ARENA_ALIGN, valid until the arena is reset, or NULL if out of memory
+ */
+static inline void* json_arena_alloc(struct json_arena *arena, size_t size)
+{
+  char *p;
+  size = (size + JSON_ARENA_ALIGN - 1) & ~(size_t)(JSON_ARENA_ALIGN - 1);
+  if((size_t)(arena->limit - arena->cursor) < size) {
+    size_t grow = (arena->chunks != NULL) ? arena->chunks->size * 2 : JSON_ARENA_DEFAULT_SIZE;
+    if(grow < size) grow = size;
+    if(json_arena_add_chunk(arena, grow) != 0) return NULL;
+  }
+  p = arena->cursor;
+  arena->cursor += size;
+  return p;
+}
+
+/* INTERNAL: register an object to release at reset */
+static inline int json_arena_track(struct json_arena *arena, struct json_object *obj, int put)
+{
+  struct json_arena_ref *ref = (struct json_arena_ref*)json_arena_alloc(arena, sizeof(struct json_arena_ref));
+  if(ref == NULL) return -1;
+  ref->obj = obj;
+  ref->put = put;
+  ref->next = arena->refs;
+  arena->refs = ref;
+  return 0;
+}
+
+/* INTERNAL: put the json-c objects added to arena ones, free the printbufs made by json_object_to_json_string() */
+static inline void json_arena_release_refs(struct json_arena *arena)
+{
+  struct json_arena_ref *ref;
+  for(ref = arena->refs; ref != NULL; ref = ref->next) {
+    if(ref->put) {
+      json_object_put(ref->obj);
+    } else {
+      printbuf_free(ref->obj->_pb);
+      ref->obj->_pb = NULL;
+    }
+  }
+  arena->refs = NULL;
+}
+
+/**
+ * Release all the objects of an arena at once
+ *
+ * The memory is kept for the next document: after a reset, the arena has
+ * a single chunk as large as all the memory used before.
+ *
+ * @param arena the arena
+ */
+static inline void json_arena_reset(struct json_arena *arena)
+{
+  struct json_arena_chunk *chunk;
+  size_t header = (sizeof(struct json_arena_chunk) + JSON_ARENA_ALIGN - 1) & ~(size_t)(JSON_ARENA_ALIGN - 1);
+
+  json_arena_release_refs(arena);
+
+  if(arena->chunks != NULL && arena->chunks->next != NULL) {
+    size_t total = arena->total;
+    while(arena->chunks != NULL) {
+      chunk = arena->chunks;
+      arena->chunks = chunk->next;
+      free(chunk);
+    }
+    arena->total = 0;
+    if(json_arena_add_chunk(arena, total) == 0) return;
+    /* out of memory: the next allocation makes a new chunk */
+  }
+  if(arena->chunks == NULL) {
+    arena->cursor = arena->limit = NULL;
+    return;
+  }
+  arena->cursor = (char*)arena->chunks + header;
+  arena->limit = arena->cursor + arena->chunks->size;
+}
+
+/**
+ * Free an arena and all its objects
+ * @param arena the arena, or NULL
+ */
+static inline void json_arena_free(struct json_arena *arena)
+{
+  struct json_arena_chunk *chunk;
+  if(arena == NULL) return;
+  json_arena_release_refs(arena);
+  while(arena->chunks != NULL) {
+    chunk = arena->chunks;
+    arena->chunks = chunk->next;
+    free(chunk);
+  }
+  json_printbuf_pool_put(arena->pb);
+  free(arena);
+}
+
+/* INTERNAL: deleting an arena object releases nothing, the arena owns it */
+static inline void json_arena_object_delete(struct json_object *jso)
+{
+  (void)jso;
+}
+
+/* INTERNAL: record the printbuf created by json_object_to_json_string() on an arena object */
+static inline void json_arena_track_pb(struct json_object *jso, struct printbuf *pb)
+{
+  struct json_arena_object *ao = (struct json_arena_object*)jso;
+  if(pb == jso->_pb && !ao->pb_tracked && json_arena_track(ao->arena, jso, 0) == 0) {
+    ao->pb_tracked = 1;
+  }
+}
+
+/* INTERNAL: append a nul terminated string */
+static inline int json_arena_append(struct printbuf *pb, const char *str)
+{
+  return json_printbuf_memappend(pb, str, (int)strlen(str));
+}
+
+/* INTERNAL: escape a string as json-c does */
+static inline void json_arena_escape_str(struct printbuf *pb, const char *str)
+{
+  static const char hex[] = "0123456789abcdef";
+  int pos = 0, start_offset = 0;
+  unsigned char c;
+
+  while((c = (unsigned char)str[pos]) != '\0') {
+    const char *escaped = NULL;
+    char unicode[7];
+    switch(c) {
+    case '\b': escaped = "\\b"; break;
+    case '\n': escaped = "\\n"; break;
+    case '\r': escaped = "\\r"; break;
+    case '\t': escaped = "\\t"; break;
+    case '"': escaped = "\\\""; break;
+    case '\\': escaped = "\\\\"; break;
+    case '/': escaped = "\\/"; break;
+    default:
+      if(c < ' ') {
+        memcpy(unicode, "\\u00", 4);
+        unicode[4] = hex[c >> 4];
+        unicode[5] = hex[c & 0xf];
+        unicode[6] = '\0';
+        escaped = unicode;
+      }
+      break;
+    }
+    if(escaped != NULL) {
+      if(pos - start_offset > 0) json_printbuf_memappend(pb, str + start_offset, pos - start_offset);
+      json_arena_append(pb, escaped);
+      start_offset = pos + 1;
+    }
+    pos++;
+  }
+  if(pos - start_offset > 0) json_printbuf_memappend(pb, str + start_offset, pos - start_offset);
+}
+
+static inline int json_arena_value_to_json_string(struct json_object *jso, struct printbuf *pb)
+{
+  char number[64];
+  json_arena_track_pb(jso, pb);
+  switch(jso->o_type) {
+  case json_type_boolean:
+    return json_arena_append(pb, jso->o.c_boolean ? "true" : "false");
+  case json_type_int:
+    snprintf(number, sizeof(number), "%d", jso->o.c_int);
+    return json_arena_append(pb, number);
+  case json_type_double:
+    snprintf(number, sizeof(number), "%lf", jso->o.c_double);
+    return json_arena_append(pb, number);
+  case json_type_string:
+    json_arena_append(pb, "\"");
+    json_arena_escape_str(pb, jso->o.c_string);
+    return json_arena_append(pb, "\"");
+  default:
+    return json_arena_append(pb, "null");
+  }
+}
+
+static inline int json_arena_object_to_json_string(struct json_object *jso, struct printbuf *pb)
+{
+  struct lh_entry *entry;
+  int i = 0;
+  json_arena_track_pb(jso, pb);
+  json_arena_append(pb, "{");
+  for(entry = jso->o.c_object->head; entry != NULL; entry = entry->next) {
+    struct json_object *val = (struct json_object*)entry->v;
+    json_arena_append(pb, i++ ? ", \"" : " \"");
+    json_arena_escape_str(pb, (const char*)entry->k);
+    json_arena_append(pb, "\": ");
+    if(val == NULL) json_arena_append(pb, "null");
+    else val->_to_json_string(val, pb);
+  }
+  return json_arena_append(pb, " }");
+}
+
+static inline int json_arena_array_to_json_string(struct json_object *jso, struct printbuf *pb)
+{
+  int i;
+  json_arena_track_pb(jso, pb);
+  json_arena_append(pb, "[");
+  for(i = 0; i < jso->o.c_array->length; i++) {
+    struct json_object *val = (struct json_object*)jso->o.c_array->array[i];
+    json_arena_append(pb, i ? ", " : " ");
+    if(val == NULL) json_arena_append(pb, "null");
+    else val->_to_json_string(val, pb);
+  }
+  return json_arena_append(pb, " ]");
+}
+
+/* INTERNAL: create an arena object of a type */
+static inline struct json_object* json_arena_object_new(struct json_arena *arena, enum json_type type)
+{
+  struct json_arena_object *ao = (struct json_arena_object*)json_arena_alloc(arena, sizeof(struct json_arena_object));
+  if(ao == NULL) return NULL;
+  memset(ao, 0, sizeof(*ao));
+  ao->arena = arena;
+  ao->obj.o_type = type;
+  ao->obj._delete = json_arena_object_delete;
+  ao->obj._to_json_string = json_arena_value_to_json_string;
+  ao->obj._ref_count = 1;
+  return &ao->obj;
+}
+
+/* INTERNAL: make the table of an arena object empty with size slots */
+static inline int json_arena_table_init(struct json_arena *arena, struct lh_table *t, int size)
+{
+  struct lh_entry *table = (struct lh_entry*)json_arena_alloc(arena, (size_t)size * sizeof(struct lh_entry));
+  int i;
+  if(table == NULL) return -1;
+  memset(table, 0, (size_t)size * sizeof(struct lh_entry));
+  for(i = 0; i < size; i++) table[i].k = LH_EMPTY;
+  t->table = table;
+  t->size = size;
+  t->count = 0;
+  t->head = t->tail = NULL;
+  return 0;
+}
+
+/* INTERNAL: double the table of an arena object, keeping the insertion order */
+static inline int json_arena_table_grow(struct json_arena *arena, struct lh_table *t)
+{
+  struct lh_entry *entry = t->head;
+  if(json_arena_table_init(arena, t, t->size * 2) != 0) return -1;
+  /* the old slots stay in the arena, untouched by the inserts */
+  for(; entry != NULL; entry = entry->next) lh_table_insert(t, entry->k, entry->v);
+  t->resizes++;
+  return 0;
+}
+
+/**
+ * Create a new json_object of type json_type_object in an arena
+ * @param arena the arena
+ * @param count number of fields expected, the table grows past it when needed
+ * @returns the object, or NULL if out of memory
+ */
+static inline struct json_object* json_arena_new_object_size(struct json_arena *arena, int count)
+{
+  struct json_object *jso = json_arena_object_new(arena, json_type_object);
+  struct lh_table *t;
+  int size = JSON_OBJECT_DEF_HASH_ENTRIES;
+  if(jso == NULL) return NULL;
+  /* keep the load under 1/2 so that lh_table_insert() never resizes the table itself */
+  if(count > 0 && count * 2 + 2 > size) size = count * 2 + 2;
+  t = (struct lh_table*)json_arena_alloc(arena, sizeof(struct lh_table));
+  if(t == NULL) return NULL;
+  memset(t, 0, sizeof(*t));
+  t->name = "json_arena_object";
+  t->hash_fn = lh_char_hash;
+  t->equal_fn = lh_char_equal;
+  if(json_arena_table_init(arena, t, size) != 0) return NULL;
+  jso->o.c_object = t;
+  jso->_to_json_string = json_arena_object_to_json_string;
+  return jso;
+}
+
+/**
+ * Create a new json_object of type json_type_object in an arena
+ * @param arena the arena
+ * @returns the object, or NULL if out of memory
+ */
+static inline struct json_object* json_arena_new_object(struct json_arena *arena)
+{
+  return json_arena_new_object_size(arena, 0);
+}
+
+/**
+ * Create a new json_object of type json_type_array in an arena
+ * @param arena the arena
+ * @param count number of elements expected, the array grows past it when needed
+ * @returns the array, or NULL if out of memory
+ */
+static inline struct json_object* json_arena_new_array_size(struct json_arena *arena, int count)
+{
+  struct json_object *jso = json_arena_object_new(arena, json_type_array);
+  struct array_list *al;
+  if(jso == NULL) return NULL;
+  al = (struct array_list*)json_arena_alloc(arena, sizeof(struct array_list));
+  if(al == NULL) return NULL;
+  al->size = (count > 0) ? count : 8;
+  al->length = 0;
+  al->free_fn = NULL;
+  al->array = (void**)json_arena_alloc(arena, (size_t)al->size * sizeof(void*));
+  if(al->array == NULL) return NULL;
+  jso->o.c_array = al;
+  jso->_to_json_string = json_arena_array_to_json_string;
+  return jso;
+}
+
+/**
+ * Create a new json_object of type json_type_array in an arena
+ * @param arena the arena
+ * @returns the array, or NULL if out of memory
+ */
+static inline struct json_object* json_arena_new_array(struct json_arena *arena)
+{
+  return json_arena_new_array_size(arena, 0);
+}
+
+/**
+ * Create a new json_object of type json_type_boolean in an arena
+ * @param arena the arena
+ * @param b the value
+ * @returns the object, or NULL if out of memory
+ */
+static inline struct json_object* json_arena_new_boolean(struct json_arena *arena, boolean b)
+{
+  struct json_object *jso = json_arena_object_new(arena, json_type_boolean);
+  if(jso != NULL) jso->o.c_boolean = b;
+  return jso;
+}
+
+/**
+ * Create a new json_object of type json_type_int in an arena
+ * @param arena the arena
+ * @param i the value
+ * @returns the object, or NULL if out of memory
+ */
+static inline struct json_object* json_arena_new_int(struct json_arena *arena, int i)
+{
+  struct json_object *jso = json_arena_object_new(arena, json_type_int);
+  if(jso != NULL) jso->o.c_int = i;
+  return jso;
+}
+
+/**
+ * Create a new json_object of type json_type_double in an arena
+ * @param arena the arena
+ * @param d the value
+ * @returns the object, or NULL if out of memory
+ */
+static inline struct json_object* json_arena_new_double(struct json_arena *arena, double d)
+{
+  struct json_object *jso = json_arena_object_new(arena, json_type_double);
+  if(jso != NULL) jso->o.c_double = d;
+  return jso;
+}
+
+/**
+ * Create a new json_object of type json_type_string in an arena
+ * @param arena the arena
+ * @param s the string, copied in the arena
+ * @param len the length of the string
+ * @returns the object, or NULL if out of memory
+ */
+static inline struct json_object* json_arena_new_string_len(struct json_arena *arena, const char *s, int len)
+{
+  struct json_object *jso = json_arena_object_new(arena, json_type_string);
+  char *copy;
+  if(jso == NULL) return NULL;
+  copy = (char*)json_arena_alloc(arena, (size_t)len + 1);
+  if(copy == NULL) return NULL;
+  memcpy(copy, s, (size_t)len);
+  copy[len] = '\0';
+  jso->o.c_string = copy;
+  return jso;
+}
+
+/**
+ * Create a new json_object of type json_type_string in an arena
+ * @param arena the arena
+ * @param s the nul terminated string, copied in the arena
+ * @returns the object, or NULL if out of memory
+ */
+static inline struct json_object* json_arena_new_string(struct json_arena *arena, const char *s)
+{
+  return json_arena_new_string_len(arena, s, (int)strlen(s));
+}
+
+/* INTERNAL: take the reference of a json-c value added to an arena container */
+static inline int json_arena_adopt(struct json_arena *arena, struct json_object *val)
+{
+  if(val == NULL || val->_delete == json_arena_object_delete) return 0;
+  return json_arena_track(arena, val, 1);
+}
+
+/**
+ * Add a field to an arena object
+ *
+ * As json_object_object_add(), the reference of val is taken over: a
+ * json-c value is put when the arena is reset. A field with the same key
+ * is replaced.
+ *
+ * @param arena the arena of the object
+ * @param jso an arena object of type json_type_object
+ * @param key the key, copied in the arena
+ * @param val the value, or NULL for null
+ * @returns 0 on success, -1 if out of memory
+ */
+static inline int json_arena_object_add(struct json_arena *arena, struct json_object *jso, const char *key, struct json_object *val)
+{
+  struct lh_table *t = jso->o.c_object;
+  struct lh_entry *existing = lh_table_lookup_entry(t, key);
+  size_t len;
+  char *copy;
+
+  if(json_arena_adopt(arena, val) != 0) return -1;
+  if(existing != NULL) {
+    existing->v = val;
+    return 0;
+  }
+  if(t->count + 1 > t->size / 2 && json_arena_table_grow(arena, t) != 0) return -1;
+  len = strlen(key);
+  copy = (char*)json_arena_alloc(arena, len + 1);
+  if(copy == NULL) return -1;
+  memcpy(copy, key, len + 1);
+  return lh_table_insert(t, copy, val);
+}
+
+/**
+ * Append an element to an arena array
+ *
+ * As json_object_array_add(), the reference of val is taken over: a
+ * json-c value is put when the arena is reset.
+ *
+ * @param arena the arena of the array
+ * @param jso an arena object of type json_type_array
+ * @param val the element, or NULL for null
+ * @returns 0 on success, -1 if out of memory
+ */
+static inline int json_arena_array_add(struct json_arena *arena, struct json_object *jso, struct json_object *val)
+{
+  struct array_list *al = jso->o.c_array;
+  if(json_arena_adopt(arena, val) != 0) return -1;
+  if(al->length == al->size) {
+    void **array = (void**)json_arena_alloc(arena, (size_t)al->size * 2 * sizeof(void*));
+    if(array == NULL) return -1;
+    memcpy(array, al->array, (size_t)al->length * sizeof(void*));
+    al->array = array;
+    al->size *= 2;
+  }
+  al->array[al->length++] = val;
+  return 0;
+}
+
+/**
+ * Serialize a json_object in the printbuf of an arena
+ *
+ * Unlike json_object_to_json_string(), the object can come from the arena
+ * or from json-c, and its printbuf is taken from the pool of the calling
+ * thread and reused for all the documents of the arena.
+ *
+ * @param arena the arena
+ * @param jso the object, or NULL for null
+ * @returns the string, valid until the next call or json_arena_free(), or NULL if out of memory
+ */
+static inline const char* json_arena_to_json_string(struct json_arena *arena, struct json_object *jso)
+{
+  struct printbuf *pb = arena->pb;
+  if(pb == NULL) {
+    pb = arena->pb = json_printbuf_pool_get();
+    if(pb == NULL) return NULL;
+  }
+  pb->bpos = 0;
+  pb->buf[0] = '\0';
+  if(jso == NULL) json_arena_append(pb, "null");
+  else jso->_to_json_string(jso, pb);
+  return pb->buf;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1009 @@
+/*
+ * Two pass SIMD parser producing json_object trees
+ *
+ * This library is free software; you can redistribute it and/or modify
+ * it under the terms of the MIT license. See COPYING for details.
+ *
+ */
+
+/**
+ * The first pass classifies the input 64 bytes at a time with vector
+ * compares (SSE2 on x86, NEON on arm64, portable code elsewhere) and
+ * records the offsets of the structural characters, of the opening quotes
+ * and of the first byte of each scalar, skipping the insides of strings
+ * with a prefix xor of the unescaped quotes. The second pass walks these
+ * offsets without looking at the bytes in between and writes a flat tape
+ * of nodes; strings are unescaped into a single buffer.
+ *
+ * The index, the tape and the strings live in buffers owned by the
+ * parser, which keeps them from a document to the next: once they have
+ * grown to the size of the largest document, parsing allocates nothing.
+ * The tape can be read in place with the json_simd_node_* functions,
+ * or converted into a regular json_object tree with json_simd_to_object(),
+ * or into a tree allocated in an arena with json_simd_to_arena().
+ *
+ * The parser accepts strict JSON (RFC 8259). json_simd_tokener_parse()
+ * falls back to json_tokener_parse() for the extensions of the json-c
+ * tokener (comments, single quoted strings...).
+ */
+
+#ifndef _json_simd_h_
+#define _json_simd_h_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "json_object.h"
+#include "json_tokener.h"
+#include "json_arena.h"
+#include "linkhash_oa.h"
+
+#if !defined(JSON_SIMD_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+# include <emmintrin.h>
+# define JSON_SIMD_SSE2 1
+#elif !defined(JSON_SIMD_NO_SIMD) && defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+# include <arm_neon.h>
+# define JSON_SIMD_NEON 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximum nesting of arrays and objects, as in the json-c tokener
+ */
+#define JSON_SIMD_MAX_DEPTH JSON_TOKENER_MAX_DEPTH
+
+/**
+ * Number of members from which json_simd_node_object_get() indexes an
+ * object instead of scanning it
+ */
+#define JSON_SIMD_INDEX_MIN_COUNT 32
+
+/**
+ * A value of a parsed document
+ *
+ * The nodes of a document are stored in document order: an object is
+ * followed by its keys (string nodes) each followed by its value, an
+ * array by its elements.
+ */
+struct json_simd_node
+{
+  /**
+   * Type of the value
+   */
+  enum json_type type;
+  /**
+   * Number of nodes of this value: 1 plus the nodes of its children
+   */
+  uint32_t size;
+  union {
+    boolean c_boolean;
+    double c_double;
+    int c_int;
+    /**
+     * Number of members of an object or of elements of an array
+     */
+    uint32_t c_count;
+    /**
+     * Unescaped string, in the strings buffer of the parser
+     */
+    struct {
+      uint32_t offset;
+      uint32_t length;
+    } c_string;
+  } o;
+};
+
+/**
+ * A reusable parser
+ */
+struct json_simd_parser
+{
+  uint32_t *index;
+  size_t index_size;
+  struct json_simd_node *tape;
+  size_t tape_count;
+  size_t tape_size;
+  char *strings;
+  size_t strings_size;
+  enum json_tokener_error err;
+  size_t err_offset;
+  /* index of the members of the last large object looked up, keys in strings */
+  struct lh_oa_table *object_index;
+  const struct json_simd_node *object_indexed;
+};
+
+/**
+ * Create a new parser
+ * @returns the parser, or NULL if out of memory
+ */
+static inline struct json_simd_parser* json_simd_parser_new(void)
+{
+  return (struct json_simd_parser*)calloc(1, sizeof(struct json_simd_parser));
+}
+
+/**
+ * Free a parser and the last document parsed
+ * @param parser the parser
+ */
+static inline void json_simd_parser_free(struct json_simd_parser *parser)
+{
+  if(parser == NULL) return;
+  free(parser->index);
+  free(parser->tape);
+  free(parser->strings);
+  lh_oa_table_free(parser->object_index);
+  free(parser);
+}
+
+/* INTERNAL: bit masks of a 64 bytes block, bit i for byte i */
+struct json_simd_block
+{
+  uint64_t quote;
+  uint64_t backslash;
+  uint64_t structural;
+  uint64_t whitespace;
+};
+
+#if defined(JSON_SIMD_SSE2)
+
+static inline uint64_t json_simd_mask16(__m128i m)
+{
+  return (uint64_t)(uint16_t)_mm_movemask_epi8(m);
+}
+
+static inline void json_simd_classify(const char *p, struct json_simd_block *b)
+{
+  int i;
+  memset(b, 0, sizeof(*b));
+  for(i = 0; i < 4; i++) {
+    __m128i v = _mm_loadu_si128((const __m128i*)(p + 16 * i));
+    /* '{' '[' and '}' ']' differ only by 0x20 */
+    __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    __m128i s = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')),
+                                          _mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))),
+                             _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')),
+                                          _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+    __m128i w = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                          _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                             _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+                                          _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+    b->quote |= json_simd_mask16(_mm_cmpeq_epi8(v, _mm_set1_epi8('"'))) << (16 * i);
+    b->backslash |= json_simd_mask16(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))) << (16 * i);
+    b->structural |= json_simd_mask16(s) << (16 * i);
+    b->whitespace |= json_simd_mask16(w) << (16 * i);
+  }
+}
+
+#elif defined(JSON_SIMD_NEON)
+
+static inline uint64_t json_simd_mask64(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3)
+{
+  static const uint8_t bits[16] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                                    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+  uint8x16_t bit = vld1q_u8(bits);
+  uint8x16_t sum0 = vpaddq_u8(vandq_u8(m0, bit), vandq_u8(m1, bit));
+  uint8x16_t sum1 = vpaddq_u8(vandq_u8(m2, bit), vandq_u8(m3, bit));
+  sum0 = vpaddq_u8(sum0, sum1);
+  sum0 = vpaddq_u8(sum0, sum0);
+  return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+
+static inline void json_simd_classify(const char *p, struct json_simd_block *b)
+{
+  uint8x16_t q[4], bs[4], s[4], w[4];
+  int i;
+  for(i = 0; i < 4; i++) {
+    uint8x16_t v = vld1q_u8((const uint8_t*)p + 16 * i);
+    uint8x16_t lower = vorrq_u8(v, vdupq_n_u8(0x20));
+    q[i] = vceqq_u8(v, vdupq_n_u8('"'));
+    bs[i] = vceqq_u8(v, vdupq_n_u8('\\'));
+    s[i] = vorrq_u8(vorrq_u8(vceqq_u8(lower, vdupq_n_u8('{')), vceqq_u8(lower, vdupq_n_u8('}'))),
+                    vorrq_u8(vceqq_u8(v, vdupq_n_u8(':')), vceqq_u8(v, vdupq_n_u8(','))));
+    w[i] = vorrq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')), vceqq_u8(v, vdupq_n_u8('\t'))),
+                    vorrq_u8(vceqq_u8(v, vdupq_n_u8('\n')), vceqq_u8(v, vdupq_n_u8('\r'))));
+  }
+  b->quote = json_simd_mask64(q[0], q[1], q[2], q[3]);
+  b->backslash = json_simd_mask64(bs[0], bs[1], bs[2], bs[3]);
+  b->structural = json_simd_mask64(s[0], s[1], s[2], s[3]);
+  b->whitespace = json_simd_mask64(w[0], w[1], w[2], w[3]);
+}
+
+#else
+
+static inline void json_simd_classify(const char *p, struct json_simd_block *b)
+{
+  int i;
+  memset(b, 0, sizeof(*b));
+  for(i = 0; i < 64; i++) {
+    uint64_t bit = (uint64_t)1 << i;
+    switch(p[i]) {
+    case '"': b->quote |= bit; break;
+    case '\\': b->backslash |= bit; break;
+    case '{': case '}': case '[': case ']': case ':': case ',': b->structural |= bit; break;
+    case ' ': case '\t': case '\n': case '\r': b->whitespace |= bit; break;
+    default: break;
+    }
+  }
+}
+
+#endif
+
+/* INTERNAL: inclusive prefix xor, bit i is the parity of bits 0..i */
+static inline uint64_t json_simd_prefix_xor(uint64_t x)
+{
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+/* INTERNAL: bytes escaped by an odd run of backslashes, carrying runs across blocks */
+static inline uint64_t json_simd_escaped(uint64_t backslash, uint64_t *carry)
+{
+  const uint64_t even = 0x5555555555555555ULL;
+  uint64_t follows, odd_starts, sum, invert;
+  int overflow;
+
+  backslash &= ~*carry;
+  follows = (backslash << 1) | *carry;
+  odd_starts = backslash & ~even & ~follows;
+  sum = odd_starts + backslash;
+  overflow = sum < backslash;
+  *carry = (uint64_t)overflow;
+  invert = sum << 1;
+  return (even ^ invert) & follows;
+}
+
+/* INTERNAL: grow a buffer to hold count elements */
+static inline int json_simd_reserve(void **buf, size_t *size, size_t count, size_t elem)
+{
+  void *grown;
+  size_t want;
+  if(*size >= count) return 0;
+  want = (*size < 64) ? 64 : *size;
+  while(want < count) want *= 2;
+  grown = realloc(*buf, want * elem);
+  if(grown == NULL) return -1;
+  *buf = grown;
+  *size = want;
+  return 0;
+}
+
+/* INTERNAL: first pass, record the offsets of the structural bytes into parser->index */
+static inline size_t json_simd_index(struct json_simd_parser *parser, const char *str, size_t len,
+                                     int *unclosed)
+{
+  uint32_t *out = parser->index;
+  size_t count = 0;
+  uint64_t carry = 0, in_string = 0, prev_scalar = 0;
+  size_t pos;
+  char tail[64];
+
+  for(pos = 0; pos < len; pos += 64) {
+    struct json_simd_block b;
+    uint64_t escaped, quote, string, scalar, bits;
+
+    if(len - pos >= 64) {
+      json_simd_classify(str + pos, &b);
+    } else {
+      memset(tail, ' ', sizeof(tail));
+      memcpy(tail, str + pos, len - pos);
+      json_simd_classify(tail, &b);
+    }
+
+    escaped = json_simd_escaped(b.backslash, &carry);
+    quote = b.quote & ~escaped;
+    /* 1 from an opening quote up to the byte before the closing quote */
+    string = json_simd_prefix_xor(quote) ^ in_string;
+    in_string = (uint64_t)((int64_t)string >> 63);
+
+    scalar = ~(b.structural | b.whitespace | quote) & ~string;
+    bits = (b.structural & ~string) | (quote & string) | (scalar & ~((scalar << 1) | prev_scalar));
+    prev_scalar = scalar >> 63;
+
+    while(bits != 0) {
+      out[count++] = (uint32_t)(pos + (size_t)__builtin_ctzll(bits));
+      bits &= bits - 1;
+    }
+  }
+
+  *unclosed = (in_string != 0);
+  return count;
+}
+
+/* INTERNAL: true for the bytes which can continue a scalar */
+static inline int json_simd_is_scalar_byte(const char *str, size_t len, size_t pos)
+{
+  char c;
+  if(pos >= len) return 0;
+  c = str[pos];
+  return !(c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' || c == ':' ||
+           c == '[' || c == ']' || c == '{' || c == '}' || c == '"');
+}
+
+/* INTERNAL: offset of the first '"' or '\\' from pos, or len */
+static inline size_t json_simd_find_quote(const char *str, size_t len, size_t pos)
+{
+#if defined(JSON_SIMD_SSE2)
+  while(pos + 16 <= len) {
+    __m128i v = _mm_loadu_si128((const __m128i*)(str + pos));
+    int m = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+                                           _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))));
+    if(m != 0) return pos + (size_t)__builtin_ctz((unsigned)m);
+    pos += 16;
+  }
+#elif defined(JSON_SIMD_NEON)
+  while(pos + 16 <= len) {
+    uint8x16_t v = vld1q_u8((const uint8_t*)str + pos);
+    uint8x16_t m = vorrq_u8(vceqq_u8(v, vdupq_n_u8('"')), vceqq_u8(v, vdupq_n_u8('\\')));
+    /* 4 bits per byte */
+    uint64_t nibbles = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+    if(nibbles != 0) return pos + (size_t)(__builtin_ctzll(nibbles) >> 2);
+    pos += 16;
+  }
+#endif
+  while(pos < len && str[pos] != '"' && str[pos] != '\\') pos++;
+  return pos;
+}
+
+/* INTERNAL: value of a hexadecimal digit, or -1 */
+static inline int json_simd_hex(char c)
+{
+  if(c >= '0' && c <= '9') return c - '0';
+  if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+/* INTERNAL: read 4 hexadecimal digits, or return -1 */
+static inline long json_simd_hex4(const char *str, size_t len, size_t pos)
+{
+  long value = 0;
+  int i;
+  if(pos + 4 > len) return -1;
+  for(i = 0; i < 4; i++) {
+    int digit = json_simd_hex(str[pos + i]);
+    if(digit < 0) return -1;
+    value = (value << 4) | digit;
+  }
+  return value;
+}
+
+/* INTERNAL: unescape the string opening at pos into the strings buffer, return the offset after the closing quote or 0 */
+static inline size_t json_simd_string(struct json_simd_parser *parser, const char *str, size_t len,
+                                      size_t pos, size_t *used, struct json_simd_node *node)
+{
+  char *out = parser->strings + *used;
+  char *start = out;
+
+  pos++;
+  for(;;) {
+    size_t next = json_simd_find_quote(str, len, pos);
+    memcpy(out, str + pos, next - pos);
+    out += next - pos;
+    if(next >= len) return 0;
+    pos = next + 1;
+    if(str[next] == '"') break;
+
+    if(pos >= len) return 0;
+    switch(str[pos++]) {
+    case '"': *out++ = '"'; break;
+    case '\\': *out++ = '\\'; break;
+    case '/': *out++ = '/'; break;
+    case 'b': *out++ = '\b'; break;
+    case 'f': *out++ = '\f'; break;
+    case 'n': *out++ = '\n'; break;
+    case 'r': *out++ = '\r'; break;
+    case 't': *out++ = '\t'; break;
+    case 'u': {
+      long c = json_simd_hex4(str, len, pos);
+      if(c < 0) return 0;
+      pos += 4;
+      if(c >= 0xD800 && c < 0xDC00 && pos + 6 <= len && str[pos] == '\\' && str[pos + 1] == 'u') {
+        long low = json_simd_hex4(str, len, pos + 2);
+        if(low >= 0xDC00 && low < 0xE000) {
+          c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+          pos += 6;
+        }
+      }
+      /* lone surrogates are encoded as is, like the json-c tokener does */
+      if(c < 0x80) {
+        *out++ = (char)c;
+      } else if(c < 0x800) {
+        *out++ = (char)(0xC0 | (c >> 6));
+        *out++ = (char)(0x80 | (c & 0x3F));
+      } else if(c < 0x10000) {
+        *out++ = (char)(0xE0 | (c >> 12));
+        *out++ = (char)(0x80 | ((c >> 6) & 0x3F));
+        *out++ = (char)(0x80 | (c & 0x3F));
+      } else {
+        *out++ = (char)(0xF0 | (c >> 18));
+        *out++ = (char)(0x80 | ((c >> 12) & 0x3F));
+        *out++ = (char)(0x80 | ((c >> 6) & 0x3F));
+        *out++ = (char)(0x80 | (c & 0x3F));
+      }
+      break;
+    }
+    default:
+      return 0;
+    }
+  }
+
+  *out = '\0';
+  node->type = json_type_string;
+  node->o.c_string.offset = (uint32_t)*used;
+  node->o.c_string.length = (uint32_t)(out - start);
+  *used += (size_t)(out - start) + 1;
+  return pos;
+}
+
+/* INTERNAL: parse the scalar starting at pos, return the offset after it or 0 */
+static inline size_t json_simd_scalar(struct json_simd_parser *parser, const char *str, size_t len,
+                                      size_t pos, size_t used, struct json_simd_node *node)
+{
+  size_t start = pos;
+  uint64_t mantissa = 0;
+  int digits = 0, integer = 1;
+
+  switch(str[pos]) {
+  case 't':
+    if(len - pos < 4 || memcmp(str + pos, "true", 4) != 0) return 0;
+    node->type = json_type_boolean;
+    node->o.c_boolean = TRUE;
+    pos += 4;
+    break;
+  case 'f':
+    if(len - pos < 5 || memcmp(str + pos, "false", 5) != 0) return 0;
+    node->type = json_type_boolean;
+    node->o.c_boolean = FALSE;
+    pos += 5;
+    break;
+  case 'n':
+    if(len - pos < 4 || memcmp(str + pos, "null", 4) != 0) return 0;
+    node->type = json_type_null;
+    pos += 4;
+    break;
+  default:
+    if(str[pos] == '-') pos++;
+    if(pos >= len || str[pos] < '0' || str[pos] > '9') return 0;
+    if(str[pos] == '0') {
+      pos++;
+      digits = 1;
+    } else {
+      while(pos < len && str[pos] >= '0' && str[pos] <= '9') {
+        mantissa = mantissa * 10 + (uint64_t)(str[pos] - '0');
+        digits++;
+        pos++;
+      }
+    }
+    if(pos < len && str[pos] == '.') {
+      integer = 0;
+      pos++;
+      if(pos >= len || str[pos] < '0' || str[pos] > '9') return 0;
+      while(pos < len && str[pos] >= '0' && str[pos] <= '9') pos++;
+    }
+    if(pos < len && (str[pos] == 'e' || str[pos] == 'E')) {
+      integer = 0;
+      pos++;
+      if(pos < len && (str[pos] == '+' || str[pos] == '-')) pos++;
+      if(pos >= len || str[pos] < '0' || str[pos] > '9') return 0;
+      while(pos < len && str[pos] >= '0' && str[pos] <= '9') pos++;
+    }
+    if(integer && digits <= 10 && mantissa <= (uint64_t)INT_MAX + (str[start] == '-')) {
+      node->type = json_type_int;
+      node->o.c_int = (str[start] == '-') ? (int)(0 - mantissa) : (int)mantissa;
+    } else {
+      /* integers beyond the range of an int are kept as doubles ; the input is not
+         nul terminated, strtod() reads a copy in the free space of the strings buffer */
+      char *copy = parser->strings + used;
+      memcpy(copy, str + start, pos - start);
+      copy[pos - start] = '\0';
+      node->type = json_type_double;
+      node->o.c_double = strtod(copy, NULL);
+    }
+    break;
+  }
+
+  if(json_simd_is_scalar_byte(str, len, pos)) return 0;
+  return pos;
+}
+
+/**
+ * Parse a document
+ *
+ * The returned tape is valid until the next parse or until the parser is freed.
+ *
+ * @param parser the parser
+ * @param str the document, which does not need to be nul terminated
+ * @param len the length of the document
+ * @returns the root node, or NULL on error (see json_simd_parser_error())
+ */
+static inline const struct json_simd_node* json_simd_parse(struct json_simd_parser *parser,
+                                                           const char *str, size_t len)
+{
+  /* for each open container, its node and the state to restore */
+  uint32_t stack[JSON_SIMD_MAX_DEPTH];
+  int depth = 0;
+  size_t count, i = 0, used = 0, pos = 0;
+  struct json_simd_node *tape;
+  uint32_t n = 0;
+  int unclosed = 0;
+
+  parser->tape_count = 0;
+  parser->err = json_tokener_success;
+  parser->err_offset = 0;
+  /* the tape is reused: a node of the new document can have the address of the indexed one */
+  parser->object_indexed = NULL;
+
+  if(len >= UINT32_MAX ||
+     json_simd_reserve((void**)&parser->index, &parser->index_size, len + 1, sizeof(uint32_t)) != 0 ||
+     json_simd_reserve((void**)&parser->strings, &parser->strings_size, len + 1, 1) != 0) {
+    parser->err = json_tokener_error_parse_eof;
+    return NULL;
+  }
+
+  /* each node starts at an indexed byte */
+  count = json_simd_index(parser, str, len, &unclosed);
+  if(json_simd_reserve((void**)&parser->tape, &parser->tape_size, count + 1, sizeof(struct json_simd_node)) != 0) {
+    parser->err = json_tokener_error_parse_eof;
+    return NULL;
+  }
+  tape = parser->tape;
+
+  if(unclosed) {
+    parser->err = json_tokener_error_parse_string;
+    parser->err_offset = len;
+    return NULL;
+  }
+
+  for(;;) {
+    struct json_simd_node *container;
+    char c;
+
+    /* a value is expected */
+    if(i >= count) {
+      parser->err = json_tokener_error_parse_eof;
+      goto fail;
+    }
+    pos = parser->index[i++];
+    c = str[pos];
+    if(c == '{' || c == '[') {
+      if(depth == JSON_SIMD_MAX_DEPTH) {
+        parser->err = json_tokener_error_depth;
+        goto fail;
+      }
+      tape[n].type = (c == '{') ? json_type_object : json_type_array;
+      tape[n].o.c_count = 0;
+      stack[depth++] = n++;
+      if(i < count && str[parser->index[i]] == ((c == '{') ? '}' : ']')) {
+        i++;
+        goto close;
+      }
+      if(c == '{') goto key;
+      continue;
+    } else if(c == '"') {
+      pos = json_simd_string(parser, str, len, pos, &used, &tape[n]);
+      if(pos == 0) {
+        parser->err = json_tokener_error_parse_string;
+        goto fail;
+      }
+    } else if(c == ']' || c == '}' || c == ',' || c == ':') {
+      parser->err = json_tokener_error_parse_unexpected;
+      goto fail;
+    } else {
+      if(json_simd_scalar(parser, str, len, pos, used, &tape[n]) == 0) {
+        parser->err = json_tokener_error_parse_unexpected;
+        goto fail;
+      }
+    }
+    tape[n].size = 1;
+    n++;
+
+  value_done:
+    if(depth == 0) break;
+    container = &tape[stack[depth - 1]];
+    container->o.c_count++;
+    if(i >= count) {
+      parser->err = json_tokener_error_parse_eof;
+      goto fail;
+    }
+    pos = parser->index[i++];
+    c = str[pos];
+    if(c == ',') {
+      if(container->type == json_type_object) goto key;
+      continue;
+    }
+    if(c != ((container->type == json_type_object) ? '}' : ']')) {
+      parser->err = (container->type == json_type_object) ?
+        json_tokener_error_parse_object_value_sep : json_tokener_error_parse_array;
+      goto fail;
+    }
+
+  close:
+    depth--;
+    tape[stack[depth]].size = n - stack[depth];
+    goto value_done;
+
+  key:
+    if(i >= count) {
+      parser->err = json_tokener_error_parse_eof;
+      goto fail;
+    }
+    pos = parser->index[i++];
+    if(str[pos] != '"') {
+      parser->err = json_tokener_error_parse_object_key_name;
+      goto fail;
+    }
+    pos = json_simd_string(parser, str, len, pos, &used, &tape[n]);
+    if(pos == 0) {
+      parser->err = json_tokener_error_parse_string;
+      goto fail;
+    }
+    tape[n].size = 1;
+    n++;
+    if(i >= count || str[parser->index[i]] != ':') {
+      parser->err = json_tokener_error_parse_object_key_sep;
+      goto fail;
+    }
+    i++;
+  }
+
+  if(i != count) {
+    pos = parser->index[i];
+    parser->err = json_tokener_error_parse_unexpected;
+    goto fail;
+  }
+
+  parser->tape_count = n;
+  return tape;
+
+ fail:
+  parser->err_offset = pos;
+  parser->tape_count = 0;
+  return NULL;
+}
+
+/**
+ * Get the error of the last parse
+ * @param parser the parser
+ * @param offset if not NULL, receives the offset of the error in the document
+ * @returns json_tokener_success if the last parse succeeded
+ */
+static inline enum json_tokener_error json_simd_parser_error(struct json_simd_parser *parser,
+                                                             size_t *offset)
+{
+  if(offset != NULL) *offset = parser->err_offset;
+  return parser->err;
+}
+
+/**
+ * Get the type of a node
+ * @param node the node
+ * @returns the type, json_type_null for a NULL node
+ */
+static inline enum json_type json_simd_node_get_type(const struct json_simd_node *node)
+{
+  return (node == NULL) ? json_type_null : node->type;
+}
+
+/**
+ * Get a boolean value
+ * @param node the node
+ * @returns the value, FALSE if the node is not a boolean
+ */
+static inline boolean json_simd_node_get_boolean(const struct json_simd_node *node)
+{
+  return (node != NULL && node->type == json_type_boolean) ? node->o.c_boolean : FALSE;
+}
+
+/**
+ * Get an integer value
+ * @param node the node
+ * @returns the value, converted from a double, 0 if the node is not a number
+ */
+static inline int json_simd_node_get_int(const struct json_simd_node *node)
+{
+  if(node == NULL) return 0;
+  if(node->type == json_type_int) return node->o.c_int;
+  if(node->type == json_type_double) return (int)node->o.c_double;
+  return 0;
+}
+
+/**
+ * Get a double value
+ * @param node the node
+ * @returns the value, converted from an integer, 0.0 if the node is not a number
+ */
+static inline double json_simd_node_get_double(const struct json_simd_node *node)
+{
+  if(node == NULL) return 0.0;
+  if(node->type == json_type_double) return node->o.c_double;
+  if(node->type == json_type_int) return (double)node->o.c_int;
+  return 0.0;
+}
+
+/**
+ * Get a string value
+ * @param parser the parser which parsed the node
+ * @param node the node
+ * @param len if not NULL, receives the length of the string, which can contain nul characters
+ * @returns the nul terminated string, NULL if the node is not a string
+ */
+static inline const char* json_simd_node_get_string(const struct json_simd_parser *parser,
+                                                    const struct json_simd_node *node, int *len)
+{
+  if(node == NULL || node->type != json_type_string) return NULL;
+  if(len != NULL) *len = (int)node->o.c_string.length;
+  return parser->strings + node->o.c_string.offset;
+}
+
+/**
+ * Get the number of members of an object or of elements of an array
+ * @param node the node
+ * @returns the count, 0 for the other types
+ */
+static inline int json_simd_node_length(const struct json_simd_node *node)
+{
+  if(node == NULL || (node->type != json_type_object && node->type != json_type_array)) return 0;
+  return (int)node->o.c_count;
+}
+
+/**
+ * Get the first child of an object or array
+ *
+ * The children of an object are its keys: the value of a key is the node
+ * following it.
+ *
+ * @param node the object or array
+ * @returns the first child, NULL if there are none
+ */
+static inline const struct json_simd_node* json_simd_node_first(const struct json_simd_node *node)
+{
+  if(json_simd_node_length(node) == 0) return NULL;
+  return node + 1;
+}
+
+/**
+ * Get the next child of an object or array
+ * @param parent the object or array
+ * @param child a child of parent
+ * @returns the following child, NULL after the last one
+ */
+static inline const struct json_simd_node* json_simd_node_next(const struct json_simd_node *parent,
+                                                               const struct json_simd_node *child)
+{
+  const struct json_simd_node *next;
+  if(parent->type == json_type_object) {
+    next = child + 1 + child[1].size;
+  } else {
+    next = child + child->size;
+  }
+  return (next < parent + parent->size) ? next : NULL;
+}
+
+/* INTERNAL: index the members of an object in parser->object_index, returns -1 if out of memory */
+static inline int json_simd_node_object_index(struct json_simd_parser *parser,
+                                              const struct json_simd_node *node)
+{
+  const struct json_simd_node *child;
+  struct lh_entry *e;
+  char *key;
+
+  lh_oa_table_free(parser->object_index);
+  parser->object_indexed = NULL;
+  parser->object_index = lh_oa_kchar_table_new((int)node->o.c_count, "json_simd_object_index", NULL);
+  if(parser->object_index == NULL) return -1;
+
+  for(child = json_simd_node_first(node); child != NULL; child = json_simd_node_next(node, child)) {
+    key = parser->strings + child->o.c_string.offset;
+    /* a key holding a nul character never equals a C string */
+    if(strlen(key) != child->o.c_string.length) continue;
+    e = lh_oa_table_lookup_entry(parser->object_index, key);
+    if(e != NULL) {
+      e->v = child + 1;
+    } else if(lh_oa_table_insert(parser->object_index, key, child + 1) != 0) {
+      lh_oa_table_free(parser->object_index);
+      parser->object_index = NULL;
+      return -1;
+    }
+  }
+  parser->object_indexed = node;
+  return 0;
+}
+
+/**
+ * Get the value of an object field
+ *
+ * Like json_object_object_get(), the last value is returned when the key
+ * appears several times.
+ *
+ * Objects of JSON_SIMD_INDEX_MIN_COUNT members or more are indexed in a
+ * struct lh_oa_table kept by the parser, so that looking up many fields
+ * of the same large object does not scan it each time. The index covers
+ * the last large object looked up and is dropped by the next parse.
+ *
+ * @param parser the parser which parsed the node
+ * @param node the object
+ * @param key the field name
+ * @returns the value, NULL if the field does not exist or node is not an object
+ */
+static inline const struct json_simd_node* json_simd_node_object_get(struct json_simd_parser *parser,
+                                                                     const struct json_simd_node *node,
+                                                                     const char *key)
+{
+  const struct json_simd_node *child, *found = NULL;
+  size_t len;
+  if(node == NULL || node->type != json_type_object) return NULL;
+  if(node->o.c_count >= JSON_SIMD_INDEX_MIN_COUNT &&
+     (parser->object_indexed == node || json_simd_node_object_index(parser, node) == 0)) {
+    return (const struct json_simd_node*)lh_oa_table_lookup(parser->object_index, key);
+  }
+  len = strlen(key);
+  for(child = json_simd_node_first(node); child != NULL; child = json_simd_node_next(node, child)) {
+    if(child->o.c_string.length == len &&
+       memcmp(parser->strings + child->o.c_string.offset, key, len) == 0) {
+      found = child + 1;
+    }
+  }
+  return found;
+}
+
+/**
+ * Get the element at the specified index of an array
+ * @param node the array
+ * @param idx the index
+ * @returns the element, NULL if idx is out of range or node is not an array
+ */
+static inline const struct json_simd_node* json_simd_node_array_get_idx(const struct json_simd_node *node,
+                                                                        int idx)
+{
+  const struct json_simd_node *child;
+  if(node == NULL || node->type != json_type_array || idx < 0) return NULL;
+  for(child = json_simd_node_first(node); child != NULL && idx > 0; child = json_simd_node_next(node, child)) {
+    idx--;
+  }
+  return child;
+}
+
+/**
+ * Convert a node into a json_object tree
+ *
+ * The tree is made of regular json-c objects, independent of the parser,
+ * and must be released with json_object_put().
+ *
+ * @param parser the parser which parsed the node
+ * @param node the node
+ * @returns the json_object, NULL for a null value
+ */
+static inline struct json_object* json_simd_to_object(const struct json_simd_parser *parser,
+                                                      const struct json_simd_node *node)
+{
+  const struct json_simd_node *child;
+  struct json_object *obj = NULL;
+
+  switch(json_simd_node_get_type(node)) {
+  case json_type_null:
+    break;
+  case json_type_boolean:
+    obj = json_object_new_boolean(node->o.c_boolean);
+    break;
+  case json_type_double:
+    obj = json_object_new_double(node->o.c_double);
+    break;
+  case json_type_int:
+    obj = json_object_new_int(node->o.c_int);
+    break;
+  case json_type_string:
+    obj = json_object_new_string_len(parser->strings + node->o.c_string.offset,
+                                     (int)node->o.c_string.length);
+    break;
+  case json_type_object:
+    obj = json_object_new_object();
+    for(child = json_simd_node_first(node); obj != NULL && child != NULL; child = json_simd_node_next(node, child)) {
+      json_object_object_add(obj, parser->strings + child->o.c_string.offset,
+                             json_simd_to_object(parser, child + 1));
+    }
+    break;
+  case json_type_array:
+    obj = json_object_new_array();
+    for(child = json_simd_node_first(node); obj != NULL && child != NULL; child = json_simd_node_next(node, child)) {
+      json_object_array_add(obj, json_simd_to_object(parser, child));
+    }
+    break;
+  }
+  return obj;
+}
+
+/**
+ * Convert a node into a json_object tree allocated in an arena
+ *
+ * Same as json_simd_to_object(), with the objects and arrays sized from
+ * the tape so that their tables never grow. The tree is released with
+ * the arena (see json_arena.h).
+ *
+ * @param parser the parser which parsed the node
+ * @param node the node
+ * @param arena the arena
+ * @returns the json_object, NULL for a null value or if out of memory
+ */
+static inline struct json_object* json_simd_to_arena(const struct json_simd_parser *parser,
+                                                     const struct json_simd_node *node,
+                                                     struct json_arena *arena)
+{
+  const struct json_simd_node *child;
+  struct json_object *obj = NULL;
+
+  switch(json_simd_node_get_type(node)) {
+  case json_type_null:
+    break;
+  case json_type_boolean:
+    obj = json_arena_new_boolean(arena, node->o.c_boolean);
+    break;
+  case json_type_double:
+    obj = json_arena_new_double(arena, node->o.c_double);
+    break;
+  case json_type_int:
+    obj = json_arena_new_int(arena, node->o.c_int);
+    break;
+  case json_type_string:
+    obj = json_arena_new_string_len(arena, parser->strings + node->o.c_string.offset,
+                                    (int)node->o.c_string.length);
+    break;
+  case json_type_object:
+    obj = json_arena_new_object_size(arena, json_simd_node_length(node));
+    for(child = json_simd_node_first(node); obj != NULL && child != NULL; child = json_simd_node_next(node, child)) {
+      json_arena_object_add(arena, obj, parser->strings + child->o.c_string.offset,
+                            json_simd_to_arena(parser, child + 1, arena));
+    }
+    break;
+  case json_type_array:
+    obj = json_arena_new_array_size(arena, json_simd_node_length(node));
+    for(child = json_simd_node_first(node); obj != NULL && child != NULL; child = json_simd_node_next(node, child)) {
+      json_arena_array_add(arena, obj, json_simd_to_arena(parser, child, arena));
+    }
+    break;
+  }
+  return obj;
+}
+
+/**
+ * Parse a document into a json_object tree, like json_tokener_parse()
+ *
+ * Documents which are not strict JSON are handed to json_tokener_parse(),
+ * so the result and the errors are the ones of the json-c tokener.
+ *
+ * @param parser a parser, or NULL to use a temporary one
+ * @param str the nul terminated document
+ * @returns the json_object, or an error pointer (see is_error())
+ */
+static inline struct json_object* json_simd_tokener_parse(struct json_simd_parser *parser,
+                                                          const char *str)
+{
+  struct json_simd_parser *local = NULL;
+  const struct json_simd_node *root;
+  struct json_object *obj;
+
+  if(parser == NULL) {
+    parser = local = json_simd_parser_new();
+    if(parser == NULL) return json_tokener_parse(str);
+  }
+
+  root = json_simd_parse(parser, str, strlen(str));
+  obj = (root != NULL) ? json_simd_to_object(parser, root) : json_tokener_parse(str);
+
+  json_simd_parser_free(local);
+  return obj;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,610 @@
+/*
+ * Open addressing hash table with the linkhash interface
+ *
+ * This library is free software; you can redistribute it and/or modify
+ * it under the terms of the MIT license. See COPYING for details.
+ *
+ */
+
+/**
+ * struct lh_oa_table has the functions of struct lh_table, with the same
+ * arguments and results, prefixed with lh_oa_ instead of lh_.
+ *
+ * The entries are stored densely in insertion order and keep the head /
+ * next / prev links of struct lh_entry, so lh_foreach() and
+ * lh_foreach_safe() iterate over a struct lh_oa_table as over a struct
+ * lh_table. The hash index is separate: one control byte per slot holding
+ * 7 bits of the hash, compared 16 slots at a time (SSE2 on x86, NEON on
+ * arm64), and the position of the entry. A lookup compares keys only when
+ * their control byte matches, instead of calling the equality function on
+ * every probed entry.
+ *
+ * lh_oa_char_hash() is a wyhash style hash, which reads the key 8 bytes at
+ * a time.
+ *
+ * As with struct lh_table, the entries move when the table grows: entry
+ * pointers are valid until the next insertion.
+ *
+ * json_simd_node_object_get() uses it to index the members of large
+ * objects of a parsed document.
+ */
+
+#ifndef _linkhash_oa_h_
+#define _linkhash_oa_h_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "linkhash.h"
+
+#if !defined(LH_OA_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+# include <emmintrin.h>
+# define LH_OA_SSE2 1
+#elif !defined(LH_OA_NO_SIMD) && defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+# include <arm_neon.h>
+# define LH_OA_NEON 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * number of slots probed together
+ */
+#define LH_OA_GROUP 16
+
+/**
+ * control byte of a slot which never held an entry
+ */
+#define LH_OA_CTRL_EMPTY 0x80
+
+/**
+ * control byte of a slot whose entry was deleted
+ */
+#define LH_OA_CTRL_DELETED 0xFE
+
+/**
+ * The hash table structure.
+ */
+struct lh_oa_table {
+	/**
+	 * Number of slots of the index, a power of 2.
+	 */
+	int size;
+	/**
+	 * Numbers of entries.
+	 */
+	int count;
+
+	/**
+	 * Number of probed groups beyond the first one.
+	 */
+	int collisions;
+
+	/**
+	 * Number of resizes.
+	 */
+	int resizes;
+
+	/**
+	 * Number of lookups.
+	 */
+	int lookups;
+
+	/**
+	 * Number of inserts.
+	 */
+	int inserts;
+
+	/**
+	 * Number of deletes.
+	 */
+	int deletes;
+
+	/**
+	 * Name of the hash table.
+	 */
+	const char *name;
+
+	/**
+	 * The first entry.
+	 */
+	struct lh_entry *head;
+
+	/**
+	 * The last entry.
+	 */
+	struct lh_entry *tail;
+
+	/**
+	 * The entries in insertion order, deleted ones have the key LH_FREED.
+	 */
+	struct lh_entry *entries;
+
+	/**
+	 * Number of used entries, deleted ones included.
+	 */
+	int entries_used;
+
+	/**
+	 * Number of entries which fit before a resize: 7/8 of the slots.
+	 */
+	int entries_size;
+
+	/**
+	 * Control byte of each slot: 7 bits of the hash, LH_OA_CTRL_EMPTY or LH_OA_CTRL_DELETED.
+	 */
+	uint8_t *ctrl;
+
+	/**
+	 * Position in entries of the entry of each slot.
+	 */
+	uint32_t *slots;
+
+	/**
+	 * A pointer onto the function responsible for freeing an entry.
+	 */
+	lh_entry_free_fn *free_fn;
+	lh_hash_fn *hash_fn;
+	lh_equal_fn *equal_fn;
+};
+
+/* INTERNAL: 64x64 to 128 bits multiplication */
+static inline void lh_oa_mum(uint64_t *a, uint64_t *b)
+{
+#if defined(__SIZEOF_INT128__)
+	__uint128_t r = (__uint128_t)*a * *b;
+	*a = (uint64_t)r;
+	*b = (uint64_t)(r >> 64);
+#else
+	uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+	uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	uint64_t t = rl + (rm0 << 32), lo, c = t < rl;
+	lo = t + (rm1 << 32);
+	c += lo < t;
+	*a = lo;
+	*b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+/* INTERNAL: multiply and fold */
+static inline uint64_t lh_oa_mix(uint64_t a, uint64_t b)
+{
+	lh_oa_mum(&a, &b);
+	return a ^ b;
+}
+
+/* INTERNAL: unaligned reads */
+static inline uint64_t lh_oa_read8(const uint8_t *p)
+{
+	uint64_t v;
+	memcpy(&v, p, 8);
+	return v;
+}
+
+static inline uint64_t lh_oa_read4(const uint8_t *p)
+{
+	uint32_t v;
+	memcpy(&v, p, 4);
+	return v;
+}
+
+/**
+ * wyhash style hash of a buffer
+ * @param key the buffer
+ * @param len the length of the buffer
+ * @param seed the seed
+ * @returns the 64 bits hash
+ */
+static inline uint64_t lh_oa_hash(const void *key, size_t len, uint64_t seed)
+{
+	static const uint64_t secret[4] = { 0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+					    0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL };
+	const uint8_t *p = (const uint8_t*)key;
+	uint64_t a, b;
+
+	seed ^= lh_oa_mix(seed ^ secret[0], secret[1]);
+	if(len <= 16) {
+		if(len >= 4) {
+			a = (lh_oa_read4(p) << 32) | lh_oa_read4(p + ((len >> 3) << 2));
+			b = (lh_oa_read4(p + len - 4) << 32) | lh_oa_read4(p + len - 4 - ((len >> 3) << 2));
+		} else if(len > 0) {
+			a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+			b = 0;
+		} else {
+			a = b = 0;
+		}
+	} else {
+		size_t i = len;
+		if(i > 48) {
+			uint64_t see1 = seed, see2 = seed;
+			do {
+				seed = lh_oa_mix(lh_oa_read8(p) ^ secret[1], lh_oa_read8(p + 8) ^ seed);
+				see1 = lh_oa_mix(lh_oa_read8(p + 16) ^ secret[2], lh_oa_read8(p + 24) ^ see1);
+				see2 = lh_oa_mix(lh_oa_read8(p + 32) ^ secret[3], lh_oa_read8(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while(i > 48);
+			seed ^= see1 ^ see2;
+		}
+		while(i > 16) {
+			seed = lh_oa_mix(lh_oa_read8(p) ^ secret[1], lh_oa_read8(p + 8) ^ seed);
+			i -= 16;
+			p += 16;
+		}
+		a = lh_oa_read8(p + i - 16);
+		b = lh_oa_read8(p + i - 8);
+	}
+	a ^= secret[1];
+	b ^= seed;
+	lh_oa_mum(&a, &b);
+	return lh_oa_mix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+/**
+ * Hash function for nul terminated string keys
+ */
+static inline unsigned long lh_oa_char_hash(const void *k)
+{
+	return (unsigned long)lh_oa_hash(k, strlen((const char*)k), 0);
+}
+
+/**
+ * Equality function for nul terminated string keys
+ */
+static inline int lh_oa_char_equal(const void *k1, const void *k2)
+{
+	return (strcmp((const char*)k1, (const char*)k2) == 0);
+}
+
+/**
+ * Hash function for pointer keys
+ */
+static inline unsigned long lh_oa_ptr_hash(const void *k)
+{
+	return (unsigned long)lh_oa_mix((uint64_t)(uintptr_t)k ^ 0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL);
+}
+
+/**
+ * Equality function for pointer keys
+ */
+static inline int lh_oa_ptr_equal(const void *k1, const void *k2)
+{
+	return (k1 == k2);
+}
+
+/* INTERNAL: bit mask of the slots of a group whose control byte is c, one bit per slot */
+static inline uint32_t lh_oa_group_match(const uint8_t *group, uint8_t c)
+{
+#if defined(LH_OA_SSE2)
+	__m128i v = _mm_loadu_si128((const __m128i*)group);
+	return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8((char)c)));
+#elif defined(LH_OA_NEON)
+	static const uint8_t bits[16] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+					  0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+	uint8x16_t m = vandq_u8(vceqq_u8(vld1q_u8(group), vdupq_n_u8(c)), vld1q_u8(bits));
+	return (uint32_t)vaddv_u8(vget_low_u8(m)) | ((uint32_t)vaddv_u8(vget_high_u8(m)) << 8);
+#else
+	uint32_t mask = 0;
+	int i;
+	for(i = 0; i < LH_OA_GROUP; i++) {
+		if(group[i] == c) mask |= (uint32_t)1 << i;
+	}
+	return mask;
+#endif
+}
+
+/* INTERNAL: bit mask of the empty or deleted slots of a group */
+static inline uint32_t lh_oa_group_free(const uint8_t *group)
+{
+#if defined(LH_OA_SSE2)
+	/* only the empty and deleted control bytes have the high bit */
+	return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+	return lh_oa_group_match(group, LH_OA_CTRL_EMPTY) | lh_oa_group_match(group, LH_OA_CTRL_DELETED);
+#endif
+}
+
+/* INTERNAL: index the entry at position pos, whose hash is h */
+static inline void lh_oa_table_place(struct lh_oa_table *t, unsigned long h, uint32_t pos)
+{
+	size_t groups_mask = (size_t)(t->size / LH_OA_GROUP) - 1;
+	size_t g = (size_t)(h >> 7) & groups_mask, step = 0;
+	for(;;) {
+		uint8_t *group = t->ctrl + g * LH_OA_GROUP;
+		uint32_t free_slots = lh_oa_group_free(group);
+		if(free_slots != 0) {
+			size_t slot = g * LH_OA_GROUP + (size_t)__builtin_ctz(free_slots);
+			t->ctrl[slot] = (uint8_t)(h & 0x7F);
+			t->slots[slot] = pos;
+			return;
+		}
+		t->collisions++;
+		g = (g + ++step) & groups_mask;
+	}
+}
+
+/**
+ * Resize a table, which also drops the deleted entries.
+ * @param t the table
+ * @param new_size the new number of slots, rounded up to a power of 2
+ * @returns 0 on success, -1 if out of memory (the table is unchanged)
+ */
+static inline int lh_oa_table_resize(struct lh_oa_table *t, int new_size)
+{
+	int size = LH_OA_GROUP, entries_size, i, n = 0;
+	struct lh_entry *entries, *e, *prev = NULL;
+	uint8_t *ctrl;
+	uint32_t *slots;
+
+	while(size < new_size || size / 8 * 7 < t->count) size *= 2;
+	entries_size = size / 8 * 7;
+
+	entries = (struct lh_entry*)malloc((size_t)entries_size * sizeof(struct lh_entry));
+	ctrl = (uint8_t*)malloc((size_t)size);
+	slots = (uint32_t*)malloc((size_t)size * sizeof(uint32_t));
+	if(entries == NULL || ctrl == NULL || slots == NULL) {
+		free(entries);
+		free(ctrl);
+		free(slots);
+		return -1;
+	}
+
+	/* compact in insertion order and relink */
+	for(e = t->head; e != NULL; e = e->next) {
+		entries[n].k = e->k;
+		entries[n].v = e->v;
+		entries[n].prev = prev;
+		entries[n].next = NULL;
+		if(prev != NULL) prev->next = &entries[n];
+		prev = &entries[n];
+		n++;
+	}
+
+	free(t->entries);
+	free(t->ctrl);
+	free(t->slots);
+	t->entries = entries;
+	t->ctrl = ctrl;
+	t->slots = slots;
+	t->size = size;
+	t->entries_size = entries_size;
+	t->entries_used = n;
+	t->head = (n > 0) ? &entries[0] : NULL;
+	t->tail = (n > 0) ? &entries[n - 1] : NULL;
+	t->resizes++;
+
+	memset(ctrl, LH_OA_CTRL_EMPTY, (size_t)size);
+	for(i = 0; i < n; i++) {
+		lh_oa_table_place(t, t->hash_fn(entries[i].k), (uint32_t)i);
+	}
+	return 0;
+}
+
+/**
+ * Create a new table.
+ * @param size number of entries which fit before the first resize.
+ * @param name the table name.
+ * @param free_fn callback function used to free memory for entries
+ * when lh_oa_table_free or lh_oa_table_delete is called.
+ * If NULL is provided, then memory for keys and values
+ * must be freed by the caller.
+ * @param hash_fn function used to hash keys, see lh_oa_char_hash and
+ * lh_oa_ptr_hash.
+ * @param equal_fn comparison function to compare keys, see
+ * lh_oa_char_equal and lh_oa_ptr_equal.
+ * @return a pointer onto the table, NULL if out of memory.
+ */
+static inline struct lh_oa_table* lh_oa_table_new(int size, const char *name,
+						  lh_entry_free_fn *free_fn,
+						  lh_hash_fn *hash_fn,
+						  lh_equal_fn *equal_fn)
+{
+	struct lh_oa_table *t = (struct lh_oa_table*)calloc(1, sizeof(struct lh_oa_table));
+	if(t == NULL) return NULL;
+	t->name = name;
+	t->free_fn = free_fn;
+	t->hash_fn = hash_fn;
+	t->equal_fn = equal_fn;
+	if(lh_oa_table_resize(t, (size > 0) ? size + size / 7 + 1 : LH_OA_GROUP) != 0) {
+		free(t);
+		return NULL;
+	}
+	t->resizes = 0;
+	return t;
+}
+
+/**
+ * Convenience function to create a new table with char keys.
+ */
+static inline struct lh_oa_table* lh_oa_kchar_table_new(int size, const char *name,
+							lh_entry_free_fn *free_fn)
+{
+	return lh_oa_table_new(size, name, free_fn, lh_oa_char_hash, lh_oa_char_equal);
+}
+
+/**
+ * Convenience function to create a new table with ptr keys.
+ */
+static inline struct lh_oa_table* lh_oa_kptr_table_new(int size, const char *name,
+						       lh_entry_free_fn *free_fn)
+{
+	return lh_oa_table_new(size, name, free_fn, lh_oa_ptr_hash, lh_oa_ptr_equal);
+}
+
+/**
+ * Free a table.
+ * If a callback free function is provided then it is called for all
+ * entries in the table.
+ * @param t table to free.
+ */
+static inline void lh_oa_table_free(struct lh_oa_table *t)
+{
+	struct lh_entry *e;
+	if(t == NULL) return;
+	if(t->free_fn) {
+		for(e = t->head; e != NULL; e = e->next) t->free_fn(e);
+	}
+	free(t->entries);
+	free(t->ctrl);
+	free(t->slots);
+	free(t);
+}
+
+/**
+ * Insert a record into the table.
+ *
+ * As with lh_table_insert(), the key is not looked up first: inserting a
+ * key twice makes two entries.
+ *
+ * @param t the table to insert into.
+ * @param k a pointer to the key to insert.
+ * @param v a pointer to the value to insert.
+ * @returns 0 on success, -1 if out of memory.
+ */
+static inline int lh_oa_table_insert(struct lh_oa_table *t, void *k, const void *v)
+{
+	struct lh_entry *e;
+
+	if(t->entries_used == t->entries_size) {
+		/* grow, or only drop the deleted entries when they are many */
+		if(lh_oa_table_resize(t, (t->count >= t->entries_size / 2) ? t->size * 2 : t->size) != 0) return -1;
+	}
+
+	t->inserts++;
+	e = &t->entries[t->entries_used];
+	e->k = k;
+	e->v = v;
+	e->next = NULL;
+	e->prev = t->tail;
+	if(t->tail != NULL) t->tail->next = e;
+	else t->head = e;
+	t->tail = e;
+	lh_oa_table_place(t, t->hash_fn(k), (uint32_t)t->entries_used);
+	t->entries_used++;
+	t->count++;
+	return 0;
+}
+
+/* INTERNAL: slot of the first entry of key k, or -1 */
+static inline long lh_oa_table_find(struct lh_oa_table *t, const void *k)
+{
+	unsigned long h = t->hash_fn(k);
+	size_t groups_mask = (size_t)(t->size / LH_OA_GROUP) - 1;
+	size_t g = (size_t)(h >> 7) & groups_mask, step = 0;
+	uint8_t tag = (uint8_t)(h & 0x7F);
+
+	t->lookups++;
+	for(;;) {
+		const uint8_t *group = t->ctrl + g * LH_OA_GROUP;
+		uint32_t match = lh_oa_group_match(group, tag);
+		while(match != 0) {
+			size_t slot = g * LH_OA_GROUP + (size_t)__builtin_ctz(match);
+			if(t->equal_fn(t->entries[t->slots[slot]].k, k)) return (long)slot;
+			match &= match - 1;
+		}
+		if(lh_oa_group_match(group, LH_OA_CTRL_EMPTY) != 0) return -1;
+		g = (g + ++step) & groups_mask;
+	}
+}
+
+/**
+ * Lookup a record into the table.
+ * @param t the table to lookup
+ * @param k a pointer to the key to lookup
+ * @return a pointer to the record structure of the value or NULL if it does not exist.
+ */
+static inline struct lh_entry* lh_oa_table_lookup_entry(struct lh_oa_table *t, const void *k)
+{
+	long slot = lh_oa_table_find(t, k);
+	return (slot < 0) ? NULL : &t->entries[t->slots[slot]];
+}
+
+/**
+ * Lookup a record into the table
+ * @param t the table to lookup
+ * @param k a pointer to the key to lookup
+ * @return a pointer to the found value or NULL if it does not exist.
+ */
+static inline const void* lh_oa_table_lookup(struct lh_oa_table *t, const void *k)
+{
+	struct lh_entry *e = lh_oa_table_lookup_entry(t, k);
+	return (e != NULL) ? e->v : NULL;
+}
+
+/**
+ * Delete a record from the table.
+ * If a callback free function is provided then it is called for the
+ * for the item being deleted.
+ * @param t the table to delete from.
+ * @param e a pointer to the entry to delete.
+ * @return 0 if the item was deleted.
+ * @return -1 if it was not found.
+ */
+static inline int lh_oa_table_delete_entry(struct lh_oa_table *t, struct lh_entry *e)
+{
+	uint32_t pos;
+	long slot;
+
+	if(e < t->entries || e >= t->entries + t->entries_used || e->k == LH_FREED) return -1;
+	pos = (uint32_t)(e - t->entries);
+
+	/* find the slot of this entry, which is not the first one of its key with duplicates */
+	{
+		unsigned long h = t->hash_fn(e->k);
+		size_t groups_mask = (size_t)(t->size / LH_OA_GROUP) - 1;
+		size_t g = (size_t)(h >> 7) & groups_mask, step = 0;
+		uint8_t tag = (uint8_t)(h & 0x7F);
+		slot = -1;
+		while(slot < 0) {
+			const uint8_t *group = t->ctrl + g * LH_OA_GROUP;
+			uint32_t match = lh_oa_group_match(group, tag);
+			while(match != 0) {
+				size_t s = g * LH_OA_GROUP + (size_t)__builtin_ctz(match);
+				if(t->slots[s] == pos) {
+					slot = (long)s;
+					break;
+				}
+				match &= match - 1;
+			}
+			if(slot < 0 && lh_oa_group_match(group, LH_OA_CTRL_EMPTY) != 0) return -1;
+			g = (g + ++step) & groups_mask;
+		}
+	}
+
+	t->deletes++;
+	if(t->free_fn) t->free_fn(e);
+	t->ctrl[slot] = LH_OA_CTRL_DELETED;
+	if(e->prev != NULL) e->prev->next = e->next;
+	else t->head = e->next;
+	if(e->next != NULL) e->next->prev = e->prev;
+	else t->tail = e->prev;
+	e->k = LH_FREED;
+	e->v = LH_FREED;
+	e->next = e->prev = NULL;
+	t->count--;
+	return 0;
+}
+
+/**
+ * Delete a record from the table.
+ * If a callback free function is provided then it is called for the
+ * for the item being deleted.
+ * @param t the table to delete from.
+ * @param k a pointer to the key to delete.
+ * @return 0 if the item was deleted.
+ * @return -1 if it was not found.
+ */
+static inline int lh_oa_table_delete(struct lh_oa_table *t, const void *k)
+{
+	struct lh_entry *e = lh_oa_table_lookup_entry(t, k);
+	if(e == NULL) return -1;
+	return lh_oa_table_delete_entry(t, e);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
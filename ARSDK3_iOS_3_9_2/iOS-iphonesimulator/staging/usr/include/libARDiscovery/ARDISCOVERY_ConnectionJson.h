@@ -0,0 +1,952 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARDISCOVERY_ConnectionJson.h
+ * @brief Allocation-free encoder and scanner for the connection json.
+ * @note The connection json has a fixed, flat schema (see ARDISCOVERY_Connection.h).
+ * The fields are stored in a plain structure; string fields are views into the
+ * caller buffers, so neither encoding nor decoding allocates memory.
+ * @date 10/18/2026
+ */
+
+#ifndef _ARDISCOVERY_CONNECTION_JSON_H_
+#define _ARDISCOVERY_CONNECTION_JSON_H_
+
+#include <inttypes.h>
+#include <string.h>
+#include <libARDiscovery/ARDISCOVERY_Error.h>
+#include <libARDiscovery/ARDISCOVERY_Connection.h>
+
+/**
+ * @brief Fields of the connection json.
+ * @note Integer fields come first, followed by the string fields.
+ */
+typedef enum
+{
+    ARDISCOVERY_CONNECTIONJSON_FIELD_STATUS = 0, /**< "status" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_C2DPORT, /**< "c2d_port" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_D2CPORT, /**< "d2c_port" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM_FRAGMENT_SIZE, /**< "arstream_fragment_size" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM_FRAGMENT_MAXIMUM_NUMBER, /**< "arstream_fragment_maximum_number" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM_MAX_ACK_INTERVAL, /**< "arstream_max_ack_interval" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_C2D_UPDATE_PORT, /**< "c2d_update_port" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_C2D_USER_PORT, /**< "c2d_user_port" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM2_CLIENT_STREAM_PORT, /**< "arstream2_client_stream_port" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM2_CLIENT_CONTROL_PORT, /**< "arstream2_client_control_port" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM2_SERVER_STREAM_PORT, /**< "arstream2_server_stream_port" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM2_SERVER_CONTROL_PORT, /**< "arstream2_server_control_port" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM2_MAX_PACKET_SIZE, /**< "arstream2_max_packet_size" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM2_MAX_LATENCY, /**< "arstream2_max_latency" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM2_MAX_NETWORK_LATENCY, /**< "arstream2_max_network_latency" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM2_MAX_BITRATE, /**< "arstream2_max_bitrate" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM2_SUPPORTED_METADATA_VERSION, /**< "arstream2_supported_metadata_version" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_AUDIO_CODEC, /**< "audio_codec" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_QOS_MODE, /**< "qos_mode" */
+
+    ARDISCOVERY_CONNECTIONJSON_FIELD_CONTROLLER_TYPE, /**< "controller_type" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_CONTROLLER_NAME, /**< "controller_name" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_DEVICE_ID, /**< "device_id" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_SKYCONTROLLER_VERSION, /**< "skycontroller_version" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_FEATURES, /**< "features" */
+    ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM2_PARAMETER_SETS, /**< "arstream2_parameter_sets" */
+
+    ARDISCOVERY_CONNECTIONJSON_FIELD_MAX, /**< Max of the enumeration */
+} eARDISCOVERY_CONNECTIONJSON_FIELD;
+
+/**
+ * @brief First string field of eARDISCOVERY_CONNECTIONJSON_FIELD
+ */
+#define ARDISCOVERY_CONNECTIONJSON_FIELD_FIRST_STRING ARDISCOVERY_CONNECTIONJSON_FIELD_CONTROLLER_TYPE
+
+/**
+ * @brief Number of integer fields
+ */
+#define ARDISCOVERY_CONNECTIONJSON_INT_FIELD_COUNT (ARDISCOVERY_CONNECTIONJSON_FIELD_FIRST_STRING)
+
+/**
+ * @brief Number of string fields
+ */
+#define ARDISCOVERY_CONNECTIONJSON_STRING_FIELD_COUNT (ARDISCOVERY_CONNECTIONJSON_FIELD_MAX - ARDISCOVERY_CONNECTIONJSON_FIELD_FIRST_STRING)
+
+/**
+ * @brief String view ; not Null-terminated.
+ * @note When decoded, data points to the raw json string content, escape sequences included (see ARDISCOVERY_ConnectionJson_CopyString()).
+ */
+typedef struct
+{
+    const char *data; /**< First character of the string */
+    uint32_t length; /**< Length in bytes of the string */
+    uint8_t isEscaped; /**< 1 if the string contains json escape sequences ; otherwise 0 */
+} ARDISCOVERY_ConnectionJson_String_t;
+
+/**
+ * @brief Lightweight view of a connection json.
+ * @note This structure does not own any memory ; it can live on the stack.
+ */
+typedef struct
+{
+    uint32_t fields; /**< Bit field of the fields present ; bit n is set if field n is present */
+    int32_t intValues[ARDISCOVERY_CONNECTIONJSON_INT_FIELD_COUNT]; /**< Values of the integer fields */
+    ARDISCOVERY_ConnectionJson_String_t stringValues[ARDISCOVERY_CONNECTIONJSON_STRING_FIELD_COUNT]; /**< Values of the string fields */
+} ARDISCOVERY_ConnectionJson_t;
+
+/**
+ * @brief Callback to add or read the fields of the connection json.
+ * @note Counterpart of ARDISCOVERY_Device_ConnectionJsonCallback_t working on the lightweight view.
+ * @param[in,out] json The connection json view.
+ * @param[in] customData custom data.
+ * @return error during callback execution.
+ */
+typedef eARDISCOVERY_ERROR (*ARDISCOVERY_ConnectionJson_Callback_t) (ARDISCOVERY_ConnectionJson_t *json, void *customData);
+
+/**
+ * @brief Callbacks given as customData to ARDISCOVERY_ConnectionJson_SendJsonCallback() and ARDISCOVERY_ConnectionJson_ReceiveJsonCallback().
+ */
+typedef struct
+{
+    ARDISCOVERY_ConnectionJson_Callback_t sendJsonCallback; /**< Callback to add the fields to send ; may be NULL */
+    ARDISCOVERY_ConnectionJson_Callback_t receiveJsonCallback; /**< Callback to read the fields received ; may be NULL */
+    void *customData; /**< custom data given as parameter to the callbacks */
+} ARDISCOVERY_ConnectionJson_Callbacks_t;
+
+/**
+ * @brief Get the json key of a field.
+ * @param[in] field The field.
+ * @return The key of the field, or NULL if the field is unknown.
+ */
+static inline const char *ARDISCOVERY_ConnectionJson_GetKey (eARDISCOVERY_CONNECTIONJSON_FIELD field)
+{
+    static const char *const keys[ARDISCOVERY_CONNECTIONJSON_FIELD_MAX] =
+    {
+        ARDISCOVERY_CONNECTION_JSON_STATUS_KEY,
+        ARDISCOVERY_CONNECTION_JSON_C2DPORT_KEY,
+        ARDISCOVERY_CONNECTION_JSON_D2CPORT_KEY,
+        ARDISCOVERY_CONNECTION_JSON_ARSTREAM_FRAGMENT_SIZE_KEY,
+        ARDISCOVERY_CONNECTION_JSON_ARSTREAM_FRAGMENT_MAXIMUM_NUMBER_KEY,
+        ARDISCOVERY_CONNECTION_JSON_ARSTREAM_MAX_ACK_INTERVAL_KEY,
+        ARDISCOVERY_CONNECTION_JSON_C2D_UPDATE_PORT_KEY,
+        ARDISCOVERY_CONNECTION_JSON_C2D_USER_PORT_KEY,
+        ARDISCOVERY_CONNECTION_JSON_ARSTREAM2_CLIENT_STREAM_PORT_KEY,
+        ARDISCOVERY_CONNECTION_JSON_ARSTREAM2_CLIENT_CONTROL_PORT_KEY,
+        ARDISCOVERY_CONNECTION_JSON_ARSTREAM2_SERVER_STREAM_PORT_KEY,
+        ARDISCOVERY_CONNECTION_JSON_ARSTREAM2_SERVER_CONTROL_PORT_KEY,
+        ARDISCOVERY_CONNECTION_JSON_ARSTREAM2_MAX_PACKET_SIZE_KEY,
+        ARDISCOVERY_CONNECTION_JSON_ARSTREAM2_MAX_LATENCY_KEY,
+        ARDISCOVERY_CONNECTION_JSON_ARSTREAM2_MAX_NETWORK_LATENCY_KEY,
+        ARDISCOVERY_CONNECTION_JSON_ARSTREAM2_MAX_BITRATE_KEY,
+        ARDISCOVERY_CONNECTION_JSON_ARSTREAM2_SUPPORTED_METADATA_VERSION_KEY,
+        ARDISCOVERY_CONNECTION_JSON_AUDIO_CODEC_VERSION_KEY,
+        ARDISCOVERY_CONNECTION_JSON_QOS_MODE_KEY,
+        ARDISCOVERY_CONNECTION_JSON_CONTROLLER_TYPE_KEY,
+        ARDISCOVERY_CONNECTION_JSON_CONTROLLER_NAME_KEY,
+        ARDISCOVERY_CONNECTION_JSON_DEVICE_ID_KEY,
+        ARDISCOVERY_CONNECTION_JSON_SKYCONTROLLER_VERSION,
+        ARDISCOVERY_CONNECTION_JSON_FEATURES_KEY,
+        ARDISCOVERY_CONNECTION_JSON_ARSTREAM2_PARAMETER_SETS_KEY,
+    };
+
+    return ((unsigned)field < ARDISCOVERY_CONNECTIONJSON_FIELD_MAX) ? keys[field] : NULL;
+}
+
+/**
+ * @brief Reset a connection json view ; no field is present.
+ * @param[out] json The connection json view.
+ */
+static inline void ARDISCOVERY_ConnectionJson_Init (ARDISCOVERY_ConnectionJson_t *json)
+{
+    memset (json, 0, sizeof (*json));
+}
+
+/**
+ * @brief Check if a field is present.
+ * @param[in] json The connection json view.
+ * @param[in] field The field.
+ * @return 1 if the field is present ; otherwise 0.
+ */
+static inline int ARDISCOVERY_ConnectionJson_Has (const ARDISCOVERY_ConnectionJson_t *json, eARDISCOVERY_CONNECTIONJSON_FIELD field)
+{
+    return ((unsigned)field < ARDISCOVERY_CONNECTIONJSON_FIELD_MAX) && ((json->fields >> field) & 1);
+}
+
+/**
+ * @brief Set an integer field.
+ * @param json The connection json view.
+ * @param[in] field The integer field.
+ * @param[in] value The value.
+ * @return executing error.
+ */
+static inline eARDISCOVERY_ERROR ARDISCOVERY_ConnectionJson_SetInt (ARDISCOVERY_ConnectionJson_t *json, eARDISCOVERY_CONNECTIONJSON_FIELD field, int32_t value)
+{
+    if ((json == NULL) || ((unsigned)field >= ARDISCOVERY_CONNECTIONJSON_INT_FIELD_COUNT))
+    {
+        return ARDISCOVERY_ERROR_BAD_PARAMETER;
+    }
+
+    json->intValues[field] = value;
+    json->fields |= (uint32_t)1 << field;
+    return ARDISCOVERY_OK;
+}
+
+/**
+ * @brief Get an integer field.
+ * @param[in] json The connection json view.
+ * @param[in] field The integer field.
+ * @param[in] defaultValue Value returned if the field is not present.
+ * @return The value of the field.
+ */
+static inline int32_t ARDISCOVERY_ConnectionJson_GetInt (const ARDISCOVERY_ConnectionJson_t *json, eARDISCOVERY_CONNECTIONJSON_FIELD field, int32_t defaultValue)
+{
+    if (((unsigned)field >= ARDISCOVERY_CONNECTIONJSON_INT_FIELD_COUNT) || !ARDISCOVERY_ConnectionJson_Has (json, field))
+    {
+        return defaultValue;
+    }
+
+    return json->intValues[field];
+}
+
+/**
+ * @brief Set a string field.
+ * @warning The string is not copied ; it must stay valid until the json is encoded.
+ * @param json The connection json view.
+ * @param[in] field The string field.
+ * @param[in] value The value ; must be Null-terminated and not escaped.
+ * @return executing error.
+ */
+static inline eARDISCOVERY_ERROR ARDISCOVERY_ConnectionJson_SetString (ARDISCOVERY_ConnectionJson_t *json, eARDISCOVERY_CONNECTIONJSON_FIELD field, const char *value)
+{
+    ARDISCOVERY_ConnectionJson_String_t *str;
+
+    if ((json == NULL) || (value == NULL) ||
+        (field < ARDISCOVERY_CONNECTIONJSON_FIELD_FIRST_STRING) || (field >= ARDISCOVERY_CONNECTIONJSON_FIELD_MAX))
+    {
+        return ARDISCOVERY_ERROR_BAD_PARAMETER;
+    }
+
+    str = &json->stringValues[field - ARDISCOVERY_CONNECTIONJSON_FIELD_FIRST_STRING];
+    str->data = value;
+    str->length = (uint32_t)strlen (value);
+    str->isEscaped = 0;
+    json->fields |= (uint32_t)1 << field;
+    return ARDISCOVERY_OK;
+}
+
+/**
+ * @brief Get a string field.
+ * @param[in] json The connection json view.
+ * @return The string view, or NULL if the field is not present.
+ */
+static inline const ARDISCOVERY_ConnectionJson_String_t *ARDISCOVERY_ConnectionJson_GetString (const ARDISCOVERY_ConnectionJson_t *json, eARDISCOVERY_CONNECTIONJSON_FIELD field)
+{
+    if ((field < ARDISCOVERY_CONNECTIONJSON_FIELD_FIRST_STRING) || !ARDISCOVERY_ConnectionJson_Has (json, field))
+    {
+        return NULL;
+    }
+
+    return &json->stringValues[field - ARDISCOVERY_CONNECTIONJSON_FIELD_FIRST_STRING];
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Value of an hexadecimal digit
+ * @return the value, or -1 if c is not an hexadecimal digit.
+ */
+static inline int ARDISCOVERY_ConnectionJson_HexValue (char c)
+{
+    if ((c >= '0') && (c <= '9')) return c - '0';
+    if ((c >= 'a') && (c <= 'f')) return c - 'a' + 10;
+    if ((c >= 'A') && (c <= 'F')) return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * @brief Copy a string field into a Null-terminated buffer, resolving the json escape sequences.
+ * @note \\u escapes are encoded in UTF-8 ; surrogate pairs are not combined.
+ * @param[in] json The connection json view.
+ * @param[in] field The string field.
+ * @param[out] buffer The destination buffer.
+ * @param[in] length The size of the destination buffer.
+ * @return executing error ; ARDISCOVERY_ERROR_OUTPUT_LENGTH if the buffer is too small.
+ */
+static inline eARDISCOVERY_ERROR ARDISCOVERY_ConnectionJson_CopyString (const ARDISCOVERY_ConnectionJson_t *json, eARDISCOVERY_CONNECTIONJSON_FIELD field, char *buffer, uint32_t length)
+{
+    const ARDISCOVERY_ConnectionJson_String_t *str = ARDISCOVERY_ConnectionJson_GetString (json, field);
+    uint32_t in = 0;
+    uint32_t out = 0;
+
+    if ((str == NULL) || (buffer == NULL) || (length == 0))
+    {
+        return ARDISCOVERY_ERROR_BAD_PARAMETER;
+    }
+
+    while (in < str->length)
+    {
+        char c = str->data[in++];
+        uint32_t cp = 0;
+        char utf8[3];
+        int n = 1;
+        int i;
+
+        utf8[0] = c;
+
+        if (c == '\\')
+        {
+            if (in >= str->length)
+            {
+                return ARDISCOVERY_ERROR_JSON_PARSSING;
+            }
+            c = str->data[in++];
+            switch (c)
+            {
+            case 'b': utf8[0] = '\b'; break;
+            case 'f': utf8[0] = '\f'; break;
+            case 'n': utf8[0] = '\n'; break;
+            case 'r': utf8[0] = '\r'; break;
+            case 't': utf8[0] = '\t'; break;
+            case 'u':
+                if (in + 4 > str->length)
+                {
+                    return ARDISCOVERY_ERROR_JSON_PARSSING;
+                }
+                for (i = 0; i < 4; i++)
+                {
+                    int v = ARDISCOVERY_ConnectionJson_HexValue (str->data[in++]);
+                    if (v < 0)
+                    {
+                        return ARDISCOVERY_ERROR_JSON_PARSSING;
+                    }
+                    cp = (cp << 4) | (uint32_t)v;
+                }
+                if (cp < 0x80)
+                {
+                    utf8[0] = (char)cp;
+                }
+                else if (cp < 0x800)
+                {
+                    utf8[0] = (char)(0xC0 | (cp >> 6));
+                    utf8[1] = (char)(0x80 | (cp & 0x3F));
+                    n = 2;
+                }
+                else
+                {
+                    utf8[0] = (char)(0xE0 | (cp >> 12));
+                    utf8[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+                    utf8[2] = (char)(0x80 | (cp & 0x3F));
+                    n = 3;
+                }
+                break;
+            default: utf8[0] = c; break;
+            }
+        }
+
+        if (out + (uint32_t)n >= length)
+        {
+            buffer[out] = '\0';
+            return ARDISCOVERY_ERROR_OUTPUT_LENGTH;
+        }
+        for (i = 0; i < n; i++)
+        {
+            buffer[out++] = utf8[i];
+        }
+    }
+
+    buffer[out] = '\0';
+    return ARDISCOVERY_OK;
+}
+
+/**
+ * @brief Checks if the connection json contains stream2 parameters.
+ * @note Counterpart of ARCONTROLLER_Stream2_JsonContainsStream2Param() working on the lightweight view.
+ * @param[in] json The connection json view.
+ * @return different of 0 if the json contains stream2 parameters, otherwise 0.
+ */
+static inline uint8_t ARDISCOVERY_ConnectionJson_ContainsStream2Param (const ARDISCOVERY_ConnectionJson_t *json)
+{
+    return (ARDISCOVERY_ConnectionJson_Has (json, ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM2_SERVER_STREAM_PORT) &&
+            ARDISCOVERY_ConnectionJson_Has (json, ARDISCOVERY_CONNECTIONJSON_FIELD_ARSTREAM2_SERVER_CONTROL_PORT)) ? 1 : 0;
+}
+
+/*****************************************
+ *
+ *             encoder
+ *
+ *****************************************/
+
+/**
+ * @brief INTERNAL FUNCTION : Append raw bytes to the output
+ * @return 0 if no error occured, -1 if the output is full
+ */
+static inline int ARDISCOVERY_ConnectionJson_Put (uint8_t *dataTx, uint32_t capacity, uint32_t *pos, const char *data, uint32_t length)
+{
+    if (*pos + length >= capacity)
+    {
+        return -1;
+    }
+    memcpy (dataTx + *pos, data, length);
+    *pos += length;
+    return 0;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Append a quoted, escaped json string to the output
+ * @return 0 if no error occured, -1 if the output is full
+ */
+static inline int ARDISCOVERY_ConnectionJson_PutString (uint8_t *dataTx, uint32_t capacity, uint32_t *pos, const char *data, uint32_t length, uint8_t isEscaped)
+{
+    uint32_t i;
+    uint32_t start = 0;
+    char esc[6] = { '\\', 'u', '0', '0', '0', '0' };
+
+    if (ARDISCOVERY_ConnectionJson_Put (dataTx, capacity, pos, "\"", 1) != 0)
+    {
+        return -1;
+    }
+
+    for (i = 0; (i < length) && !isEscaped; i++)
+    {
+        unsigned char c = (unsigned char)data[i];
+        uint32_t escLength = 2;
+
+        if ((c >= 0x20) && (c != '"') && (c != '\\'))
+        {
+            continue;
+        }
+
+        switch (c)
+        {
+        case '"':  esc[1] = '"'; break;
+        case '\\': esc[1] = '\\'; break;
+        case '\b': esc[1] = 'b'; break;
+        case '\f': esc[1] = 'f'; break;
+        case '\n': esc[1] = 'n'; break;
+        case '\r': esc[1] = 'r'; break;
+        case '\t': esc[1] = 't'; break;
+        default:
+            esc[1] = 'u';
+            esc[4] = "0123456789abcdef"[c >> 4];
+            esc[5] = "0123456789abcdef"[c & 0xF];
+            escLength = 6;
+            break;
+        }
+
+        if ((ARDISCOVERY_ConnectionJson_Put (dataTx, capacity, pos, data + start, i - start) != 0) ||
+            (ARDISCOVERY_ConnectionJson_Put (dataTx, capacity, pos, esc, escLength) != 0))
+        {
+            return -1;
+        }
+        start = i + 1;
+    }
+
+    if (isEscaped)
+    {
+        start = 0;
+        i = length;
+    }
+
+    if ((ARDISCOVERY_ConnectionJson_Put (dataTx, capacity, pos, data + start, i - start) != 0) ||
+        (ARDISCOVERY_ConnectionJson_Put (dataTx, capacity, pos, "\"", 1) != 0))
+    {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Append a decimal integer to the output
+ * @return 0 if no error occured, -1 if the output is full
+ */
+static inline int ARDISCOVERY_ConnectionJson_PutInt (uint8_t *dataTx, uint32_t capacity, uint32_t *pos, int32_t value)
+{
+    char digits[12];
+    int i = sizeof (digits);
+    uint32_t magnitude = (value < 0) ? (uint32_t)0 - (uint32_t)value : (uint32_t)value;
+
+    do
+    {
+        digits[--i] = (char)('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (value < 0)
+    {
+        digits[--i] = '-';
+    }
+
+    return ARDISCOVERY_ConnectionJson_Put (dataTx, capacity, pos, digits + i, (uint32_t)(sizeof (digits) - i));
+}
+
+/**
+ * @brief Encode the connection json.
+ * @note The fields are written in the order of eARDISCOVERY_CONNECTIONJSON_FIELD ; no memory is allocated.
+ * @param[in] json The connection json view.
+ * @param[out] dataTx Transmission buffer ; Null-terminated on success.
+ * @param[in] capacity Size of the transmission buffer (typically ARDISCOVERY_CONNECTION_TX_BUFFER_SIZE).
+ * @param[out] dataTxSize Transmission data size, Null character included.
+ * @return executing error ; ARDISCOVERY_ERROR_JSON_BUFFER_SIZE if the buffer is too small.
+ */
+static inline eARDISCOVERY_ERROR ARDISCOVERY_ConnectionJson_Encode (const ARDISCOVERY_ConnectionJson_t *json, uint8_t *dataTx, uint32_t capacity, uint32_t *dataTxSize)
+{
+    uint32_t pos = 0;
+    int field;
+    int isFirst = 1;
+
+    if ((json == NULL) || (dataTx == NULL) || (dataTxSize == NULL) || (capacity == 0))
+    {
+        return ARDISCOVERY_ERROR_BAD_PARAMETER;
+    }
+
+    if (ARDISCOVERY_ConnectionJson_Put (dataTx, capacity, &pos, "{ ", 2) != 0)
+    {
+        return ARDISCOVERY_ERROR_JSON_BUFFER_SIZE;
+    }
+
+    for (field = 0; field < ARDISCOVERY_CONNECTIONJSON_FIELD_MAX; field++)
+    {
+        const char *key;
+        int res;
+
+        if (!((json->fields >> field) & 1))
+        {
+            continue;
+        }
+
+        key = ARDISCOVERY_ConnectionJson_GetKey ((eARDISCOVERY_CONNECTIONJSON_FIELD)field);
+        res = ((!isFirst) ? ARDISCOVERY_ConnectionJson_Put (dataTx, capacity, &pos, ", ", 2) : 0);
+        res = (res == 0) ? ARDISCOVERY_ConnectionJson_PutString (dataTx, capacity, &pos, key, (uint32_t)strlen (key), 0) : res;
+        res = (res == 0) ? ARDISCOVERY_ConnectionJson_Put (dataTx, capacity, &pos, ": ", 2) : res;
+
+        if (res == 0)
+        {
+            if (field < ARDISCOVERY_CONNECTIONJSON_FIELD_FIRST_STRING)
+            {
+                res = ARDISCOVERY_ConnectionJson_PutInt (dataTx, capacity, &pos, json->intValues[field]);
+            }
+            else
+            {
+                const ARDISCOVERY_ConnectionJson_String_t *str = &json->stringValues[field - ARDISCOVERY_CONNECTIONJSON_FIELD_FIRST_STRING];
+                res = ARDISCOVERY_ConnectionJson_PutString (dataTx, capacity, &pos, str->data, str->length, str->isEscaped);
+            }
+        }
+
+        if (res != 0)
+        {
+            return ARDISCOVERY_ERROR_JSON_BUFFER_SIZE;
+        }
+        isFirst = 0;
+    }
+
+    if (ARDISCOVERY_ConnectionJson_Put (dataTx, capacity, &pos, " }", 2) != 0)
+    {
+        return ARDISCOVERY_ERROR_JSON_BUFFER_SIZE;
+    }
+
+    dataTx[pos++] = '\0';
+    *dataTxSize = pos;
+    return ARDISCOVERY_OK;
+}
+
+/*****************************************
+ *
+ *             scanner
+ *
+ *****************************************/
+
+/**
+ * @brief INTERNAL FUNCTION : Skip json white spaces
+ */
+static inline uint32_t ARDISCOVERY_ConnectionJson_SkipSpaces (const uint8_t *data, uint32_t size, uint32_t pos)
+{
+    while ((pos < size) && ((data[pos] == ' ') || (data[pos] == '\t') || (data[pos] == '\n') || (data[pos] == '\r')))
+    {
+        pos++;
+    }
+    return pos;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Scan a json string ; pos must be on the opening quote
+ * @return the position after the closing quote, or 0 on error
+ */
+static inline uint32_t ARDISCOVERY_ConnectionJson_ScanString (const uint8_t *data, uint32_t size, uint32_t pos, ARDISCOVERY_ConnectionJson_String_t *str)
+{
+    uint32_t start = ++pos;
+    uint8_t isEscaped = 0;
+
+    while (pos < size)
+    {
+        uint8_t c = data[pos];
+        if (c == '"')
+        {
+            str->data = (const char *)data + start;
+            str->length = pos - start;
+            str->isEscaped = isEscaped;
+            return pos + 1;
+        }
+        if (c == '\\')
+        {
+            isEscaped = 1;
+            pos++;
+        }
+        else if (c < 0x20)
+        {
+            return 0;
+        }
+        pos++;
+    }
+    return 0;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Skip a true, false or null literal
+ * @return the position after the literal, or 0 if it is not one of them
+ */
+static inline uint32_t ARDISCOVERY_ConnectionJson_SkipLiteral (const uint8_t *data, uint32_t size, uint32_t pos)
+{
+    static const char *const literals[] = { "true", "false", "null" };
+    uint32_t i;
+
+    for (i = 0; i < sizeof (literals) / sizeof (literals[0]); i++)
+    {
+        uint32_t length = (uint32_t)strlen (literals[i]);
+        if ((size - pos >= length) && (memcmp (data + pos, literals[i], length) == 0))
+        {
+            return pos + length;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Skip any json value (nested objects and arrays included)
+ * @return the position after the value, or 0 on error
+ */
+static inline uint32_t ARDISCOVERY_ConnectionJson_SkipValue (const uint8_t *data, uint32_t size, uint32_t pos)
+{
+    uint32_t depth = 0;
+    ARDISCOVERY_ConnectionJson_String_t unused;
+
+    do
+    {
+        pos = ARDISCOVERY_ConnectionJson_SkipSpaces (data, size, pos);
+        if (pos >= size)
+        {
+            return 0;
+        }
+
+        switch (data[pos])
+        {
+        case '"':
+            pos = ARDISCOVERY_ConnectionJson_ScanString (data, size, pos, &unused);
+            if (pos == 0)
+            {
+                return 0;
+            }
+            break;
+        case '{':
+        case '[':
+            depth++;
+            pos++;
+            break;
+        case '}':
+        case ']':
+            if (depth == 0)
+            {
+                return 0;
+            }
+            depth--;
+            pos++;
+            break;
+        case ',':
+        case ':':
+            if (depth == 0)
+            {
+                return 0;
+            }
+            pos++;
+            break;
+        case 't':
+        case 'f':
+        case 'n':
+            pos = ARDISCOVERY_ConnectionJson_SkipLiteral (data, size, pos);
+            if (pos == 0)
+            {
+                return 0;
+            }
+            break;
+        default:
+        {
+            /* number */
+            uint32_t start = pos;
+            while ((pos < size) && (((data[pos] >= '0') && (data[pos] <= '9')) || (data[pos] == '-') || (data[pos] == '+') ||
+                                    (data[pos] == '.') || (data[pos] == 'e') || (data[pos] == 'E')))
+            {
+                pos++;
+            }
+            if (pos == start)
+            {
+                return 0;
+            }
+            break;
+        }
+        }
+    } while (depth > 0);
+
+    return pos;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Find the field matching a key
+ * @return the field, or ARDISCOVERY_CONNECTIONJSON_FIELD_MAX if the key is unknown
+ */
+static inline eARDISCOVERY_CONNECTIONJSON_FIELD ARDISCOVERY_ConnectionJson_FindField (const ARDISCOVERY_ConnectionJson_String_t *key)
+{
+    int field;
+
+    if (key->isEscaped)
+    {
+        return ARDISCOVERY_CONNECTIONJSON_FIELD_MAX;
+    }
+
+    for (field = 0; field < ARDISCOVERY_CONNECTIONJSON_FIELD_MAX; field++)
+    {
+        const char *name = ARDISCOVERY_ConnectionJson_GetKey ((eARDISCOVERY_CONNECTIONJSON_FIELD)field);
+        if ((name[0] == key->data[0]) && (strncmp (name, key->data, key->length) == 0) && (name[key->length] == '\0'))
+        {
+            return (eARDISCOVERY_CONNECTIONJSON_FIELD)field;
+        }
+    }
+
+    return ARDISCOVERY_CONNECTIONJSON_FIELD_MAX;
+}
+
+/**
+ * @brief Decode a connection json in a single pass.
+ * @note No memory is allocated: the string fields of the view point into dataRx,
+ * which must stay valid as long as the view is used. Unknown keys are skipped.
+ * @param[out] json The connection json view.
+ * @param[in] dataRx Reception buffer ; does not need to be Null-terminated.
+ * @param[in] dataRxSize Reception data size.
+ * @return executing error ; ARDISCOVERY_ERROR_JSON_PARSSING if the json is malformed or a known field has a wrong type.
+ */
+static inline eARDISCOVERY_ERROR ARDISCOVERY_ConnectionJson_Parse (ARDISCOVERY_ConnectionJson_t *json, const uint8_t *dataRx, uint32_t dataRxSize)
+{
+    uint32_t pos;
+
+    if ((json == NULL) || (dataRx == NULL))
+    {
+        return ARDISCOVERY_ERROR_BAD_PARAMETER;
+    }
+
+    ARDISCOVERY_ConnectionJson_Init (json);
+
+    /* the transmitted size may include the Null character */
+    while ((dataRxSize > 0) && (dataRx[dataRxSize - 1] == '\0'))
+    {
+        dataRxSize--;
+    }
+
+    pos = ARDISCOVERY_ConnectionJson_SkipSpaces (dataRx, dataRxSize, 0);
+    if ((pos >= dataRxSize) || (dataRx[pos] != '{'))
+    {
+        return ARDISCOVERY_ERROR_JSON_PARSSING;
+    }
+    pos = ARDISCOVERY_ConnectionJson_SkipSpaces (dataRx, dataRxSize, pos + 1);
+
+    if ((pos < dataRxSize) && (dataRx[pos] == '}'))
+    {
+        return ARDISCOVERY_OK;
+    }
+
+    while (pos < dataRxSize)
+    {
+        ARDISCOVERY_ConnectionJson_String_t key;
+        eARDISCOVERY_CONNECTIONJSON_FIELD field;
+
+        if (dataRx[pos] != '"')
+        {
+            return ARDISCOVERY_ERROR_JSON_PARSSING;
+        }
+        pos = ARDISCOVERY_ConnectionJson_ScanString (dataRx, dataRxSize, pos, &key);
+        if (pos == 0)
+        {
+            return ARDISCOVERY_ERROR_JSON_PARSSING;
+        }
+
+        pos = ARDISCOVERY_ConnectionJson_SkipSpaces (dataRx, dataRxSize, pos);
+        if ((pos >= dataRxSize) || (dataRx[pos] != ':'))
+        {
+            return ARDISCOVERY_ERROR_JSON_PARSSING;
+        }
+        pos = ARDISCOVERY_ConnectionJson_SkipSpaces (dataRx, dataRxSize, pos + 1);
+        if (pos >= dataRxSize)
+        {
+            return ARDISCOVERY_ERROR_JSON_PARSSING;
+        }
+
+        field = ARDISCOVERY_ConnectionJson_FindField (&key);
+        if (field == ARDISCOVERY_CONNECTIONJSON_FIELD_MAX)
+        {
+            pos = ARDISCOVERY_ConnectionJson_SkipValue (dataRx, dataRxSize, pos);
+        }
+        else if (field >= ARDISCOVERY_CONNECTIONJSON_FIELD_FIRST_STRING)
+        {
+            if (dataRx[pos] != '"')
+            {
+                return ARDISCOVERY_ERROR_JSON_PARSSING;
+            }
+            pos = ARDISCOVERY_ConnectionJson_ScanString (dataRx, dataRxSize, pos, &json->stringValues[field - ARDISCOVERY_CONNECTIONJSON_FIELD_FIRST_STRING]);
+            json->fields |= (uint32_t)1 << field;
+        }
+        else
+        {
+            int negative = 0;
+            uint32_t start;
+            int64_t value = 0;
+
+            if (dataRx[pos] == '-')
+            {
+                negative = 1;
+                pos++;
+            }
+            start = pos;
+            while ((pos < dataRxSize) && (dataRx[pos] >= '0') && (dataRx[pos] <= '9'))
+            {
+                value = value * 10 + (dataRx[pos] - '0');
+                if (value > (int64_t)INT32_MAX + 1)
+                {
+                    return ARDISCOVERY_ERROR_JSON_PARSSING;
+                }
+                pos++;
+            }
+            value = negative ? -value : value;
+            if ((pos == start) || (value > INT32_MAX) ||
+                ((pos < dataRxSize) && ((dataRx[pos] == '.') || (dataRx[pos] == 'e') || (dataRx[pos] == 'E'))))
+            {
+                return ARDISCOVERY_ERROR_JSON_PARSSING;
+            }
+            json->intValues[field] = (int32_t)value;
+            json->fields |= (uint32_t)1 << field;
+        }
+
+        if (pos == 0)
+        {
+            return ARDISCOVERY_ERROR_JSON_PARSSING;
+        }
+
+        pos = ARDISCOVERY_ConnectionJson_SkipSpaces (dataRx, dataRxSize, pos);
+        if (pos >= dataRxSize)
+        {
+            break;
+        }
+        if (dataRx[pos] == '}')
+        {
+            return ARDISCOVERY_OK;
+        }
+        if (dataRx[pos] != ',')
+        {
+            return ARDISCOVERY_ERROR_JSON_PARSSING;
+        }
+        pos = ARDISCOVERY_ConnectionJson_SkipSpaces (dataRx, dataRxSize, pos + 1);
+    }
+
+    return ARDISCOVERY_ERROR_JSON_PARSSING;
+}
+
+/*****************************************
+ *
+ *             connection callbacks
+ *
+ *****************************************/
+
+/**
+ * @brief Send json callback encoding the connection json without allocation.
+ * @note To give to ARDISCOVERY_Connection_New() with an ARDISCOVERY_ConnectionJson_Callbacks_t as customData.
+ * @see ARDISCOVERY_Connection_SendJsonCallback_t
+ */
+static inline eARDISCOVERY_ERROR ARDISCOVERY_ConnectionJson_SendJsonCallback (uint8_t *dataTx, uint32_t *dataTxSize, void *customData)
+{
+    ARDISCOVERY_ConnectionJson_Callbacks_t *callbacks = (ARDISCOVERY_ConnectionJson_Callbacks_t *)customData;
+    ARDISCOVERY_ConnectionJson_t json;
+    eARDISCOVERY_ERROR error = ARDISCOVERY_OK;
+
+    if ((callbacks == NULL) || (dataTx == NULL) || (dataTxSize == NULL))
+    {
+        return ARDISCOVERY_ERROR_BAD_PARAMETER;
+    }
+
+    ARDISCOVERY_ConnectionJson_Init (&json);
+
+    if (callbacks->sendJsonCallback != NULL)
+    {
+        error = callbacks->sendJsonCallback (&json, callbacks->customData);
+    }
+
+    if (error == ARDISCOVERY_OK)
+    {
+        error = ARDISCOVERY_ConnectionJson_Encode (&json, dataTx, ARDISCOVERY_CONNECTION_TX_BUFFER_SIZE, dataTxSize);
+    }
+
+    return error;
+}
+
+/**
+ * @brief Receive json callback decoding the connection json without allocation.
+ * @note To give to ARDISCOVERY_Connection_New() with an ARDISCOVERY_ConnectionJson_Callbacks_t as customData.
+ * The status sent by the device is returned as error, as done by the device connection.
+ * @see ARDISCOVERY_Connection_ReceiveJsonCallback_t
+ */
+static inline eARDISCOVERY_ERROR ARDISCOVERY_ConnectionJson_ReceiveJsonCallback (uint8_t *dataRx, uint32_t dataRxSize, char *ip, void *customData)
+{
+    ARDISCOVERY_ConnectionJson_Callbacks_t *callbacks = (ARDISCOVERY_ConnectionJson_Callbacks_t *)customData;
+    ARDISCOVERY_ConnectionJson_t json;
+    eARDISCOVERY_ERROR error;
+
+    (void)ip;
+
+    if ((callbacks == NULL) || (dataRx == NULL))
+    {
+        return ARDISCOVERY_ERROR_BAD_PARAMETER;
+    }
+
+    error = ARDISCOVERY_ConnectionJson_Parse (&json, dataRx, dataRxSize);
+
+    if ((error == ARDISCOVERY_OK) && (callbacks->receiveJsonCallback != NULL))
+    {
+        error = callbacks->receiveJsonCallback (&json, callbacks->customData);
+    }
+
+    if (error == ARDISCOVERY_OK)
+    {
+        error = (eARDISCOVERY_ERROR)ARDISCOVERY_ConnectionJson_GetInt (&json, ARDISCOVERY_CONNECTIONJSON_FIELD_STATUS, ARDISCOVERY_OK);
+    }
+
+    return error;
+}
+
+#endif /* _ARDISCOVERY_CONNECTION_JSON_H_ */
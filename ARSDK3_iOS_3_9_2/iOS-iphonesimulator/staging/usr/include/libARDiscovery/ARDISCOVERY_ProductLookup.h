@@ -0,0 +1,331 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARDISCOVERY_ProductLookup.h
+ * @brief Constant time product lookups
+ * @note Same results as ARDISCOVERY_getProductFromName(), ARDISCOVERY_getProductFromPathName()
+ * and ARDISCOVERY_getProductFromProductID(), without their linear search:
+ * product IDs index a direct table, names and path names go through a perfect hash
+ * followed by a single string comparison. C++11 code gets constexpr accessors.
+ * @date 10/18/2026
+ */
+
+#ifndef _ARDISCOVERY_PRODUCT_LOOKUP_H_
+#define _ARDISCOVERY_PRODUCT_LOOKUP_H_
+
+#include <inttypes.h>
+#include <string.h>
+#include <libARDiscovery/ARDISCOVERY_Discovery.h>
+
+/**
+ * @brief Products table ; X is called with the product, its ID, its name and its path name.
+ * @note Must stay in sync with the product tables of ARDISCOVERY_Discovery.c.
+ */
+#define ARDISCOVERY_PRODUCTLOOKUP_PRODUCTS(X)                                                                          \
+    X(ARDISCOVERY_PRODUCT_ARDRONE,                  0x0901, "Bebop Drone",       "Bebop_Drone")                        \
+    X(ARDISCOVERY_PRODUCT_JS,                       0x0902, "Jumping Sumo",      "Jumping_Sumo")                       \
+    X(ARDISCOVERY_PRODUCT_SKYCONTROLLER,            0x0903, "SkyController",     "SkyController")                      \
+    X(ARDISCOVERY_PRODUCT_JS_EVO_LIGHT,             0x0905, "Jumping Night",     "Jumping_Night")                      \
+    X(ARDISCOVERY_PRODUCT_JS_EVO_RACE,              0x0906, "Jumping Race",      "Jumping_Race")                       \
+    X(ARDISCOVERY_PRODUCT_BEBOP_2,                  0x090c, "Bebop 2",           "Bebop_2")                            \
+    X(ARDISCOVERY_PRODUCT_UNKNOWN_PRODUCT_1,        0x090d, "Unknown Product 1", "Unknown_Product_1")                  \
+    X(ARDISCOVERY_PRODUCT_EVINRUDE,                 0x090e, "Disco",             "Disco")                              \
+    X(ARDISCOVERY_PRODUCT_MINIDRONE,                0x0900, "Rolling Spider",    "Rolling_Spider")                     \
+    X(ARDISCOVERY_PRODUCT_MINIDRONE_EVO_LIGHT,      0x0907, "Airborne Night",    "Airborne_Night")                     \
+    X(ARDISCOVERY_PRODUCT_MINIDRONE_EVO_BRICK,      0x0909, "Airborne Cargo",    "Airborne_Cargo")                     \
+    X(ARDISCOVERY_PRODUCT_MINIDRONE_EVO_HYDROFOIL,  0x090a, "Hydrofoil",         "Hydrofoil")                          \
+    X(ARDISCOVERY_PRODUCT_UNKNOWNPRODUCT_2,         0x090f, "UnknownProduct 2",  "UnknownProduct_2")
+
+/**
+ * @brief First product ID ; the product IDs table is indexed by (productID - ARDISCOVERY_PRODUCTLOOKUP_ID_BASE)
+ */
+#define ARDISCOVERY_PRODUCTLOOKUP_ID_BASE 0x0900
+
+/**
+ * @brief Size of the product IDs table
+ */
+#define ARDISCOVERY_PRODUCTLOOKUP_ID_TABLE_SIZE 16
+
+/**
+ * @brief Size of the perfect hash table of the names
+ */
+#define ARDISCOVERY_PRODUCTLOOKUP_HASH_TABLE_SIZE 16
+
+/**
+ * @brief Perfect hash of the product names and path names
+ * @note Generated for the names of ARDISCOVERY_PRODUCTLOOKUP_PRODUCTS: the pair
+ * (length, first character, last character) is distinct for every product and is
+ * the same for a name and its path name. Regenerate the multipliers and the slot
+ * table when a product is added.
+ */
+#define ARDISCOVERY_PRODUCTLOOKUP_HASH(length, first, last) \
+    ((((uint32_t)(length) * 8) + ((uint32_t)(unsigned char)(first) * 6) + (uint32_t)(unsigned char)(last)) & (ARDISCOVERY_PRODUCTLOOKUP_HASH_TABLE_SIZE - 1))
+
+/**
+ * @brief Products table indexed by (productID - ARDISCOVERY_PRODUCTLOOKUP_ID_BASE)
+ */
+#define ARDISCOVERY_PRODUCTLOOKUP_ID_TABLE                                                                             \
+    {                                                                                                                   \
+        ARDISCOVERY_PRODUCT_MINIDRONE, ARDISCOVERY_PRODUCT_ARDRONE, ARDISCOVERY_PRODUCT_JS,                             \
+        ARDISCOVERY_PRODUCT_SKYCONTROLLER, ARDISCOVERY_PRODUCT_MAX, ARDISCOVERY_PRODUCT_JS_EVO_LIGHT,                   \
+        ARDISCOVERY_PRODUCT_JS_EVO_RACE, ARDISCOVERY_PRODUCT_MINIDRONE_EVO_LIGHT, ARDISCOVERY_PRODUCT_MAX,              \
+        ARDISCOVERY_PRODUCT_MINIDRONE_EVO_BRICK, ARDISCOVERY_PRODUCT_MINIDRONE_EVO_HYDROFOIL, ARDISCOVERY_PRODUCT_MAX,  \
+        ARDISCOVERY_PRODUCT_BEBOP_2, ARDISCOVERY_PRODUCT_UNKNOWN_PRODUCT_1, ARDISCOVERY_PRODUCT_EVINRUDE,               \
+        ARDISCOVERY_PRODUCT_UNKNOWNPRODUCT_2,                                                                           \
+    }
+
+/**
+ * @brief Products table indexed by ARDISCOVERY_PRODUCTLOOKUP_HASH() of their name
+ */
+#define ARDISCOVERY_PRODUCTLOOKUP_HASH_TABLE                                                                           \
+    {                                                                                                                   \
+        ARDISCOVERY_PRODUCT_UNKNOWNPRODUCT_2, ARDISCOVERY_PRODUCT_JS_EVO_RACE, ARDISCOVERY_PRODUCT_MAX,                 \
+        ARDISCOVERY_PRODUCT_MAX, ARDISCOVERY_PRODUCT_MINIDRONE_EVO_HYDROFOIL, ARDISCOVERY_PRODUCT_MINIDRONE_EVO_BRICK,  \
+        ARDISCOVERY_PRODUCT_BEBOP_2, ARDISCOVERY_PRODUCT_UNKNOWN_PRODUCT_1, ARDISCOVERY_PRODUCT_JS_EVO_LIGHT,           \
+        ARDISCOVERY_PRODUCT_ARDRONE, ARDISCOVERY_PRODUCT_MINIDRONE_EVO_LIGHT, ARDISCOVERY_PRODUCT_JS,                   \
+        ARDISCOVERY_PRODUCT_SKYCONTROLLER, ARDISCOVERY_PRODUCT_MAX, ARDISCOVERY_PRODUCT_MINIDRONE,                      \
+        ARDISCOVERY_PRODUCT_EVINRUDE,                                                                                   \
+    }
+
+/**
+ * @brief INTERNAL MACROS : Columns of ARDISCOVERY_PRODUCTLOOKUP_PRODUCTS
+ */
+#define ARDISCOVERY_PRODUCTLOOKUP_ID(product, id, name, pathName) (id),
+#define ARDISCOVERY_PRODUCTLOOKUP_NAME(product, id, name, pathName) name,
+#define ARDISCOVERY_PRODUCTLOOKUP_PATH_NAME(product, id, name, pathName) pathName,
+
+/**
+ * @brief Converts from product enumerator to product ID
+ * @param product The product's enumerator
+ * @return The corresponding product ID, or 0 if the product is unknown
+ */
+static inline uint16_t ARDISCOVERY_ProductLookup_GetProductID (eARDISCOVERY_PRODUCT product)
+{
+    static const uint16_t ids[ARDISCOVERY_PRODUCT_MAX] = { ARDISCOVERY_PRODUCTLOOKUP_PRODUCTS (ARDISCOVERY_PRODUCTLOOKUP_ID) };
+    return ((unsigned)product < ARDISCOVERY_PRODUCT_MAX) ? ids[product] : 0;
+}
+
+/**
+ * @brief Converts from product enumerator to product name
+ * @param product The product's enumerator
+ * @return The corresponding product name, or an empty string if the product is unknown
+ */
+static inline const char *ARDISCOVERY_ProductLookup_GetName (eARDISCOVERY_PRODUCT product)
+{
+    static const char *const names[ARDISCOVERY_PRODUCT_MAX] = { ARDISCOVERY_PRODUCTLOOKUP_PRODUCTS (ARDISCOVERY_PRODUCTLOOKUP_NAME) };
+    return ((unsigned)product < ARDISCOVERY_PRODUCT_MAX) ? names[product] : "";
+}
+
+/**
+ * @brief Converts from product enumerator to product path name
+ * @param product The product's enumerator
+ * @return The corresponding product path name, or an empty string if the product is unknown
+ */
+static inline const char *ARDISCOVERY_ProductLookup_GetPathName (eARDISCOVERY_PRODUCT product)
+{
+    static const char *const pathNames[ARDISCOVERY_PRODUCT_MAX] = { ARDISCOVERY_PRODUCTLOOKUP_PRODUCTS (ARDISCOVERY_PRODUCTLOOKUP_PATH_NAME) };
+    return ((unsigned)product < ARDISCOVERY_PRODUCT_MAX) ? pathNames[product] : "";
+}
+
+/**
+ * @brief Converts from product ID to product enumerator
+ * @param productID the productID of the product
+ * @return The corresponding product enumerator, or ARDISCOVERY_PRODUCT_MAX if the ID is unknown
+ */
+static inline eARDISCOVERY_PRODUCT ARDISCOVERY_ProductLookup_FromProductID (uint16_t productID)
+{
+    static const eARDISCOVERY_PRODUCT products[ARDISCOVERY_PRODUCTLOOKUP_ID_TABLE_SIZE] = ARDISCOVERY_PRODUCTLOOKUP_ID_TABLE;
+    uint16_t index = (uint16_t)(productID - ARDISCOVERY_PRODUCTLOOKUP_ID_BASE);
+    return (index < ARDISCOVERY_PRODUCTLOOKUP_ID_TABLE_SIZE) ? products[index] : ARDISCOVERY_PRODUCT_MAX;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Find the product candidate of a name with the perfect hash
+ */
+static inline eARDISCOVERY_PRODUCT ARDISCOVERY_ProductLookup_HashCandidate (const char *name, size_t length)
+{
+    static const eARDISCOVERY_PRODUCT products[ARDISCOVERY_PRODUCTLOOKUP_HASH_TABLE_SIZE] = ARDISCOVERY_PRODUCTLOOKUP_HASH_TABLE;
+    return (length == 0) ? ARDISCOVERY_PRODUCT_MAX : products[ARDISCOVERY_PRODUCTLOOKUP_HASH (length, name[0], name[length - 1])];
+}
+
+/**
+ * @brief Converts from product name to product enumerator
+ * @param name The product's name
+ * @return The corresponding product enumerator, or ARDISCOVERY_PRODUCT_MAX if the name is unknown
+ */
+static inline eARDISCOVERY_PRODUCT ARDISCOVERY_ProductLookup_FromName (const char *name)
+{
+    eARDISCOVERY_PRODUCT product;
+
+    if (name == NULL)
+    {
+        return ARDISCOVERY_PRODUCT_MAX;
+    }
+
+    product = ARDISCOVERY_ProductLookup_HashCandidate (name, strlen (name));
+    return ((product != ARDISCOVERY_PRODUCT_MAX) && (strcmp (name, ARDISCOVERY_ProductLookup_GetName (product)) == 0)) ? product : ARDISCOVERY_PRODUCT_MAX;
+}
+
+/**
+ * @brief Converts from product path name to product enumerator
+ * @param name The product's path name
+ * @return The corresponding product enumerator, or ARDISCOVERY_PRODUCT_MAX if the path name is unknown
+ */
+static inline eARDISCOVERY_PRODUCT ARDISCOVERY_ProductLookup_FromPathName (const char *name)
+{
+    eARDISCOVERY_PRODUCT product;
+
+    if (name == NULL)
+    {
+        return ARDISCOVERY_PRODUCT_MAX;
+    }
+
+    product = ARDISCOVERY_ProductLookup_HashCandidate (name, strlen (name));
+    return ((product != ARDISCOVERY_PRODUCT_MAX) && (strcmp (name, ARDISCOVERY_ProductLookup_GetPathName (product)) == 0)) ? product : ARDISCOVERY_PRODUCT_MAX;
+}
+
+#if defined(__cplusplus) && (__cplusplus >= 201103L)
+
+/*****************************************
+ *
+ *             constexpr accessors :
+ *
+ *****************************************/
+
+/**
+ * @brief INTERNAL TABLES : constexpr copies of the lookup tables
+ */
+static constexpr uint16_t ARDISCOVERY_ProductLookup_IDs[ARDISCOVERY_PRODUCT_MAX] = { ARDISCOVERY_PRODUCTLOOKUP_PRODUCTS (ARDISCOVERY_PRODUCTLOOKUP_ID) };
+static constexpr const char *ARDISCOVERY_ProductLookup_Names[ARDISCOVERY_PRODUCT_MAX] = { ARDISCOVERY_PRODUCTLOOKUP_PRODUCTS (ARDISCOVERY_PRODUCTLOOKUP_NAME) };
+static constexpr const char *ARDISCOVERY_ProductLookup_PathNames[ARDISCOVERY_PRODUCT_MAX] = { ARDISCOVERY_PRODUCTLOOKUP_PRODUCTS (ARDISCOVERY_PRODUCTLOOKUP_PATH_NAME) };
+static constexpr eARDISCOVERY_PRODUCT ARDISCOVERY_ProductLookup_IDTable[ARDISCOVERY_PRODUCTLOOKUP_ID_TABLE_SIZE] = ARDISCOVERY_PRODUCTLOOKUP_ID_TABLE;
+static constexpr eARDISCOVERY_PRODUCT ARDISCOVERY_ProductLookup_HashTable[ARDISCOVERY_PRODUCTLOOKUP_HASH_TABLE_SIZE] = ARDISCOVERY_PRODUCTLOOKUP_HASH_TABLE;
+
+/**
+ * @brief INTERNAL FUNCTION : constexpr strlen
+ */
+constexpr size_t ARDISCOVERY_ProductLookup_ConstLength (const char *str, size_t length = 0)
+{
+    return (str[length] == '\0') ? length : ARDISCOVERY_ProductLookup_ConstLength (str, length + 1);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : constexpr string equality
+ */
+constexpr bool ARDISCOVERY_ProductLookup_ConstEquals (const char *a, const char *b)
+{
+    return (*a != *b) ? false : ((*a == '\0') ? true : ARDISCOVERY_ProductLookup_ConstEquals (a + 1, b + 1));
+}
+
+/**
+ * @brief INTERNAL FUNCTION : constexpr perfect hash candidate
+ */
+constexpr eARDISCOVERY_PRODUCT ARDISCOVERY_ProductLookup_ConstHashCandidate (const char *name, size_t length)
+{
+    return (length == 0) ? ARDISCOVERY_PRODUCT_MAX : ARDISCOVERY_ProductLookup_HashTable[ARDISCOVERY_PRODUCTLOOKUP_HASH (length, name[0], name[length - 1])];
+}
+
+/**
+ * @brief INTERNAL FUNCTION : constexpr check of a candidate against a names table
+ */
+constexpr eARDISCOVERY_PRODUCT ARDISCOVERY_ProductLookup_ConstMatch (const char *name, eARDISCOVERY_PRODUCT product, const char *const *names)
+{
+    return ((product != ARDISCOVERY_PRODUCT_MAX) && ARDISCOVERY_ProductLookup_ConstEquals (name, names[product])) ? product : ARDISCOVERY_PRODUCT_MAX;
+}
+
+/**
+ * @brief constexpr version of ARDISCOVERY_ProductLookup_GetProductID()
+ */
+constexpr uint16_t ARDISCOVERY_ProductLookup_ConstGetProductID (eARDISCOVERY_PRODUCT product)
+{
+    return ((unsigned)product < ARDISCOVERY_PRODUCT_MAX) ? ARDISCOVERY_ProductLookup_IDs[product] : 0;
+}
+
+/**
+ * @brief constexpr version of ARDISCOVERY_ProductLookup_GetName()
+ */
+constexpr const char *ARDISCOVERY_ProductLookup_ConstGetName (eARDISCOVERY_PRODUCT product)
+{
+    return ((unsigned)product < ARDISCOVERY_PRODUCT_MAX) ? ARDISCOVERY_ProductLookup_Names[product] : "";
+}
+
+/**
+ * @brief constexpr version of ARDISCOVERY_ProductLookup_GetPathName()
+ */
+constexpr const char *ARDISCOVERY_ProductLookup_ConstGetPathName (eARDISCOVERY_PRODUCT product)
+{
+    return ((unsigned)product < ARDISCOVERY_PRODUCT_MAX) ? ARDISCOVERY_ProductLookup_PathNames[product] : "";
+}
+
+/**
+ * @brief constexpr version of ARDISCOVERY_ProductLookup_FromProductID()
+ */
+constexpr eARDISCOVERY_PRODUCT ARDISCOVERY_ProductLookup_ConstFromProductID (uint16_t productID)
+{
+    return ((uint16_t)(productID - ARDISCOVERY_PRODUCTLOOKUP_ID_BASE) < ARDISCOVERY_PRODUCTLOOKUP_ID_TABLE_SIZE) ?
+        ARDISCOVERY_ProductLookup_IDTable[(uint16_t)(productID - ARDISCOVERY_PRODUCTLOOKUP_ID_BASE)] : ARDISCOVERY_PRODUCT_MAX;
+}
+
+/**
+ * @brief constexpr version of ARDISCOVERY_ProductLookup_FromName()
+ */
+constexpr eARDISCOVERY_PRODUCT ARDISCOVERY_ProductLookup_ConstFromName (const char *name)
+{
+    return (name == nullptr) ? ARDISCOVERY_PRODUCT_MAX :
+        ARDISCOVERY_ProductLookup_ConstMatch (name, ARDISCOVERY_ProductLookup_ConstHashCandidate (name, ARDISCOVERY_ProductLookup_ConstLength (name)), ARDISCOVERY_ProductLookup_Names);
+}
+
+/**
+ * @brief constexpr version of ARDISCOVERY_ProductLookup_FromPathName()
+ */
+constexpr eARDISCOVERY_PRODUCT ARDISCOVERY_ProductLookup_ConstFromPathName (const char *name)
+{
+    return (name == nullptr) ? ARDISCOVERY_PRODUCT_MAX :
+        ARDISCOVERY_ProductLookup_ConstMatch (name, ARDISCOVERY_ProductLookup_ConstHashCandidate (name, ARDISCOVERY_ProductLookup_ConstLength (name)), ARDISCOVERY_ProductLookup_PathNames);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : constexpr check that every product round-trips through the lookup tables
+ */
+constexpr bool ARDISCOVERY_ProductLookup_ConstCheckTables (int product = 0)
+{
+    return (product >= ARDISCOVERY_PRODUCT_MAX) ? true :
+        ((ARDISCOVERY_ProductLookup_ConstFromName (ARDISCOVERY_ProductLookup_Names[product]) == product) &&
+         (ARDISCOVERY_ProductLookup_ConstFromPathName (ARDISCOVERY_ProductLookup_PathNames[product]) == product) &&
+         (ARDISCOVERY_ProductLookup_ConstFromProductID (ARDISCOVERY_ProductLookup_IDs[product]) == product) &&
+         ARDISCOVERY_ProductLookup_ConstCheckTables (product + 1));
+}
+
+static_assert (ARDISCOVERY_ProductLookup_ConstCheckTables (), "ARDISCOVERY_ProductLookup tables are out of sync with ARDISCOVERY_PRODUCTLOOKUP_PRODUCTS");
+
+#endif
+
+#endif // _ARDISCOVERY_PRODUCT_LOOKUP_H_
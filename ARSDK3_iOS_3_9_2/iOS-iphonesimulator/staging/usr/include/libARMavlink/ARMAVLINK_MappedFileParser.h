@@ -0,0 +1,651 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARMAVLINK_MappedFileParser.h
+ * @brief Memory mapped Mavlink file parser
+ * @note Parses the same QGC WPL files as ARMAVLINK_FileParser, with the same results, but maps the
+ * file instead of reading it line by line, converts the numbers in place and stores the mission
+ * items in one array sized from the line count of the file. Large survey missions load without
+ * any stdio call nor reallocation, and a parsing error reports the line where it occurred.
+ * @date 10/18/2026
+ */
+#ifndef _ARMAVLINK_MAPPED_FILE_PARSER_H
+#define _ARMAVLINK_MAPPED_FILE_PARSER_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <libARSAL/ARSAL_Allocator.h>
+#include <libARMavlink/ARMAVLINK_Error.h>
+#include <mavlink/parrot/mavlink.h>
+
+/**
+ * @brief Number of fields of a mission item line
+ */
+#define ARMAVLINK_MAPPEDFILEPARSER_ITEM_FIELDS 12
+
+/**
+ * @brief Size of the buffer used to convert the numbers which are not handled in place
+ */
+#define ARMAVLINK_MAPPEDFILEPARSER_NUMBER_SIZE 64
+
+/**
+ * @brief Memory mapped file parser
+ * @note The mission items are owned by the parser and remain valid until the next parsing or the deletion of the parser.
+ */
+typedef struct
+{
+    mavlink_mission_item_t *missionItems; /**< Mission items of the last parsed file */
+    int size; /**< Number of mission items */
+    int capacity; /**< Number of mission items which can be stored without allocation */
+    int errorLine; /**< Line (starting at 1) of the last parsing error, 0 if none */
+} ARMAVLINK_MappedFileParser_t;
+
+/**
+ * @brief INTERNAL FUNCTION : Whether a character is a blank for the scanf conversions
+ */
+static inline int ARMAVLINK_MappedFileParser_IsBlank (char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\v') || (c == '\f');
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Skip the blanks of a line
+ */
+static inline const char *ARMAVLINK_MappedFileParser_SkipBlanks (const char *cursor, const char *end)
+{
+    while ((cursor < end) && ARMAVLINK_MappedFileParser_IsBlank (*cursor))
+    {
+        cursor++;
+    }
+    return cursor;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Copy the number starting at cursor into a null terminated buffer
+ * @return The buffer to convert, either buffer or an allocated copy which must be freed, NULL on allocation error
+ */
+static inline char *ARMAVLINK_MappedFileParser_CopyNumber (const char *cursor, const char *end, char *buffer)
+{
+    const char *last = cursor;
+    char *copy = buffer;
+    size_t length = 0;
+
+    while ((last < end) && (((*last >= '0') && (*last <= '9')) || ((*last >= 'a') && (*last <= 'z')) ||
+                            ((*last >= 'A') && (*last <= 'Z')) || (*last == '.') || (*last == '+') || (*last == '-')))
+    {
+        last++;
+    }
+
+    length = (size_t)(last - cursor);
+    if (length >= ARMAVLINK_MAPPEDFILEPARSER_NUMBER_SIZE)
+    {
+        copy = (char *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, length + 1);
+    }
+
+    if (copy != NULL)
+    {
+        memcpy (copy, cursor, length);
+        copy[length] = '\0';
+    }
+
+    return copy;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Narrow a converted integer to an int, saturated like strtol saturates a long
+ */
+static inline int ARMAVLINK_MappedFileParser_NarrowInt (int64_t converted)
+{
+    if (converted > INT_MAX)
+    {
+        return INT_MAX;
+    }
+    if (converted < INT_MIN)
+    {
+        return INT_MIN;
+    }
+    return (int)converted;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Convert an integer like the %i conversion of scanf
+ * @note The integers out of the int range are saturated to INT_MIN or INT_MAX, on 32 and 64 bit systems alike.
+ * @return The first character after the integer, NULL if there is no integer at cursor
+ */
+static inline const char *ARMAVLINK_MappedFileParser_ParseInt (const char *cursor, const char *end, int *value)
+{
+    const char *digits = cursor;
+    const char *next = NULL;
+    int64_t accumulator = 0;
+    int negative = 0;
+
+    if ((digits < end) && ((*digits == '-') || (*digits == '+')))
+    {
+        negative = (*digits == '-');
+        digits++;
+    }
+
+    /* in place conversion of the decimal integers, which are the only ones written by the generators */
+    if ((digits < end) && (*digits >= '1') && (*digits <= '9'))
+    {
+        next = digits;
+        while ((next < end) && (*next >= '0') && (*next <= '9') && (next - digits < 18))
+        {
+            accumulator = (accumulator * 10) + (*next - '0');
+            next++;
+        }
+
+        if ((next == end) || (*next < '0') || (*next > '9'))
+        {
+            /* at most 18 digits, which do not overflow the 64 bits accumulator */
+            *value = ARMAVLINK_MappedFileParser_NarrowInt (negative ? -accumulator : accumulator);
+            return next;
+        }
+    }
+    else if ((digits < end) && (*digits == '0') && ((digits + 1 == end) || (digits[1] < '0') || (digits[1] > '9')) &&
+             ((digits + 1 == end) || ((digits[1] != 'x') && (digits[1] != 'X'))))
+    {
+        *value = 0;
+        return digits + 1;
+    }
+
+    /* octal, hexadecimal and out of range integers */
+    {
+        char buffer[ARMAVLINK_MAPPEDFILEPARSER_NUMBER_SIZE];
+        char *copy = ARMAVLINK_MappedFileParser_CopyNumber (cursor, end, buffer);
+        char *stop = NULL;
+        long long converted = 0;
+
+        if (copy == NULL)
+        {
+            return NULL;
+        }
+
+        converted = strtoll (copy, &stop, 0);
+        next = (stop != copy) ? cursor + (stop - copy) : NULL;
+        *value = ARMAVLINK_MappedFileParser_NarrowInt (converted);
+
+        if (copy != buffer)
+        {
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, copy);
+        }
+    }
+
+    return next;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Exact powers of ten in double precision
+ */
+static inline double ARMAVLINK_MappedFileParser_PowerOfTen (int exponent)
+{
+    static const double powers[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+    return powers[exponent];
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Convert a float like the %f conversion of scanf
+ * @note Decimal numbers of at most 15 significant digits and with a power of ten of at most 22 are
+ * converted in place : the double computed from the exact mantissa and power of ten is correctly
+ * rounded, and so is its conversion to float unless it lies exactly between two floats. The other
+ * numbers (hexadecimal, infinite, too precise or ambiguous ones) are converted by strtof().
+ * @return The first character after the float, NULL if there is no float at cursor
+ */
+static inline const char *ARMAVLINK_MappedFileParser_ParseFloat (const char *cursor, const char *end, float *value)
+{
+    const char *next = cursor;
+    uint64_t mantissa = 0;
+    int significant = 0;
+    int exponent = 0;
+    int digits = 0;
+    int negative = 0;
+    int fast = 1;
+
+    if ((next < end) && ((*next == '-') || (*next == '+')))
+    {
+        negative = (*next == '-');
+        next++;
+    }
+
+    if ((next + 1 < end) && (next[0] == '0') && ((next[1] == 'x') || (next[1] == 'X')))
+    {
+        fast = 0;
+    }
+
+    while (fast && (next < end) && (*next >= '0') && (*next <= '9'))
+    {
+        if ((mantissa != 0) || (*next != '0'))
+        {
+            mantissa = (mantissa * 10) + (uint64_t)(*next - '0');
+            significant++;
+        }
+        digits++;
+        next++;
+        fast = (significant <= 15);
+    }
+
+    if (fast && (next < end) && (*next == '.'))
+    {
+        next++;
+        while (fast && (next < end) && (*next >= '0') && (*next <= '9'))
+        {
+            if ((mantissa != 0) || (*next != '0'))
+            {
+                mantissa = (mantissa * 10) + (uint64_t)(*next - '0');
+                significant++;
+            }
+            exponent--;
+            digits++;
+            next++;
+            fast = (significant <= 15);
+        }
+    }
+
+    fast = fast && (digits > 0);
+
+    if (fast && (next < end) && ((*next == 'e') || (*next == 'E')))
+    {
+        const char *exponentCursor = next + 1;
+        int exponentNegative = 0;
+        int exponentValue = 0;
+
+        if ((exponentCursor < end) && ((*exponentCursor == '-') || (*exponentCursor == '+')))
+        {
+            exponentNegative = (*exponentCursor == '-');
+            exponentCursor++;
+        }
+
+        if ((exponentCursor < end) && (*exponentCursor >= '0') && (*exponentCursor <= '9'))
+        {
+            while ((exponentCursor < end) && (*exponentCursor >= '0') && (*exponentCursor <= '9') && (exponentValue < 1000))
+            {
+                exponentValue = (exponentValue * 10) + (*exponentCursor - '0');
+                exponentCursor++;
+            }
+            exponent += exponentNegative ? -exponentValue : exponentValue;
+            next = exponentCursor;
+        }
+    }
+
+    fast = fast && (next == end || ((*next < '0') || (*next > '9'))) && (exponent >= -22) && (exponent <= 22);
+
+    if (fast)
+    {
+        double result = (double)mantissa;
+        float rounded = 0.0f;
+
+        result = (exponent < 0) ? result / ARMAVLINK_MappedFileParser_PowerOfTen (-exponent) : result * ARMAVLINK_MappedFileParser_PowerOfTen (exponent);
+        rounded = (float)result;
+
+        if (((double)rounded == result) ||
+            (((double)rounded + (double)nextafterf (rounded, (result > (double)rounded) ? HUGE_VALF : -HUGE_VALF)) / 2.0 != result))
+        {
+            *value = negative ? -rounded : rounded;
+            return next;
+        }
+    }
+
+    {
+        char buffer[ARMAVLINK_MAPPEDFILEPARSER_NUMBER_SIZE];
+        char *copy = ARMAVLINK_MappedFileParser_CopyNumber (cursor, end, buffer);
+        char *stop = NULL;
+
+        if (copy == NULL)
+        {
+            return NULL;
+        }
+
+        *value = strtof (copy, &stop);
+        next = (stop != copy) ? cursor + (stop - copy) : NULL;
+
+        if (copy != buffer)
+        {
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, copy);
+        }
+    }
+
+    return next;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Parse a mission item line
+ * @return 1 if the line holds the 12 fields of a mission item, 0 otherwise
+ */
+static inline int ARMAVLINK_MappedFileParser_ParseItem (const char *cursor, const char *end, mavlink_mission_item_t *missionItem)
+{
+    int integers[5] = {0};
+    float floats[7] = {0};
+    int field = 0;
+
+    for (field = 0; (cursor != NULL) && (field < ARMAVLINK_MAPPEDFILEPARSER_ITEM_FIELDS); field++)
+    {
+        cursor = ARMAVLINK_MappedFileParser_SkipBlanks (cursor, end);
+        if (cursor == end)
+        {
+            cursor = NULL;
+        }
+        else if (field < 4)
+        {
+            cursor = ARMAVLINK_MappedFileParser_ParseInt (cursor, end, &integers[field]);
+        }
+        else if (field < 11)
+        {
+            cursor = ARMAVLINK_MappedFileParser_ParseFloat (cursor, end, &floats[field - 4]);
+        }
+        else
+        {
+            cursor = ARMAVLINK_MappedFileParser_ParseInt (cursor, end, &integers[4]);
+        }
+    }
+
+    if (cursor == NULL)
+    {
+        return 0;
+    }
+
+    /* same filling as ARMAVLINK_MissionItemUtils_CreateMavlinkMissionItemWithAllParams() */
+    missionItem->param1 = floats[0];
+    missionItem->param2 = floats[1];
+    missionItem->param3 = floats[2];
+    missionItem->param4 = floats[3];
+    missionItem->x = floats[4];
+    missionItem->y = floats[5];
+    missionItem->z = floats[6];
+    missionItem->seq = (uint16_t)integers[0];
+    missionItem->command = (uint16_t)integers[3];
+    missionItem->target_system = 1;
+    missionItem->target_component = 1;
+    missionItem->frame = (uint8_t)integers[2];
+    missionItem->current = (uint8_t)integers[1];
+    missionItem->autocontinue = (uint8_t)integers[4];
+
+    return 1;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Check that the header line holds at least three words (QGC WPL <version>)
+ */
+static inline int ARMAVLINK_MappedFileParser_CheckHeader (const char *cursor, const char *end)
+{
+    int words = 0;
+
+    while (words < 3)
+    {
+        cursor = ARMAVLINK_MappedFileParser_SkipBlanks (cursor, end);
+        if (cursor == end)
+        {
+            return 0;
+        }
+        while ((cursor < end) && !ARMAVLINK_MappedFileParser_IsBlank (*cursor))
+        {
+            cursor++;
+        }
+        words++;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Create a new memory mapped file parser
+ * @warning This function allocates memory
+ * @post ARMAVLINK_MappedFileParser_Delete() must be called to delete the file parser and free the memory allocated.
+ * @param[out] error : pointer on the error output.
+ * @return Pointer on the new file parser
+ * @see ARMAVLINK_MappedFileParser_Delete()
+ */
+static inline ARMAVLINK_MappedFileParser_t *ARMAVLINK_MappedFileParser_New (eARMAVLINK_ERROR *error)
+{
+    eARMAVLINK_ERROR localError = ARMAVLINK_OK;
+    ARMAVLINK_MappedFileParser_t *fileParser = (ARMAVLINK_MappedFileParser_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, 1, sizeof (ARMAVLINK_MappedFileParser_t));
+
+    if (fileParser == NULL)
+    {
+        localError = ARMAVLINK_ERROR_ALLOC;
+    }
+
+    if (error != NULL)
+    {
+        *error = localError;
+    }
+
+    return fileParser;
+}
+
+/**
+ * @brief Delete the memory mapped file parser and its mission items
+ * @warning This function frees memory
+ * @param fileParser : address of the pointer on the file parser
+ * @see ARMAVLINK_MappedFileParser_New()
+ */
+static inline void ARMAVLINK_MappedFileParser_Delete (ARMAVLINK_MappedFileParser_t **fileParser)
+{
+    if ((fileParser != NULL) && (*fileParser != NULL))
+    {
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (*fileParser)->missionItems);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, *fileParser);
+        *fileParser = NULL;
+    }
+}
+
+/**
+ * @brief Parse Mavlink file content held in memory
+ * @note The content does not need to be null terminated. On error, the mission items parsed before
+ * the faulty line are kept and ARMAVLINK_MappedFileParser_GetErrorLine() returns the faulty line.
+ * @param fileParser : pointer on the file parser
+ * @param[in] data : the content to parse
+ * @param[in] size : the size of the content
+ * @return ARMAVLINK_OK if parsing went well, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MappedFileParser_ParseBuffer (ARMAVLINK_MappedFileParser_t *fileParser, const char *data, size_t size)
+{
+    const char *cursor = data;
+    const char *end = data + size;
+    const char *lineEnd = NULL;
+    size_t lines = 1;
+    int line = 1;
+
+    if ((fileParser == NULL) || ((data == NULL) && (size != 0)))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    fileParser->size = 0;
+    fileParser->errorLine = 0;
+
+    if (size == 0)
+    {
+        return ARMAVLINK_OK;
+    }
+
+    /* the header line does not hold any mission item */
+    for (lineEnd = (const char *)memchr (cursor, '\n', size); lineEnd != NULL; lineEnd = (const char *)memchr (lineEnd + 1, '\n', (size_t)(end - lineEnd - 1)))
+    {
+        lines++;
+    }
+
+    if (lines > (size_t)fileParser->capacity)
+    {
+        mavlink_mission_item_t *missionItems = NULL;
+
+        if (lines > (size_t)INT_MAX / sizeof (mavlink_mission_item_t))
+        {
+            return ARMAVLINK_ERROR_ALLOC;
+        }
+
+        missionItems = (mavlink_mission_item_t *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, lines * sizeof (mavlink_mission_item_t));
+        if (missionItems == NULL)
+        {
+            return ARMAVLINK_ERROR_ALLOC;
+        }
+
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, fileParser->missionItems);
+        fileParser->missionItems = missionItems;
+        fileParser->capacity = (int)lines;
+    }
+
+    lineEnd = (const char *)memchr (cursor, '\n', size);
+    if (lineEnd == NULL)
+    {
+        lineEnd = end;
+    }
+
+    if (!ARMAVLINK_MappedFileParser_CheckHeader (cursor, lineEnd))
+    {
+        fileParser->errorLine = line;
+        return ARMAVLINK_ERROR_FILE_PARSER_WORD_NOT_EXPTECTED;
+    }
+
+    while (lineEnd < end)
+    {
+        cursor = lineEnd + 1;
+        line++;
+
+        if (cursor == end)
+        {
+            break;
+        }
+
+        lineEnd = (const char *)memchr (cursor, '\n', (size_t)(end - cursor));
+        if (lineEnd == NULL)
+        {
+            lineEnd = end;
+        }
+
+        if (!ARMAVLINK_MappedFileParser_ParseItem (cursor, lineEnd, &fileParser->missionItems[fileParser->size]))
+        {
+            fileParser->errorLine = line;
+            return ARMAVLINK_ERROR_FILE_PARSER_WORD_NOT_EXPTECTED;
+        }
+
+        fileParser->size++;
+    }
+
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief Parse a Mavlink file
+ * @note The file is mapped in memory for the time of the parsing.
+ * @param fileParser : pointer on the file parser
+ * @param[in] filePath : the path of the file to parse
+ * @return ARMAVLINK_OK if parsing went well, the enum description of the error otherwise
+ * @see ARMAVLINK_MappedFileParser_ParseBuffer()
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MappedFileParser_Parse (ARMAVLINK_MappedFileParser_t *fileParser, const char *const filePath)
+{
+    eARMAVLINK_ERROR error = ARMAVLINK_OK;
+    struct stat status;
+    void *data = NULL;
+    int fd = -1;
+
+    if ((fileParser == NULL) || (filePath == NULL))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    fd = open (filePath, O_RDONLY);
+    if (fd < 0)
+    {
+        return ARMAVLINK_ERROR_FILE_PARSER_FILE_NOT_FOUND;
+    }
+
+    if ((fstat (fd, &status) != 0) || (status.st_size < 0) || ((off_t)(size_t)status.st_size != status.st_size))
+    {
+        error = ARMAVLINK_ERROR_FILE_PARSER;
+    }
+    else if (status.st_size == 0)
+    {
+        error = ARMAVLINK_MappedFileParser_ParseBuffer (fileParser, NULL, 0);
+    }
+    else
+    {
+        data = mmap (NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            error = ARMAVLINK_ERROR_FILE_PARSER;
+        }
+        else
+        {
+            madvise (data, (size_t)status.st_size, MADV_SEQUENTIAL);
+            error = ARMAVLINK_MappedFileParser_ParseBuffer (fileParser, (const char *)data, (size_t)status.st_size);
+            munmap (data, (size_t)status.st_size);
+        }
+    }
+
+    close (fd);
+
+    return error;
+}
+
+/**
+ * @brief Get the number of mission items of the last parsing
+ * @param fileParser : pointer on the file parser
+ * @return the number of mission items
+ */
+static inline int ARMAVLINK_MappedFileParser_GetSize (const ARMAVLINK_MappedFileParser_t *fileParser)
+{
+    return (fileParser != NULL) ? fileParser->size : 0;
+}
+
+/**
+ * @brief Get a mission item of the last parsing according to its index
+ * @param fileParser : pointer on the file parser
+ * @param[in] index : the index of the mission item to return
+ * @return a pointer on the mission item if it exists, otherwise NULL
+ */
+static inline mavlink_mission_item_t *ARMAVLINK_MappedFileParser_Get (const ARMAVLINK_MappedFileParser_t *fileParser, int index)
+{
+    return ((fileParser != NULL) && (index >= 0) && (index < fileParser->size)) ? &fileParser->missionItems[index] : NULL;
+}
+
+/**
+ * @brief Get the line of the last parsing error
+ * @param fileParser : pointer on the file parser
+ * @return the line (starting at 1) where the last parsing failed, 0 if it succeeded
+ */
+static inline int ARMAVLINK_MappedFileParser_GetErrorLine (const ARMAVLINK_MappedFileParser_t *fileParser)
+{
+    return (fileParser != NULL) ? fileParser->errorLine : 0;
+}
+
+#endif
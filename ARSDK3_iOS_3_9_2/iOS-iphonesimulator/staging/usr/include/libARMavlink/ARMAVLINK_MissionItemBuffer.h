@@ -0,0 +1,388 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARMAVLINK_MissionItemBuffer.h
+ * @brief Editable mission item buffer
+ * @note The mission items are stored in one contiguous array holding a gap at the edit point :
+ * indexed access is O(1) and inserting or deleting near the previous edit only moves the items
+ * between the two edit points. Sequence numbers are not maintained while editing, they are
+ * rewritten when the mission is exported.
+ * @date 10/18/2026
+ */
+#ifndef _ARMAVLINK_MISSION_ITEM_BUFFER_H
+#define _ARMAVLINK_MISSION_ITEM_BUFFER_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <libARSAL/ARSAL_Allocator.h>
+#include <libARMavlink/ARMAVLINK_Error.h>
+#include <libARMavlink/ARMAVLINK_FileGenerator.h>
+#include <mavlink/parrot/mavlink.h>
+
+/**
+ * @brief Minimum capacity of a mission item buffer
+ */
+#define ARMAVLINK_MISSIONITEMBUFFER_MIN_CAPACITY 32
+
+/**
+ * @brief Mission item buffer
+ * @note The items [0, gapStart[ and [gapEnd, capacity[ of missionItems are the mission, in order.
+ */
+typedef struct
+{
+    mavlink_mission_item_t *missionItems; /**< Storage of the mission items, including the gap */
+    int capacity; /**< Number of mission items of the storage */
+    int gapStart; /**< Index of the first free mission item of the storage */
+    int gapEnd; /**< Index of the first mission item after the gap */
+} ARMAVLINK_MissionItemBuffer_t;
+
+/**
+ * @brief INTERNAL FUNCTION : Move the gap so that it starts at index
+ */
+static inline void ARMAVLINK_MissionItemBuffer_MoveGap (ARMAVLINK_MissionItemBuffer_t *buffer, int index)
+{
+    int gapSize = buffer->gapEnd - buffer->gapStart;
+
+    if (index < buffer->gapStart)
+    {
+        memmove (&buffer->missionItems[index + gapSize], &buffer->missionItems[index], (size_t)(buffer->gapStart - index) * sizeof (mavlink_mission_item_t));
+    }
+    else if (index > buffer->gapStart)
+    {
+        memmove (&buffer->missionItems[buffer->gapStart], &buffer->missionItems[buffer->gapEnd], (size_t)(index - buffer->gapStart) * sizeof (mavlink_mission_item_t));
+    }
+
+    buffer->gapStart = index;
+    buffer->gapEnd = index + gapSize;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Make the gap large enough to hold count mission items
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MissionItemBuffer_Reserve (ARMAVLINK_MissionItemBuffer_t *buffer, int count)
+{
+    mavlink_mission_item_t *missionItems = NULL;
+    int tailSize = buffer->capacity - buffer->gapEnd;
+    int size = buffer->capacity - (buffer->gapEnd - buffer->gapStart);
+    int capacity = buffer->capacity;
+
+    if (buffer->gapEnd - buffer->gapStart >= count)
+    {
+        return ARMAVLINK_OK;
+    }
+
+    if (count > INT_MAX - size)
+    {
+        return ARMAVLINK_ERROR_ALLOC;
+    }
+
+    /* grows geometrically so that appending one item at a time is amortized O(1) */
+    capacity = (capacity < ARMAVLINK_MISSIONITEMBUFFER_MIN_CAPACITY) ? ARMAVLINK_MISSIONITEMBUFFER_MIN_CAPACITY : capacity;
+    while (capacity < size + count)
+    {
+        capacity = (capacity > INT_MAX / 2) ? INT_MAX : capacity * 2;
+    }
+
+    missionItems = (mavlink_mission_item_t *)ARSAL_Allocator_Realloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, buffer->missionItems, (size_t)capacity * sizeof (mavlink_mission_item_t));
+    if (missionItems == NULL)
+    {
+        return ARMAVLINK_ERROR_ALLOC;
+    }
+
+    memmove (&missionItems[capacity - tailSize], &missionItems[buffer->gapEnd], (size_t)tailSize * sizeof (mavlink_mission_item_t));
+
+    buffer->missionItems = missionItems;
+    buffer->gapEnd = capacity - tailSize;
+    buffer->capacity = capacity;
+
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief Create a new mission item buffer
+ * @warning This function allocates memory
+ * @post ARMAVLINK_MissionItemBuffer_Delete() must be called to delete the buffer and free the memory allocated.
+ * @param[in] capacity : number of mission items to allocate first
+ * @param[out] error : pointer on the error output.
+ * @return Pointer on the new buffer
+ * @see ARMAVLINK_MissionItemBuffer_Delete()
+ */
+static inline ARMAVLINK_MissionItemBuffer_t *ARMAVLINK_MissionItemBuffer_New (int capacity, eARMAVLINK_ERROR *error)
+{
+    eARMAVLINK_ERROR localError = ARMAVLINK_OK;
+    ARMAVLINK_MissionItemBuffer_t *buffer = (ARMAVLINK_MissionItemBuffer_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, 1, sizeof (ARMAVLINK_MissionItemBuffer_t));
+
+    if (buffer == NULL)
+    {
+        localError = ARMAVLINK_ERROR_ALLOC;
+    }
+    else if ((capacity > 0) && (ARMAVLINK_MissionItemBuffer_Reserve (buffer, capacity) != ARMAVLINK_OK))
+    {
+        localError = ARMAVLINK_ERROR_ALLOC;
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, buffer);
+        buffer = NULL;
+    }
+
+    if (error != NULL)
+    {
+        *error = localError;
+    }
+
+    return buffer;
+}
+
+/**
+ * @brief Delete the mission item buffer
+ * @warning This function frees memory
+ * @param buffer : address of the pointer on the buffer
+ * @see ARMAVLINK_MissionItemBuffer_New()
+ */
+static inline void ARMAVLINK_MissionItemBuffer_Delete (ARMAVLINK_MissionItemBuffer_t **buffer)
+{
+    if ((buffer != NULL) && (*buffer != NULL))
+    {
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, (*buffer)->missionItems);
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARMAVLINK, *buffer);
+        *buffer = NULL;
+    }
+}
+
+/**
+ * @brief Get the number of mission items of the buffer
+ * @param buffer : pointer on the buffer
+ * @return the number of mission items
+ */
+static inline int ARMAVLINK_MissionItemBuffer_GetSize (const ARMAVLINK_MissionItemBuffer_t *buffer)
+{
+    return (buffer != NULL) ? buffer->capacity - (buffer->gapEnd - buffer->gapStart) : 0;
+}
+
+/**
+ * @brief Get a mission item of the buffer according to its index
+ * @note The pointer is valid until the next modification of the buffer. The seq field of the mission item is not meaningful before export.
+ * @param buffer : pointer on the buffer
+ * @param[in] index : the index of the mission item to return
+ * @return a pointer on the mission item if it exists, otherwise NULL
+ */
+static inline mavlink_mission_item_t *ARMAVLINK_MissionItemBuffer_Get (const ARMAVLINK_MissionItemBuffer_t *buffer, int index)
+{
+    if ((index < 0) || (index >= ARMAVLINK_MissionItemBuffer_GetSize (buffer)))
+    {
+        return NULL;
+    }
+
+    return &buffer->missionItems[(index < buffer->gapStart) ? index : index + (buffer->gapEnd - buffer->gapStart)];
+}
+
+/**
+ * @brief Replace a range of mission items by other mission items
+ * @note This is the operation all the edits are made of : it moves the gap to index, which costs the
+ * number of items between index and the previous edit point, then drops the removed items into
+ * the gap and copies the new ones.
+ * @param buffer : pointer on the buffer
+ * @param[in] index : index of the first mission item to replace
+ * @param[in] removeCount : number of mission items to remove from index
+ * @param[in] missionItems : the mission items to insert at index ; must not point into the buffer. Can be NULL if count is 0
+ * @param[in] count : number of mission items to insert
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MissionItemBuffer_ReplaceRange (ARMAVLINK_MissionItemBuffer_t *buffer, int index, int removeCount, const mavlink_mission_item_t *missionItems, int count)
+{
+    eARMAVLINK_ERROR error = ARMAVLINK_OK;
+    int size = ARMAVLINK_MissionItemBuffer_GetSize (buffer);
+
+    if ((buffer == NULL) || (index < 0) || (removeCount < 0) || (count < 0) || (index > size) ||
+        (removeCount > size - index) || ((missionItems == NULL) && (count > 0)))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    ARMAVLINK_MissionItemBuffer_MoveGap (buffer, index);
+    buffer->gapEnd += removeCount;
+
+    error = ARMAVLINK_MissionItemBuffer_Reserve (buffer, count);
+    if (error != ARMAVLINK_OK)
+    {
+        buffer->gapEnd -= removeCount;
+        return error;
+    }
+
+    if (count > 0)
+    {
+        memcpy (&buffer->missionItems[buffer->gapStart], missionItems, (size_t)count * sizeof (mavlink_mission_item_t));
+        buffer->gapStart += count;
+    }
+
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief Append mission items at the end of the buffer
+ * @param buffer : pointer on the buffer
+ * @param[in] missionItems : the mission items to append, for example the ones of an ARMAVLINK_MappedFileParser_t
+ * @param[in] count : number of mission items to append
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MissionItemBuffer_Append (ARMAVLINK_MissionItemBuffer_t *buffer, const mavlink_mission_item_t *missionItems, int count)
+{
+    return ARMAVLINK_MissionItemBuffer_ReplaceRange (buffer, ARMAVLINK_MissionItemBuffer_GetSize (buffer), 0, missionItems, count);
+}
+
+/**
+ * @brief Insert a mission item in the buffer
+ * @param buffer : pointer on the buffer
+ * @param[in] missionItem : the mission item to insert
+ * @param[in] index : the index where the mission item is inserted
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MissionItemBuffer_InsertMissionItem (ARMAVLINK_MissionItemBuffer_t *buffer, const mavlink_mission_item_t *missionItem, int index)
+{
+    if (missionItem == NULL)
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    return ARMAVLINK_MissionItemBuffer_ReplaceRange (buffer, index, 0, missionItem, 1);
+}
+
+/**
+ * @brief Delete a mission item of the buffer
+ * @param buffer : pointer on the buffer
+ * @param[in] index : the index of the mission item to delete
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MissionItemBuffer_DeleteMissionItem (ARMAVLINK_MissionItemBuffer_t *buffer, int index)
+{
+    return ARMAVLINK_MissionItemBuffer_ReplaceRange (buffer, index, 1, NULL, 0);
+}
+
+/**
+ * @brief Replace a mission item of the buffer
+ * @note The gap is not moved, the mission item is overwritten in place.
+ * @param buffer : pointer on the buffer
+ * @param[in] missionItem : the mission item to replace with
+ * @param[in] index : the index of the mission item to replace
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MissionItemBuffer_ReplaceMissionItem (ARMAVLINK_MissionItemBuffer_t *buffer, const mavlink_mission_item_t *missionItem, int index)
+{
+    mavlink_mission_item_t *target = ARMAVLINK_MissionItemBuffer_Get (buffer, index);
+
+    if ((target == NULL) || (missionItem == NULL))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    *target = *missionItem;
+    return ARMAVLINK_OK;
+}
+
+/**
+ * @brief Remove all the mission items of the buffer, keeping its memory
+ * @param buffer : pointer on the buffer
+ */
+static inline void ARMAVLINK_MissionItemBuffer_Clear (ARMAVLINK_MissionItemBuffer_t *buffer)
+{
+    if (buffer != NULL)
+    {
+        buffer->gapStart = 0;
+        buffer->gapEnd = buffer->capacity;
+    }
+}
+
+/**
+ * @brief Copy the mission items of the buffer in order, numbering their sequences from 0
+ * @param buffer : pointer on the buffer
+ * @param[out] missionItems : the array receiving the mission items
+ * @param[in] count : the number of mission items the array can hold
+ * @return the number of mission items copied, ARMAVLINK_ERROR_BAD_PARAMETER if buffer or missionItems is NULL
+ */
+static inline int ARMAVLINK_MissionItemBuffer_Export (const ARMAVLINK_MissionItemBuffer_t *buffer, mavlink_mission_item_t *missionItems, int count)
+{
+    int size = 0;
+    int head = 0;
+    int index = 0;
+
+    if ((buffer == NULL) || (missionItems == NULL))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    if (count <= 0)
+    {
+        return 0;
+    }
+
+    size = ARMAVLINK_MissionItemBuffer_GetSize (buffer);
+
+    size = (size < count) ? size : count;
+    head = (size < buffer->gapStart) ? size : buffer->gapStart;
+
+    memcpy (missionItems, buffer->missionItems, (size_t)head * sizeof (mavlink_mission_item_t));
+    memcpy (&missionItems[head], &buffer->missionItems[buffer->gapEnd], (size_t)(size - head) * sizeof (mavlink_mission_item_t));
+
+    for (index = 0; index < size; index++)
+    {
+        missionItems[index].seq = (uint16_t)index;
+    }
+
+    return size;
+}
+
+/**
+ * @brief Add the mission items of the buffer in order to a file generator
+ * @note The file generator numbers the sequences of the mission items it adds.
+ * @param buffer : pointer on the buffer
+ * @param fileGenerator : pointer on the file generator
+ * @return ARMAVLINK_OK if operation went well, the enum description of the error otherwise
+ * @see ARMAVLINK_FileGenerator_CreateMavlinkFile()
+ */
+static inline eARMAVLINK_ERROR ARMAVLINK_MissionItemBuffer_ExportToFileGenerator (const ARMAVLINK_MissionItemBuffer_t *buffer, ARMAVLINK_FileGenerator_t *fileGenerator)
+{
+    eARMAVLINK_ERROR error = ARMAVLINK_OK;
+    int size = ARMAVLINK_MissionItemBuffer_GetSize (buffer);
+    int index = 0;
+
+    if ((buffer == NULL) || (fileGenerator == NULL))
+    {
+        return ARMAVLINK_ERROR_BAD_PARAMETER;
+    }
+
+    for (index = 0; (error == ARMAVLINK_OK) && (index < size); index++)
+    {
+        error = ARMAVLINK_FileGenerator_AddMissionItem (fileGenerator, ARMAVLINK_MissionItemBuffer_Get (buffer, index));
+    }
+
+    return error;
+}
+
+#endif
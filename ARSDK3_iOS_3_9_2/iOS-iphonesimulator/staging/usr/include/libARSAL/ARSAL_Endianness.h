@@ -539,4 +539,309 @@ static inline double ARSAL_Endianness_bswapd (double orig)
 
 #endif // __APPLE__
 
+/*
+ * BULK CONVERSIONS
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 1 when the host has the device endianness, so that the bulk conversions are copies
+ */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+# if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) == (__DEVICE_ENDIAN == __LITTLE_ENDIAN)
+#  define ARSAL_ENDIANNESS_HOST_IS_DEVICE 1
+# else
+#  define ARSAL_ENDIANNESS_HOST_IS_DEVICE 0
+# endif
+#elif defined(__BYTE_ORDER) && (__BYTE_ORDER == __DEVICE_ENDIAN)
+# define ARSAL_ENDIANNESS_HOST_IS_DEVICE 1
+#else
+# define ARSAL_ENDIANNESS_HOST_IS_DEVICE 0
+#endif
+
+/*
+ * The vector kernels are NEON on ARM (always present on arm64), SSSE3 or AVX2 on x86, chosen at run time.
+ * Define ARSAL_ENDIANNESS_NO_SIMD to build the scalar loop only.
+ */
+#if !defined(ARSAL_ENDIANNESS_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+# include <arm_neon.h>
+# define ARSAL_ENDIANNESS_NEON 1
+#elif !defined(ARSAL_ENDIANNESS_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+# include <immintrin.h>
+# define ARSAL_ENDIANNESS_X86 1
+#endif
+
+/**
+ * @brief Vector kernel used by the bulk conversions
+ */
+typedef enum
+{
+    ARSAL_ENDIANNESS_KERNEL_SCALAR = 0, /**< Scalar loop */
+    ARSAL_ENDIANNESS_KERNEL_NEON, /**< ARM NEON, 16 bytes per step */
+    ARSAL_ENDIANNESS_KERNEL_SSSE3, /**< x86 SSSE3, 16 bytes per step */
+    ARSAL_ENDIANNESS_KERNEL_AVX2, /**< x86 AVX2, 32 bytes per step */
+} eARSAL_ENDIANNESS_KERNEL;
+
+/**
+ * @brief Get the vector kernel of the running processor
+ * @return The kernel used by ARSAL_Endianness_SwapArray16() and the others
+ */
+static inline eARSAL_ENDIANNESS_KERNEL ARSAL_Endianness_GetKernel (void)
+{
+#if defined(ARSAL_ENDIANNESS_NEON)
+    return ARSAL_ENDIANNESS_KERNEL_NEON;
+#elif defined(ARSAL_ENDIANNESS_X86)
+    static int kernel = -1;
+    if (kernel < 0)
+    {
+        __builtin_cpu_init ();
+        kernel = __builtin_cpu_supports ("avx2") ? ARSAL_ENDIANNESS_KERNEL_AVX2 :
+                 __builtin_cpu_supports ("ssse3") ? ARSAL_ENDIANNESS_KERNEL_SSSE3 : ARSAL_ENDIANNESS_KERNEL_SCALAR;
+    }
+    return (eARSAL_ENDIANNESS_KERNEL)kernel;
+#else
+    return ARSAL_ENDIANNESS_KERNEL_SCALAR;
+#endif
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Swap the tail of an array, element by element
+ * @param dst Destination, may be src
+ * @param src Source
+ * @param count Number of elements
+ * @param width Size of an element : 2, 4 or 8
+ */
+static inline void ARSAL_Endianness_SwapScalar (uint8_t *dst, const uint8_t *src, size_t count, size_t width)
+{
+    size_t index = 0;
+
+    for (index = 0; index < count; index++, src += width, dst += width)
+    {
+        if (width == 2)
+        {
+            uint16_t value;
+            memcpy (&value, src, 2);
+            value = __builtin_bswap16 (value);
+            memcpy (dst, &value, 2);
+        }
+        else if (width == 4)
+        {
+            uint32_t value;
+            memcpy (&value, src, 4);
+            value = __builtin_bswap32 (value);
+            memcpy (dst, &value, 4);
+        }
+        else
+        {
+            uint64_t value;
+            memcpy (&value, src, 8);
+            value = __builtin_bswap64 (value);
+            memcpy (dst, &value, 8);
+        }
+    }
+}
+
+#if defined(ARSAL_ENDIANNESS_X86)
+/**
+ * @brief INTERNAL FUNCTION : Byte shuffle of each element width, for 16 bytes
+ */
+static inline const uint8_t *ARSAL_Endianness_ShuffleMask (size_t width)
+{
+    static const uint8_t masks[3][16] = {
+        { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 },
+        { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+        { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 },
+    };
+    return masks[(width == 2) ? 0 : (width == 4) ? 1 : 2];
+}
+
+/**
+ * @brief INTERNAL FUNCTION : SSSE3 kernel
+ * @return The number of elements swapped
+ */
+__attribute__ ((target ("ssse3")))
+static inline size_t ARSAL_Endianness_SwapSSSE3 (uint8_t *dst, const uint8_t *src, size_t count, size_t width)
+{
+    const __m128i mask = _mm_loadu_si128 ((const __m128i *)ARSAL_Endianness_ShuffleMask (width));
+    size_t bytes = (count * width) & ~(size_t)15;
+    size_t offset = 0;
+
+    for (offset = 0; offset < bytes; offset += 16)
+    {
+        __m128i value = _mm_loadu_si128 ((const __m128i *)(src + offset));
+        _mm_storeu_si128 ((__m128i *)(dst + offset), _mm_shuffle_epi8 (value, mask));
+    }
+
+    return bytes / width;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : AVX2 kernel, two vectors per step
+ * @return The number of elements swapped
+ */
+__attribute__ ((target ("avx2")))
+static inline size_t ARSAL_Endianness_SwapAVX2 (uint8_t *dst, const uint8_t *src, size_t count, size_t width)
+{
+    const __m256i mask = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *)ARSAL_Endianness_ShuffleMask (width)));
+    size_t bytes = (count * width) & ~(size_t)63;
+    size_t offset = 0;
+
+    for (offset = 0; offset < bytes; offset += 64)
+    {
+        __m256i first = _mm256_loadu_si256 ((const __m256i *)(src + offset));
+        __m256i second = _mm256_loadu_si256 ((const __m256i *)(src + offset + 32));
+        _mm256_storeu_si256 ((__m256i *)(dst + offset), _mm256_shuffle_epi8 (first, mask));
+        _mm256_storeu_si256 ((__m256i *)(dst + offset + 32), _mm256_shuffle_epi8 (second, mask));
+    }
+
+    return bytes / width;
+}
+#endif
+
+#if defined(ARSAL_ENDIANNESS_NEON)
+/**
+ * @brief INTERNAL FUNCTION : NEON kernel, two vectors per step
+ * @return The number of elements swapped
+ */
+static inline size_t ARSAL_Endianness_SwapNEON (uint8_t *dst, const uint8_t *src, size_t count, size_t width)
+{
+    size_t bytes = (count * width) & ~(size_t)31;
+    size_t offset = 0;
+
+    for (offset = 0; offset < bytes; offset += 32)
+    {
+        uint8x16_t first = vld1q_u8 (src + offset);
+        uint8x16_t second = vld1q_u8 (src + offset + 16);
+        if (width == 2)
+        {
+            first = vrev16q_u8 (first);
+            second = vrev16q_u8 (second);
+        }
+        else if (width == 4)
+        {
+            first = vrev32q_u8 (first);
+            second = vrev32q_u8 (second);
+        }
+        else
+        {
+            first = vrev64q_u8 (first);
+            second = vrev64q_u8 (second);
+        }
+        vst1q_u8 (dst + offset, first);
+        vst1q_u8 (dst + offset + 16, second);
+    }
+
+    return bytes / width;
+}
+#endif
+
+/**
+ * @brief INTERNAL FUNCTION : Swap the byte order of each element of an array
+ * @param dst Destination, equal to src for an in place conversion ; other overlaps are not supported
+ * @param src Source
+ * @param count Number of elements
+ * @param width Size of an element : 2, 4 or 8
+ */
+static inline void ARSAL_Endianness_SwapArray (void *dst, const void *src, size_t count, size_t width)
+{
+    uint8_t *out = (uint8_t *)dst;
+    const uint8_t *in = (const uint8_t *)src;
+    size_t done = 0;
+
+#if defined(ARSAL_ENDIANNESS_NEON)
+    done = ARSAL_Endianness_SwapNEON (out, in, count, width);
+#elif defined(ARSAL_ENDIANNESS_X86)
+    switch (ARSAL_Endianness_GetKernel ())
+    {
+    case ARSAL_ENDIANNESS_KERNEL_AVX2:
+        done = ARSAL_Endianness_SwapAVX2 (out, in, count, width);
+        /* the remaining 16 bytes blocks go through SSSE3, which AVX2 implies */
+        done += ARSAL_Endianness_SwapSSSE3 (out + done * width, in + done * width, count - done, width);
+        break;
+    case ARSAL_ENDIANNESS_KERNEL_SSSE3:
+        done = ARSAL_Endianness_SwapSSSE3 (out, in, count, width);
+        break;
+    default:
+        break;
+    }
+#endif
+
+    ARSAL_Endianness_SwapScalar (out + done * width, in + done * width, count - done, width);
+}
+
+/**
+ * @brief Swap the byte order of an array of short ints (2 bytes)
+ * @param dst Destination array, equal to src for an in place conversion ; other overlaps are not supported
+ * @param src Source array ; the arrays do not need to be aligned
+ * @param count Number of elements
+ */
+static inline void ARSAL_Endianness_SwapArray16 (void *dst, const void *src, size_t count)
+{
+    ARSAL_Endianness_SwapArray (dst, src, count, 2);
+}
+
+/**
+ * @brief Swap the byte order of an array of long ints or IEEE-754 floats (4 bytes)
+ * @param dst Destination array, equal to src for an in place conversion ; other overlaps are not supported
+ * @param src Source array ; the arrays do not need to be aligned
+ * @param count Number of elements
+ */
+static inline void ARSAL_Endianness_SwapArray32 (void *dst, const void *src, size_t count)
+{
+    ARSAL_Endianness_SwapArray (dst, src, count, 4);
+}
+
+/**
+ * @brief Swap the byte order of an array of long long ints or IEEE-754 doubles (8 bytes)
+ * @param dst Destination array, equal to src for an in place conversion ; other overlaps are not supported
+ * @param src Source array ; the arrays do not need to be aligned
+ * @param count Number of elements
+ */
+static inline void ARSAL_Endianness_SwapArray64 (void *dst, const void *src, size_t count)
+{
+    ARSAL_Endianness_SwapArray (dst, src, count, 8);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Convert an array between host and device endianness
+ */
+static inline void ARSAL_Endianness_ConvertArray (void *dst, const void *src, size_t count, size_t width)
+{
+#if ARSAL_ENDIANNESS_HOST_IS_DEVICE
+    if (dst != src)
+    {
+        memmove (dst, src, count * width);
+    }
+#else
+    ARSAL_Endianness_SwapArray (dst, src, count, width);
+#endif
+}
+
+/**
+ * @brief Convert an array of short ints (2 bytes) to device endianness, in place when dst == src
+ */
+#define htodsArray(dst, src, count) ARSAL_Endianness_ConvertArray ((dst), (src), (count), 2)
+/**
+ * @brief Convert an array of long ints or IEEE-754 floats (4 bytes) to device endianness, in place when dst == src
+ */
+#define htodlArray(dst, src, count) ARSAL_Endianness_ConvertArray ((dst), (src), (count), 4)
+/**
+ * @brief Convert an array of long long ints or IEEE-754 doubles (8 bytes) to device endianness, in place when dst == src
+ */
+#define htodllArray(dst, src, count) ARSAL_Endianness_ConvertArray ((dst), (src), (count), 8)
+/**
+ * @brief Convert an array of short ints (2 bytes) from device endianness, in place when dst == src
+ */
+#define dtohsArray(dst, src, count) ARSAL_Endianness_ConvertArray ((dst), (src), (count), 2)
+/**
+ * @brief Convert an array of long ints or IEEE-754 floats (4 bytes) from device endianness, in place when dst == src
+ */
+#define dtohlArray(dst, src, count) ARSAL_Endianness_ConvertArray ((dst), (src), (count), 4)
+/**
+ * @brief Convert an array of long long ints or IEEE-754 doubles (8 bytes) from device endianness, in place when dst == src
+ */
+#define dtohllArray(dst, src, count) ARSAL_Endianness_ConvertArray ((dst), (src), (count), 8)
+
 #endif /* _ARSAL_ENDIANNESS_H_ */
@@ -0,0 +1,367 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file libARSAL/ARSAL_EventSem.h
+ * @brief Semaphore backed by a file descriptor, with timed waits on the monotonic clock
+ * @note The descriptor is readable while the semaphore is positive, so the semaphore can be watched by
+ * poll(), epoll, kqueue or a run loop next to sockets. It is an eventfd in semaphore mode on Linux and a
+ * non blocking pipe holding one byte per count elsewhere (iOS has no eventfd).
+ * Unlike ARSAL_Sem_Timedwait(), the timed waits measure the timeout on the monotonic clock, so changes of
+ * the system date do not make them return early or late.
+ * @date 10/18/2026
+ */
+#ifndef _ARSAL_EVENT_SEM_H_
+#define _ARSAL_EVENT_SEM_H_
+
+#include <stdint.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__linux__) && !defined(ARSAL_EVENTSEM_NO_EVENTFD)
+#include <sys/eventfd.h>
+#endif
+#include <libARSAL/ARSAL_Time.h>
+
+/**
+ * @brief 1 when the semaphores are eventfds
+ * @note Can be disabled with -DARSAL_EVENTSEM_NO_EVENTFD
+ */
+#if defined(__linux__) && defined(EFD_SEMAPHORE) && !defined(ARSAL_EVENTSEM_NO_EVENTFD)
+#define ARSAL_EVENTSEM_EVENTFD 1
+#else
+#define ARSAL_EVENTSEM_EVENTFD 0
+#endif
+
+/**
+ * @brief Semaphore stored inline
+ * @warning With the pipe, the count is limited by the capacity of the pipe : ARSAL_EventSem_Post() fails with EAGAIN beyond it.
+ */
+typedef struct
+{
+    int readFd; /**< Descriptor read by the waits, readable while the semaphore is positive */
+    int writeFd; /**< Descriptor written by the posts, readFd for an eventfd */
+} ARSAL_EventSem_t;
+
+/**
+ * @brief INTERNAL FUNCTION : Set a descriptor non blocking and closed on exec
+ */
+static inline int ARSAL_EventSem_SetFlags (int fd)
+{
+    int flags = fcntl (fd, F_GETFL, 0);
+
+    if ((flags < 0) || (fcntl (fd, F_SETFL, flags | O_NONBLOCK) < 0))
+    {
+        return -1;
+    }
+
+    flags = fcntl (fd, F_GETFD, 0);
+    if ((flags < 0) || (fcntl (fd, F_SETFD, flags | FD_CLOEXEC) < 0))
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Increments a semaphore
+ *
+ * @param sem The semaphore to increment
+ * @retval On success, ARSAL_EventSem_Post() returns 0. Otherwise, it returns -1 and set errno (See errno.h)
+ */
+static inline int ARSAL_EventSem_Post (ARSAL_EventSem_t *sem)
+{
+#if ARSAL_EVENTSEM_EVENTFD
+    uint64_t one = 1;
+#else
+    uint8_t one = 1;
+#endif
+    ssize_t written = 0;
+
+    do
+    {
+        written = write (sem->writeFd, &one, sizeof (one));
+    }
+    while ((written < 0) && (errno == EINTR));
+
+    return (written == (ssize_t)sizeof (one)) ? 0 : -1;
+}
+
+/**
+ * @brief Initializes a semaphore
+ * @post ARSAL_EventSem_Destroy() must be called to close the descriptors
+ *
+ * @param sem The semaphore to initialize
+ * @param value Initial value of the semaphore
+ * @retval On success, ARSAL_EventSem_Init() returns 0. Otherwise, it returns -1 and set errno (See errno.h)
+ */
+static inline int ARSAL_EventSem_Init (ARSAL_EventSem_t *sem, unsigned int value)
+{
+    if (sem == NULL)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+#if ARSAL_EVENTSEM_EVENTFD
+    sem->readFd = eventfd (value, EFD_SEMAPHORE | EFD_NONBLOCK | EFD_CLOEXEC);
+    sem->writeFd = sem->readFd;
+
+    return (sem->readFd < 0) ? -1 : 0;
+#else
+    {
+        int fds[2];
+        int savedErrno = 0;
+        unsigned int i = 0;
+
+        if (pipe (fds) < 0)
+        {
+            sem->readFd = -1;
+            sem->writeFd = -1;
+            return -1;
+        }
+
+        sem->readFd = fds[0];
+        sem->writeFd = fds[1];
+
+        if ((ARSAL_EventSem_SetFlags (fds[0]) == 0) && (ARSAL_EventSem_SetFlags (fds[1]) == 0))
+        {
+            for (i = 0; (i < value) && (ARSAL_EventSem_Post (sem) == 0); i++)
+            {
+                /* one byte per count */
+            }
+            if (i == value)
+            {
+                return 0;
+            }
+        }
+
+        savedErrno = errno;
+        close (fds[0]);
+        close (fds[1]);
+        sem->readFd = -1;
+        sem->writeFd = -1;
+        errno = savedErrno;
+
+        return -1;
+    }
+#endif
+}
+
+/**
+ * @brief Destroys a semaphore
+ *
+ * @param sem The semaphore to destroy
+ * @retval On success, ARSAL_EventSem_Destroy() returns 0. Otherwise, it returns -1 and set errno (See errno.h)
+ */
+static inline int ARSAL_EventSem_Destroy (ARSAL_EventSem_t *sem)
+{
+    int result = 0;
+
+    if ((sem == NULL) || (sem->readFd < 0))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (sem->writeFd != sem->readFd)
+    {
+        result = close (sem->writeFd);
+    }
+    if (close (sem->readFd) < 0)
+    {
+        result = -1;
+    }
+
+    sem->readFd = -1;
+    sem->writeFd = -1;
+
+    return result;
+}
+
+/**
+ * @brief Gets the descriptor to watch for a semaphore
+ * @note The descriptor is readable while the semaphore is positive. Do not read it : call ARSAL_EventSem_Trywait()
+ * when it is readable, another waiter can have taken the count first.
+ *
+ * @param sem The semaphore
+ * @return The descriptor, to watch for POLLIN / EPOLLIN / EVFILT_READ
+ */
+static inline int ARSAL_EventSem_GetFd (const ARSAL_EventSem_t *sem)
+{
+    return sem->readFd;
+}
+
+/**
+ * @brief Non blocking wait for a semaphore
+ *
+ * @param sem The sem to wait for
+ * @retval If the semaphore was successfully decremented, ARSAL_EventSem_Trywait() returns 0. If the call would have blocked, it returns -1 and sets errno to "EAGAIN". On any other error, return -1 and set errno (See errno.h)
+ */
+static inline int ARSAL_EventSem_Trywait (ARSAL_EventSem_t *sem)
+{
+#if ARSAL_EVENTSEM_EVENTFD
+    uint64_t count = 0;
+#else
+    uint8_t count = 0;
+#endif
+    ssize_t readSize = 0;
+
+    do
+    {
+        readSize = read (sem->readFd, &count, sizeof (count));
+    }
+    while ((readSize < 0) && (errno == EINTR));
+
+    if (readSize == 0)
+    {
+        /* pipe closed : the semaphore was destroyed */
+        errno = EINVAL;
+        return -1;
+    }
+
+    return (readSize < 0) ? -1 : 0;
+}
+
+/**
+ * @brief Wait for a semaphore until a deadline of the monotonic clock
+ * @note The wait sleeps in poll(), with a resolution of one nanosecond on Linux and of one millisecond
+ * elsewhere ; it never returns ETIMEDOUT before the deadline.
+ *
+ * @param sem The sem to wait for
+ * @param deadline The time (see ARSAL_Time_GetMonotonicNs()) at which to give up, or ARSAL_TIME_MONOTONIC_INFINITE to wait without timeout
+ * @retval If the semaphore was sucessfully decremented, ARSAL_EventSem_TimedwaitNs() returns 0. If the call has timed-out, it returns -1 and sets errno to "ETIMEDOUT". On any other error, return -1 and set errno (See errno.h)
+ */
+static inline int ARSAL_EventSem_TimedwaitNs (ARSAL_EventSem_t *sem, ARSAL_Time_Monotonic_t deadline)
+{
+    struct pollfd pfd;
+
+    pfd.fd = sem->readFd;
+    pfd.events = POLLIN;
+
+    while (ARSAL_EventSem_Trywait (sem) != 0)
+    {
+        ARSAL_Time_Duration_t remaining = 0;
+        int result = 0;
+
+        if (errno != EAGAIN)
+        {
+            return -1;
+        }
+
+        remaining = ARSAL_Time_GetRemainingNs (deadline);
+        if (remaining == 0)
+        {
+            errno = ETIMEDOUT;
+            return -1;
+        }
+
+        pfd.revents = 0;
+#if defined(__linux__) && defined(__USE_GNU)
+        {
+            struct timespec limit;
+
+            ARSAL_Time_NsToTimespec ((uint64_t)remaining, &limit);
+            result = ppoll (&pfd, 1, (deadline == ARSAL_TIME_MONOTONIC_INFINITE) ? NULL : &limit, NULL);
+        }
+#else
+        if (deadline == ARSAL_TIME_MONOTONIC_INFINITE)
+        {
+            result = poll (&pfd, 1, -1);
+        }
+        else
+        {
+            /* rounded up so that the wait does not end before the deadline */
+            ARSAL_Time_Duration_t ms = (remaining + 999999) / 1000000;
+            result = poll (&pfd, 1, (ms > INT_MAX) ? INT_MAX : (int)ms);
+        }
+#endif
+        if ((result < 0) && (errno != EINTR))
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Wait for a semaphore
+ *
+ * @param sem The sem to wait for
+ * @retval On success, ARSAL_EventSem_Wait() returns 0. Otherwise, it returns -1 and set errno (See errno.h)
+ */
+static inline int ARSAL_EventSem_Wait (ARSAL_EventSem_t *sem)
+{
+    return ARSAL_EventSem_TimedwaitNs (sem, ARSAL_TIME_MONOTONIC_INFINITE);
+}
+
+/**
+ * @brief Wait for a semaphore with a timeout
+ *
+ * @param sem The sem to wait for
+ * @param timeout Maximum time to wait, measured on the monotonic clock
+ * @warning Like ARSAL_Sem_Timedwait(), the timeout is a relative time
+ * @note A negative timeout only tries to decrement the semaphore, it does not wait
+ * @retval If the semaphore was sucessfully decremented, ARSAL_EventSem_Timedwait() returns 0. If the call has timed-out, it returns -1 and sets errno to "ETIMEDOUT". If timeout is NULL, it returns -1 and sets errno to "EINVAL". On any other error, return -1 and set errno (See errno.h)
+ */
+static inline int ARSAL_EventSem_Timedwait (ARSAL_EventSem_t *sem, const struct timespec *timeout)
+{
+    ARSAL_Time_Duration_t duration = 0;
+
+    if (timeout == NULL)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    /* negative durations would read as no timeout, overlong ones would wrap */
+    if ((timeout->tv_sec < 0) || ((timeout->tv_sec == 0) && (timeout->tv_nsec < 0)))
+    {
+        duration = 0;
+    }
+    else if ((uint64_t)timeout->tv_sec >= (uint64_t)(INT64_MAX / 1000000000LL) - 1)
+    {
+        duration = INT64_MAX / 2;
+    }
+    else
+    {
+        duration = (ARSAL_Time_Duration_t)timeout->tv_sec * 1000000000LL + timeout->tv_nsec;
+        duration = (duration < 0) ? 0 : duration;
+    }
+
+    return ARSAL_EventSem_TimedwaitNs (sem, ARSAL_Time_GetDeadlineNs (duration));
+}
+
+#endif // _ARSAL_EVENT_SEM_H_
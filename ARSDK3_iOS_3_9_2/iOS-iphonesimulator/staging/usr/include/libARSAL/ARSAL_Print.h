@@ -39,6 +39,8 @@
 #include <time.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <sched.h>
 #include <libARSAL/ARSAL_Time.h>
 
 #ifdef HAVE_CONFIG_H
@@ -62,6 +64,42 @@ typedef enum
 
 #define     ARSAL_PRINT_DATE_STRING_LENGTH 9        // HH:MM:SS\0
 
+/**
+ * @brief Maximum level of the logs built in the application
+ * Logs with a lower level are removed at build time.
+ * Default is "ARSAL_PRINT_INFO" when NDEBUG is defined, "ARSAL_PRINT_VERBOSE" otherwise.
+ * Can be overridden with -DARSAL_PRINT_MAX_LEVEL=ARSAL_PRINT_xxx.
+ */
+#ifndef ARSAL_PRINT_MAX_LEVEL
+#ifdef NDEBUG
+#define ARSAL_PRINT_MAX_LEVEL ARSAL_PRINT_INFO
+#else
+#define ARSAL_PRINT_MAX_LEVEL ARSAL_PRINT_VERBOSE
+#endif
+#endif
+
+/**
+ * @brief Maximum number of tags with their own level, see ARSAL_Print_SetTagLevel()
+ */
+#define ARSAL_PRINT_TAG_LEVEL_MAX_TAGS 64
+
+/**
+ * @brief Size of the tag names compared by the tag levels, null character included
+ */
+#define ARSAL_PRINT_TAG_LEVEL_NAME_SIZE 48
+
+/**
+ * @brief Checks whether a log is enabled, before any formatting
+ * @note Removed at build time when level is above ARSAL_PRINT_MAX_LEVEL. Otherwise, the tag is looked
+ * up once per call site when it is a constant, then checked with one relaxed atomic load.
+ * @param level The print level (eARSAL_PRINT_LEVEL enum)
+ * @param tag The tag of the log
+ * @param slot A static int of the call site, initialized to 0, caching the tag level
+ */
+#define ARSAL_PRINT_IS_ENABLED(level, tag, slot)                        \
+    (((level) <= ARSAL_PRINT_MAX_LEVEL) &&                              \
+     ARSAL_Print_IsLevelEnabled ((level), (tag), __builtin_constant_p (tag) ? &(slot) : NULL))
+
 /**
  * @brief Prints a specific output
  *
@@ -77,18 +115,22 @@ typedef enum
 #define ARSAL_PRINT(level, tag, format, ...)                            \
     do                                                                  \
     {                                                                   \
-        char __nowTimeStr [ARSAL_PRINT_DATE_STRING_LENGTH];             \
-        struct timespec __ts;                                           \
-        struct tm __tm;                                                 \
-        ARSAL_Time_GetLocalTime(&__ts, &__tm);                          \
-        strftime (__nowTimeStr, ARSAL_PRINT_DATE_STRING_LENGTH, "%H:%M:%S", &__tm); \
-        if (!strlen (format) || format[strlen (format)-1] != '\n')      \
-        {                                                               \
-            ARSAL_Print_PrintRaw(level, tag, "%s:%03d | %s:%d - " format "\n", __nowTimeStr, NSEC_TO_MSEC(__ts.tv_nsec), __FUNCTION__, __LINE__, ##__VA_ARGS__); \
-        }                                                               \
-        else                                                            \
+        static int __tagSlot = 0;                                       \
+        if (ARSAL_PRINT_IS_ENABLED (level, tag, __tagSlot))             \
         {                                                               \
-            ARSAL_Print_PrintRaw(level, tag, "%s:%03d | %s:%d - " format, __nowTimeStr, NSEC_TO_MSEC(__ts.tv_nsec), __FUNCTION__, __LINE__, ##__VA_ARGS__); \
+            char __nowTimeStr [ARSAL_PRINT_DATE_STRING_LENGTH];         \
+            struct timespec __ts;                                       \
+            struct tm __tm;                                             \
+            ARSAL_Time_GetLocalTime(&__ts, &__tm);                      \
+            strftime (__nowTimeStr, ARSAL_PRINT_DATE_STRING_LENGTH, "%H:%M:%S", &__tm); \
+            if (!strlen (format) || format[strlen (format)-1] != '\n')  \
+            {                                                           \
+                ARSAL_Print_PrintRaw(level, tag, "%s:%03d | %s:%d - " format "\n", __nowTimeStr, NSEC_TO_MSEC(__ts.tv_nsec), __FUNCTION__, __LINE__, ##__VA_ARGS__); \
+            }                                                           \
+            else                                                        \
+            {                                                           \
+                ARSAL_Print_PrintRaw(level, tag, "%s:%03d | %s:%d - " format, __nowTimeStr, NSEC_TO_MSEC(__ts.tv_nsec), __FUNCTION__, __LINE__, ##__VA_ARGS__); \
+            }                                                           \
         }                                                               \
     } while (0)
 
@@ -131,6 +173,389 @@ const char* ARSAL_Print_GetLevelDescription(eARSAL_PRINT_LEVEL level);
 typedef int (*ARSAL_Print_Callback_t) (eARSAL_PRINT_LEVEL level, const char *tag, const char *format, va_list va);
 void ARSAL_Print_SetCallback( ARSAL_Print_Callback_t callback);
 
+/**
+ * @brief Levels of the tags
+ * @warning Used through the ARSAL_Print_xxxTagLevel() functions, do not use directly
+ */
+typedef struct
+{
+    char names[ARSAL_PRINT_TAG_LEVEL_MAX_TAGS][ARSAL_PRINT_TAG_LEVEL_NAME_SIZE]; /**< Names of the tags ; slot 0 is shared by the tags which do not fit */
+    int levels[ARSAL_PRINT_TAG_LEVEL_MAX_TAGS]; /**< Level + 1 of each tag, 0 to follow ARSAL_Print_GetMinimumLevel() */
+    int explicitLevels[ARSAL_PRINT_TAG_LEVEL_MAX_TAGS]; /**< 1 when the level of the tag was set, 0 when it follows the default level */
+    int count; /**< Number of tags, slot 0 excluded */
+    int defaultLevel; /**< Level + 1 of the tags without their own level, 0 until a tag level is set */
+    int minimumLevel; /**< Minimum level set with ARSAL_Print_SetMinimumLevel() + 1, 0 until it is read */
+    int lowerMinimumLevel; /**< 1 when the tag levels may lower the minimum level, see ARSAL_Print_SetTagLevelsLowerMinimumLevel() */
+    uint64_t slotCache[ARSAL_PRINT_TAG_LEVEL_MAX_TAGS]; /**< Slots of the non constant tags, by address : address << 8 | slot */
+    int lock; /**< Protects the changes of the table */
+} ARSAL_Print_TagLevels_t;
+
+/**
+ * @brief Levels of the tags, shared by all the compilation units
+ */
+__attribute__((weak)) ARSAL_Print_TagLevels_t ARSAL_Print_TagLevels;
+
+/**
+ * @brief INTERNAL FUNCTION : Lock the table of the tag levels
+ */
+static inline void ARSAL_Print_LockTagLevels(void)
+{
+    int spins = 0;
+
+    while (__atomic_exchange_n (&ARSAL_Print_TagLevels.lock, 1, __ATOMIC_ACQUIRE))
+    {
+        /* the table is held for a few hundred cycles, yield if its owner was preempted */
+        if (++spins < 64)
+        {
+#if defined(__i386__) || defined(__x86_64__)
+            __asm__ __volatile__ ("pause");
+#elif defined(__arm__) || defined(__aarch64__)
+            __asm__ __volatile__ ("yield");
+#endif
+        }
+        else
+        {
+            sched_yield ();
+        }
+    }
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Unlock the table of the tag levels
+ */
+static inline void ARSAL_Print_UnlockTagLevels(void)
+{
+    __atomic_store_n (&ARSAL_Print_TagLevels.lock, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Gets the minimum level of ARSAL_Print, read once then cached
+ * @return The minimum level
+ */
+static inline eARSAL_PRINT_LEVEL ARSAL_Print_GetCachedMinimumLevel(void)
+{
+    int minimumLevel = __atomic_load_n (&ARSAL_Print_TagLevels.minimumLevel, __ATOMIC_RELAXED);
+
+    if (minimumLevel == 0)
+    {
+        minimumLevel = (int)ARSAL_Print_GetMinimumLevel () + 1;
+        __atomic_store_n (&ARSAL_Print_TagLevels.minimumLevel, minimumLevel, __ATOMIC_RELAXED);
+    }
+
+    return (eARSAL_PRINT_LEVEL)(minimumLevel - 1);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Find the slot of a tag, adding it on its first use
+ * @param tag The tag
+ * @return The slot of the tag, 0 if the tag is NULL or the table is full
+ */
+static inline int ARSAL_Print_GetTagSlot(const char *tag)
+{
+    ARSAL_Print_TagLevels_t *table = &ARSAL_Print_TagLevels;
+    int count = 0;
+    int index = 0;
+
+    if (tag == NULL)
+    {
+        return 0;
+    }
+
+    count = __atomic_load_n (&table->count, __ATOMIC_ACQUIRE);
+    for (index = 1; index <= count; index++)
+    {
+        if (strncmp (table->names[index], tag, ARSAL_PRINT_TAG_LEVEL_NAME_SIZE - 1) == 0)
+        {
+            return index;
+        }
+    }
+
+    if (count >= ARSAL_PRINT_TAG_LEVEL_MAX_TAGS - 1)
+    {
+        /* the table is full : no lock for the tags which do not fit */
+        return 0;
+    }
+
+    ARSAL_Print_LockTagLevels ();
+
+    /* another thread may have added tags since the first search */
+    for (; index <= table->count; index++)
+    {
+        if (strncmp (table->names[index], tag, ARSAL_PRINT_TAG_LEVEL_NAME_SIZE - 1) == 0)
+        {
+            break;
+        }
+    }
+
+    if (index > table->count)
+    {
+        if (index < ARSAL_PRINT_TAG_LEVEL_MAX_TAGS)
+        {
+            strncpy (table->names[index], tag, ARSAL_PRINT_TAG_LEVEL_NAME_SIZE - 1);
+            __atomic_store_n (&table->levels[index], table->defaultLevel, __ATOMIC_RELAXED);
+            __atomic_store_n (&table->count, index, __ATOMIC_RELEASE);
+        }
+        else
+        {
+            index = 0;
+        }
+    }
+
+    ARSAL_Print_UnlockTagLevels ();
+
+    return index;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Find the slot of a non constant tag through the cache of the tag addresses
+ * @note The name in the slot is compared with the tag, which may have changed since it was cached.
+ * @param tag The tag
+ * @return The slot of the tag, 0 if the tag is NULL or the table is full
+ */
+static inline int ARSAL_Print_GetCachedTagSlot(const char *tag)
+{
+    ARSAL_Print_TagLevels_t *table = &ARSAL_Print_TagLevels;
+    uint64_t address = (uint64_t)(uintptr_t)tag & 0x00FFFFFFFFFFFFFFULL;
+    uint32_t hash = (uint32_t)((address * 0x9E3779B97F4A7C15ULL) >> 58) % ARSAL_PRINT_TAG_LEVEL_MAX_TAGS;
+    uint64_t entry = 0;
+    int index = 0;
+
+    if (tag == NULL)
+    {
+        return 0;
+    }
+
+    /* address and slot in a single word, which cannot be seen torn */
+    entry = __atomic_load_n (&table->slotCache[hash], __ATOMIC_ACQUIRE);
+    index = (int)(entry & 0xFF);
+    if (((entry >> 8) == address) && (index > 0) &&
+        (strncmp (table->names[index], tag, ARSAL_PRINT_TAG_LEVEL_NAME_SIZE - 1) == 0))
+    {
+        return index;
+    }
+
+    index = ARSAL_Print_GetTagSlot (tag);
+    if (index > 0)
+    {
+        __atomic_store_n (&table->slotCache[hash], (address << 8) | (uint64_t)index, __ATOMIC_RELEASE);
+    }
+
+    return index;
+}
+
+/**
+ * @brief Checks whether a log of a tag is enabled
+ * @warning This function should not be used directly
+ * @see ARSAL_PRINT_IS_ENABLED()
+ *
+ * @param level The level of the log
+ * @param tag The tag of the log
+ * @param slot Cache of the slot of the tag, or NULL when the tag is not constant
+ * @return 1 if the log is enabled, 0 otherwise
+ */
+static inline int ARSAL_Print_IsLevelEnabled(eARSAL_PRINT_LEVEL level, const char *tag, int *slot)
+{
+    int index = (slot != NULL) ? __atomic_load_n (slot, __ATOMIC_RELAXED) - 1 : -1;
+    int tagLevel = 0;
+
+    if (index < 0)
+    {
+        if (slot != NULL)
+        {
+            index = ARSAL_Print_GetTagSlot (tag);
+            __atomic_store_n (slot, index + 1, __ATOMIC_RELAXED);
+        }
+        else
+        {
+            index = ARSAL_Print_GetCachedTagSlot (tag);
+        }
+    }
+
+    tagLevel = __atomic_load_n (&ARSAL_Print_TagLevels.levels[index], __ATOMIC_RELAXED);
+
+    return (tagLevel != 0) ? ((int)level < tagLevel) : (level <= ARSAL_Print_GetCachedMinimumLevel ());
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Update the levels of the tags following the default level
+ * @warning The table must be locked
+ * @return The most verbose tag level
+ */
+static inline eARSAL_PRINT_LEVEL ARSAL_Print_UpdateTagLevels(void)
+{
+    ARSAL_Print_TagLevels_t *table = &ARSAL_Print_TagLevels;
+    int maxLevel = table->defaultLevel;
+    int index = 0;
+
+    for (index = 0; index <= table->count; index++)
+    {
+        if (!table->explicitLevels[index])
+        {
+            __atomic_store_n (&table->levels[index], table->defaultLevel, __ATOMIC_RELAXED);
+        }
+        maxLevel = (table->levels[index] > maxLevel) ? table->levels[index] : maxLevel;
+    }
+
+    return (eARSAL_PRINT_LEVEL)(maxLevel - 1);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Set the minimum level of ARSAL_Print from the tag levels
+ * @note It is the level set with ARSAL_Print_SetMinimumLevel(), lowered to the most verbose tag level only
+ * once ARSAL_Print_SetTagLevelsLowerMinimumLevel() enabled it.
+ * @return 0 If the minimum level was set, 1 Otherwise
+ */
+static inline int ARSAL_Print_ApplyTagLevels(void)
+{
+    ARSAL_Print_TagLevels_t *table = &ARSAL_Print_TagLevels;
+    eARSAL_PRINT_LEVEL level = ARSAL_Print_GetCachedMinimumLevel ();
+    eARSAL_PRINT_LEVEL tagsLevel = ARSAL_PRINT_FATAL;
+
+    ARSAL_Print_LockTagLevels ();
+    if (table->defaultLevel != 0)
+    {
+        tagsLevel = ARSAL_Print_UpdateTagLevels ();
+    }
+    ARSAL_Print_UnlockTagLevels ();
+
+    if (__atomic_load_n (&table->lowerMinimumLevel, __ATOMIC_RELAXED) && (tagsLevel > level))
+    {
+        level = tagsLevel;
+    }
+
+    return ARSAL_Print_SetMinimumLevel (level);
+}
+
+/**
+ * @brief Sets the minimum level of verbosity for logs, updating the cache of ARSAL_PRINT_IS_ENABLED()
+ * @note ARSAL_Print_SetMinimumLevel() calls are redirected here by a macro once this header is included.
+ * @param level The minimum level for logs.
+ * @return 0 If the minimum level was set, 1 Otherwise
+ */
+static inline int ARSAL_Print_SetMinimumLevelCached(eARSAL_PRINT_LEVEL level)
+{
+    int result = ARSAL_Print_SetMinimumLevel (level);
+
+    __atomic_store_n (&ARSAL_Print_TagLevels.minimumLevel, (int)ARSAL_Print_GetMinimumLevel () + 1, __ATOMIC_RELAXED);
+
+    if ((result == 0) && __atomic_load_n (&ARSAL_Print_TagLevels.lowerMinimumLevel, __ATOMIC_RELAXED))
+    {
+        result = ARSAL_Print_ApplyTagLevels ();
+    }
+
+    return result;
+}
+
+/**
+ * @brief Sets the level of verbosity of the logs of a tag
+ * Once a tag level is set, the level of the other tags is set with ARSAL_Print_SetTagLevel (NULL, level)
+ * instead of ARSAL_Print_SetMinimumLevel(). It starts at the minimum level of the first call.
+ * @note The minimum level of ARSAL_Print is not changed : ARSAL_Print_PrintRaw() still drops the logs below it,
+ * so a tag level more verbose than the minimum level is capped by it, unless ARSAL_Print_SetTagLevelsLowerMinimumLevel()
+ * is enabled. The logs of the prebuilt libraries, built before the tag levels, are only filtered by the minimum level.
+ * @param tag The tag, or NULL to set the level of the tags without their own level
+ * @param level The minimum level for the logs of the tag
+ * @return 0 If the level was set, 1 Otherwise
+ */
+static inline int ARSAL_Print_SetTagLevel(const char *tag, eARSAL_PRINT_LEVEL level)
+{
+    ARSAL_Print_TagLevels_t *table = &ARSAL_Print_TagLevels;
+    eARSAL_PRINT_LEVEL minimumLevel = ARSAL_PRINT_FATAL;
+    int index = 0;
+
+    if ((level < ARSAL_PRINT_FATAL) || (level >= ARSAL_PRINT_MAX))
+    {
+        return 1;
+    }
+
+    index = ARSAL_Print_GetTagSlot (tag);
+    if ((tag != NULL) && (index == 0))
+    {
+        return 1;
+    }
+
+    minimumLevel = ARSAL_Print_GetCachedMinimumLevel ();
+
+    ARSAL_Print_LockTagLevels ();
+
+    if (table->defaultLevel == 0)
+    {
+        table->defaultLevel = (int)minimumLevel + 1;
+    }
+
+    if (tag == NULL)
+    {
+        table->defaultLevel = (int)level + 1;
+    }
+    else
+    {
+        table->explicitLevels[index] = 1;
+        __atomic_store_n (&table->levels[index], (int)level + 1, __ATOMIC_RELAXED);
+    }
+
+    ARSAL_Print_UnlockTagLevels ();
+
+    return ARSAL_Print_ApplyTagLevels ();
+}
+
+/**
+ * @brief Makes a tag follow the default level again
+ * @param tag The tag
+ * @return 0 If the level was reset, 1 Otherwise
+ */
+static inline int ARSAL_Print_ResetTagLevel(const char *tag)
+{
+    ARSAL_Print_TagLevels_t *table = &ARSAL_Print_TagLevels;
+    int index = ARSAL_Print_GetTagSlot (tag);
+
+    if (index == 0)
+    {
+        return 1;
+    }
+
+    ARSAL_Print_LockTagLevels ();
+
+    table->explicitLevels[index] = 0;
+
+    ARSAL_Print_UnlockTagLevels ();
+
+    return ARSAL_Print_ApplyTagLevels ();
+}
+
+/**
+ * @brief Lets the tag levels lower the minimum level of ARSAL_Print
+ * ARSAL_Print_PrintRaw() drops the logs below the minimum level, so by default a tag can only be made quieter than it.
+ * Once enabled, the minimum level is lowered to the most verbose tag level so that the logs of that tag get printed ;
+ * the logs of the prebuilt libraries (ARNETWORK, ARSTREAM2, ARCONTROLLER...), which are not filtered by tag, then
+ * use that level too. Disabling it restores the minimum level set with ARSAL_Print_SetMinimumLevel().
+ * @param enable 1 to let the tag levels lower the minimum level, 0 otherwise (default)
+ * @return 0 If the minimum level was set, 1 Otherwise
+ */
+static inline int ARSAL_Print_SetTagLevelsLowerMinimumLevel(int enable)
+{
+    __atomic_store_n (&ARSAL_Print_TagLevels.lowerMinimumLevel, (enable != 0) ? 1 : 0, __ATOMIC_RELAXED);
+
+    return ARSAL_Print_ApplyTagLevels ();
+}
+
+/**
+ * @brief Gets the level of verbosity of the logs of a tag
+ * @param tag The tag
+ * @return The level of the tag
+ */
+static inline eARSAL_PRINT_LEVEL ARSAL_Print_GetTagLevel(const char *tag)
+{
+    int tagLevel = __atomic_load_n (&ARSAL_Print_TagLevels.levels[ARSAL_Print_GetTagSlot (tag)], __ATOMIC_RELAXED);
+
+    return (tagLevel != 0) ? (eARSAL_PRINT_LEVEL)(tagLevel - 1) : ARSAL_Print_GetCachedMinimumLevel ();
+}
+
+/**
+ * @brief Sets the minimum level of verbosity for logs
+ * @see ARSAL_Print_SetMinimumLevelCached()
+ */
+#define ARSAL_Print_SetMinimumLevel(level) ARSAL_Print_SetMinimumLevelCached (level)
+
 /**
  * @brief Dump data in a file.
  * @param file output file
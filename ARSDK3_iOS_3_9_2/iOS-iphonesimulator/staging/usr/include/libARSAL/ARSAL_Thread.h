@@ -37,6 +37,24 @@
 #ifndef _ARSAL_THREAD_H_
 #define _ARSAL_THREAD_H_
 
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <mach/mach.h>
+#include <mach/thread_policy.h>
+#endif
+
+/**
+ * @brief Maximum length of a thread name, null character included
+ */
+#define ARSAL_THREAD_NAME_SIZE 64
+
 /**
  * @brief Define a thread type.
  */
@@ -74,4 +92,215 @@ int ARSAL_Thread_Join(ARSAL_Thread_t thread, void **retval);
  */
 int ARSAL_Thread_Destroy(ARSAL_Thread_t *thread);
 
+/**
+ * @brief Scheduling policy of a thread
+ */
+typedef enum
+{
+    ARSAL_THREAD_SCHED_DEFAULT = 0, /**< Inherit the scheduling of the system */
+    ARSAL_THREAD_SCHED_OTHER, /**< Time sharing scheduling */
+    ARSAL_THREAD_SCHED_FIFO, /**< Real time scheduling, first in first out */
+    ARSAL_THREAD_SCHED_RR, /**< Real time scheduling, round robin */
+    ARSAL_THREAD_SCHED_MAX, /**< Max of the enum, do not use */
+} eARSAL_THREAD_SCHED;
+
+/**
+ * @brief Attributes of a thread
+ * @see ARSAL_Thread_Attributes_Init()
+ */
+typedef struct
+{
+    const char *name; /**< Name of the thread shown in debuggers and profilers, NULL for no name ; copied at creation */
+    eARSAL_THREAD_SCHED policy; /**< Scheduling policy */
+    int priority; /**< Priority in the policy, clamped to its range ; 0 for the default priority */
+    uint64_t affinity; /**< Mask of the CPUs the thread may run on, 0 for all */
+    size_t stackSize; /**< Size of the stack in bytes, 0 for the default size */
+} ARSAL_Thread_Attributes_t;
+
+/**
+ * @brief Start arguments of a thread created with attributes
+ */
+typedef struct
+{
+    ARSAL_Thread_Routine_t routine; /**< Routine of the thread */
+    void *arg; /**< Argument of the routine */
+    char name[ARSAL_THREAD_NAME_SIZE]; /**< Name of the thread */
+    uint64_t affinity; /**< Mask of the CPUs */
+} ARSAL_Thread_Start_t;
+
+/**
+ * @brief Initialize thread attributes to the default values
+ *
+ * @param attributes The attributes to initialize
+ */
+static inline void ARSAL_Thread_Attributes_Init(ARSAL_Thread_Attributes_t *attributes)
+{
+    if (attributes != NULL)
+    {
+        memset (attributes, 0, sizeof (ARSAL_Thread_Attributes_t));
+    }
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Apply the name and the affinity of a thread, then run its routine
+ * @note The name can only be set by the thread itself on Apple systems. CPU affinity is a hint there :
+ * threads with the same mask get the same affinity tag, which the kernel may ignore.
+ */
+static inline void *ARSAL_Thread_Start(void *arg)
+{
+    ARSAL_Thread_Start_t start = *((ARSAL_Thread_Start_t *)arg);
+
+    free (arg);
+
+    if (start.name[0] != '\0')
+    {
+#if defined(__APPLE__)
+        pthread_setname_np (start.name);
+#elif defined(__linux__) && defined(__USE_GNU)
+        /* Linux limits names to 15 characters */
+        start.name[15] = '\0';
+        pthread_setname_np (pthread_self (), start.name);
+#endif
+    }
+
+    if (start.affinity != 0)
+    {
+#if defined(__APPLE__)
+        thread_affinity_policy_data_t policy = { (integer_t)(start.affinity & INT_MAX) };
+        /* pthread_mach_thread_np() does not take a new send right, unlike mach_thread_self() */
+        thread_policy_set (pthread_mach_thread_np (pthread_self ()), THREAD_AFFINITY_POLICY, (thread_policy_t)&policy, THREAD_AFFINITY_POLICY_COUNT);
+#elif defined(__linux__) && defined(__USE_GNU)
+        cpu_set_t cpus;
+        int cpu = 0;
+
+        CPU_ZERO (&cpus);
+        for (cpu = 0; (cpu < 64) && (cpu < CPU_SETSIZE); cpu++)
+        {
+            if (start.affinity & ((uint64_t)1 << cpu))
+            {
+                CPU_SET (cpu, &cpus);
+            }
+        }
+        pthread_setaffinity_np (pthread_self (), sizeof (cpus), &cpus);
+#endif
+    }
+
+    return start.routine (start.arg);
+}
+
+/**
+ * @brief Create a new thread with attributes
+ * @note When the real time scheduling is not permitted, the thread is created with the default scheduling.
+ * The thread is joined and destroyed with ARSAL_Thread_Join() and ARSAL_Thread_Destroy().
+ *
+ * @param thread The thread to create
+ * @param routine The routine to invoke by thread
+ * @param arg The argument passed to routine()
+ * @param attributes The attributes of the thread, NULL for the default attributes
+ * @retval On success, ARSAL_Thread_CreateWithAttributes() returns 0. Otherwise, it returns an error number (See errno.h)
+ */
+static inline int ARSAL_Thread_CreateWithAttributes(ARSAL_Thread_t *thread, ARSAL_Thread_Routine_t routine, void *arg, const ARSAL_Thread_Attributes_t *attributes)
+{
+    static const int policies[ARSAL_THREAD_SCHED_MAX] = { SCHED_OTHER, SCHED_OTHER, SCHED_FIFO, SCHED_RR };
+    ARSAL_Thread_Attributes_t defaultAttributes;
+    ARSAL_Thread_Start_t *start = NULL;
+    pthread_t *pthread = NULL;
+    pthread_attr_t attr;
+    int result = 0;
+
+    if ((thread == NULL) || (routine == NULL))
+    {
+        return EINVAL;
+    }
+
+    if (attributes == NULL)
+    {
+        ARSAL_Thread_Attributes_Init (&defaultAttributes);
+        attributes = &defaultAttributes;
+    }
+
+    if ((attributes->policy < ARSAL_THREAD_SCHED_DEFAULT) || (attributes->policy >= ARSAL_THREAD_SCHED_MAX))
+    {
+        return EINVAL;
+    }
+
+    pthread = (pthread_t *)calloc (1, sizeof (pthread_t));
+    start = (ARSAL_Thread_Start_t *)calloc (1, sizeof (ARSAL_Thread_Start_t));
+    if ((pthread == NULL) || (start == NULL))
+    {
+        free (pthread);
+        free (start);
+        return ENOMEM;
+    }
+
+    start->routine = routine;
+    start->arg = arg;
+    start->affinity = attributes->affinity;
+    if (attributes->name != NULL)
+    {
+        strncpy (start->name, attributes->name, ARSAL_THREAD_NAME_SIZE - 1);
+    }
+
+    result = pthread_attr_init (&attr);
+    if (result == 0)
+    {
+        if (attributes->stackSize > 0)
+        {
+            long pageSize = sysconf (_SC_PAGESIZE);
+            size_t stackSize = attributes->stackSize;
+
+#ifdef PTHREAD_STACK_MIN
+            stackSize = (stackSize < (size_t)PTHREAD_STACK_MIN) ? (size_t)PTHREAD_STACK_MIN : stackSize;
+#endif
+
+            if (pageSize > 0)
+            {
+                stackSize = (stackSize + (size_t)pageSize - 1) & ~((size_t)pageSize - 1);
+            }
+            result = pthread_attr_setstacksize (&attr, stackSize);
+        }
+
+        if ((result == 0) && (attributes->policy != ARSAL_THREAD_SCHED_DEFAULT))
+        {
+            int policy = policies[attributes->policy];
+            struct sched_param param;
+            int minimum = sched_get_priority_min (policy);
+            int maximum = sched_get_priority_max (policy);
+
+            memset (&param, 0, sizeof (param));
+            param.sched_priority = (attributes->priority != 0) ? attributes->priority : (minimum + maximum) / 2;
+            param.sched_priority = (param.sched_priority < minimum) ? minimum : param.sched_priority;
+            param.sched_priority = (param.sched_priority > maximum) ? maximum : param.sched_priority;
+
+            result = pthread_attr_setinheritsched (&attr, PTHREAD_EXPLICIT_SCHED);
+            result = (result == 0) ? pthread_attr_setschedpolicy (&attr, policy) : result;
+            result = (result == 0) ? pthread_attr_setschedparam (&attr, &param) : result;
+        }
+
+        if (result == 0)
+        {
+            result = pthread_create (pthread, &attr, ARSAL_Thread_Start, start);
+            if ((result == EPERM) && (attributes->policy != ARSAL_THREAD_SCHED_DEFAULT))
+            {
+                /* real time scheduling not permitted */
+                pthread_attr_setinheritsched (&attr, PTHREAD_INHERIT_SCHED);
+                result = pthread_create (pthread, &attr, ARSAL_Thread_Start, start);
+            }
+        }
+
+        pthread_attr_destroy (&attr);
+    }
+
+    if (result != 0)
+    {
+        free (pthread);
+        free (start);
+        return result;
+    }
+
+    *thread = (ARSAL_Thread_t)pthread;
+
+    return 0;
+}
+
 #endif // _ARSAL_THREAD_H_
@@ -0,0 +1,665 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file libARSAL/ARSAL_Trace.h
+ * @brief Trace event recorder, exported as Chrome trace JSON or Perfetto protobuf
+ * @note Each thread records begin, end, instant and flow events into a ring it owns, without
+ * locking : a relaxed load when the recorder is stopped, a timestamp and a 32 bytes store when
+ * it is started. The rings keep the last ARSAL_TRACE_BUFFER_EVENTS events of each thread, so a
+ * capture can stay enabled in production and be exported when something goes wrong.
+ * Names and categories must be string literals, or strings which outlive the export.
+ * Build with ARSAL_TRACE_DISABLED to compile the ARSAL_TRACE_* macros out.
+ * @date 10/18/2026
+ */
+#ifndef _ARSAL_TRACE_H_
+#define _ARSAL_TRACE_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <libARSAL/ARSAL_Error.h>
+#include <libARSAL/ARSAL_Allocator.h>
+#include <libARSAL/ARSAL_Time.h>
+
+/**
+ * @brief Number of events kept by each thread ; must be a power of two
+ */
+#define ARSAL_TRACE_BUFFER_EVENTS 16384
+
+/**
+ * @brief Maximum size of the name of a thread
+ */
+#define ARSAL_TRACE_THREAD_NAME_SIZE 32
+
+/**
+ * @brief Type of a trace event
+ */
+typedef enum
+{
+    ARSAL_TRACE_EVENT_BEGIN = 0, /**< Start of a slice */
+    ARSAL_TRACE_EVENT_END, /**< End of the last slice started by the thread */
+    ARSAL_TRACE_EVENT_INSTANT, /**< Single point in time */
+    ARSAL_TRACE_EVENT_FLOW_BEGIN, /**< Start of a flow, which links the slices of its id across threads */
+    ARSAL_TRACE_EVENT_FLOW_STEP, /**< Step of a flow */
+    ARSAL_TRACE_EVENT_FLOW_END, /**< End of a flow */
+} eARSAL_TRACE_EVENT;
+
+/**
+ * @brief Trace event
+ */
+typedef struct
+{
+    uint64_t timestamp; /**< Monotonic time in nanoseconds */
+    const char *category; /**< Category of the event */
+    const char *name; /**< Name of the event */
+    uint64_t id : 56; /**< Id of the flow, 0 for the other events */
+    uint64_t type : 8; /**< Type of the event, from eARSAL_TRACE_EVENT */
+} ARSAL_Trace_Event_t;
+
+/**
+ * @brief Ring of the events of a thread
+ */
+typedef struct ARSAL_Trace_Buffer_t
+{
+    uint64_t head; /**< Number of events recorded since the capture started ; only written by the thread */
+    uint32_t generation; /**< Capture of the events of the ring */
+    uint32_t tid; /**< Id of the thread in the trace */
+    int orphan; /**< 1 once the thread exited */
+    char name[ARSAL_TRACE_THREAD_NAME_SIZE]; /**< Name of the thread */
+    struct ARSAL_Trace_Buffer_t *next; /**< Next ring of the recorder */
+    ARSAL_Trace_Event_t events[ARSAL_TRACE_BUFFER_EVENTS]; /**< Events */
+} ARSAL_Trace_Buffer_t;
+
+/**
+ * @brief Trace recorder
+ */
+typedef struct
+{
+    int enabled; /**< 1 while a capture runs */
+    uint32_t generation; /**< Current capture, incremented by each start */
+    uint64_t nextFlowId; /**< Last flow id given */
+    uint32_t nextTid; /**< Last thread id given */
+    int keyCreated; /**< 1 once key is created */
+    pthread_key_t key; /**< Key of the ring of the calling thread */
+    ARSAL_Trace_Buffer_t *buffers; /**< Rings of all the threads */
+    int lock; /**< Protects the creation of the key and the list of the rings */
+} ARSAL_Trace_Recorder_t;
+
+/**
+ * @brief Recorder shared by all the compilation units
+ */
+__attribute__((weak)) ARSAL_Trace_Recorder_t ARSAL_Trace_Recorder;
+
+/**
+ * @brief Check whether a capture runs
+ */
+#define ARSAL_TRACE_IS_ENABLED() (__builtin_expect (__atomic_load_n (&ARSAL_Trace_Recorder.enabled, __ATOMIC_RELAXED), 0))
+
+/**
+ * @brief INTERNAL FUNCTION : Destructor of the key, marks the ring of the exiting thread
+ */
+static inline void ARSAL_Trace_ReleaseBuffer (void *buffer)
+{
+    __atomic_store_n (&((ARSAL_Trace_Buffer_t *)buffer)->orphan, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Create the ring of the calling thread
+ * @return The ring, or NULL if it could not be allocated
+ */
+static inline ARSAL_Trace_Buffer_t *ARSAL_Trace_NewBuffer (void)
+{
+    ARSAL_Trace_Recorder_t *recorder = &ARSAL_Trace_Recorder;
+    ARSAL_Trace_Buffer_t *buffer = (ARSAL_Trace_Buffer_t *)ARSAL_Allocator_Calloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, 1, sizeof (ARSAL_Trace_Buffer_t));
+
+    if (buffer == NULL)
+    {
+        return NULL;
+    }
+
+#if defined(__APPLE__) || (defined(__linux__) && defined(__USE_GNU))
+    pthread_getname_np (pthread_self (), buffer->name, sizeof (buffer->name));
+#endif
+
+    while (__atomic_exchange_n (&recorder->lock, 1, __ATOMIC_ACQUIRE))
+    {
+    }
+
+    if (!recorder->keyCreated)
+    {
+        recorder->keyCreated = (pthread_key_create (&recorder->key, ARSAL_Trace_ReleaseBuffer) == 0);
+    }
+
+    if (recorder->keyCreated)
+    {
+        buffer->tid = ++recorder->nextTid;
+        buffer->generation = recorder->generation;
+        buffer->next = recorder->buffers;
+        pthread_setspecific (recorder->key, buffer);
+        __atomic_store_n (&recorder->buffers, buffer, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, buffer);
+        buffer = NULL;
+    }
+
+    __atomic_store_n (&recorder->lock, 0, __ATOMIC_RELEASE);
+
+    return buffer;
+}
+
+/**
+ * @brief Record an event on the calling thread
+ * @note Prefer the ARSAL_TRACE_* macros, which skip the call when no capture runs.
+ * @param type The type of the event
+ * @param category The category of the event
+ * @param name The name of the event
+ * @param id The id of a flow, 0 for the other events
+ */
+static inline void ARSAL_Trace_Record (eARSAL_TRACE_EVENT type, const char *category, const char *name, uint64_t id)
+{
+    ARSAL_Trace_Recorder_t *recorder = &ARSAL_Trace_Recorder;
+    ARSAL_Trace_Buffer_t *buffer = NULL;
+    ARSAL_Trace_Event_t *event = NULL;
+    uint32_t generation = __atomic_load_n (&recorder->generation, __ATOMIC_ACQUIRE);
+    uint64_t head = 0;
+
+    if (__atomic_load_n (&recorder->keyCreated, __ATOMIC_ACQUIRE))
+    {
+        buffer = (ARSAL_Trace_Buffer_t *)pthread_getspecific (recorder->key);
+    }
+    if (buffer == NULL)
+    {
+        buffer = ARSAL_Trace_NewBuffer ();
+        if (buffer == NULL)
+        {
+            return;
+        }
+    }
+
+    head = buffer->head;
+    if (buffer->generation != generation)
+    {
+        /* first event of a new capture : forgets the previous one */
+        head = 0;
+        __atomic_store_n (&buffer->head, 0, __ATOMIC_RELEASE);
+        __atomic_store_n (&buffer->generation, generation, __ATOMIC_RELEASE);
+    }
+
+    event = &buffer->events[head & (ARSAL_TRACE_BUFFER_EVENTS - 1)];
+    event->timestamp = ARSAL_Time_GetMonotonicNs ();
+    event->category = category;
+    event->name = name;
+    event->id = id;
+    event->type = type;
+    __atomic_store_n (&buffer->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Get a new flow id, to link events across threads
+ * @return A flow id, never 0
+ */
+static inline uint64_t ARSAL_Trace_NewFlowId (void)
+{
+    return __atomic_add_fetch (&ARSAL_Trace_Recorder.nextFlowId, 1, __ATOMIC_RELAXED);
+}
+
+#ifndef ARSAL_TRACE_DISABLED
+
+/**
+ * @brief Start a slice on the calling thread
+ */
+#define ARSAL_TRACE_BEGIN(category, name)                                   \
+    do                                                                      \
+    {                                                                       \
+        if (ARSAL_TRACE_IS_ENABLED ())                                      \
+        {                                                                   \
+            ARSAL_Trace_Record (ARSAL_TRACE_EVENT_BEGIN, category, name, 0);\
+        }                                                                   \
+    } while (0)
+
+/**
+ * @brief End the last slice started on the calling thread
+ */
+#define ARSAL_TRACE_END(category, name)                                     \
+    do                                                                      \
+    {                                                                       \
+        if (ARSAL_TRACE_IS_ENABLED ())                                      \
+        {                                                                   \
+            ARSAL_Trace_Record (ARSAL_TRACE_EVENT_END, category, name, 0);  \
+        }                                                                   \
+    } while (0)
+
+/**
+ * @brief Record a point in time on the calling thread
+ */
+#define ARSAL_TRACE_INSTANT(category, name)                                 \
+    do                                                                      \
+    {                                                                       \
+        if (ARSAL_TRACE_IS_ENABLED ())                                      \
+        {                                                                   \
+            ARSAL_Trace_Record (ARSAL_TRACE_EVENT_INSTANT, category, name, 0);\
+        }                                                                   \
+    } while (0)
+
+/**
+ * @brief Start, continue or end a flow, from the slice which runs on the calling thread
+ * @note id comes from ARSAL_Trace_NewFlowId(), and travels with the data from thread to thread ;
+ * the events of a flow share its category and name.
+ */
+#define ARSAL_TRACE_FLOW(type, category, name, id)                          \
+    do                                                                      \
+    {                                                                       \
+        if (ARSAL_TRACE_IS_ENABLED () && ((id) != 0))                       \
+        {                                                                   \
+            ARSAL_Trace_Record (type, category, name, id);                  \
+        }                                                                   \
+    } while (0)
+#define ARSAL_TRACE_FLOW_BEGIN(category, name, id) ARSAL_TRACE_FLOW (ARSAL_TRACE_EVENT_FLOW_BEGIN, category, name, id)
+#define ARSAL_TRACE_FLOW_STEP(category, name, id) ARSAL_TRACE_FLOW (ARSAL_TRACE_EVENT_FLOW_STEP, category, name, id)
+#define ARSAL_TRACE_FLOW_END(category, name, id) ARSAL_TRACE_FLOW (ARSAL_TRACE_EVENT_FLOW_END, category, name, id)
+
+#else
+
+#define ARSAL_TRACE_BEGIN(category, name) do { } while (0)
+#define ARSAL_TRACE_END(category, name) do { } while (0)
+#define ARSAL_TRACE_INSTANT(category, name) do { } while (0)
+#define ARSAL_TRACE_FLOW_BEGIN(category, name, id) do { } while (0)
+#define ARSAL_TRACE_FLOW_STEP(category, name, id) do { } while (0)
+#define ARSAL_TRACE_FLOW_END(category, name, id) do { } while (0)
+
+#endif
+
+/**
+ * @brief Start a capture
+ * @note The events of the previous capture are forgotten, and the rings of the exited threads are freed.
+ * Must not be called during an export.
+ */
+static inline void ARSAL_Trace_Start (void)
+{
+    ARSAL_Trace_Recorder_t *recorder = &ARSAL_Trace_Recorder;
+    ARSAL_Trace_Buffer_t **link = NULL;
+
+    while (__atomic_exchange_n (&recorder->lock, 1, __ATOMIC_ACQUIRE))
+    {
+    }
+
+    link = &recorder->buffers;
+    while (*link != NULL)
+    {
+        ARSAL_Trace_Buffer_t *buffer = *link;
+        if (__atomic_load_n (&buffer->orphan, __ATOMIC_ACQUIRE))
+        {
+            *link = buffer->next;
+            ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, buffer);
+        }
+        else
+        {
+            link = &buffer->next;
+        }
+    }
+
+    __atomic_add_fetch (&recorder->generation, 1, __ATOMIC_RELEASE);
+    __atomic_store_n (&recorder->enabled, 1, __ATOMIC_RELEASE);
+
+    __atomic_store_n (&recorder->lock, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Stop the capture ; its events stay available for the export
+ */
+static inline void ARSAL_Trace_Stop (void)
+{
+    __atomic_store_n (&ARSAL_Trace_Recorder.enabled, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Copy the events of the current capture from a ring
+ * @param buffer The ring
+ * @param[out] events The events, at least ARSAL_TRACE_BUFFER_EVENTS
+ * @return The number of events copied, oldest first
+ */
+static inline size_t ARSAL_Trace_CopyEvents (ARSAL_Trace_Buffer_t *buffer, ARSAL_Trace_Event_t *events)
+{
+    uint64_t head = __atomic_load_n (&buffer->head, __ATOMIC_ACQUIRE);
+    uint64_t first = (head > ARSAL_TRACE_BUFFER_EVENTS) ? head - ARSAL_TRACE_BUFFER_EVENTS : 0;
+    uint64_t valid = 0;
+    uint64_t index = 0;
+    size_t count = 0;
+    size_t depth = 0;
+
+    if (__atomic_load_n (&buffer->generation, __ATOMIC_ACQUIRE) != __atomic_load_n (&ARSAL_Trace_Recorder.generation, __ATOMIC_ACQUIRE))
+    {
+        return 0;
+    }
+
+    for (index = first; index < head; index++)
+    {
+        events[index - first] = buffer->events[index & (ARSAL_TRACE_BUFFER_EVENTS - 1)];
+    }
+
+    /* the thread may have overwritten the oldest events during the copy */
+    __atomic_thread_fence (__ATOMIC_ACQUIRE);
+    valid = __atomic_load_n (&buffer->head, __ATOMIC_RELAXED);
+    valid = (valid >= ARSAL_TRACE_BUFFER_EVENTS) ? valid - ARSAL_TRACE_BUFFER_EVENTS + 1 : 0;
+    if (valid > head)
+    {
+        return 0;
+    }
+    if (valid > first)
+    {
+        memmove (events, &events[valid - first], (size_t)(head - valid) * sizeof (ARSAL_Trace_Event_t));
+        first = valid;
+    }
+
+    /* drops the ends of the slices which began before the oldest event kept */
+    for (index = 0; index < head - first; index++)
+    {
+        if (events[index].type == ARSAL_TRACE_EVENT_BEGIN)
+        {
+            depth++;
+        }
+        else if (events[index].type == ARSAL_TRACE_EVENT_END)
+        {
+            if (depth == 0)
+            {
+                continue;
+            }
+            depth--;
+        }
+        events[count++] = events[index];
+    }
+
+    return count;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Write a string as a JSON string
+ */
+static inline void ARSAL_Trace_WriteJsonString (FILE *out, const char *string)
+{
+    fputc ('"', out);
+    for (; (string != NULL) && (*string != '\0'); string++)
+    {
+        if ((*string == '"') || (*string == '\\'))
+        {
+            fputc ('\\', out);
+            fputc (*string, out);
+        }
+        else if ((unsigned char)*string < 0x20)
+        {
+            fprintf (out, "\\u%04x", (unsigned char)*string);
+        }
+        else
+        {
+            fputc (*string, out);
+        }
+    }
+    fputc ('"', out);
+}
+
+/**
+ * @brief Export the capture as Chrome trace JSON, for chrome://tracing or ui.perfetto.dev
+ * @param out The file to write
+ * @retval On success, returns ARSAL_OK. Otherwise, it returns an error number of eARSAL_ERROR
+ */
+static inline eARSAL_ERROR ARSAL_Trace_ExportChromeJson (FILE *out)
+{
+    static const char *phases[] = { "B", "E", "i", "s", "t", "f" };
+    ARSAL_Trace_Event_t *events = NULL;
+    ARSAL_Trace_Buffer_t *buffer = NULL;
+    int pid = (int)getpid ();
+    int first = 1;
+
+    if (out == NULL)
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    events = (ARSAL_Trace_Event_t *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, ARSAL_TRACE_BUFFER_EVENTS * sizeof (ARSAL_Trace_Event_t));
+    if (events == NULL)
+    {
+        return ARSAL_ERROR_ALLOC;
+    }
+
+    fprintf (out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    for (buffer = __atomic_load_n (&ARSAL_Trace_Recorder.buffers, __ATOMIC_ACQUIRE); buffer != NULL; buffer = buffer->next)
+    {
+        size_t count = ARSAL_Trace_CopyEvents (buffer, events);
+        size_t index = 0;
+
+        if (count == 0)
+        {
+            continue;
+        }
+
+        fprintf (out, "%s\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",", pid, buffer->tid);
+        ARSAL_Trace_WriteJsonString (out, (buffer->name[0] != '\0') ? buffer->name : "thread");
+        fprintf (out, "}}");
+        first = 0;
+
+        for (index = 0; index < count; index++)
+        {
+            ARSAL_Trace_Event_t *event = &events[index];
+
+            fprintf (out, ",\n{\"ph\":\"%s\",\"pid\":%d,\"tid\":%u,\"ts\":%llu.%03u,\"cat\":", phases[event->type], pid, buffer->tid,
+                     (unsigned long long)(event->timestamp / 1000), (unsigned)(event->timestamp % 1000));
+            ARSAL_Trace_WriteJsonString (out, event->category);
+            fprintf (out, ",\"name\":");
+            ARSAL_Trace_WriteJsonString (out, event->name);
+            if (event->type == ARSAL_TRACE_EVENT_INSTANT)
+            {
+                fprintf (out, ",\"s\":\"t\"");
+            }
+            else if (event->type >= ARSAL_TRACE_EVENT_FLOW_BEGIN)
+            {
+                /* binds the flow to the enclosing slice */
+                fprintf (out, ",\"id\":%llu,\"bp\":\"e\"", (unsigned long long)event->id);
+            }
+            fprintf (out, "}");
+        }
+    }
+
+    fprintf (out, "\n]}\n");
+    ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, events);
+
+    return ferror (out) ? ARSAL_ERROR_FILE : ARSAL_OK;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Append a protobuf varint
+ */
+static inline size_t ARSAL_Trace_PutVarint (uint8_t *data, size_t position, uint64_t value)
+{
+    do
+    {
+        data[position++] = (uint8_t)((value & 0x7F) | ((value > 0x7F) ? 0x80 : 0));
+        value >>= 7;
+    } while (value != 0);
+
+    return position;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Append a protobuf varint field
+ */
+static inline size_t ARSAL_Trace_PutField (uint8_t *data, size_t position, uint32_t field, uint64_t value)
+{
+    position = ARSAL_Trace_PutVarint (data, position, (uint64_t)field << 3);
+    return ARSAL_Trace_PutVarint (data, position, value);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Append a protobuf fixed64 field
+ */
+static inline size_t ARSAL_Trace_PutFixed64 (uint8_t *data, size_t position, uint32_t field, uint64_t value)
+{
+    int index = 0;
+
+    position = ARSAL_Trace_PutVarint (data, position, ((uint64_t)field << 3) | 1);
+    for (index = 0; index < 8; index++)
+    {
+        data[position++] = (uint8_t)(value >> (8 * index));
+    }
+
+    return position;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Append a protobuf length delimited field
+ */
+static inline size_t ARSAL_Trace_PutBytes (uint8_t *data, size_t position, uint32_t field, const void *bytes, size_t size)
+{
+    position = ARSAL_Trace_PutVarint (data, position, ((uint64_t)field << 3) | 2);
+    position = ARSAL_Trace_PutVarint (data, position, size);
+    memcpy (&data[position], bytes, size);
+
+    return position + size;
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Append a protobuf string field, truncated to 255 bytes
+ */
+static inline size_t ARSAL_Trace_PutString (uint8_t *data, size_t position, uint32_t field, const char *string, size_t maxSize)
+{
+    const char *end = (const char *)memchr (string, '\0', (maxSize < 255) ? maxSize : 255);
+    size_t size = (end != NULL) ? (size_t)(end - string) : ((maxSize < 255) ? maxSize : 255);
+
+    return ARSAL_Trace_PutBytes (data, position, field, string, size);
+}
+
+/**
+ * @brief INTERNAL FUNCTION : Write a TracePacket, as a field of the Trace message
+ */
+static inline void ARSAL_Trace_WritePacket (FILE *out, const uint8_t *packet, size_t size)
+{
+    uint8_t header[12];
+    size_t position = ARSAL_Trace_PutVarint (header, 0, (1 << 3) | 2);
+
+    position = ARSAL_Trace_PutVarint (header, position, size);
+    fwrite (header, 1, position, out);
+    fwrite (packet, 1, size, out);
+}
+
+/**
+ * @brief Export the capture in the Perfetto protobuf trace format, for ui.perfetto.dev or trace_processor
+ * @note Each thread gets a track ; the events are TrackEvent slices and instants, the flows are flow ids.
+ * @param out The file to write
+ * @retval On success, returns ARSAL_OK. Otherwise, it returns an error number of eARSAL_ERROR
+ */
+static inline eARSAL_ERROR ARSAL_Trace_ExportPerfetto (FILE *out)
+{
+    /* TrackEvent.Type of each event type : SLICE_BEGIN, SLICE_END or INSTANT */
+    static const uint8_t types[] = { 1, 2, 3, 3, 3, 3 };
+    ARSAL_Trace_Event_t *events = NULL;
+    ARSAL_Trace_Buffer_t *buffer = NULL;
+    uint64_t pid = (uint64_t)getpid ();
+
+    if (out == NULL)
+    {
+        return ARSAL_ERROR_BAD_PARAMETER;
+    }
+
+    events = (ARSAL_Trace_Event_t *)ARSAL_Allocator_Malloc (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, ARSAL_TRACE_BUFFER_EVENTS * sizeof (ARSAL_Trace_Event_t));
+    if (events == NULL)
+    {
+        return ARSAL_ERROR_ALLOC;
+    }
+
+    for (buffer = __atomic_load_n (&ARSAL_Trace_Recorder.buffers, __ATOMIC_ACQUIRE); buffer != NULL; buffer = buffer->next)
+    {
+        size_t count = ARSAL_Trace_CopyEvents (buffer, events);
+        uint64_t uuid = (pid << 32) | buffer->tid;
+        uint8_t message[1024];
+        uint8_t packet[1024];
+        size_t messageSize = 0;
+        size_t packetSize = 0;
+        size_t index = 0;
+
+        if (count == 0)
+        {
+            continue;
+        }
+
+        /* TrackDescriptor { uuid = 1, thread = 4 { pid = 1, tid = 2, thread_name = 5 } } */
+        messageSize = ARSAL_Trace_PutField (message, 0, 1, pid);
+        messageSize = ARSAL_Trace_PutField (message, messageSize, 2, buffer->tid);
+        messageSize = ARSAL_Trace_PutString (message, messageSize, 5, buffer->name, sizeof (buffer->name));
+        packetSize = ARSAL_Trace_PutField (packet, 0, 1, uuid);
+        packetSize = ARSAL_Trace_PutBytes (packet, packetSize, 4, message, messageSize);
+        messageSize = packetSize;
+        memcpy (message, packet, messageSize);
+
+        /* TracePacket { trusted_packet_sequence_id = 10, track_descriptor = 60 } */
+        packetSize = ARSAL_Trace_PutField (packet, 0, 10, buffer->tid);
+        packetSize = ARSAL_Trace_PutBytes (packet, packetSize, 60, message, messageSize);
+        ARSAL_Trace_WritePacket (out, packet, packetSize);
+
+        for (index = 0; index < count; index++)
+        {
+            ARSAL_Trace_Event_t *event = &events[index];
+
+            /* TrackEvent { type = 9, track_uuid = 11, categories = 22, name = 23, flow_ids = 47, terminating_flow_ids = 48 } */
+            messageSize = ARSAL_Trace_PutField (message, 0, 9, types[event->type]);
+            messageSize = ARSAL_Trace_PutField (message, messageSize, 11, uuid);
+            if ((event->category != NULL) && (event->type != ARSAL_TRACE_EVENT_END))
+            {
+                messageSize = ARSAL_Trace_PutString (message, messageSize, 22, event->category, SIZE_MAX);
+            }
+            if ((event->name != NULL) && (event->type != ARSAL_TRACE_EVENT_END))
+            {
+                messageSize = ARSAL_Trace_PutString (message, messageSize, 23, event->name, SIZE_MAX);
+            }
+            if (event->type >= ARSAL_TRACE_EVENT_FLOW_BEGIN)
+            {
+                messageSize = ARSAL_Trace_PutFixed64 (message, messageSize, (event->type == ARSAL_TRACE_EVENT_FLOW_END) ? 48 : 47, event->id);
+            }
+
+            /* TracePacket { timestamp = 8, trusted_packet_sequence_id = 10, track_event = 11, timestamp_clock_id = 58 (MONOTONIC) } */
+            packetSize = ARSAL_Trace_PutField (packet, 0, 8, event->timestamp);
+            packetSize = ARSAL_Trace_PutField (packet, packetSize, 10, buffer->tid);
+            packetSize = ARSAL_Trace_PutBytes (packet, packetSize, 11, message, messageSize);
+            packetSize = ARSAL_Trace_PutField (packet, packetSize, 58, 3);
+            ARSAL_Trace_WritePacket (out, packet, packetSize);
+        }
+    }
+
+    ARSAL_Allocator_Free (ARSAL_ALLOCATOR_SUBSYSTEM_ARSAL, events);
+
+    return ferror (out) ? ARSAL_ERROR_FILE : ARSAL_OK;
+}
+
+#endif /* _ARSAL_TRACE_H_ */
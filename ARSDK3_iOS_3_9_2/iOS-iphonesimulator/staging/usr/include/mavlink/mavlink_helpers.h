@@ -251,6 +251,7 @@ MAVLINK_HELPER uint8_t mavlink_frame_char_buffer(mavlink_message_t* rxmsg,
 #ifndef MAVLINK_MESSAGE_CRC
 	static const uint8_t mavlink_message_crcs[256] = MAVLINK_MESSAGE_CRCS;
 #define MAVLINK_MESSAGE_CRC(msgid) mavlink_message_crcs[msgid]
+#define _MAVLINK_MESSAGE_CRC_TABLE
 #endif
 #endif
 
@@ -264,6 +265,7 @@ MAVLINK_HELPER uint8_t mavlink_frame_char_buffer(mavlink_message_t* rxmsg,
 #ifndef MAVLINK_MESSAGE_LENGTH
 	static const uint8_t mavlink_message_lengths[256] = MAVLINK_MESSAGE_LENGTHS;
 #define MAVLINK_MESSAGE_LENGTH(msgid) mavlink_message_lengths[msgid]
+#define _MAVLINK_MESSAGE_LENGTH_TABLE
 #endif
 #endif
 
@@ -415,7 +417,7 @@ MAVLINK_HELPER uint8_t mavlink_frame_char_buffer(mavlink_message_t* rxmsg,
 		  mavlink_msg_to_send_buffer() won't overwrite the
 		  checksum
 		 */
-		r_message->checksum = _MAV_PAYLOAD(rxmsg)[status->packet_idx] | (_MAV_PAYLOAD(rxmsg)[status->packet_idx+1]<<8);
+		r_message->checksum = (uint8_t)_MAV_PAYLOAD(rxmsg)[status->packet_idx] | ((uint8_t)_MAV_PAYLOAD(rxmsg)[status->packet_idx+1]<<8);
 	}
 
 	return status->msg_received;
@@ -533,6 +535,298 @@ MAVLINK_HELPER uint8_t mavlink_parse_char(uint8_t chan, uint8_t c, mavlink_messa
     return msg_received;
 }
 
+/**
+ * @brief Reset a caller owned parser
+ */
+MAVLINK_HELPER void mavlink_parser_init(mavlink_parser_t* parser)
+{
+	memset(parser, 0, sizeof(mavlink_parser_t));
+	parser->status.parse_state = MAVLINK_PARSE_STATE_IDLE;
+}
+
+/*
+ * Internal function ending the message of a parser after its second CRC byte.
+ * Returns MAVLINK_FRAMING_INCOMPLETE for a bad CRC when drop_bad_crc is set.
+ */
+MAVLINK_HELPER uint8_t _mavlink_parser_end_message(mavlink_parser_t* parser, uint8_t ck_a, uint8_t ck_b,
+						   mavlink_message_t* r_message, mavlink_status_t* r_mavlink_status,
+						   uint8_t drop_bad_crc)
+{
+	mavlink_message_t* rxmsg = &parser->rxmsg;
+	mavlink_status_t* status = &parser->status;
+
+	if (status->parse_state == MAVLINK_PARSE_STATE_GOT_CRC1 && ck_b == (rxmsg->checksum >> 8)) {
+		status->msg_received = MAVLINK_FRAMING_OK;
+	} else {
+		status->msg_received = MAVLINK_FRAMING_BAD_CRC;
+	}
+	status->parse_state = MAVLINK_PARSE_STATE_IDLE;
+	_MAV_PAYLOAD_NON_CONST(rxmsg)[rxmsg->len] = (char)ck_a;
+	_MAV_PAYLOAD_NON_CONST(rxmsg)[rxmsg->len+1] = (char)ck_b;
+
+	if (status->msg_received == MAVLINK_FRAMING_BAD_CRC && drop_bad_crc) {
+		// same as mavlink_parse_char(): count it and keep parsing
+		status->parse_error++;
+		status->msg_received = MAVLINK_FRAMING_INCOMPLETE;
+		return MAVLINK_FRAMING_INCOMPLETE;
+	}
+
+	if (status->msg_received == MAVLINK_FRAMING_OK) {
+		status->current_rx_seq = rxmsg->seq;
+		// Initial condition: If no packet has been received so far, drop count is undefined
+		if (status->packet_rx_success_count == 0) status->packet_rx_drop_count = 0;
+		// Count this packet as received
+		status->packet_rx_success_count++;
+	}
+
+	memcpy(r_message, rxmsg, sizeof(mavlink_message_t));
+	if (status->msg_received == MAVLINK_FRAMING_BAD_CRC) {
+		// keep the CRC on the wire, see mavlink_frame_char_buffer()
+		r_message->checksum = (uint16_t)(ck_a | (ck_b << 8));
+	}
+
+	r_mavlink_status->msg_received = status->msg_received;
+	r_mavlink_status->parse_state = status->parse_state;
+	r_mavlink_status->packet_idx = status->packet_idx;
+	r_mavlink_status->current_rx_seq = status->current_rx_seq+1;
+	r_mavlink_status->packet_rx_success_count = status->packet_rx_success_count;
+	r_mavlink_status->packet_rx_drop_count = status->parse_error;
+	status->parse_error = 0;
+
+	return status->msg_received;
+}
+
+/*
+ * Internal function parsing a buffer with a caller owned parser, see
+ * mavlink_frame_buffer() and mavlink_parse_buffer().
+ */
+MAVLINK_HELPER uint8_t _mavlink_parser_buffer(mavlink_parser_t* parser, const uint8_t* buf, size_t len, size_t* r_consumed,
+					      mavlink_message_t* r_message, mavlink_status_t* r_mavlink_status,
+					      uint8_t drop_bad_crc)
+{
+#if MAVLINK_CRC_EXTRA && defined(_MAVLINK_MESSAGE_CRC_TABLE)
+	static const uint8_t mavlink_message_crcs[256] = MAVLINK_MESSAGE_CRCS;
+#endif
+#if defined(MAVLINK_CHECK_MESSAGE_LENGTH) && defined(_MAVLINK_MESSAGE_LENGTH_TABLE)
+	static const uint8_t mavlink_message_lengths[256] = MAVLINK_MESSAGE_LENGTHS;
+#endif
+
+	mavlink_message_t* rxmsg = &parser->rxmsg;
+	mavlink_status_t* status = &parser->status;
+	uint8_t result = MAVLINK_FRAMING_INCOMPLETE;
+	size_t i = 0;
+	size_t n;
+	uint8_t c;
+	uint16_t checksum;
+
+	status->msg_received = MAVLINK_FRAMING_INCOMPLETE;
+
+	while (i < len && result == MAVLINK_FRAMING_INCOMPLETE)
+	{
+		switch (status->parse_state)
+		{
+		case MAVLINK_PARSE_STATE_UNINIT:
+		case MAVLINK_PARSE_STATE_IDLE:
+		{
+			// memchr() is vectorized by the C library
+			const uint8_t* stx = (const uint8_t*)memchr(buf + i, MAVLINK_STX, len - i);
+			if (stx == NULL) {
+				i = len;
+				break;
+			}
+			i = (size_t)(stx - buf);
+
+			if (len - i < MAVLINK_NUM_NON_PAYLOAD_BYTES ||
+			    len - i < (size_t)buf[i+1] + MAVLINK_NUM_NON_PAYLOAD_BYTES
+#if (MAVLINK_MAX_PAYLOAD_LEN < 255)
+			    || buf[i+1] > MAVLINK_MAX_PAYLOAD_LEN
+#endif
+			    ) {
+				// the frame ends in a later buffer, or must be rejected byte by byte
+				status->parse_state = MAVLINK_PARSE_STATE_GOT_STX;
+				rxmsg->len = 0;
+				rxmsg->magic = MAVLINK_STX;
+				mavlink_start_checksum(rxmsg);
+				i++;
+				break;
+			}
+
+#ifdef MAVLINK_CHECK_MESSAGE_LENGTH
+			if (buf[i+1] != MAVLINK_MESSAGE_LENGTH(buf[i+5])) {
+				status->parse_error++;
+				i += MAVLINK_NUM_HEADER_BYTES;
+				break;
+			}
+#endif
+			// the whole frame is in the buffer: copy it and hash it at once
+			memcpy(&rxmsg->magic, buf + i, MAVLINK_NUM_HEADER_BYTES + (size_t)buf[i+1]);
+			status->packet_idx = rxmsg->len;
+			rxmsg->checksum = crc_calculate(buf + i + 1, MAVLINK_CORE_HEADER_LEN + (uint16_t)rxmsg->len);
+#if MAVLINK_CRC_EXTRA
+			mavlink_update_checksum(rxmsg, MAVLINK_MESSAGE_CRC(rxmsg->msgid));
+#endif
+			i += MAVLINK_NUM_HEADER_BYTES + (size_t)rxmsg->len;
+			status->parse_state = (buf[i] == (rxmsg->checksum & 0xFF)) ? MAVLINK_PARSE_STATE_GOT_CRC1 : MAVLINK_PARSE_STATE_GOT_BAD_CRC1;
+			result = _mavlink_parser_end_message(parser, buf[i], buf[i+1], r_message, r_mavlink_status, drop_bad_crc);
+			// like mavlink_parse_char(), a dropped frame whose last byte is STX restarts there
+			i += (result == MAVLINK_FRAMING_INCOMPLETE && buf[i+1] == MAVLINK_STX) ? 1 : 2;
+			break;
+		}
+
+		case MAVLINK_PARSE_STATE_GOT_STX:
+			c = buf[i++];
+#if (MAVLINK_MAX_PAYLOAD_LEN < 255)
+			if (c > MAVLINK_MAX_PAYLOAD_LEN) {
+				status->buffer_overrun++;
+				status->parse_error++;
+				status->parse_state = MAVLINK_PARSE_STATE_IDLE;
+				break;
+			}
+#endif
+			// NOT counting STX, LENGTH, SEQ, SYSID, COMPID, MSGID, CRC1 and CRC2
+			rxmsg->len = c;
+			status->packet_idx = 0;
+			mavlink_update_checksum(rxmsg, c);
+			status->parse_state = MAVLINK_PARSE_STATE_GOT_LENGTH;
+			break;
+
+		case MAVLINK_PARSE_STATE_GOT_LENGTH:
+			rxmsg->seq = buf[i++];
+			mavlink_update_checksum(rxmsg, rxmsg->seq);
+			status->parse_state = MAVLINK_PARSE_STATE_GOT_SEQ;
+			break;
+
+		case MAVLINK_PARSE_STATE_GOT_SEQ:
+			rxmsg->sysid = buf[i++];
+			mavlink_update_checksum(rxmsg, rxmsg->sysid);
+			status->parse_state = MAVLINK_PARSE_STATE_GOT_SYSID;
+			break;
+
+		case MAVLINK_PARSE_STATE_GOT_SYSID:
+			rxmsg->compid = buf[i++];
+			mavlink_update_checksum(rxmsg, rxmsg->compid);
+			status->parse_state = MAVLINK_PARSE_STATE_GOT_COMPID;
+			break;
+
+		case MAVLINK_PARSE_STATE_GOT_COMPID:
+			c = buf[i++];
+#ifdef MAVLINK_CHECK_MESSAGE_LENGTH
+			if (rxmsg->len != MAVLINK_MESSAGE_LENGTH(c)) {
+				status->parse_error++;
+				status->parse_state = MAVLINK_PARSE_STATE_IDLE;
+				break;
+			}
+#endif
+			rxmsg->msgid = c;
+			mavlink_update_checksum(rxmsg, c);
+			status->parse_state = (rxmsg->len == 0) ? MAVLINK_PARSE_STATE_GOT_PAYLOAD : MAVLINK_PARSE_STATE_GOT_MSGID;
+			break;
+
+		case MAVLINK_PARSE_STATE_GOT_MSGID:
+			// copy and hash as much of the payload as the buffer holds
+			n = (size_t)(rxmsg->len - status->packet_idx);
+			if (n > len - i) {
+				n = len - i;
+			}
+			memcpy(_MAV_PAYLOAD_NON_CONST(rxmsg) + status->packet_idx, buf + i, n);
+			// rxmsg is packed: accumulate into an aligned local
+			checksum = rxmsg->checksum;
+			crc_accumulate_buffer(&checksum, (const char*)(buf + i), (uint16_t)n);
+			rxmsg->checksum = checksum;
+			status->packet_idx = (uint8_t)(status->packet_idx + n);
+			i += n;
+			if (status->packet_idx == rxmsg->len) {
+				status->parse_state = MAVLINK_PARSE_STATE_GOT_PAYLOAD;
+			}
+			break;
+
+		case MAVLINK_PARSE_STATE_GOT_PAYLOAD:
+#if MAVLINK_CRC_EXTRA
+			mavlink_update_checksum(rxmsg, MAVLINK_MESSAGE_CRC(rxmsg->msgid));
+#endif
+			c = buf[i++];
+			status->parse_state = (c == (rxmsg->checksum & 0xFF)) ? MAVLINK_PARSE_STATE_GOT_CRC1 : MAVLINK_PARSE_STATE_GOT_BAD_CRC1;
+			_MAV_PAYLOAD_NON_CONST(rxmsg)[status->packet_idx] = (char)c;
+			break;
+
+		case MAVLINK_PARSE_STATE_GOT_CRC1:
+		case MAVLINK_PARSE_STATE_GOT_BAD_CRC1:
+			c = buf[i++];
+			result = _mavlink_parser_end_message(parser, (uint8_t)_MAV_PAYLOAD(rxmsg)[status->packet_idx], c,
+							     r_message, r_mavlink_status, drop_bad_crc);
+			// like mavlink_parse_char(), a dropped frame whose last byte is STX restarts there
+			if (result == MAVLINK_FRAMING_INCOMPLETE && c == MAVLINK_STX) {
+				i--;
+			}
+			break;
+		}
+	}
+
+	*r_consumed = i;
+	return result;
+}
+
+/**
+ * This is a buffer at a time variant of mavlink_frame_char_buffer(), with a
+ * caller owned parser instead of the channel buffers.
+ *
+ * The function parses buf until it ends or until a message is decoded, and
+ * returns the number of bytes consumed in r_consumed: call it again on the
+ * rest of the buffer to get the next messages. Frames wholly inside the
+ * buffer are copied and hashed at once, frames split across buffers carry
+ * on with the next call.
+ *
+ * @param parser   parser initialized by mavlink_parser_init()
+ * @param buf      bytes to parse
+ * @param len      number of bytes to parse
+ * @param r_consumed number of bytes consumed
+ * @param r_message if a message was decoded, this is filled with the message
+ * @param r_mavlink_status if a message was decoded, this is filled with the parser stats
+ * @return 0 if no message could be decoded, 1 on good message and CRC, 2 on bad CRC
+ *
+ * A typical use scenario of this function call is:
+ *
+ * @code
+ * #include <mavlink.h>
+ *
+ * mavlink_parser_t parser;
+ * mavlink_message_t msg;
+ * mavlink_status_t status;
+ * size_t offset = 0, consumed;
+ *
+ * mavlink_parser_init(&parser);
+ * while (offset < length)
+ * {
+ *   if (mavlink_frame_buffer(&parser, buffer + offset, length - offset, &consumed, &msg, &status) != MAVLINK_FRAMING_INCOMPLETE)
+ *   {
+ *     printf("Received message with ID %d, sequence: %d from component %d of system %d", msg.msgid, msg.seq, msg.compid, msg.sysid);
+ *   }
+ *   offset += consumed;
+ * }
+ * @endcode
+ */
+MAVLINK_HELPER uint8_t mavlink_frame_buffer(mavlink_parser_t* parser, const uint8_t* buf, size_t len, size_t* r_consumed,
+					    mavlink_message_t* r_message, mavlink_status_t* r_mavlink_status)
+{
+	return _mavlink_parser_buffer(parser, buf, len, r_consumed, r_message, r_mavlink_status, 0);
+}
+
+/**
+ * This is a buffer at a time variant of mavlink_parse_char(), with a caller
+ * owned parser instead of the channel buffers: messages with a bad CRC are
+ * skipped, see mavlink_frame_buffer() for the rest.
+ *
+ * r_mavlink_status->packet_rx_drop_count is the number of parse errors since
+ * the previous decoded message.
+ *
+ * @return 0 if the buffer was consumed without decoding a message, 1 on good message and CRC
+ */
+MAVLINK_HELPER uint8_t mavlink_parse_buffer(mavlink_parser_t* parser, const uint8_t* buf, size_t len, size_t* r_consumed,
+					    mavlink_message_t* r_message, mavlink_status_t* r_mavlink_status)
+{
+	return _mavlink_parser_buffer(parser, buf, len, r_consumed, r_message, r_mavlink_status, 1);
+}
+
 /**
  * @brief Put a bitfield of length 1-32 bit into the buffer
  *